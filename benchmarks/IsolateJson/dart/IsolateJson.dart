@@ -47,6 +47,52 @@ Uint8List createSampleJson(final size) {
   return utf8.encode(json.encode(map));
 }
 
+// Repeats the entries of [decoded1MB] to build a JSON document of roughly
+// [megabytes] MB.
+Uint8List createLargeJson(Map decoded1MB, int megabytes) {
+  final map = <dynamic, dynamic>{};
+  for (int i = 0; i < megabytes; i++) {
+    for (final entry in decoded1MB.entries) {
+      map['$i.${entry.key}'] = entry.value;
+    }
+  }
+  return utf8.encode(json.encode(map));
+}
+
+// A map of 4 MB [Uint8List]s totalling [megabytes] MB.
+Map<String, Uint8List> createBytesPayload(int megabytes) {
+  const chunk = 4 * 1024 * 1024;
+  return <String, Uint8List>{
+    for (int i = 0; i < megabytes ~/ 4; i++)
+      '$i': Uint8List(chunk)..fillRange(0, chunk, i & 0xff),
+  };
+}
+
+// Measures how long the sender is blocked copying a large message.
+class SendBenchmark {
+  SendBenchmark(this.name, this.payload);
+
+  Future<void> report() async {
+    final port = ReceivePort();
+    final inbox = StreamIterator<dynamic>(port);
+    int sendMicros = 0;
+    // Benchmark harness counts 10 iterations as one.
+    for (int i = 0; i < 10; i++) {
+      final stopwatch = Stopwatch()..start();
+      port.sendPort.send(payload);
+      sendMicros += stopwatch.elapsedMicroseconds;
+      await inbox.moveNext();
+    }
+    await inbox.cancel();
+    port.close();
+
+    print('$name(RunTime): $sendMicros us.');
+  }
+
+  final String name;
+  final Object payload;
+}
+
 class JsonDecodeRequest {
   final bool useSendAndExit;
   final SendPort sendPort;
@@ -141,6 +187,12 @@ Future<void> main() async {
     BenchmarkConfig('250KB', json250KB),
     BenchmarkConfig('1MB', json1MB),
   ];
+  // Very large payloads are only decoded by a single worker, to keep the
+  // running time and memory usage of the benchmark reasonable.
+  final largeConfigs = <BenchmarkConfig>[
+    BenchmarkConfig('16MB', createLargeJson(decoded1MB, 16)),
+    BenchmarkConfig('64MB', createLargeJson(decoded1MB, 64)),
+  ];
 
   for (final config in configs) {
     for (final iterations in <int>[1, 4]) {
@@ -163,4 +215,35 @@ Future<void> main() async {
       ).report();
     }
   }
+
+  for (final config in largeConfigs) {
+    await JsonDecodingBenchmark(
+      'IsolateJson.Decode${config.suffix}x1',
+      useSendAndExit: false,
+      sample: config.sample,
+      numTasks: 1,
+    ).report();
+    await JsonDecodingBenchmark(
+      'IsolateJson.SendAndExit_Decode${config.suffix}x1',
+      useSendAndExit: true,
+      sample: config.sample,
+      numTasks: 1,
+    ).report();
+  }
+
+  // Sending decoded JSON, a graph of many small maps, lists and strings.
+  for (final config in largeConfigs) {
+    await SendBenchmark(
+      'IsolateJson.SendDecoded${config.suffix}',
+      json.decode(utf8.decode(config.sample)),
+    ).report();
+  }
+
+  // Sending decoded data which carries large binary payloads.
+  for (final megabytes in <int>[16, 64]) {
+    await SendBenchmark(
+      'IsolateJson.SendBytes${megabytes}MB',
+      createBytesPayload(megabytes),
+    ).report();
+  }
 }
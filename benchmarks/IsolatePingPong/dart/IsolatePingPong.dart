@@ -0,0 +1,107 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measures the throughput of small messages exchanged between pairs of
+// isolates, as a function of the number of isolates exchanging messages
+// concurrently.
+
+import 'dart:async';
+import 'dart:isolate';
+
+const int roundTripsPerPair = 20000;
+const List<int> isolateCounts = [2, 4, 8, 16, 32, 64];
+
+// Echoes every message back to the sender of the first message.
+void pong(SendPort initialReply) {
+  final port = RawReceivePort();
+  SendPort? ping;
+  port.handler = (message) {
+    if (message is SendPort) {
+      ping = message;
+      return;
+    }
+    if (message == null) {
+      port.close();
+      return;
+    }
+    ping!.send(message);
+  };
+  initialReply.send(port.sendPort);
+}
+
+// Sends [roundTrips] messages to pong and waits for each echo before sending
+// the next one.
+void ping(List args) {
+  final SendPort pongPort = args[0];
+  final SendPort ready = args[1];
+  final SendPort done = args[2];
+  final int roundTrips = args[3];
+
+  final port = RawReceivePort();
+  int remaining = roundTrips;
+  port.handler = (message) {
+    if (message is SendPort) {
+      // Start signal.
+      pongPort.send(remaining);
+      return;
+    }
+    remaining--;
+    if (remaining == 0) {
+      pongPort.send(null);
+      port.close();
+      done.send(null);
+      return;
+    }
+    pongPort.send(remaining);
+  };
+  pongPort.send(port.sendPort);
+  ready.send(port.sendPort);
+}
+
+Future<double> measure(int pairs) async {
+  final readyPort = ReceivePort();
+  final donePort = ReceivePort();
+  final ready = StreamIterator(readyPort);
+
+  final pingPorts = <SendPort>[];
+  for (int i = 0; i < pairs; i++) {
+    await Isolate.spawn(pong, readyPort.sendPort);
+    await ready.moveNext();
+    final pongPort = ready.current as SendPort;
+    await Isolate.spawn(ping, [
+      pongPort,
+      readyPort.sendPort,
+      donePort.sendPort,
+      roundTripsPerPair,
+    ]);
+    await ready.moveNext();
+    pingPorts.add(ready.current as SendPort);
+  }
+
+  final watch = Stopwatch()..start();
+  for (final port in pingPorts) {
+    port.send(port);
+  }
+  await donePort.take(pairs).length;
+  watch.stop();
+
+  await ready.cancel();
+  readyPort.close();
+
+  final messages = 2 * roundTripsPerPair * pairs;
+  return messages * 1e6 / watch.elapsedMicroseconds;
+}
+
+Future<void> main() async {
+  // Warm up the message passing paths.
+  await measure(2);
+
+  for (final count in isolateCounts) {
+    final messagesPerSecond = await measure(count ~/ 2);
+    print(
+      'IsolatePingPong.Isolates$count(MessagesPerSecond): '
+      '${messagesPerSecond.round()}',
+    );
+  }
+}
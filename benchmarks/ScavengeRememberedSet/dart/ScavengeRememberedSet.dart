@@ -0,0 +1,74 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Measures scavenges in the presence of a large old-space graph that the
+// mutator keeps pointing at new objects. Each store into an old array makes
+// the array part of the remembered set, so the cost of the following scavenge
+// depends on how much of each array has to be rescanned.
+//
+// Compare runs with and without --card_mark_promoted_arrays.
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+// ~100MB of arrays: 12800 arrays of 1024 elements.
+const int arrayCount = 12800;
+const int arrayLength = 1024;
+
+// Number of old arrays updated between scavenges, and the stride between the
+// updated slots.
+const int storesPerRound = 4096;
+const int storeStride = 97;
+
+class Leaf {
+  final int value;
+  Leaf(this.value);
+}
+
+class ScavengeRememberedSet extends BenchmarkBase {
+  ScavengeRememberedSet() : super('ScavengeRememberedSet');
+
+  late List<List<Object?>> arrays;
+  int cursor = 0;
+  int sink = 0;
+
+  @override
+  void setup() {
+    arrays = List<List<Object?>>.generate(
+      arrayCount,
+      (_) => List<Object?>.filled(arrayLength, null),
+    );
+    // Survive enough scavenges for the arrays to be promoted.
+    for (int i = 0; i < 4; i++) {
+      allocateGarbage();
+    }
+  }
+
+  @override
+  void teardown() {
+    arrays = const [];
+  }
+
+  // Enough short-lived allocation to fill new space at least once.
+  void allocateGarbage() {
+    for (int i = 0; i < 1 << 20; i++) {
+      sink ^= List<int>.filled(8, i).length;
+    }
+  }
+
+  @override
+  void run() {
+    for (int i = 0; i < storesPerRound; i++) {
+      final array = arrays[cursor % arrayCount];
+      array[(cursor * storeStride) % arrayLength] = Leaf(i);
+      cursor++;
+    }
+    allocateGarbage();
+  }
+}
+
+void main() {
+  final benchmark = ScavengeRememberedSet();
+  benchmark.report();
+  if (benchmark.sink == -1) print(benchmark.sink);
+}
@@ -0,0 +1,167 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+/// Micro-benchmarks for socket traffic through the dart:io event handler.
+///
+/// Run once without flags and once with `--use-io-uring` to compare the
+/// epoll and io_uring backends of the Linux event handler.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+/// Echoes everything received on every accepted connection.
+Future<ServerSocket> startEchoServer() async {
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((socket) {
+    socket.setOption(SocketOption.tcpNoDelay, true);
+    socket.listen(socket.add, onDone: socket.destroy);
+  });
+  return server;
+}
+
+/// A client connection that waits for the echo of a message before sending
+/// the next one.
+class EchoClient {
+  final Socket _socket;
+  late final StreamSubscription<Uint8List> _subscription;
+  int _expected = 0;
+  Completer<void>? _echoed;
+
+  EchoClient(this._socket) {
+    _socket.setOption(SocketOption.tcpNoDelay, true);
+    _subscription = _socket.listen((data) {
+      _expected -= data.length;
+      if (_expected == 0) {
+        final echoed = _echoed!;
+        _echoed = null;
+        echoed.complete();
+      }
+    });
+  }
+
+  Future<void> roundTrip(Uint8List message) {
+    final echoed = _echoed = Completer<void>();
+    _expected = message.length;
+    _socket.add(message);
+    return echoed.future;
+  }
+
+  Future<void> close() async {
+    await _subscription.cancel();
+    _socket.destroy();
+  }
+}
+
+/// Benchmark many connections exchanging small messages concurrently, which
+/// is dominated by event handler wake-ups.
+class BenchmarkPingPong extends AsyncBenchmarkBase {
+  static const numConnections = 64;
+  static const numRoundTrips = 10;
+
+  late ServerSocket _server;
+  final _clients = <EchoClient>[];
+  final _message = Uint8List(64);
+
+  BenchmarkPingPong() : super('SocketEcho.PingPong');
+
+  @override
+  Future<void> setup() async {
+    _server = await startEchoServer();
+    for (int i = 0; i < numConnections; i++) {
+      final socket = await Socket.connect(
+        InternetAddress.loopbackIPv4,
+        _server.port,
+      );
+      _clients.add(EchoClient(socket));
+    }
+  }
+
+  @override
+  Future<void> teardown() async {
+    for (final client in _clients) {
+      await client.close();
+    }
+    await _server.close();
+  }
+
+  Future<void> _run(EchoClient client) async {
+    for (int i = 0; i < numRoundTrips; i++) {
+      await client.roundTrip(_message);
+    }
+  }
+
+  @override
+  Future<void> run() async {
+    await Future.wait(_clients.map(_run));
+  }
+}
+
+/// Benchmark echoing a large buffer through one connection, which is
+/// dominated by reads and by writes waiting for write events.
+class BenchmarkBulk extends AsyncBenchmarkBase {
+  late ServerSocket _server;
+  late EchoClient _client;
+  final _message = Uint8List(4 * 1024 * 1024);
+
+  BenchmarkBulk() : super('SocketEcho.Bulk');
+
+  @override
+  Future<void> setup() async {
+    _server = await startEchoServer();
+    _client = EchoClient(
+      await Socket.connect(InternetAddress.loopbackIPv4, _server.port),
+    );
+  }
+
+  @override
+  Future<void> teardown() async {
+    await _client.close();
+    await _server.close();
+  }
+
+  @override
+  Future<void> run() => _client.roundTrip(_message);
+}
+
+/// Benchmark connecting and closing, which is dominated by accepting on the
+/// listening socket.
+class BenchmarkConnect extends AsyncBenchmarkBase {
+  static const numConnections = 32;
+
+  late ServerSocket _server;
+
+  BenchmarkConnect() : super('SocketEcho.Connect');
+
+  @override
+  Future<void> setup() async {
+    _server = await startEchoServer();
+  }
+
+  @override
+  Future<void> teardown() async {
+    await _server.close();
+  }
+
+  @override
+  Future<void> run() async {
+    final sockets = await Future.wait([
+      for (int i = 0; i < numConnections; i++)
+        Socket.connect(InternetAddress.loopbackIPv4, _server.port),
+    ]);
+    for (final socket in sockets) {
+      socket.destroy();
+    }
+  }
+}
+
+void main() async {
+  final benchmarks = [BenchmarkPingPong(), BenchmarkBulk(), BenchmarkConnect()];
+
+  for (final benchmark in benchmarks) {
+    await benchmark.report();
+  }
+}
@@ -7,6 +7,7 @@
 #include "bin/crypto.h"
 #include "bin/directory.h"
 #include "bin/eventhandler.h"
+#include "bin/io_buffer.h"
 #include "bin/io_natives.h"
 #if defined(DART_IO_SECURE_SOCKET_DISABLED)
 #include "bin/io_service_no_ssl.h"
@@ -27,6 +28,7 @@ namespace bin {
 void BootstrapDartIo() {
   // Bootstrap 'dart:io' event handler.
   TimerUtils::InitOnce();
+  IOBufferPool::Init();
   Process::Init();
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLFilter::Init();
@@ -42,6 +44,7 @@ void CleanupDartIo() {
 #endif
   Process::Cleanup();
   IOService::Cleanup();
+  IOBufferPool::Cleanup();
 }
 
 void SetSystemTempDirectory(const char* system_temp) {
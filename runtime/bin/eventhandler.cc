@@ -19,6 +19,8 @@ namespace bin {
 static EventHandler* event_handler = nullptr;
 static Monitor* shutdown_monitor = nullptr;
 
+bool EventHandler::use_io_uring_ = false;
+
 void EventHandler::Start() {
   FileSystemWatcher::InitOnce();
 
@@ -636,10 +636,18 @@ class EventHandler {
 
   static void SendFromNative(intptr_t id, Dart_Port port, int64_t data);
 
+  // Whether the event handler should use io_uring instead of epoll where the
+  // kernel supports it. Only honored on Linux, and only when set before
+  // Start() is called.
+  static bool use_io_uring() { return use_io_uring_; }
+  static void set_use_io_uring(bool value) { use_io_uring_ = value; }
+
  private:
   friend class EventHandlerImplementation;
   EventHandlerImplementation delegate_;
 
+  static bool use_io_uring_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandler);
 };
 
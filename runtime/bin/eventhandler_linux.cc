@@ -14,10 +14,18 @@
 #include <stdio.h>        // NOLINT
 #include <string.h>       // NOLINT
 #include <sys/epoll.h>    // NOLINT
+#include <sys/mman.h>     // NOLINT
 #include <sys/stat.h>     // NOLINT
+#include <sys/syscall.h>  // NOLINT
 #include <sys/timerfd.h>  // NOLINT
 #include <unistd.h>       // NOLINT
 
+#if defined(DART_HOST_OS_LINUX) && defined(__NR_io_uring_setup) &&             \
+    defined(__NR_io_uring_enter) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>  // NOLINT
+#define DART_EVENTHANDLER_HAS_IO_URING
+#endif
+
 #include "bin/dartutils.h"
 #include "bin/fdutils.h"
 #include "bin/lockers.h"
@@ -70,8 +78,271 @@ static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
   }
 }
 
+// A completion reaped from the io_uring completion queue.
+struct IOUringCompletion {
+  uint64_t user_data;
+  int32_t res;
+  uint32_t flags;
+};
+
+// Set on completions of multishot requests that remain armed.
+#if !defined(IORING_CQE_F_MORE)
+#define IORING_CQE_F_MORE (1U << 1)
+#endif
+
+#if defined(DART_EVENTHANDLER_HAS_IO_URING)
+
+// Older kernel headers do not define everything we rely on. The values are
+// part of the kernel ABI.
+#if !defined(IORING_POLL_ADD_MULTI)
+#define IORING_POLL_ADD_MULTI (1U << 0)
+#endif
+#if !defined(IORING_FEAT_RSRC_TAGS)
+#define IORING_FEAT_RSRC_TAGS (1U << 10)
+#endif
+
+// A minimal io_uring instance used by the event handler thread to batch poll
+// registrations with the wait for events.
+//
+// Only readiness is taken from the kernel: dart:io reads, writes and accepts
+// on the descriptors itself when notified, so the data cannot be consumed
+// here with multishot accept/recv into registered buffers. This saves the
+// epoll_ctl calls, but every event still costs a read on the Dart side.
+//
+// Only the event handler thread touches the rings, so the only required
+// synchronization is with the kernel.
+class IOUring {
+ public:
+  // Returns nullptr if io_uring is not available or the kernel lacks
+  // multishot poll support (added in Linux 5.13).
+  static IOUring* Create(uint32_t entries) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = entries * 4;
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd == -1) {
+      return nullptr;
+    }
+    // There is no feature bit for multishot poll, so use one that was
+    // introduced in the same kernel release.
+    const uint32_t kRequiredFeatures =
+        IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_RSRC_TAGS;
+    if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+      close(fd);
+      return nullptr;
+    }
+    const size_t sq_ring_size =
+        params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    const size_t cq_ring_size =
+        params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    const size_t ring_size = Utils::Maximum(sq_ring_size, cq_ring_size);
+    void* ring = mmap(nullptr, ring_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ring == MAP_FAILED) {
+      close(fd);
+      return nullptr;
+    }
+    const size_t sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      munmap(ring, ring_size);
+      close(fd);
+      return nullptr;
+    }
+    return new IOUring(fd, params, ring, ring_size,
+                       reinterpret_cast<struct io_uring_sqe*>(sqes),
+                       sqes_size);
+  }
+
+  ~IOUring() {
+    munmap(sqes_, sqes_size_);
+    munmap(ring_, ring_size_);
+    close(fd_);
+  }
+
+  // Queues a poll for `poll_mask` on `fd`. Multishot polls stay armed and,
+  // like EPOLLET registrations, report readiness changes until removed.
+  void PollAdd(intptr_t fd,
+               uint32_t poll_mask,
+               bool multishot,
+               uint64_t user_data) {
+    struct io_uring_sqe* sqe = NextSqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = poll_mask;
+    sqe->len = multishot ? IORING_POLL_ADD_MULTI : 0;
+    sqe->user_data = user_data;
+    PublishSqe();
+  }
+
+  // Queues the removal of the poll request identified by `target`.
+  void PollRemove(uint64_t target, uint64_t user_data) {
+    struct io_uring_sqe* sqe = NextSqe();
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = target;
+    sqe->user_data = user_data;
+    PublishSqe();
+  }
+
+  // Submits all queued requests in a single system call and blocks until at
+  // least one completion is available.
+  void SubmitAndWait() {
+    while (true) {
+      const uint32_t to_submit = Pending();
+      int result = static_cast<int>(
+          syscall(__NR_io_uring_enter, fd_, to_submit, 1,
+                  IORING_ENTER_GETEVENTS, nullptr, 0));
+      if (result >= 0) {
+        return;
+      }
+      if ((errno != EINTR) && (errno != EAGAIN)) {
+        FATAL("io_uring_enter failed: %s", strerror(errno));
+      }
+      if (HasCompletions()) {
+        return;
+      }
+    }
+  }
+
+  // Copies up to `max` completions into `completions` and returns how many
+  // were copied.
+  intptr_t Reap(IOUringCompletion* completions, intptr_t max) {
+    uint32_t head = *cq_head_;
+    const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    intptr_t count = 0;
+    while ((head != tail) && (count < max)) {
+      const struct io_uring_cqe& cqe = cqes_[head & cq_mask_];
+      completions[count].user_data = cqe.user_data;
+      completions[count].res = cqe.res;
+      completions[count].flags = cqe.flags;
+      count++;
+      head++;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    return count;
+  }
+
+ private:
+  IOUring(int fd,
+          const struct io_uring_params& params,
+          void* ring,
+          size_t ring_size,
+          struct io_uring_sqe* sqes,
+          size_t sqes_size)
+      : fd_(fd),
+        ring_(ring),
+        ring_size_(ring_size),
+        sqes_(sqes),
+        sqes_size_(sqes_size) {
+    uint8_t* base = reinterpret_cast<uint8_t*>(ring);
+    sq_head_ = reinterpret_cast<uint32_t*>(base + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<uint32_t*>(base + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(base + params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    sq_array_ = reinterpret_cast<uint32_t*>(base + params.sq_off.array);
+    cq_head_ = reinterpret_cast<uint32_t*>(base + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<uint32_t*>(base + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(base + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe*>(base + params.cq_off.cqes);
+  }
+
+  uint32_t Pending() const {
+    return *sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  }
+
+  bool HasCompletions() const {
+    return *cq_head_ != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  }
+
+  struct io_uring_sqe* NextSqe() {
+    if (Pending() == sq_entries_) {
+      // The submission queue is full: hand what we have to the kernel
+      // without waiting for completions.
+      int result = static_cast<int>(
+          syscall(__NR_io_uring_enter, fd_, sq_entries_, 0, 0, nullptr, 0));
+      if ((result == -1) && (errno != EINTR)) {
+        FATAL("io_uring_enter failed: %s", strerror(errno));
+      }
+      if (Pending() == sq_entries_) {
+        FATAL("io_uring submission queue is full");
+      }
+    }
+    const uint32_t index = *sq_tail_ & sq_mask_;
+    struct io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    return sqe;
+  }
+
+  void PublishSqe() {
+    __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+  }
+
+  int fd_;
+  void* ring_;
+  size_t ring_size_;
+  struct io_uring_sqe* sqes_;
+  size_t sqes_size_;
+
+  uint32_t* sq_head_;
+  uint32_t* sq_tail_;
+  uint32_t sq_mask_;
+  uint32_t sq_entries_;
+  uint32_t* sq_array_;
+  uint32_t* cq_head_;
+  uint32_t* cq_tail_;
+  uint32_t cq_mask_;
+  struct io_uring_cqe* cqes_;
+
+  DISALLOW_COPY_AND_ASSIGN(IOUring);
+};
+
+#else  // defined(DART_EVENTHANDLER_HAS_IO_URING)
+
+class IOUring {
+ public:
+  static IOUring* Create(uint32_t entries) { return nullptr; }
+
+  void PollAdd(intptr_t fd,
+               uint32_t poll_mask,
+               bool multishot,
+               uint64_t user_data) {
+    UNREACHABLE();
+  }
+  void PollRemove(uint64_t target, uint64_t user_data) { UNREACHABLE(); }
+  void SubmitAndWait() { UNREACHABLE(); }
+  intptr_t Reap(IOUringCompletion* completions, intptr_t max) {
+    UNREACHABLE();
+    return 0;
+  }
+};
+
+#endif  // defined(DART_EVENTHANDLER_HAS_IO_URING)
+
+// io_uring user data layout: the upper 32 bits hold the poll token of the
+// DescriptorInfo the request was armed for, the lower 32 bits hold its fd.
+// Token 0 is reserved for the event handler's own requests.
+static constexpr uint64_t kInterruptUserData = 0;
+static constexpr uint64_t kTimerUserData = 1;
+static constexpr uint64_t kIgnoredUserData = 2;
+static constexpr uint32_t kIOUringEntries = 256;
+
+static uint64_t PollUserData(DescriptorInfo* di) {
+  ASSERT(di->poll_token() != 0);
+  return (static_cast<uint64_t>(di->poll_token()) << 32) |
+         static_cast<uint32_t>(di->fd());
+}
+
+bool EventHandlerImplementation::io_uring_unavailable_for_testing_ = false;
+
 EventHandlerImplementation::EventHandlerImplementation()
-    : socket_map_(&SimpleHashMap::SamePointerValue, 16) {
+    : socket_map_(&SimpleHashMap::SamePointerValue, 16),
+      epoll_fd_(-1),
+      io_uring_(nullptr),
+      next_poll_token_(1) {
   intptr_t result;
   result = NO_RETRY_EXPECTED(pipe2(interrupt_fds_, O_CLOEXEC));
   if (result != 0) {
@@ -81,6 +352,24 @@ EventHandlerImplementation::EventHandlerImplementation()
     FATAL("Failed to set pipe fd non blocking\n");
   }
   shutdown_ = false;
+  timer_fd_ = NO_RETRY_EXPECTED(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC));
+  if (timer_fd_ == -1) {
+    FATAL("Failed creating timerfd file descriptor: %i", errno);
+  }
+  if (EventHandler::use_io_uring() && !io_uring_unavailable_for_testing_) {
+    io_uring_ = IOUring::Create(kIOUringEntries);
+  }
+  if (io_uring_ != nullptr) {
+    // The interrupt and timer polls are submitted together with the first
+    // wait for events. They are one-shot, and thereby level triggered like
+    // their epoll registrations, because the interrupt pipe is not always
+    // drained by a single read.
+    io_uring_->PollAdd(interrupt_fds_[0], EPOLLIN, /*multishot=*/false,
+                       kInterruptUserData);
+    io_uring_->PollAdd(timer_fd_, EPOLLIN, /*multishot=*/false,
+                       kTimerUserData);
+    return;
+  }
   // The initial size passed to epoll_create is ignore on newer (>=
   // 2.6.8) Linux versions
   epoll_fd_ = NO_RETRY_EXPECTED(epoll_create1(O_CLOEXEC));
@@ -96,10 +385,6 @@ EventHandlerImplementation::EventHandlerImplementation()
   if (status == -1) {
     FATAL("Failed adding interrupt fd to epoll instance");
   }
-  timer_fd_ = NO_RETRY_EXPECTED(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC));
-  if (timer_fd_ == -1) {
-    FATAL("Failed creating timerfd file descriptor: %i", errno);
-  }
   // Register the timer_fd_ with the epoll instance.
   event.events = EPOLLIN;
   event.data.fd = timer_fd_;
@@ -119,14 +404,21 @@ static void DeleteDescriptorInfo(void* info) {
 
 EventHandlerImplementation::~EventHandlerImplementation() {
   socket_map_.Clear(DeleteDescriptorInfo);
-  close(epoll_fd_);
+  delete io_uring_;
+  if (epoll_fd_ != -1) {
+    close(epoll_fd_);
+  }
   close(timer_fd_);
   close(interrupt_fds_[0]);
   close(interrupt_fds_[1]);
 }
 
-void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
-                                                     DescriptorInfo* di) {
+void EventHandlerImplementation::UpdatePollInstance(intptr_t old_mask,
+                                                    DescriptorInfo* di) {
+  if (io_uring_ != nullptr) {
+    UpdateIOUringPolls(old_mask, di);
+    return;
+  }
   intptr_t new_mask = di->Mask();
   if ((old_mask != 0) && (new_mask == 0)) {
     RemoveFromEpollInstance(epoll_fd_, di);
@@ -139,6 +431,51 @@ void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
   }
 }
 
+void EventHandlerImplementation::UpdateIOUringPolls(intptr_t old_mask,
+                                                    DescriptorInfo* di) {
+  intptr_t new_mask = di->Mask();
+  if ((di->poll_token() != 0) && (new_mask != old_mask)) {
+    ASSERT((new_mask == 0) || !di->IsListeningSocket());
+    RemoveFromIOUring(di);
+  }
+  // A poll might also be missing without a mask change when a one-shot poll
+  // (listening sockets) or a terminated multishot poll has completed.
+  if ((new_mask != 0) && (di->poll_token() == 0)) {
+    AddToIOUring(di);
+  }
+}
+
+void EventHandlerImplementation::AddToIOUring(DescriptorInfo* di) {
+  if (!di->poll_checked()) {
+    // Unlike epoll_ctl, polling a regular file or directory succeeds right
+    // away with every event set. Report those as closed, the way epoll
+    // refusing them is handled in AddToEpollInstance.
+    struct stat st;
+    if ((NO_RETRY_EXPECTED(fstat(di->fd(), &st)) == -1) ||
+        S_ISREG(st.st_mode) || S_ISDIR(st.st_mode)) {
+      di->NotifyAllDartPorts(1 << kCloseEvent);
+      return;
+    }
+    di->set_poll_checked();
+  }
+  uint32_t token = next_poll_token_++;
+  if (token == 0) {
+    token = next_poll_token_++;
+  }
+  di->set_poll_token(token);
+  // Listening sockets are level triggered with epoll: emulate that with one
+  // shot polls that are re-armed after every notification.
+  // The EPOLL* event bits have the same values as their poll(2) counterparts.
+  io_uring_->PollAdd(di->fd(), EPOLLRDHUP | di->GetPollEvents(),
+                     /*multishot=*/!di->IsListeningSocket(), PollUserData(di));
+}
+
+void EventHandlerImplementation::RemoveFromIOUring(DescriptorInfo* di) {
+  ASSERT(di->poll_token() != 0);
+  io_uring_->PollRemove(PollUserData(di), kIgnoredUserData);
+  di->set_poll_token(0);
+}
+
 DescriptorInfo* EventHandlerImplementation::GetDescriptorInfo(
     intptr_t fd,
     bool is_listening) {
@@ -225,7 +562,7 @@ void EventHandlerImplementation::HandleInterruptFd() {
           di->RemovePort(port);
         }
         intptr_t new_mask = di->Mask();
-        UpdateEpollInstance(old_mask, di);
+        UpdatePollInstance(old_mask, di);
 
         intptr_t fd = di->fd();
         ASSERT(fd == socket->fd());
@@ -258,7 +595,7 @@ void EventHandlerImplementation::HandleInterruptFd() {
         int count = TOKEN_COUNT(msg[i].data);
         intptr_t old_mask = di->Mask();
         di->ReturnTokens(msg[i].dart_port, count);
-        UpdateEpollInstance(old_mask, di);
+        UpdatePollInstance(old_mask, di);
       } else if (IS_COMMAND(msg[i].data, kSetEventMaskCommand)) {
         // `events` can only have kInEvent/kOutEvent flags set.
         intptr_t events = msg[i].data & EVENT_MASK;
@@ -266,7 +603,7 @@ void EventHandlerImplementation::HandleInterruptFd() {
 
         intptr_t old_mask = di->Mask();
         di->SetPortAndMask(msg[i].dart_port, msg[i].data & EVENT_MASK);
-        UpdateEpollInstance(old_mask, di);
+        UpdatePollInstance(old_mask, di);
       } else {
         UNREACHABLE();
       }
@@ -340,6 +677,35 @@ intptr_t EventHandlerImplementation::GetPollEvents(intptr_t events,
   return event_mask;
 }
 
+void EventHandlerImplementation::HandleTimerFd() {
+  int64_t val;
+  VOID_TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
+      read(timer_fd_, &val, sizeof(val)));
+  if (timeout_queue_.HasTimeout()) {
+    DartUtils::PostNull(timeout_queue_.CurrentPort());
+    timeout_queue_.RemoveCurrent();
+  }
+  UpdateTimerFd();
+}
+
+void EventHandlerImplementation::HandleDescriptorEvents(DescriptorInfo* di,
+                                                        intptr_t events) {
+  const intptr_t old_mask = di->Mask();
+  const intptr_t event_mask = GetPollEvents(events, di);
+  if ((event_mask & (1 << kErrorEvent)) != 0) {
+    di->NotifyAllDartPorts(event_mask);
+    UpdatePollInstance(old_mask, di);
+  } else if (event_mask != 0) {
+    Dart_Port port = di->NextNotifyDartPort(event_mask);
+    ASSERT(port != 0);
+    UpdatePollInstance(old_mask, di);
+    DartUtils::PostInt32(port, event_mask);
+  } else {
+    // A one-shot poll may have been consumed without producing an event.
+    UpdatePollInstance(old_mask, di);
+  }
+}
+
 void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
                                               int size) {
   bool interrupt_seen = false;
@@ -347,28 +713,63 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
     if (events[i].data.ptr == nullptr) {
       interrupt_seen = true;
     } else if (events[i].data.fd == timer_fd_) {
-      int64_t val;
-      VOID_TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
-          read(timer_fd_, &val, sizeof(val)));
-      if (timeout_queue_.HasTimeout()) {
-        DartUtils::PostNull(timeout_queue_.CurrentPort());
-        timeout_queue_.RemoveCurrent();
-      }
-      UpdateTimerFd();
+      HandleTimerFd();
     } else {
       DescriptorInfo* di =
           reinterpret_cast<DescriptorInfo*>(events[i].data.ptr);
-      const intptr_t old_mask = di->Mask();
-      const intptr_t event_mask = GetPollEvents(events[i].events, di);
-      if ((event_mask & (1 << kErrorEvent)) != 0) {
-        di->NotifyAllDartPorts(event_mask);
-        UpdateEpollInstance(old_mask, di);
-      } else if (event_mask != 0) {
-        Dart_Port port = di->NextNotifyDartPort(event_mask);
-        ASSERT(port != 0);
-        UpdateEpollInstance(old_mask, di);
-        DartUtils::PostInt32(port, event_mask);
+      HandleDescriptorEvents(di, events[i].events);
+    }
+  }
+  if (interrupt_seen) {
+    // Handle after socket events, so we avoid closing a socket before we handle
+    // the current events.
+    HandleInterruptFd();
+  }
+}
+
+void EventHandlerImplementation::HandleCompletions(
+    IOUringCompletion* completions,
+    intptr_t size) {
+  bool interrupt_seen = false;
+  for (intptr_t i = 0; i < size; i++) {
+    const IOUringCompletion& completion = completions[i];
+    if (completion.user_data == kIgnoredUserData) {
+      continue;
+    } else if (completion.user_data == kInterruptUserData) {
+      interrupt_seen = true;
+      io_uring_->PollAdd(interrupt_fds_[0], EPOLLIN, /*multishot=*/false,
+                         kInterruptUserData);
+    } else if (completion.user_data == kTimerUserData) {
+      if (completion.res > 0) {
+        HandleTimerFd();
+      }
+      io_uring_->PollAdd(timer_fd_, EPOLLIN, /*multishot=*/false,
+                         kTimerUserData);
+    } else {
+      const uint32_t token = static_cast<uint32_t>(completion.user_data >> 32);
+      const intptr_t fd = static_cast<uint32_t>(completion.user_data);
+      SimpleHashMap::Entry* entry = socket_map_.Lookup(
+          GetHashmapKeyFromFd(fd), GetHashmapHashFromFd(fd), false);
+      if (entry == nullptr) {
+        continue;
       }
+      DescriptorInfo* di = reinterpret_cast<DescriptorInfo*>(entry->value);
+      if ((di == nullptr) || (di->poll_token() != token)) {
+        // The poll was removed (or the fd reused) after this completion was
+        // produced.
+        continue;
+      }
+      if ((completion.flags & IORING_CQE_F_MORE) == 0) {
+        // The poll is no longer armed and is re-added if still needed.
+        di->set_poll_token(0);
+      }
+      if (completion.res < 0) {
+        // The kernel refused or dropped the poll, treat it like epoll
+        // refusing the descriptor.
+        di->NotifyAllDartPorts(1 << kCloseEvent);
+        continue;
+      }
+      HandleDescriptorEvents(di, completion.res);
     }
   }
   if (interrupt_seen) {
@@ -378,6 +779,25 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
   }
 }
 
+void EventHandlerImplementation::PollIOUring(
+    EventHandlerImplementation* handler_impl) {
+  const intptr_t kMaxCompletions = 64;
+  IOUringCompletion completions[kMaxCompletions];
+  IOUring* io_uring = handler_impl->io_uring_;
+  while (!handler_impl->shutdown_) {
+    // All poll changes queued while handling the previous batch are
+    // submitted with the same system call that waits for new events.
+    io_uring->SubmitAndWait();
+    intptr_t count;
+    while ((count = io_uring->Reap(completions, kMaxCompletions)) > 0) {
+      handler_impl->HandleCompletions(completions, count);
+      if (handler_impl->shutdown_) {
+        break;
+      }
+    }
+  }
+}
+
 void EventHandlerImplementation::Poll(uword args) {
   ThreadSignalBlocker signal_blocker(SIGPROF);
   const intptr_t kMaxEvents = 16;
@@ -386,6 +806,13 @@ void EventHandlerImplementation::Poll(uword args) {
   EventHandlerImplementation* handler_impl = &handler->delegate_;
   ASSERT(handler_impl != nullptr);
 
+  if (handler_impl->io_uring_ != nullptr) {
+    PollIOUring(handler_impl);
+    DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
+    handler->NotifyShutdownDone();
+    return;
+  }
+
   while (!handler_impl->shutdown_) {
     intptr_t result = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
         epoll_wait(handler_impl->epoll_fd_, events, kMaxEvents, -1));
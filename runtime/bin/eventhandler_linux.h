@@ -28,12 +28,26 @@ class DescriptorInfo : public DescriptorInfoBase {
 
   intptr_t GetPollEvents();
 
+  // When the event handler is backed by io_uring, identifies the poll request
+  // currently armed for this descriptor (0 if none). Completions carrying a
+  // different token are stale and are dropped.
+  uint32_t poll_token() const { return poll_token_; }
+  void set_poll_token(uint32_t token) { poll_token_ = token; }
+
+  // Whether the descriptor has been checked to refer to something that
+  // supports polling (e.g. not a regular file).
+  bool poll_checked() const { return poll_checked_; }
+  void set_poll_checked() { poll_checked_ = true; }
+
   virtual void Close() {
     close(fd_);
     fd_ = -1;
   }
 
  private:
+  uint32_t poll_token_ = 0;
+  bool poll_checked_ = false;
+
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfo);
 };
 
@@ -57,12 +71,17 @@ class DescriptorInfoMultiple
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfoMultiple);
 };
 
+class IOUring;
+struct IOUringCompletion;
+
 class EventHandlerImplementation {
  public:
   EventHandlerImplementation();
   ~EventHandlerImplementation();
 
-  void UpdateEpollInstance(intptr_t old_mask, DescriptorInfo* di);
+  // Brings the registration of `di` with the epoll instance (or the io_uring
+  // poll requests) in sync with its current mask.
+  void UpdatePollInstance(intptr_t old_mask, DescriptorInfo* di);
 
   // Gets the socket data structure for a given file
   // descriptor. Creates a new one if one is not found.
@@ -71,9 +90,28 @@ class EventHandlerImplementation {
   void Start(EventHandler* handler);
   void Shutdown();
 
+  // Whether events are delivered through io_uring rather than epoll.
+  bool uses_io_uring() const { return io_uring_ != nullptr; }
+
+  // Makes io_uring setup fail like it does on kernels without io_uring
+  // support, so tests can exercise the fallback to epoll.
+  static void set_io_uring_unavailable_for_testing(bool value) {
+    io_uring_unavailable_for_testing_ = value;
+  }
+
  private:
   void HandleEvents(struct epoll_event* events, int size);
+  void HandleDescriptorEvents(DescriptorInfo* di, intptr_t events);
+  void HandleTimerFd();
   static void Poll(uword args);
+
+  // io_uring backend. Only used when `io_uring_` is not null.
+  void UpdateIOUringPolls(intptr_t old_mask, DescriptorInfo* di);
+  void AddToIOUring(DescriptorInfo* di);
+  void RemoveFromIOUring(DescriptorInfo* di);
+  void HandleCompletions(IOUringCompletion* completions, intptr_t size);
+  static void PollIOUring(EventHandlerImplementation* handler_impl);
+
   void WakeupHandler(intptr_t id, Dart_Port dart_port, int64_t data);
   void HandleInterruptFd();
   void UpdateTimerFd();
@@ -88,6 +126,10 @@ class EventHandlerImplementation {
   int interrupt_fds_[2];
   int epoll_fd_;
   int timer_fd_;
+  IOUring* io_uring_;
+  uint32_t next_poll_token_;
+
+  static bool io_uring_unavailable_for_testing_;
 
   DISALLOW_COPY_AND_ASSIGN(EventHandlerImplementation);
 };
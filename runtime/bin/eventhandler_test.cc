@@ -3,6 +3,17 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "bin/eventhandler.h"
+
+#if defined(DART_HOST_OS_LINUX)
+#include <sys/socket.h>  // NOLINT
+#include <unistd.h>      // NOLINT
+#endif
+
+#include "bin/lockers.h"
+#include "bin/socket.h"
+#include "bin/thread.h"
+#include "bin/utils.h"
+#include "include/dart_native_api.h"
 #include "platform/assert.h"
 #include "vm/unit_test.h"
 
@@ -79,5 +90,143 @@ VM_UNIT_TEST_CASE(CircularLinkedList) {
   list.Remove(4242);
 }
 
+#if defined(DART_HOST_OS_LINUX)
+
+// Collects the messages the event handler posts to a native port.
+static Monitor* event_monitor = nullptr;
+static intptr_t event_timers = 0;
+static intptr_t event_mask = 0;
+
+static void HandleEventMessage(Dart_Port dest_port, Dart_CObject* message) {
+  MonitorLocker ml(event_monitor);
+  if (message->type == Dart_CObject_kNull) {
+    event_timers++;
+  } else {
+    ASSERT(message->type == Dart_CObject_kInt32);
+    event_mask |= message->value.as_int32;
+  }
+  ml.Notify();
+}
+
+static void ExpectTimer() {
+  MonitorLocker ml(event_monitor);
+  const int64_t deadline = TimerUtils::GetCurrentMonotonicMillis() + 10000;
+  while (event_timers == 0) {
+    ml.Wait(100);
+    if (TimerUtils::GetCurrentMonotonicMillis() > deadline) {
+      FATAL("Timed out waiting for a timer");
+    }
+  }
+  event_timers--;
+}
+
+static void ExpectEvent(intptr_t event) {
+  MonitorLocker ml(event_monitor);
+  const int64_t deadline = TimerUtils::GetCurrentMonotonicMillis() + 10000;
+  while ((event_mask & (1 << event)) == 0) {
+    ml.Wait(100);
+    if (TimerUtils::GetCurrentMonotonicMillis() > deadline) {
+      FATAL("Timed out waiting for event %" Pd, event);
+    }
+  }
+  event_mask &= ~(1 << event);
+}
+
+static void SendToEventHandler(Socket* socket, Dart_Port port, int64_t data) {
+  // The event handler releases the reference when handling the message.
+  socket->Retain();
+  EventHandler::SendFromNative(reinterpret_cast<intptr_t>(socket), port, data);
+}
+
+// Restarts the process wide event handler with the given backend settings
+// and drives timer and socket traffic through it.
+static void RunEventHandlerTraffic(bool use_io_uring, bool unavailable) {
+  EventHandler::Stop();
+  EventHandler::set_use_io_uring(use_io_uring);
+  EventHandlerImplementation::set_io_uring_unavailable_for_testing(
+      unavailable);
+  EventHandler::Start();
+  if (!use_io_uring || unavailable) {
+    EXPECT(!EventHandler::delegate()->uses_io_uring());
+  }
+
+  event_monitor = new Monitor();
+  event_timers = 0;
+  event_mask = 0;
+  Dart_Port port =
+      Dart_NewNativePort("EventHandlerTest", &HandleEventMessage, false);
+  EXPECT_NE(ILLEGAL_PORT, port);
+
+  // Timers fire in order, and a timer can be re-armed from the port that
+  // received the previous one.
+  for (intptr_t i = 0; i < 3; i++) {
+    EventHandler::SendFromNative(
+        kTimerId, port, TimerUtils::GetCurrentMonotonicMillis() + 5 * i);
+    ExpectTimer();
+  }
+
+  int fds[2];
+  EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                          0, fds));
+  Socket* socket = new Socket(fds[0]);
+  SendToEventHandler(
+      socket, port,
+      (1 << kSetEventMaskCommand) | (1 << kInEvent) | (1 << kOutEvent));
+  ExpectEvent(kOutEvent);
+
+  // Readiness is edge triggered: every new write by the peer is reported,
+  // whether or not the previous data has been read.
+  char buffer[16];
+  for (intptr_t i = 0; i < 3; i++) {
+    EXPECT_EQ(1, write(fds[1], "x", 1));
+    ExpectEvent(kInEvent);
+  }
+  EXPECT_EQ(3, read(fds[0], buffer, sizeof(buffer)));
+
+  // A timer interleaved with socket traffic.
+  EventHandler::SendFromNative(kTimerId, port,
+                               TimerUtils::GetCurrentMonotonicMillis());
+  EXPECT_EQ(2, write(fds[1], "yz", 2));
+  ExpectTimer();
+  ExpectEvent(kInEvent);
+  EXPECT_EQ(2, read(fds[0], buffer, sizeof(buffer)));
+
+  close(fds[1]);
+  ExpectEvent(kCloseEvent);
+
+  SendToEventHandler(socket, port, 1 << kCloseCommand);
+  ExpectEvent(kDestroyedEvent);
+  socket->Release();
+
+  Dart_CloseNativePort(port);
+  delete event_monitor;
+  event_monitor = nullptr;
+
+  EventHandler::Stop();
+  EventHandler::set_use_io_uring(false);
+  EventHandlerImplementation::set_io_uring_unavailable_for_testing(false);
+  EventHandler::Start();
+}
+
+#endif  // defined(DART_HOST_OS_LINUX)
+
 }  // namespace bin
+
+#if defined(DART_HOST_OS_LINUX)
+
+TEST_CASE(EventHandler_Epoll) {
+  bin::RunEventHandlerTraffic(/*use_io_uring=*/false, /*unavailable=*/false);
+}
+
+TEST_CASE(EventHandler_IOUring) {
+  // Falls back to epoll on kernels without io_uring support.
+  bin::RunEventHandlerTraffic(/*use_io_uring=*/true, /*unavailable=*/false);
+}
+
+TEST_CASE(EventHandler_IOUringFallback) {
+  bin::RunEventHandlerTraffic(/*use_io_uring=*/true, /*unavailable=*/true);
+}
+
+#endif  // defined(DART_HOST_OS_LINUX)
+
 }  // namespace dart
@@ -4,7 +4,9 @@
 
 #include "bin/io_buffer.h"
 
+#include "bin/lockers.h"
 #include "platform/memory_sanitizer.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
@@ -46,5 +48,133 @@ uint8_t* IOBuffer::Reallocate(uint8_t* buffer, intptr_t new_size) {
   return static_cast<uint8_t*>(realloc(buffer, new_size));
 }
 
+Mutex* IOBufferPool::mutex_ = nullptr;
+bool IOBufferPool::enabled_ = false;
+IOBufferPool::Header* IOBufferPool::free_lists_[kNumSizeClasses] = {};
+intptr_t IOBufferPool::free_counts_[kNumSizeClasses] = {};
+
+void IOBufferPool::Init() {
+  if (mutex_ == nullptr) {
+    mutex_ = new Mutex();
+  }
+  MutexLocker ml(mutex_);
+  ASSERT(!enabled_);
+  enabled_ = true;
+}
+
+void IOBufferPool::Cleanup() {
+  if (mutex_ == nullptr) {
+    return;
+  }
+  // The mutex is intentionally leaked. Lists finalized after this point
+  // still lock it in Release() and free their buffers.
+  MutexLocker ml(mutex_);
+  enabled_ = false;
+  for (intptr_t i = 0; i < kNumSizeClasses; i++) {
+    while (free_lists_[i] != nullptr) {
+      Header* header = free_lists_[i];
+      free_lists_[i] = header->next;
+      free(header);
+    }
+    free_counts_[i] = 0;
+  }
+}
+
+intptr_t IOBufferPool::SizeClass(intptr_t size) {
+  ASSERT((size > 0) && (size <= kMaxBufferSize));
+  const intptr_t size_class =
+      Utils::Maximum<intptr_t>(Utils::ShiftForPowerOfTwo(
+                                   Utils::RoundUpToPowerOfTwo(size)),
+                               kMinBufferSizeLog2) -
+      kMinBufferSizeLog2;
+  ASSERT(size <= BufferSize(size_class));
+  return size_class;
+}
+
+uint8_t* IOBufferPool::Acquire(intptr_t size) {
+  if ((mutex_ == nullptr) || (size <= 0) || (size > kMaxBufferSize)) {
+    return nullptr;
+  }
+  const intptr_t size_class = SizeClass(size);
+  Header* header = nullptr;
+  {
+    MutexLocker ml(mutex_);
+    if (!enabled_) {
+      return nullptr;
+    }
+    header = free_lists_[size_class];
+    if (header != nullptr) {
+      free_lists_[size_class] = header->next;
+      free_counts_[size_class]--;
+    }
+  }
+  if (header == nullptr) {
+    header = static_cast<Header*>(
+        malloc(sizeof(Header) + BufferSize(size_class)));
+    if (header == nullptr) {
+      return nullptr;
+    }
+    header->size_class = size_class;
+  }
+  header->next = nullptr;
+  return reinterpret_cast<uint8_t*>(header + 1);
+}
+
+void IOBufferPool::Release(uint8_t* buffer) {
+  Header* header = HeaderOf(buffer);
+  const intptr_t size_class = header->size_class;
+  ASSERT((size_class >= 0) && (size_class < kNumSizeClasses));
+  if (mutex_ != nullptr) {
+    MutexLocker ml(mutex_);
+    if (enabled_ && (free_counts_[size_class] < kMaxCachedBuffers)) {
+      header->next = free_lists_[size_class];
+      free_lists_[size_class] = header;
+      free_counts_[size_class]++;
+      return;
+    }
+  }
+  free(header);
+}
+
+Dart_Handle IOBufferPool::NewExternalUint8List(uint8_t* buffer,
+                                               intptr_t length) {
+  const intptr_t capacity = BufferSize(HeaderOf(buffer)->size_class);
+  ASSERT(length <= capacity);
+  Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kUint8, buffer, length, buffer, capacity,
+      IOBufferPool::Finalizer);
+  if (Dart_IsError(result)) {
+    Release(buffer);
+    Dart_PropagateError(result);
+  }
+  return result;
+}
+
+Dart_Handle IOBufferPool::NewUint8List(uint8_t* buffer, intptr_t length) {
+  const intptr_t capacity = BufferSize(HeaderOf(buffer)->size_class);
+  ASSERT(length <= capacity);
+  if (length >= capacity / 2) {
+    return NewExternalUint8List(buffer, length);
+  }
+  Dart_Handle list = Dart_NewTypedData(Dart_TypedData_kUint8, length);
+  Dart_Handle result =
+      Dart_IsError(list) ? list : Dart_ListSetAsBytes(list, 0, buffer, length);
+  Release(buffer);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  return list;
+}
+
+intptr_t IOBufferPool::CachedBuffersForTesting(intptr_t size) {
+  ASSERT(mutex_ != nullptr);
+  MutexLocker ml(mutex_);
+  return free_counts_[SizeClass(size)];
+}
+
+void IOBufferPool::Finalizer(void* isolate_callback_data, void* buffer) {
+  Release(static_cast<uint8_t*>(buffer));
+}
+
 }  // namespace bin
 }  // namespace dart
@@ -7,6 +7,7 @@
 
 #include "include/dart_api.h"
 #include "platform/globals.h"
+#include "platform/synchronization.h"
 
 namespace dart {
 namespace bin {
@@ -37,6 +38,74 @@ class IOBuffer {
   DISALLOW_IMPLICIT_CONSTRUCTORS(IOBuffer);
 };
 
+// A process wide pool of recycled buffers for socket reads. The bytes are
+// read straight into a pooled buffer which is then handed out as an external
+// Uint8List of exactly the number of bytes read, so reads that fill most of
+// the buffer do not have to be copied. The buffer goes back to the pool when
+// the Uint8List is finalized. Reads that fill less than half of the buffer
+// are copied instead, so that they do not pin the whole buffer.
+class IOBufferPool {
+ public:
+  static void Init();
+  static void Cleanup();
+
+  // Largest buffer handed out by the pool.
+  static constexpr intptr_t kMaxBufferSize = 64 * KB;
+
+  // Upper bound on the number of idle buffers kept per size class.
+  static constexpr intptr_t kMaxCachedBuffers = 32;
+
+  // Returns a buffer of at least `size` bytes, or nullptr if the pool is not
+  // initialized or `size` is not in (0, kMaxBufferSize].
+  static uint8_t* Acquire(intptr_t size);
+
+  // Returns a buffer obtained from Acquire() to the pool.
+  static void Release(uint8_t* buffer);
+
+  // Wraps the first `length` bytes of a buffer obtained from Acquire() in an
+  // external Uint8List which releases the buffer when finalized.
+  static Dart_Handle NewExternalUint8List(uint8_t* buffer, intptr_t length);
+
+  // Returns the first `length` bytes of a buffer obtained from Acquire() as a
+  // Uint8List. Uses NewExternalUint8List() if they fill at least half of the
+  // buffer, and otherwise copies them and releases the buffer right away.
+  static Dart_Handle NewUint8List(uint8_t* buffer, intptr_t length);
+
+  // Number of idle buffers kept for requests of `size` bytes.
+  static intptr_t CachedBuffersForTesting(intptr_t size);
+
+ private:
+  static constexpr intptr_t kMinBufferSizeLog2 = 12;
+  static constexpr intptr_t kMaxBufferSizeLog2 = 16;
+  static constexpr intptr_t kNumSizeClasses =
+      kMaxBufferSizeLog2 - kMinBufferSizeLog2 + 1;
+
+  // Precedes the bytes of every pooled buffer.
+  struct Header {
+    Header* next;
+    intptr_t size_class;
+  };
+
+  static intptr_t SizeClass(intptr_t size);
+  static Header* HeaderOf(uint8_t* buffer) {
+    return reinterpret_cast<Header*>(buffer) - 1;
+  }
+  static intptr_t BufferSize(intptr_t size_class) {
+    return static_cast<intptr_t>(1) << (size_class + kMinBufferSizeLog2);
+  }
+  static void Finalizer(void* isolate_callback_data, void* buffer);
+
+  // Never deleted: finalizers may still release buffers after Cleanup().
+  static Mutex* mutex_;
+  // Whether buffers are handed out and cached, guarded by mutex_.
+  static bool enabled_;
+  static Header* free_lists_[kNumSizeClasses];
+  static intptr_t free_counts_[kNumSizeClasses];
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(IOBufferPool);
+};
+
 }  // namespace bin
 }  // namespace dart
 
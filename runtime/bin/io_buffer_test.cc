@@ -0,0 +1,176 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/io_buffer.h"
+
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_MACOS)
+#include <sys/socket.h>  // NOLINT
+#include <unistd.h>      // NOLINT
+#endif
+
+#include "bin/socket_base.h"
+#include "platform/assert.h"
+#include "platform/globals.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+using bin::IOBufferPool;
+
+VM_UNIT_TEST_CASE(IOBufferPool_Reuse) {
+  IOBufferPool::Init();
+  uint8_t* buffer = IOBufferPool::Acquire(100);
+  EXPECT(buffer != nullptr);
+  // The whole buffer of the smallest size class is usable.
+  memset(buffer, 0xff, 4 * KB);
+  IOBufferPool::Release(buffer);
+  EXPECT_EQ(1, IOBufferPool::CachedBuffersForTesting(100));
+
+  // Requests that round up to the same size class get the buffer back.
+  EXPECT(IOBufferPool::Acquire(4 * KB) == buffer);
+  EXPECT_EQ(0, IOBufferPool::CachedBuffersForTesting(4 * KB));
+
+  // Other size classes do not.
+  uint8_t* larger = IOBufferPool::Acquire(4 * KB + 1);
+  EXPECT(larger != nullptr);
+  EXPECT(larger != buffer);
+  memset(larger, 0xff, 8 * KB);
+  IOBufferPool::Release(larger);
+  EXPECT_EQ(0, IOBufferPool::CachedBuffersForTesting(4 * KB));
+  EXPECT_EQ(1, IOBufferPool::CachedBuffersForTesting(8 * KB));
+
+  IOBufferPool::Release(buffer);
+  IOBufferPool::Cleanup();
+}
+
+VM_UNIT_TEST_CASE(IOBufferPool_SizeLimits) {
+  // Without Init() the pool hands out nothing, so callers fall back to
+  // regular allocation.
+  EXPECT(IOBufferPool::Acquire(100) == nullptr);
+
+  IOBufferPool::Init();
+  EXPECT(IOBufferPool::Acquire(0) == nullptr);
+  EXPECT(IOBufferPool::Acquire(-1) == nullptr);
+  EXPECT(IOBufferPool::Acquire(IOBufferPool::kMaxBufferSize + 1) == nullptr);
+  uint8_t* largest = IOBufferPool::Acquire(IOBufferPool::kMaxBufferSize);
+  EXPECT(largest != nullptr);
+  memset(largest, 0xff, IOBufferPool::kMaxBufferSize);
+  IOBufferPool::Release(largest);
+
+  // Only a bounded number of idle buffers is kept per size class.
+  const intptr_t kCount = IOBufferPool::kMaxCachedBuffers + 8;
+  uint8_t* buffers[kCount];
+  for (intptr_t i = 0; i < kCount; i++) {
+    buffers[i] = IOBufferPool::Acquire(16 * KB);
+    EXPECT(buffers[i] != nullptr);
+  }
+  EXPECT_EQ(0, IOBufferPool::CachedBuffersForTesting(16 * KB));
+  for (intptr_t i = 0; i < kCount; i++) {
+    IOBufferPool::Release(buffers[i]);
+  }
+  EXPECT_EQ(IOBufferPool::kMaxCachedBuffers,
+            IOBufferPool::CachedBuffersForTesting(16 * KB));
+  IOBufferPool::Cleanup();
+
+  // Buffers released after Cleanup() are freed rather than cached.
+  IOBufferPool::Init();
+  uint8_t* buffer = IOBufferPool::Acquire(100);
+  IOBufferPool::Cleanup();
+  IOBufferPool::Release(buffer);
+}
+
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_MACOS)
+
+TEST_CASE(IOBufferPool_LongRead) {
+  IOBufferPool::Init();
+  int fds[2];
+  EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  const intptr_t kDataLength = 3 * KB;
+  uint8_t data_written[kDataLength];
+  for (intptr_t i = 0; i < kDataLength; i++) {
+    data_written[i] = static_cast<uint8_t>(i);
+  }
+  EXPECT_EQ(static_cast<ssize_t>(kDataLength),
+            write(fds[1], data_written, kDataLength));
+
+  uint8_t* buffer = IOBufferPool::Acquire(4 * KB);
+  EXPECT(buffer != nullptr);
+  const intptr_t bytes_read =
+      bin::SocketBase::Read(fds[0], buffer, 4 * KB, bin::SocketBase::kAsync);
+  EXPECT_EQ(kDataLength, bytes_read);
+
+  {
+    Dart_EnterScope();
+    Dart_Handle list = IOBufferPool::NewUint8List(buffer, bytes_read);
+    EXPECT_VALID(list);
+    // The read fills most of the buffer, so the list has exactly the bytes
+    // read and is backed by the buffer they were read into.
+    Dart_TypedData_Type type;
+    void* data;
+    intptr_t length;
+    EXPECT_VALID(Dart_TypedDataAcquireData(list, &type, &data, &length));
+    EXPECT_EQ(Dart_TypedData_kUint8, type);
+    EXPECT_EQ(bytes_read, length);
+    EXPECT(data == buffer);
+    EXPECT_EQ(0, memcmp(data_written, data, kDataLength));
+    EXPECT_VALID(Dart_TypedDataReleaseData(list));
+    Dart_ExitScope();
+  }
+  EXPECT_EQ(0, IOBufferPool::CachedBuffersForTesting(4 * KB));
+
+  // Finalizing the list returns the buffer to the pool.
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectAllGarbage();
+  }
+  EXPECT_EQ(1, IOBufferPool::CachedBuffersForTesting(4 * KB));
+  EXPECT(IOBufferPool::Acquire(100) == buffer);
+  IOBufferPool::Release(buffer);
+
+  close(fds[0]);
+  close(fds[1]);
+  IOBufferPool::Cleanup();
+}
+
+TEST_CASE(IOBufferPool_ShortRead) {
+  IOBufferPool::Init();
+  int fds[2];
+  EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  const char kData[] = "short read";
+  EXPECT_EQ(static_cast<ssize_t>(sizeof(kData)),
+            write(fds[1], kData, sizeof(kData)));
+
+  uint8_t* buffer = IOBufferPool::Acquire(4 * KB);
+  EXPECT(buffer != nullptr);
+  const intptr_t bytes_read =
+      bin::SocketBase::Read(fds[0], buffer, 4 * KB, bin::SocketBase::kAsync);
+  EXPECT_EQ(static_cast<intptr_t>(sizeof(kData)), bytes_read);
+
+  {
+    Dart_EnterScope();
+    Dart_Handle list = IOBufferPool::NewUint8List(buffer, bytes_read);
+    EXPECT_VALID(list);
+    // The bytes are copied into a list of their own, and the buffer goes
+    // back to the pool without waiting for the list to be finalized.
+    EXPECT_EQ(1, IOBufferPool::CachedBuffersForTesting(4 * KB));
+    Dart_TypedData_Type type;
+    void* data;
+    intptr_t length;
+    EXPECT_VALID(Dart_TypedDataAcquireData(list, &type, &data, &length));
+    EXPECT_EQ(Dart_TypedData_kUint8, type);
+    EXPECT_EQ(bytes_read, length);
+    EXPECT(data != buffer);
+    EXPECT_STREQ(kData, reinterpret_cast<char*>(data));
+    EXPECT_VALID(Dart_TypedDataReleaseData(list));
+    Dart_ExitScope();
+  }
+
+  close(fds[0]);
+  close(fds[1]);
+  IOBufferPool::Cleanup();
+}
+
+#endif  // defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_MACOS)
+
+}  // namespace dart
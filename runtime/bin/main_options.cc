@@ -10,6 +10,7 @@
 
 #include "bin/common_options.h"
 #include "bin/error_exit.h"
+#include "bin/eventhandler.h"
 #include "bin/file_system_watcher.h"
 #if defined(DART_IO_SECURE_SOCKET_DISABLED)
 #include "bin/io_service_no_ssl.h"
@@ -20,6 +21,7 @@
 #include "bin/utils.h"
 #include "platform/syslog.h"
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
+#include "bin/secure_socket_filter.h"
 #include "bin/security_context.h"
 #endif  // !defined(DART_IO_SECURE_SOCKET_DISABLED)
 #include "bin/socket.h"
@@ -174,6 +176,7 @@ bool Options::ParseArguments(int argc,
 
   Socket::set_short_socket_read(Options::short_socket_read());
   Socket::set_short_socket_write(Options::short_socket_write());
+  EventHandler::set_use_io_uring(Options::use_io_uring());
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLCertContext::set_root_certs_file(Options::root_certs_file());
   SSLCertContext::set_root_certs_cache(Options::root_certs_cache());
@@ -181,6 +184,7 @@ bool Options::ParseArguments(int argc,
       Options::long_ssl_cert_evaluation());
   SSLCertContext::set_bypass_trusting_system_roots(
       Options::bypass_trusting_system_roots());
+  SSLFilter::set_use_kernel_tls(Options::use_kernel_tls());
 #endif  // !defined(DART_IO_SECURE_SOCKET_DISABLED)
 
   FileSystemWatcher::set_delayed_filewatch_callback(
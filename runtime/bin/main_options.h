@@ -47,6 +47,8 @@ namespace bin {
   V(trace_loading, trace_loading)                                              \
   V(short_socket_read, short_socket_read)                                      \
   V(short_socket_write, short_socket_write)                                    \
+  V(use_io_uring, use_io_uring)                                                \
+  V(use_kernel_tls, use_kernel_tls)                                            \
   V(disable_exit, exit_disabled)                                               \
   V(suppress_core_dump, suppress_core_dump)                                    \
   V(enable_service_port_fallback, enable_service_port_fallback)                \
@@ -10,11 +10,21 @@
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 
+#if defined(DART_HOST_OS_LINUX)
+#include <linux/tls.h>     // NOLINT
+#include <netinet/tcp.h>   // NOLINT
+#include <openssl/hkdf.h>  // NOLINT
+#include <openssl/mem.h>   // NOLINT
+#include <sys/socket.h>    // NOLINT
+#endif
+
 #include "bin/io_service.h"
 #include "bin/lockers.h"
 #include "bin/secure_socket_utils.h"
 #include "bin/security_context.h"
+#include "bin/socket.h"
 #include "bin/socket_base.h"
+#include "platform/signal_blocker.h"
 #include "platform/syslog.h"
 #include "platform/text_buffer.h"
 
@@ -27,6 +37,7 @@ Mutex* SSLFilter::mutex_ = nullptr;
 int SSLFilter::filter_ssl_index;
 int SSLFilter::ssl_cert_context_index;
 Dart_Port SSLFilter::trust_evaluate_reply_port_ = ILLEGAL_PORT;
+bool SSLFilter::use_kernel_tls_ = false;
 
 void SSLFilter::Init() {
   ASSERT(SSLFilter::mutex_ == nullptr);
@@ -214,6 +225,19 @@ void FUNCTION_NAME(SecureSocket_FilterPointer)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, Dart_NewInteger(filter_pointer));
 }
 
+void FUNCTION_NAME(SecureSocket_EnableKernelTls)(Dart_NativeArguments args) {
+  SSLFilter* filter = GetFilter(args);
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 1));
+  SSLFilter::KernelTlsResult result = filter->EnableKernelTls(socket);
+  if (result == SSLFilter::kKernelTlsFailed) {
+    Dart_ThrowException(DartUtils::NewDartIOException(
+        "TlsException", "Failed to hand the TLS session to the kernel",
+        DartUtils::NewDartOSError()));
+  }
+  Dart_SetIntegerReturnValue(args, result);
+}
+
 /**
  * Pushes data through the SSL filter, reading and writing from circular
  * buffers shared with Dart.
@@ -515,6 +539,7 @@ void SSLFilter::Connect(const char* hostname,
 
   if (context->allow_tls_renegotiation()) {
     SSL_set_renegotiate_mode(ssl_, ssl_renegotiate_freely);
+    allow_renegotiation_ = true;
   }
   context->RegisterCallbacks(ssl_);
   SSL_set_ex_data(ssl_, ssl_cert_context_index, context);
@@ -653,6 +678,206 @@ int SSLFilter::Handshake(Dart_Port reply_port) {
   return error;
 }
 
+#if defined(DART_HOST_OS_LINUX)
+#if !defined(SOL_TLS)
+#define SOL_TLS 282
+#endif
+#if !defined(TCP_ULP)
+#define TCP_ULP 31
+#endif
+
+// The key material of one direction, as setsockopt(SOL_TLS) expects it.
+union KernelTlsCryptoInfo {
+  tls_crypto_info info;
+  tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+  tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+  tls12_crypto_info_chacha20_poly1305 chacha20_poly1305;
+};
+
+static void WriteRecordSequence(uint64_t sequence, uint8_t out[8]) {
+  for (int i = 7; i >= 0; --i) {
+    out[i] = static_cast<uint8_t>(sequence);
+    sequence >>= 8;
+  }
+}
+
+// For TLS 1.3 `iv` is the full 12 byte IV, split by the kernel into a salt
+// and the rest. TLS 1.2 only derives the 4 byte salt; BoringSSL uses the
+// record sequence number as the explicit part of the nonce.
+template <typename CryptoInfo>
+static void FillAesGcmCryptoInfo(CryptoInfo* info,
+                                 bool tls13,
+                                 const uint8_t* key,
+                                 const uint8_t* iv,
+                                 uint64_t sequence) {
+  memmove(info->key, key, sizeof(info->key));
+  memmove(info->salt, iv, sizeof(info->salt));
+  if (tls13) {
+    memmove(info->iv, iv + sizeof(info->salt), sizeof(info->iv));
+  } else {
+    WriteRecordSequence(sequence, info->iv);
+  }
+  WriteRecordSequence(sequence, info->rec_seq);
+}
+
+static socklen_t FillCryptoInfo(bool tls13,
+                                int cipher_nid,
+                                const uint8_t* key,
+                                const uint8_t* iv,
+                                uint64_t sequence,
+                                KernelTlsCryptoInfo* out) {
+  memset(out, 0, sizeof(*out));
+  out->info.version = tls13 ? TLS_1_3_VERSION : TLS_1_2_VERSION;
+  switch (cipher_nid) {
+    case NID_aes_128_gcm:
+      out->info.cipher_type = TLS_CIPHER_AES_GCM_128;
+      FillAesGcmCryptoInfo(&out->aes_gcm_128, tls13, key, iv, sequence);
+      return sizeof(out->aes_gcm_128);
+    case NID_aes_256_gcm:
+      out->info.cipher_type = TLS_CIPHER_AES_GCM_256;
+      FillAesGcmCryptoInfo(&out->aes_gcm_256, tls13, key, iv, sequence);
+      return sizeof(out->aes_gcm_256);
+    default:
+      ASSERT(cipher_nid == NID_chacha20_poly1305);
+      out->info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+      memmove(out->chacha20_poly1305.key, key,
+              sizeof(out->chacha20_poly1305.key));
+      memmove(out->chacha20_poly1305.iv, iv,
+              sizeof(out->chacha20_poly1305.iv));
+      WriteRecordSequence(sequence, out->chacha20_poly1305.rec_seq);
+      return sizeof(out->chacha20_poly1305);
+  }
+}
+
+// HKDF-Expand-Label from RFC 8446, section 7.1, with an empty context.
+static bool ExpandTrafficSecret(const EVP_MD* digest,
+                                bssl::Span<const uint8_t> secret,
+                                const char* label,
+                                uint8_t* out,
+                                size_t out_length) {
+  static const char kLabelPrefix[] = "tls13 ";
+  const size_t prefix_length = strlen(kLabelPrefix);
+  const size_t label_length = strlen(label);
+  uint8_t info[4 + 32];
+  ASSERT(prefix_length + label_length <= 32);
+  size_t length = 0;
+  info[length++] = static_cast<uint8_t>(out_length >> 8);
+  info[length++] = static_cast<uint8_t>(out_length);
+  info[length++] = static_cast<uint8_t>(prefix_length + label_length);
+  memmove(info + length, kLabelPrefix, prefix_length);
+  length += prefix_length;
+  memmove(info + length, label, label_length);
+  length += label_length;
+  info[length++] = 0;
+  return HKDF_expand(out, out_length, digest, secret.data(), secret.size(),
+                     info, length) == 1;
+}
+
+SSLFilter::KernelTlsResult SSLFilter::EnableKernelTls(Socket* socket) {
+  if (!use_kernel_tls_ || allow_renegotiation_ || (ssl_ == nullptr)) {
+    return kKernelTlsUnavailable;
+  }
+  if (in_handshake_ || SSL_in_init(ssl_) || SSL_has_pending(ssl_) ||
+      (BIO_ctrl_pending(socket_side_) != 0) ||
+      (BIO_ctrl_wpending(socket_side_) != 0)) {
+    // Records are still on their way through BoringSSL.
+    return kKernelTlsRetry;
+  }
+  const bool tls13 = SSL_version(ssl_) == TLS1_3_VERSION;
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl_);
+  if ((!tls13 && (SSL_version(ssl_) != TLS1_2_VERSION)) ||
+      (cipher == nullptr)) {
+    return kKernelTlsUnavailable;
+  }
+  const int cipher_nid = SSL_CIPHER_get_cipher_nid(cipher);
+  if ((cipher_nid != NID_aes_128_gcm) && (cipher_nid != NID_aes_256_gcm) &&
+      (cipher_nid != NID_chacha20_poly1305)) {
+    return kKernelTlsUnavailable;
+  }
+  const size_t key_length = (cipher_nid == NID_aes_128_gcm) ? 16 : 32;
+  const size_t iv_length =
+      (tls13 || (cipher_nid == NID_chacha20_poly1305)) ? 12 : 4;
+
+  // Keys and IVs for reading followed by those for writing.
+  uint8_t keys[2 * (32 + 12)];
+  uint8_t* read_key = keys;
+  uint8_t* read_iv = read_key + key_length;
+  uint8_t* write_key = read_iv + iv_length;
+  uint8_t* write_iv = write_key + key_length;
+  bool derived;
+  if (tls13) {
+    bssl::Span<const uint8_t> read_secret;
+    bssl::Span<const uint8_t> write_secret;
+    const EVP_MD* digest = SSL_CIPHER_get_handshake_digest(cipher);
+    derived =
+        bssl::SSL_get_traffic_secrets(ssl_, &read_secret, &write_secret) &&
+        ExpandTrafficSecret(digest, read_secret, "key", read_key,
+                            key_length) &&
+        ExpandTrafficSecret(digest, read_secret, "iv", read_iv, iv_length) &&
+        ExpandTrafficSecret(digest, write_secret, "key", write_key,
+                            key_length) &&
+        ExpandTrafficSecret(digest, write_secret, "iv", write_iv, iv_length);
+  } else {
+    // The TLS 1.2 key block of an AEAD cipher holds the client and server
+    // write keys, followed by the client and server IVs.
+    uint8_t key_block[sizeof(keys)];
+    const size_t key_block_length = 2 * (key_length + iv_length);
+    derived = (static_cast<size_t>(SSL_get_key_block_len(ssl_)) ==
+               key_block_length) &&
+              SSL_generate_key_block(ssl_, key_block, key_block_length);
+    if (derived) {
+      const uint8_t* client_key = key_block;
+      const uint8_t* server_key = client_key + key_length;
+      const uint8_t* client_iv = server_key + key_length;
+      const uint8_t* server_iv = client_iv + iv_length;
+      memmove(read_key, is_server_ ? client_key : server_key, key_length);
+      memmove(read_iv, is_server_ ? client_iv : server_iv, iv_length);
+      memmove(write_key, is_server_ ? server_key : client_key, key_length);
+      memmove(write_iv, is_server_ ? server_iv : client_iv, iv_length);
+    }
+    OPENSSL_cleanse(key_block, sizeof(key_block));
+  }
+  if (!derived) {
+    OPENSSL_cleanse(keys, sizeof(keys));
+    return kKernelTlsUnavailable;
+  }
+
+  KernelTlsCryptoInfo read_info;
+  KernelTlsCryptoInfo write_info;
+  const socklen_t info_length =
+      FillCryptoInfo(tls13, cipher_nid, read_key, read_iv,
+                     SSL_get_read_sequence(ssl_), &read_info);
+  FillCryptoInfo(tls13, cipher_nid, write_key, write_iv,
+                 SSL_get_write_sequence(ssl_), &write_info);
+  OPENSSL_cleanse(keys, sizeof(keys));
+
+  const intptr_t fd = socket->fd();
+  static const char kUlpName[] = "tls";
+  KernelTlsResult result;
+  if ((NO_RETRY_EXPECTED(setsockopt(fd, SOL_TCP, TCP_ULP, kUlpName,
+                                    sizeof(kUlpName))) != 0) ||
+      (NO_RETRY_EXPECTED(setsockopt(fd, SOL_TLS, TLS_RX, &read_info,
+                                    info_length)) != 0)) {
+    // Without the tls module, or without support for this cipher, the socket
+    // keeps working as a plain TCP socket and BoringSSL stays in charge.
+    result = kKernelTlsUnavailable;
+  } else if (NO_RETRY_EXPECTED(setsockopt(fd, SOL_TLS, TLS_TX, &write_info,
+                                          info_length)) != 0) {
+    result = kKernelTlsFailed;
+  } else {
+    socket->set_kernel_tls(true);
+    result = kKernelTlsEnabled;
+  }
+  OPENSSL_cleanse(&read_info, sizeof(read_info));
+  OPENSSL_cleanse(&write_info, sizeof(write_info));
+  return result;
+}
+#else
+SSLFilter::KernelTlsResult SSLFilter::EnableKernelTls(Socket* socket) {
+  return kKernelTlsUnavailable;
+}
+#endif  // defined(DART_HOST_OS_LINUX)
+
 void SSLFilter::GetSelectedProtocol(Dart_NativeArguments args) {
   const uint8_t* protocol;
   unsigned length;
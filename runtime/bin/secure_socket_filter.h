@@ -19,6 +19,8 @@
 namespace dart {
 namespace bin {
 
+class Socket;
+
 /* These are defined in root_certificates.cc. */
 extern const unsigned char* root_certificates_pem;
 extern unsigned int root_certificates_pem_length;
@@ -53,6 +55,16 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
     kFirstEncrypted = kReadEncrypted
   };
 
+  // These enums must agree with those in sdk/lib/io/secure_socket.dart.
+  enum KernelTlsResult {
+    kKernelTlsUnavailable = -1,
+    kKernelTlsRetry = 0,
+    kKernelTlsEnabled = 1,
+    // The receive side was handed over but the send side was not, so the
+    // session can continue neither in BoringSSL nor in the kernel.
+    kKernelTlsFailed = 2,
+  };
+
   static const intptr_t kApproximateSize;
   static constexpr int kSSLFilterNativeFieldIndex = 0;
 
@@ -65,6 +77,7 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
         handshake_complete_(nullptr),
         bad_certificate_callback_(nullptr),
         in_handshake_(false),
+        allow_renegotiation_(false),
         hostname_(nullptr) {}
 
   ~SSLFilter();
@@ -100,6 +113,12 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
                          int ends[kNumBuffers],
                          bool in_handshake);
   Dart_Handle PeerCertificate();
+  // Hands the session keys over to kernel TLS on `socket`, which then
+  // encrypts and decrypts the records itself. This is only possible once the
+  // handshake is done and no record is left inside BoringSSL, otherwise
+  // kKernelTlsRetry is returned.
+  KernelTlsResult EnableKernelTls(Socket* socket);
+  static void set_use_kernel_tls(bool value) { use_kernel_tls_ = value; }
   static void InitializeLibrary();
   Dart_Handle callback_error;
 
@@ -122,6 +141,7 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
   static bool library_initialized_;
   static Mutex* mutex_;  // To protect library initialization.
   static Dart_Port trust_evaluate_reply_port_;
+  static bool use_kernel_tls_;
 
   SSL* ssl_;
   BIO* socket_side_;
@@ -138,6 +158,7 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
   Dart_PersistentHandle handshake_complete_;
   Dart_PersistentHandle bad_certificate_callback_;
   bool in_handshake_;
+  bool allow_renegotiation_;
   bool is_server_;
   char* hostname_;
 
@@ -528,6 +528,18 @@ void FUNCTION_NAME(Socket_Available)(Dart_NativeArguments args) {
   }
 }
 
+static intptr_t ReadFromSocket(Socket* socket,
+                               uint8_t* buffer,
+                               intptr_t length) {
+#if defined(DART_HOST_OS_LINUX)
+  if (socket->kernel_tls()) {
+    return SocketBase::ReadKernelTls(socket->fd(), buffer, length,
+                                     socket->kernel_tls_reader());
+  }
+#endif
+  return SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
+}
+
 void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
@@ -537,6 +549,26 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
     if (Socket::short_socket_read()) {
       length = (length + 1) / 2;
     }
+    uint8_t* pooled_buffer = IOBufferPool::Acquire(length);
+    if (pooled_buffer != nullptr) {
+      // Read straight into a pooled buffer and hand out exactly the bytes
+      // that were read. Only reads that fill less than half of the buffer
+      // are copied.
+      intptr_t bytes_read = ReadFromSocket(socket, pooled_buffer, length);
+      if (bytes_read > 0) {
+        Dart_SetReturnValue(
+            args, IOBufferPool::NewUint8List(pooled_buffer, bytes_read));
+      } else if (bytes_read == 0) {
+        IOBufferPool::Release(pooled_buffer);
+        Dart_SetReturnValue(args, Dart_Null());
+      } else {
+        ASSERT(bytes_read == -1);
+        Dart_Handle error = DartUtils::NewDartOSError();
+        IOBufferPool::Release(pooled_buffer);
+        Dart_ThrowException(error);
+      }
+      return;
+    }
     uint8_t* buffer = nullptr;
     Dart_Handle result = IOBuffer::Allocate(length, &buffer);
     if (Dart_IsNull(result)) {
@@ -546,8 +578,7 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
       Dart_PropagateError(result);
     }
     ASSERT(buffer != nullptr);
-    intptr_t bytes_read =
-        SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
+    intptr_t bytes_read = ReadFromSocket(socket, buffer, length);
     if (bytes_read == length) {
       Dart_SetReturnValue(args, result);
     } else if (bytes_read > 0) {
@@ -782,6 +813,129 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
   }
 }
 
+// Releases the typed data acquired for the chunks of a vectored write.
+static void ReleaseWriteVectorBuffers(Dart_Handle* buffers,
+                                      const intptr_t* owners,
+                                      intptr_t num_acquired) {
+  for (intptr_t i = 0; i < num_acquired; i++) {
+    if (owners[i] == i) {
+      Dart_TypedDataReleaseData(buffers[i]);
+    }
+  }
+}
+
+void FUNCTION_NAME(Socket_WriteVector)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  // List of triples <buffer, offset, length> arranged to minimize dart api use
+  // in native methods.
+  Dart_Handle chunk_list = ThrowIfError(Dart_GetNativeArgument(args, 1));
+  ASSERT(Dart_IsList(chunk_list));
+  intptr_t num_chunk_pieces;
+  ThrowIfError(Dart_ListLength(chunk_list, &num_chunk_pieces));
+  const intptr_t num_chunks = num_chunk_pieces / 3;
+  ASSERT((num_chunks * 3) == num_chunk_pieces);
+  Dart_Handle* buffers = reinterpret_cast<Dart_Handle*>(
+      Dart_ScopeAllocate(sizeof(Dart_Handle) * num_chunks));
+  intptr_t* offsets = reinterpret_cast<intptr_t*>(
+      Dart_ScopeAllocate(sizeof(intptr_t) * num_chunks));
+  // Index of the first chunk using the same buffer, which is the only one
+  // acquiring and releasing it.
+  intptr_t* owners = reinterpret_cast<intptr_t*>(
+      Dart_ScopeAllocate(sizeof(intptr_t) * num_chunks));
+  // Length of the acquired buffer, for chunks owning their buffer.
+  intptr_t* buffer_lengths = reinterpret_cast<intptr_t*>(
+      Dart_ScopeAllocate(sizeof(intptr_t) * num_chunks));
+  SocketWriteChunk* chunks = reinterpret_cast<SocketWriteChunk*>(
+      Dart_ScopeAllocate(sizeof(SocketWriteChunk) * num_chunks));
+  ASSERT((buffers != nullptr) && (offsets != nullptr) && (owners != nullptr) &&
+         (buffer_lengths != nullptr) && (chunks != nullptr));
+  // Look up everything before acquiring the data, as no Dart API calls that
+  // might allocate are allowed while the data is acquired.
+  for (intptr_t i = 0; i < num_chunks; i++) {
+    buffers[i] = ThrowIfError(Dart_ListGetAt(chunk_list, i * 3));
+    offsets[i] = DartUtils::GetIntptrValue(
+        ThrowIfError(Dart_ListGetAt(chunk_list, i * 3 + 1)));
+    chunks[i].length = DartUtils::GetIntptrValue(
+        ThrowIfError(Dart_ListGetAt(chunk_list, i * 3 + 2)));
+    if ((offsets[i] < 0) || (chunks[i].length < 0)) {
+      Dart_ThrowException(
+          DartUtils::NewDartArgumentError("Invalid chunk offset or length"));
+    }
+    owners[i] = i;
+    for (intptr_t j = 0; j < i; j++) {
+      if (Dart_IdentityEquals(buffers[j], buffers[i])) {
+        owners[i] = owners[j];
+        break;
+      }
+    }
+  }
+  for (intptr_t i = 0; i < num_chunks; i++) {
+    if (owners[i] != i) {
+      // Temporarily holds the start of the shared buffer.
+      chunks[i].data = chunks[owners[i]].data;
+    } else {
+      Dart_TypedData_Type type;
+      void* data = nullptr;
+      Dart_Handle result = Dart_TypedDataAcquireData(buffers[i], &type, &data,
+                                                     &buffer_lengths[i]);
+      if (Dart_IsError(result)) {
+        ReleaseWriteVectorBuffers(buffers, owners, i);
+        Dart_PropagateError(result);
+      }
+      chunks[i].data = data;
+    }
+  }
+  // The offsets and lengths come from Dart, so check them against the
+  // buffers before handing anything to the OS.
+  intptr_t total_length = 0;
+  for (intptr_t i = 0; i < num_chunks; i++) {
+    const intptr_t buffer_length = buffer_lengths[owners[i]];
+    if ((offsets[i] > buffer_length) ||
+        (chunks[i].length > buffer_length - offsets[i])) {
+      ReleaseWriteVectorBuffers(buffers, owners, num_chunks);
+      Dart_ThrowException(
+          DartUtils::NewDartArgumentError("Chunk exceeds its buffer"));
+    }
+    total_length += chunks[i].length;
+  }
+  bool short_write = false;
+  if (Socket::short_socket_write()) {
+    // Cut the chunks down to half of the total, as Socket_WriteList does.
+    short_write = total_length > 1;
+    intptr_t remaining = (total_length + 1) / 2;
+    for (intptr_t i = 0; i < num_chunks; i++) {
+      chunks[i].length = Utils::Minimum(chunks[i].length, remaining);
+      remaining -= chunks[i].length;
+    }
+  }
+  for (intptr_t i = num_chunks - 1; i >= 0; i--) {
+    // Owners come first, so walk backwards to still see their buffer start.
+    chunks[i].data = static_cast<const uint8_t*>(chunks[i].data) + offsets[i];
+  }
+  intptr_t bytes_written = SocketBase::WriteVector(socket->fd(), chunks,
+                                                   num_chunks,
+                                                   SocketBase::kAsync);
+  if (bytes_written < 0) {
+    // Extract OSError before we release data, as it may override the error.
+    Dart_Handle error;
+    {
+      OSError os_error;
+      ReleaseWriteVectorBuffers(buffers, owners, num_chunks);
+      error = DartUtils::NewDartOSError(&os_error);
+    }
+    Dart_ThrowException(error);
+  }
+  ReleaseWriteVectorBuffers(buffers, owners, num_chunks);
+  if (short_write) {
+    // If the write was forced 'short', indicate by returning the negative
+    // number of bytes. A forced short write may not trigger a write event.
+    Dart_SetIntegerReturnValue(args, -bytes_written);
+  } else {
+    Dart_SetIntegerReturnValue(args, bytes_written);
+  }
+}
+
 void FUNCTION_NAME(Socket_SendMessage)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
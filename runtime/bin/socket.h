@@ -66,6 +66,14 @@ class Socket : public ReferenceCounted<Socket> {
   uint8_t* udp_receive_buffer() const { return udp_receive_buffer_; }
   void set_udp_receive_buffer(uint8_t* buffer) { udp_receive_buffer_ = buffer; }
 
+  // Whether the TLS session on this socket has been handed over to the
+  // kernel, so reads return decrypted data and control records.
+  bool kernel_tls() const { return kernel_tls_; }
+  void set_kernel_tls(bool value) { kernel_tls_ = value; }
+#if defined(DART_HOST_OS_LINUX)
+  KernelTlsRecordReader* kernel_tls_reader() { return &kernel_tls_reader_; }
+#endif
+
   static bool Initialize();
 
   // Creates a socket which is bound and connected. The port to connect to is
@@ -128,6 +136,10 @@ class Socket : public ReferenceCounted<Socket> {
   Dart_Port isolate_port_;
   Dart_Port port_;
   uint8_t* udp_receive_buffer_;
+  bool kernel_tls_ = false;
+#if defined(DART_HOST_OS_LINUX)
+  KernelTlsRecordReader kernel_tls_reader_;
+#endif
 
   friend class ReferenceCounted<Socket>;
   DISALLOW_COPY_AND_ASSIGN(Socket);
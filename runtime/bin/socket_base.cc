@@ -324,5 +324,28 @@ intptr_t SocketBase::Write(intptr_t fd,
 }
 #endif
 
+#if defined(DART_HOST_OS_WINDOWS) || defined(DART_HOST_OS_FUCHSIA)
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 const SocketWriteChunk* chunks,
+                                 intptr_t num_chunks,
+                                 SocketOpKind sync) {
+  // No gather write available, write the chunks one after the other until
+  // one of them is only partially written.
+  intptr_t total_written = 0;
+  for (intptr_t i = 0; i < num_chunks; i++) {
+    intptr_t written =
+        SocketBase::Write(fd, chunks[i].data, chunks[i].length, sync);
+    if (written < 0) {
+      return -1;
+    }
+    total_written += written;
+    if (written < chunks[i].length) {
+      break;
+    }
+  }
+  return total_written;
+}
+#endif
+
 }  // namespace bin
 }  // namespace dart
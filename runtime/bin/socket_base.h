@@ -202,6 +202,49 @@ class SocketControlMessage {
   DISALLOW_COPY_AND_ASSIGN(SocketControlMessage);
 };
 
+// One of the buffers written by SocketBase::WriteVector.
+struct SocketWriteChunk {
+  const void* data;
+  intptr_t length;
+};
+
+#if defined(DART_HOST_OS_LINUX)
+// Classifies the records read from a socket whose receive side has been
+// handed over to kernel TLS. The kernel reports the type of the record each
+// read came from, but a record can be split across reads and a handshake
+// record can hold several messages. The headers of handshake messages and
+// alerts are therefore buffered until they are complete.
+class KernelTlsRecordReader {
+ public:
+  enum Result {
+    kData,         // Application data for the caller.
+    kContinue,     // Control bytes that were consumed; read again.
+    kCloseNotify,  // A close_notify alert, which reads as the end of data.
+    kError,        // A fatal alert, a key update, or an unexpected record.
+  };
+
+  KernelTlsRecordReader() {}
+
+  // Processes the `length` bytes of a record of type `record_type` that one
+  // read returned.
+  Result Process(uint8_t record_type, const uint8_t* data, intptr_t length);
+
+ private:
+  static constexpr intptr_t kHandshakeHeaderSize = 4;
+  static constexpr intptr_t kAlertSize = 2;
+
+  // Type of the record whose handshake message or alert is incomplete, or 0.
+  uint8_t pending_type_ = 0;
+  // Received bytes of the current handshake message header or alert.
+  uint8_t header_[kHandshakeHeaderSize] = {};
+  intptr_t header_length_ = 0;
+  // Bytes of the current handshake message body that are still to come.
+  intptr_t body_remaining_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(KernelTlsRecordReader);
+};
+#endif  // defined(DART_HOST_OS_LINUX)
+
 class SocketBase : public AllStatic {
  public:
   enum SocketRequest {
@@ -222,10 +265,27 @@ class SocketBase : public AllStatic {
                        void* buffer,
                        intptr_t num_bytes,
                        SocketOpKind sync);
+#if defined(DART_HOST_OS_LINUX)
+  // Like Read, for a socket whose receive side has been handed over to
+  // kernel TLS. Session tickets are skipped and a close_notify alert reads as
+  // no data. Other alerts and TLS 1.3 key updates fail with EIO. `reader`
+  // keeps the state of records split across reads of the socket.
+  static intptr_t ReadKernelTls(intptr_t fd,
+                                void* buffer,
+                                intptr_t num_bytes,
+                                KernelTlsRecordReader* reader);
+#endif
   static intptr_t Write(intptr_t fd,
                         const void* buffer,
                         intptr_t num_bytes,
                         SocketOpKind sync);
+  // Writes the given chunks in order, using a single gather write per
+  // system call where the platform supports it. Like Write, returns the
+  // number of bytes written, or -1 on error.
+  static intptr_t WriteVector(intptr_t fd,
+                              const SocketWriteChunk* chunks,
+                              intptr_t num_chunks,
+                              SocketOpKind sync);
 
   // Send data on a socket. The port to send to is specified in the port
   // component of the passed RawAddr structure. The RawAddr structure is only
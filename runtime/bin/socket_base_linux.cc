@@ -16,6 +16,9 @@
 #include <string.h>       // NOLINT
 #include <sys/stat.h>     // NOLINT
 #include <unistd.h>       // NOLINT
+#if defined(DART_HOST_OS_LINUX)
+#include <linux/tls.h>  // NOLINT
+#endif
 
 #include "bin/fdutils.h"
 #include "bin/file.h"
@@ -142,6 +145,125 @@ bool SocketBase::LeaveMulticast(intptr_t fd,
                                       sizeof(mreq))) == 0;
 }
 
+#if defined(DART_HOST_OS_LINUX)
+#if !defined(SOL_TLS)
+#define SOL_TLS 282
+#endif
+
+// TLS record content types and the alert and handshake message types that
+// ReadKernelTls has to look at.
+static constexpr uint8_t kTlsRecordAlert = 21;
+static constexpr uint8_t kTlsRecordHandshake = 22;
+static constexpr uint8_t kTlsRecordApplicationData = 23;
+static constexpr uint8_t kTlsAlertCloseNotify = 0;
+static constexpr uint8_t kTlsHandshakeKeyUpdate = 24;
+
+KernelTlsRecordReader::Result KernelTlsRecordReader::Process(
+    uint8_t record_type,
+    const uint8_t* data,
+    intptr_t length) {
+  if ((pending_type_ != 0) && (record_type != pending_type_)) {
+    // Handshake messages and alerts must not be interleaved with other
+    // records.
+    return kError;
+  }
+  if (record_type == kTlsRecordApplicationData) {
+    return kData;
+  }
+  if (record_type == kTlsRecordAlert) {
+    const intptr_t n = Utils::Minimum(kAlertSize - header_length_, length);
+    memmove(header_ + header_length_, data, n);
+    header_length_ += n;
+    if (header_length_ < kAlertSize) {
+      pending_type_ = record_type;
+      return kContinue;
+    }
+    // The peer closes the connection after close_notify.
+    return ((length == n) && (header_[1] == kTlsAlertCloseNotify))
+               ? kCloseNotify
+               : kError;
+  }
+  if (record_type != kTlsRecordHandshake) {
+    return kError;
+  }
+  intptr_t position = 0;
+  while (position < length) {
+    if (header_length_ < kHandshakeHeaderSize) {
+      const intptr_t n = Utils::Minimum(kHandshakeHeaderSize - header_length_,
+                                        length - position);
+      memmove(header_ + header_length_, data + position, n);
+      header_length_ += n;
+      position += n;
+      if (header_length_ < kHandshakeHeaderSize) {
+        break;
+      }
+      if (header_[0] == kTlsHandshakeKeyUpdate) {
+        // The kernel cannot follow key updates.
+        return kError;
+      }
+      body_remaining_ = (static_cast<intptr_t>(header_[1]) << 16) |
+                        (static_cast<intptr_t>(header_[2]) << 8) |
+                        static_cast<intptr_t>(header_[3]);
+    }
+    // Session tickets and other messages are of no use once the session
+    // keys are in the kernel.
+    const intptr_t n = Utils::Minimum(body_remaining_, length - position);
+    body_remaining_ -= n;
+    position += n;
+    if (body_remaining_ == 0) {
+      header_length_ = 0;
+    }
+  }
+  pending_type_ = (header_length_ > 0) ? record_type : 0;
+  return kContinue;
+}
+
+intptr_t SocketBase::ReadKernelTls(intptr_t fd,
+                                   void* buffer,
+                                   intptr_t num_bytes,
+                                   KernelTlsRecordReader* reader) {
+  ASSERT(fd >= 0);
+  while (true) {
+    // With a control buffer present the kernel reports the type of the
+    // record that was read, and never mixes records of different types in
+    // one read.
+    char control[CMSG_SPACE(sizeof(uint8_t))];
+    struct iovec iov;
+    iov.iov_base = buffer;
+    iov.iov_len = num_bytes;
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    ssize_t read_bytes = TEMP_FAILURE_RETRY(recvmsg(fd, &msg, 0));
+    if (read_bytes == -1) {
+      return (errno == EWOULDBLOCK) ? 0 : -1;
+    }
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if ((read_bytes == 0) || (cmsg == nullptr) ||
+        (cmsg->cmsg_level != SOL_TLS) ||
+        (cmsg->cmsg_type != TLS_GET_RECORD_TYPE)) {
+      return read_bytes;
+    }
+    switch (reader->Process(*CMSG_DATA(cmsg),
+                            reinterpret_cast<const uint8_t*>(buffer),
+                            read_bytes)) {
+      case KernelTlsRecordReader::kData:
+        return read_bytes;
+      case KernelTlsRecordReader::kContinue:
+        continue;
+      case KernelTlsRecordReader::kCloseNotify:
+        return 0;
+      case KernelTlsRecordReader::kError:
+        errno = EIO;
+        return -1;
+    }
+  }
+}
+#endif  // defined(DART_HOST_OS_LINUX)
+
 }  // namespace bin
 }  // namespace dart
 
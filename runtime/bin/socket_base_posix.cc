@@ -14,6 +14,7 @@
 #include <stdlib.h>       // NOLINT
 #include <string.h>       // NOLINT
 #include <sys/stat.h>     // NOLINT
+#include <sys/uio.h>      // NOLINT
 #include <unistd.h>       // NOLINT
 
 #include "bin/fdutils.h"
@@ -193,6 +194,59 @@ intptr_t SocketBase::WriteImpl(intptr_t fd,
   return TEMP_FAILURE_RETRY(write(fd, buffer, num_bytes));
 }
 
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 const SocketWriteChunk* chunks,
+                                 intptr_t num_chunks,
+                                 SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  // As in Write, keep writing until everything is written or the socket
+  // would block, so that edge-triggered write events are generated.
+  const intptr_t kMaxIOVecs = 64;
+  struct iovec iov[kMaxIOVecs];
+  intptr_t total_written = 0;
+  intptr_t chunk = 0;
+  intptr_t chunk_offset = 0;
+  while (chunk < num_chunks) {
+    intptr_t iov_count = 0;
+    for (intptr_t i = chunk; (i < num_chunks) && (iov_count < kMaxIOVecs);
+         i++) {
+      const intptr_t skip = (i == chunk) ? chunk_offset : 0;
+      const intptr_t length = chunks[i].length - skip;
+      if (length == 0) {
+        // Empty chunks would only use up iovec slots.
+        continue;
+      }
+      iov[iov_count].iov_base = const_cast<uint8_t*>(
+          static_cast<const uint8_t*>(chunks[i].data) + skip);
+      iov[iov_count].iov_len = length;
+      iov_count++;
+    }
+    if (iov_count == 0) {
+      // Only empty chunks are left.
+      break;
+    }
+    ssize_t written_bytes = TEMP_FAILURE_RETRY(writev(fd, iov, iov_count));
+    static_assert(EAGAIN == EWOULDBLOCK);
+    if (written_bytes == -1) {
+      if ((sync == kAsync) && (errno == EWOULDBLOCK)) {
+        break;
+      }
+      return -1;  // Error occurred.
+    }
+    total_written += written_bytes;
+    // Advance past the chunks that were written completely.
+    intptr_t remaining = written_bytes;
+    while ((chunk < num_chunks) &&
+           (remaining >= chunks[chunk].length - chunk_offset)) {
+      remaining -= chunks[chunk].length - chunk_offset;
+      chunk++;
+      chunk_offset = 0;
+    }
+    chunk_offset += remaining;
+  }
+  return total_written;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -0,0 +1,238 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/globals.h"
+
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_MACOS)
+
+#include <errno.h>       // NOLINT
+#include <fcntl.h>       // NOLINT
+#include <sys/socket.h>  // NOLINT
+#include <unistd.h>      // NOLINT
+
+#include "bin/socket_base.h"
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+using bin::SocketBase;
+using bin::SocketWriteChunk;
+
+static void CreateNonBlockingSocketPair(int fds[2]) {
+  EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  for (intptr_t i = 0; i < 2; i++) {
+    EXPECT_NE(-1, fcntl(fds[i], F_SETFL, O_NONBLOCK));
+  }
+}
+
+// Reads everything that is available on `fd` into `buffer` at `position`.
+static intptr_t Drain(int fd, uint8_t* buffer, intptr_t position) {
+  while (true) {
+    ssize_t result = read(fd, buffer + position, 64 * KB);
+    if (result <= 0) {
+      EXPECT((result == -1) && (errno == EAGAIN));
+      return position;
+    }
+    position += result;
+  }
+}
+
+// Drops the first `written` bytes from `chunks`.
+static void Advance(SocketWriteChunk* chunks,
+                    intptr_t num_chunks,
+                    intptr_t written) {
+  for (intptr_t i = 0; (i < num_chunks) && (written > 0); i++) {
+    const intptr_t consumed = Utils::Minimum(written, chunks[i].length);
+    chunks[i].data = static_cast<const uint8_t*>(chunks[i].data) + consumed;
+    chunks[i].length -= consumed;
+    written -= consumed;
+  }
+}
+
+VM_UNIT_TEST_CASE(SocketBase_WriteVectorPartialWrites) {
+  int fds[2];
+  CreateNonBlockingSocketPair(fds);
+
+  // Larger than the socket buffers, with an empty chunk and two chunks
+  // sharing a buffer.
+  const intptr_t kChunkSize = 256 * KB;
+  uint8_t* first = reinterpret_cast<uint8_t*>(malloc(kChunkSize));
+  uint8_t* second = reinterpret_cast<uint8_t*>(malloc(kChunkSize));
+  for (intptr_t i = 0; i < kChunkSize; i++) {
+    first[i] = i & 0xff;
+    second[i] = (i * 7 + 3) & 0xff;
+  }
+  SocketWriteChunk chunks[] = {
+      {first, kChunkSize},
+      {second, 0},
+      {second + 100, kChunkSize - 100},
+      {second, 100},
+  };
+  const intptr_t kNumChunks = ARRAY_SIZE(chunks);
+  const intptr_t kTotal = 2 * kChunkSize;
+  uint8_t* expected = reinterpret_cast<uint8_t*>(malloc(kTotal));
+  memmove(expected, first, kChunkSize);
+  memmove(expected + kChunkSize, second + 100, kChunkSize - 100);
+  memmove(expected + 2 * kChunkSize - 100, second, 100);
+
+  uint8_t* received = reinterpret_cast<uint8_t*>(malloc(kTotal));
+  intptr_t total_written = 0;
+  intptr_t total_received = 0;
+  intptr_t partial_writes = 0;
+  while (total_written < kTotal) {
+    intptr_t written =
+        SocketBase::WriteVector(fds[0], chunks, kNumChunks, SocketBase::kAsync);
+    EXPECT(written >= 0);
+    if (total_written + written < kTotal) {
+      partial_writes++;
+      // The socket is full: writing again reports that nothing was written
+      // rather than an error.
+      EXPECT_EQ(0, SocketBase::WriteVector(fds[0], chunks, kNumChunks,
+                                           SocketBase::kAsync));
+    }
+    Advance(chunks, kNumChunks, written);
+    total_written += written;
+    total_received = Drain(fds[1], received, total_received);
+  }
+  EXPECT(partial_writes > 0);
+  EXPECT_EQ(kTotal, total_received);
+  EXPECT_EQ(0, memcmp(expected, received, kTotal));
+
+  free(received);
+  free(expected);
+  free(second);
+  free(first);
+  close(fds[0]);
+  close(fds[1]);
+}
+
+VM_UNIT_TEST_CASE(SocketBase_WriteVectorManyChunks) {
+  int fds[2];
+  CreateNonBlockingSocketPair(fds);
+
+  // More chunks than a single writev call takes.
+  const intptr_t kNumChunks = 200;
+  uint8_t data[kNumChunks];
+  SocketWriteChunk chunks[kNumChunks];
+  for (intptr_t i = 0; i < kNumChunks; i++) {
+    data[i] = i;
+    chunks[i].data = &data[i];
+    chunks[i].length = 1;
+  }
+  EXPECT_EQ(kNumChunks, SocketBase::WriteVector(fds[0], chunks, kNumChunks,
+                                                SocketBase::kAsync));
+  uint8_t received[kNumChunks];
+  EXPECT_EQ(kNumChunks, Drain(fds[1], received, 0));
+  EXPECT_EQ(0, memcmp(data, received, kNumChunks));
+
+  // Nothing to write.
+  EXPECT_EQ(0, SocketBase::WriteVector(fds[0], chunks, 0, SocketBase::kAsync));
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
+VM_UNIT_TEST_CASE(SocketBase_WriteVectorLeadingEmptyChunks) {
+  int fds[2];
+  CreateNonBlockingSocketPair(fds);
+
+  // More empty chunks than a single writev call takes before the data, and
+  // empty chunks between and after the data.
+  const intptr_t kNumEmpty = 150;
+  const intptr_t kNumChunks = kNumEmpty + 4;
+  uint8_t data[] = {1, 2, 3, 4, 5, 6};
+  SocketWriteChunk chunks[kNumChunks];
+  for (intptr_t i = 0; i < kNumEmpty; i++) {
+    chunks[i].data = data;
+    chunks[i].length = 0;
+  }
+  chunks[kNumEmpty] = {data, 4};
+  chunks[kNumEmpty + 1] = {data, 0};
+  chunks[kNumEmpty + 2] = {data + 4, 2};
+  chunks[kNumEmpty + 3] = {data, 0};
+  EXPECT_EQ(6, SocketBase::WriteVector(fds[0], chunks, kNumChunks,
+                                       SocketBase::kAsync));
+  uint8_t received[ARRAY_SIZE(data)];
+  EXPECT_EQ(6, Drain(fds[1], received, 0));
+  EXPECT_EQ(0, memcmp(data, received, ARRAY_SIZE(data)));
+
+  // Only empty chunks.
+  EXPECT_EQ(0, SocketBase::WriteVector(fds[0], chunks, kNumEmpty,
+                                       SocketBase::kAsync));
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
+#if defined(DART_HOST_OS_LINUX)
+using bin::KernelTlsRecordReader;
+
+static constexpr uint8_t kAlert = 21;
+static constexpr uint8_t kHandshake = 22;
+static constexpr uint8_t kApplicationData = 23;
+
+VM_UNIT_TEST_CASE(SocketBase_KernelTlsHandshakeSplitAcrossReads) {
+  KernelTlsRecordReader reader;
+  // A NewSessionTicket with a 5 byte body whose header arrives in two reads
+  // and whose body contains the key update message type.
+  const uint8_t ticket1[] = {4, 0};
+  const uint8_t ticket2[] = {0, 5, 24, 24};
+  const uint8_t ticket3[] = {24, 24, 24};
+  EXPECT_EQ(KernelTlsRecordReader::kContinue,
+            reader.Process(kHandshake, ticket1, ARRAY_SIZE(ticket1)));
+  EXPECT_EQ(KernelTlsRecordReader::kContinue,
+            reader.Process(kHandshake, ticket2, ARRAY_SIZE(ticket2)));
+  EXPECT_EQ(KernelTlsRecordReader::kContinue,
+            reader.Process(kHandshake, ticket3, ARRAY_SIZE(ticket3)));
+  const uint8_t data[] = {1, 2, 3};
+  EXPECT_EQ(KernelTlsRecordReader::kData,
+            reader.Process(kApplicationData, data, ARRAY_SIZE(data)));
+
+  // A ticket followed by a key update whose message type is only in the
+  // second read.
+  const uint8_t update1[] = {4, 0, 0, 1, 0};
+  const uint8_t update2[] = {24, 0, 0, 1, 0};
+  EXPECT_EQ(KernelTlsRecordReader::kContinue,
+            reader.Process(kHandshake, update1, ARRAY_SIZE(update1)));
+  EXPECT_EQ(KernelTlsRecordReader::kError,
+            reader.Process(kHandshake, update2, ARRAY_SIZE(update2)));
+}
+
+VM_UNIT_TEST_CASE(SocketBase_KernelTlsAlertSplitAcrossReads) {
+  {
+    KernelTlsRecordReader reader;
+    const uint8_t level[] = {1};
+    const uint8_t close_notify[] = {0};
+    EXPECT_EQ(KernelTlsRecordReader::kContinue,
+              reader.Process(kAlert, level, ARRAY_SIZE(level)));
+    EXPECT_EQ(KernelTlsRecordReader::kCloseNotify,
+              reader.Process(kAlert, close_notify, ARRAY_SIZE(close_notify)));
+  }
+  {
+    KernelTlsRecordReader reader;
+    const uint8_t level[] = {2};
+    const uint8_t bad_record_mac[] = {20};
+    EXPECT_EQ(KernelTlsRecordReader::kContinue,
+              reader.Process(kAlert, level, ARRAY_SIZE(level)));
+    EXPECT_EQ(KernelTlsRecordReader::kError,
+              reader.Process(kAlert, bad_record_mac,
+                             ARRAY_SIZE(bad_record_mac)));
+  }
+}
+
+VM_UNIT_TEST_CASE(SocketBase_KernelTlsInterleavedRecords) {
+  KernelTlsRecordReader reader;
+  const uint8_t ticket[] = {4, 0, 0, 8, 1, 2};
+  const uint8_t data[] = {1, 2, 3};
+  EXPECT_EQ(KernelTlsRecordReader::kContinue,
+            reader.Process(kHandshake, ticket, ARRAY_SIZE(ticket)));
+  EXPECT_EQ(KernelTlsRecordReader::kError,
+            reader.Process(kApplicationData, data, ARRAY_SIZE(data)));
+}
+#endif  // defined(DART_HOST_OS_LINUX)
+
+}  // namespace dart
+
+#endif  // defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_MACOS)
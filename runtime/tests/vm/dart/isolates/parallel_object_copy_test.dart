@@ -0,0 +1,96 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests that large typed data payloads copied by multiple threads arrive
+// intact.
+
+// VMOptions=--object-copy-tasks=0
+// VMOptions=--object-copy-tasks=4 --parallel-object-copy-threshold=1
+// VMOptions=--object-copy-tasks=3 --parallel-object-copy-threshold=1 --no-enable-fast-object-copy
+// VMOptions=--object-copy-tasks=4 --parallel-object-copy-threshold=1 --gc-on-foc-slow-path --force-evacuation
+
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+import 'fast_object_copy_test.dart' show SendReceiveTestBase;
+
+// Not a multiple of the chunk size used by the parallel copy.
+const int kLargeLength = 3 * 1024 * 1024 + 123;
+
+Uint8List makeBytes(int length, int seed) {
+  final bytes = Uint8List(length);
+  for (int i = 0; i < length; i++) {
+    bytes[i] = (i * 31 + seed) & 0xff;
+  }
+  return bytes;
+}
+
+void expectBytes(Uint8List bytes, int length, int seed) {
+  Expect.equals(length, bytes.length);
+  for (int i = 0; i < length; i++) {
+    if (bytes[i] != ((i * 31 + seed) & 0xff)) {
+      Expect.fail('Mismatch at $i: ${bytes[i]}');
+    }
+  }
+}
+
+class ParallelCopyTest extends SendReceiveTestBase {
+  Future runTests() async {
+    await testLargeTypedData();
+    await testManyTypedData();
+    await testViews();
+  }
+
+  Future testLargeTypedData() async {
+    print('testLargeTypedData');
+    final bytes = makeBytes(kLargeLength, 1);
+    final copy = await sendReceive(bytes);
+    Expect.notIdentical(bytes, copy);
+    expectBytes(copy, kLargeLength, 1);
+
+    final words = Int64List(kLargeLength ~/ 8);
+    for (int i = 0; i < words.length; i++) {
+      words[i] = i * 0x100000001;
+    }
+    final wordsCopy = await sendReceive(words);
+    Expect.equals(words.length, wordsCopy.length);
+    for (int i = 0; i < words.length; i++) {
+      Expect.equals(i * 0x100000001, wordsCopy[i]);
+    }
+  }
+
+  Future testManyTypedData() async {
+    print('testManyTypedData');
+    final list = <Uint8List>[
+      for (int i = 0; i < 16; i++) makeBytes(64 * 1024 + i, i),
+      makeBytes(kLargeLength, 16),
+    ];
+    final copy = await sendReceive(list);
+    Expect.equals(list.length, copy.length);
+    for (int i = 0; i < 16; i++) {
+      expectBytes(copy[i], 64 * 1024 + i, i);
+    }
+    expectBytes(copy[16], kLargeLength, 16);
+  }
+
+  Future testViews() async {
+    print('testViews');
+    final bytes = makeBytes(kLargeLength, 7);
+    final view = Uint8List.view(bytes.buffer, 1000, kLargeLength - 2000);
+    final copy = await sendReceive([bytes, view]);
+    final bytesCopy = copy[0] as Uint8List;
+    final viewCopy = copy[1] as Uint8List;
+    expectBytes(bytesCopy, kLargeLength, 7);
+    // The view must still share the backing store with the copied bytes.
+    Expect.identical(bytesCopy.buffer, viewCopy.buffer);
+    Expect.equals(1000, viewCopy.offsetInBytes);
+    Expect.equals(kLargeLength - 2000, viewCopy.length);
+  }
+}
+
+main() async {
+  await ParallelCopyTest().run();
+}
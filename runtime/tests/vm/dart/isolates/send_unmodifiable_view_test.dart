@@ -0,0 +1,125 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests that large unmodifiable typed data views are received backed by
+// immutable memory, and can then be sent again without being copied.
+
+// VMOptions=
+// VMOptions=--share-unmodifiable-view-threshold=1
+// VMOptions=--share-unmodifiable-view-threshold=1 --no-enable-fast-object-copy
+// VMOptions=--share-unmodifiable-view-threshold=1 --object-copy-tasks=4 --parallel-object-copy-threshold=1
+
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+import 'fast_object_copy_test.dart' show SendReceiveTestBase;
+
+const int kLength = 1024 * 1024 + 3;
+
+class SendUnmodifiableViewTest extends SendReceiveTestBase {
+  Future runTests() async {
+    await testUint8View();
+    await testRepeatedSends();
+    await testWiderView();
+    await testSmallView();
+    await testViewInsideGraph();
+  }
+
+  Future testUint8View() async {
+    print('testUint8View');
+    final bytes = Uint8List(kLength);
+    for (int i = 0; i < kLength; i++) {
+      bytes[i] = i & 0xff;
+    }
+    final view = Uint8List.sublistView(
+      bytes,
+      10,
+      kLength - 10,
+    ).asUnmodifiableView();
+
+    final copy = await sendReceive(view);
+    Expect.notIdentical(view, copy);
+    Expect.equals(view.length, copy.length);
+    Expect.equals(view.offsetInBytes, copy.offsetInBytes);
+    Expect.equals(bytes.lengthInBytes, copy.buffer.lengthInBytes);
+    for (int i = 0; i < copy.length; i++) {
+      Expect.equals((i + 10) & 0xff, copy[i]);
+    }
+    Expect.throws(() => copy[0] = 42);
+
+    // The sender's mutations are not visible in the received copy.
+    bytes[10] = 42;
+    Expect.equals(42, view[0]);
+    Expect.equals(10, copy[0]);
+
+    // The received view is backed by immutable memory and can be sent on
+    // without being copied.
+    Expect.identical(copy, await sendReceive(copy));
+    final list = await sendReceive([copy, copy]);
+    Expect.identical(copy, list[0]);
+    Expect.identical(copy, list[1]);
+  }
+
+  Future testRepeatedSends() async {
+    print('testRepeatedSends');
+    final bytes = Uint8List(kLength);
+    final view = bytes.asUnmodifiableView();
+    final first = await sendReceive(view);
+
+    // The sender can still write to the backing store, so each message gets
+    // its own copy.
+    bytes[0] = 42;
+    final second = await sendReceive(view);
+    Expect.notEquals(first.buffer, second.buffer);
+    Expect.equals(0, first[0]);
+    Expect.equals(42, second[0]);
+
+    // Forwarding a received view shares its immutable backing store.
+    final forwarded = await sendReceive(first);
+    Expect.identical(first, forwarded);
+    Expect.equals(first.buffer, forwarded.buffer);
+  }
+
+  Future testWiderView() async {
+    print('testWiderView');
+    final doubles = Float64List(kLength ~/ 8);
+    for (int i = 0; i < doubles.length; i++) {
+      doubles[i] = i * 0.5;
+    }
+    final view = doubles.asUnmodifiableView();
+    final copy = await sendReceive(view);
+    Expect.equals(doubles.length, copy.length);
+    for (int i = 0; i < copy.length; i++) {
+      Expect.equals(i * 0.5, copy[i]);
+    }
+    Expect.identical(copy, await sendReceive(copy));
+  }
+
+  Future testSmallView() async {
+    print('testSmallView');
+    final view = Uint8List.fromList([1, 2, 3]).asUnmodifiableView();
+    final copy = await sendReceive(view);
+    Expect.listEquals([1, 2, 3], copy);
+    Expect.throws(() => copy[0] = 42);
+  }
+
+  Future testViewInsideGraph() async {
+    print('testViewInsideGraph');
+    // When the backing store is part of the message as well, the received
+    // view and list must still share it.
+    final bytes = Uint8List(kLength);
+    final view = bytes.asUnmodifiableView();
+    final copy = await sendReceive([bytes, view]);
+    final bytesCopy = copy[0] as Uint8List;
+    final viewCopy = copy[1] as Uint8List;
+    bytesCopy[0] = 42;
+    Expect.equals(42, viewCopy[0]);
+  }
+}
+
+main() async {
+  await SendUnmodifiableViewTest().run();
+}
@@ -0,0 +1,182 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests that objects proven to be deeply immutable are shared instead of
+// copied when sent to another isolate of the same group.
+
+// VMOptions=--promote-immutable-objects
+// VMOptions=--promote-immutable-objects --no-enable-fast-object-copy
+// VMOptions=--promote-immutable-objects --gc-on-foc-slow-path --force-evacuation
+
+import 'dart:isolate';
+
+import 'package:expect/expect.dart';
+
+import 'fast_object_copy_test.dart' show SendReceiveTestBase;
+
+class Route {
+  final String path;
+  final int port;
+  final double weight;
+
+  Route(this.path, this.port, this.weight);
+}
+
+class Config {
+  final String name;
+  final List<Route> routes;
+  final (int, Route) primary;
+
+  Config(this.name, this.routes, this.primary);
+}
+
+class Counter {
+  int count = 0;
+}
+
+class HasMutableField {
+  final String name;
+  int count = 0;
+
+  HasMutableField(this.name);
+}
+
+class HasLateFinalField {
+  late final String name;
+}
+
+class ReferencesMutable {
+  final Counter counter;
+
+  ReferencesMutable(this.counter);
+}
+
+class SubclassOfImmutable extends Route {
+  int hits = 0;
+
+  SubclassOfImmutable(super.path, super.port, super.weight);
+}
+
+Config makeConfig() {
+  final routes = List<Route>.unmodifiable([
+    for (int i = 0; i < 100; i++) Route('/path/$i', 8000 + i, i / 100),
+  ]);
+  return Config('config', routes, (1, routes[1]));
+}
+
+// A graph with 2^depth paths from the root to [leaf], but only depth + 1
+// objects.
+Object makeDiamonds(Object leaf, int depth) {
+  Object node = leaf;
+  for (int i = 0; i < depth; i++) {
+    node = (node, node);
+  }
+  return node;
+}
+
+class ShareImmutableObjectsTest extends SendReceiveTestBase {
+  Future runTests() async {
+    await testPromotedGraph();
+    await testPromotedInsideMutableGraph();
+    await testRecordsAndUnmodifiableLists();
+    await testSharedSubstructure();
+    await testNotPromoted();
+    await testWeakReferences();
+  }
+
+  Future testPromotedGraph() async {
+    print('testPromotedGraph');
+    final config = makeConfig();
+    final copy = await sendReceive(config);
+    Expect.identical(config, copy);
+    // Sending it again shares it without examining it again.
+    Expect.identical(config, await sendReceive(config));
+  }
+
+  Future testPromotedInsideMutableGraph() async {
+    print('testPromotedInsideMutableGraph');
+    final config = makeConfig();
+    final graph = <String, Object>{'config': config, 'counter': Counter()};
+    final copy = await sendReceive(graph);
+    Expect.notIdentical(graph, copy);
+    Expect.notIdentical(graph['counter'], copy['counter']);
+    Expect.identical(config, copy['config']);
+  }
+
+  Future testRecordsAndUnmodifiableLists() async {
+    print('testRecordsAndUnmodifiableLists');
+    final list = List<Object>.unmodifiable(['a', 1, 2.5, (3, 'b')]);
+    final record = (list, name: 'record');
+    final copy = await sendReceive(record);
+    Expect.identical(record, copy);
+    Expect.identical(list, copy.$1);
+
+    final mutable = [1, 2, 3];
+    final recordWithMutable = (mutable, 1);
+    final copy2 = await sendReceive(recordWithMutable);
+    Expect.notIdentical(recordWithMutable, copy2);
+    mutable[0] = 42;
+    Expect.equals(1, copy2.$1[0]);
+
+    final unmodifiableWithMutable = List<Object>.unmodifiable([mutable]);
+    final copy3 = await sendReceive(unmodifiableWithMutable);
+    Expect.notIdentical(unmodifiableWithMutable, copy3);
+  }
+
+  Future testSharedSubstructure() async {
+    print('testSharedSubstructure');
+    // Each object is examined once, so the number of paths does not count
+    // against the per-message limit.
+    final diamonds = makeDiamonds(List<int>.unmodifiable([1, 2]), 64);
+    Expect.identical(diamonds, await sendReceive(diamonds));
+
+    final counter = Counter();
+    final mutableDiamonds = makeDiamonds(counter, 64) as (Object, Object);
+    final copy = await sendReceive(mutableDiamonds) as (Object, Object);
+    Expect.notIdentical(mutableDiamonds, copy);
+    Expect.identical(copy.$1, copy.$2);
+    counter.count = 42;
+    Object leaf = copy;
+    while (leaf is (Object, Object)) {
+      leaf = leaf.$1;
+    }
+    Expect.equals(0, (leaf as Counter).count);
+  }
+
+  Future testNotPromoted() async {
+    print('testNotPromoted');
+    final objects = <Object>[
+      Counter(),
+      HasMutableField('name'),
+      HasLateFinalField()..name = 'name',
+      ReferencesMutable(Counter()),
+      SubclassOfImmutable('/', 80, 1.0),
+    ];
+    for (final object in objects) {
+      final copy = await sendReceive(object);
+      Expect.notIdentical(object, copy);
+      Expect.equals(object.runtimeType, copy.runtimeType);
+    }
+
+    final counter = Counter();
+    final referencesMutable = ReferencesMutable(counter);
+    final copy = await sendReceive(referencesMutable);
+    counter.count = 42;
+    Expect.equals(0, copy.counter.count);
+  }
+
+  Future testWeakReferences() async {
+    print('testWeakReferences');
+    final route = Route('/', 80, 1.0);
+    final weakRef = WeakReference(route);
+    final result = await sendReceive([weakRef, route]);
+    final weakRefCopy = result[0] as WeakReference<Route>;
+    Expect.equals('/', weakRefCopy.target!.path);
+    Expect.identical(result[1], weakRefCopy.target);
+  }
+}
+
+main() async {
+  await ShareImmutableObjectsTest().run();
+}
@@ -35,6 +35,7 @@
 #include "vm/zone_text_buffer.h"
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/backend/code_statistics.h"
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/relocation.h"
@@ -2726,6 +2727,8 @@ class CodeSerializationCluster : public SerializationCluster {
     CodePtr code;
     intptr_t not_discarded;  // 1 if this code was not discarded and
                              // 0 otherwise.
+    intptr_t is_hot;         // 1 if the AOT profile marks the owner of this
+                             // code as hot and 0 otherwise.
     intptr_t instructions_id;
   };
 
@@ -2740,10 +2743,16 @@ class CodeSerializationCluster : public SerializationCluster {
   // there is no way to identify which specific Code object (out of those
   // which point to the specific instructions range) actually corresponds
   // to a particular frame.
+  //
+  // Within each of these groups, code of functions which were hot in the
+  // training run of the AOT profile (if any) comes first, so frequently
+  // executed instructions share pages and the rest is kept out of the way.
   static int CompareCodeOrderInfo(CodeOrderInfo const* a,
                                   CodeOrderInfo const* b) {
     if (a->not_discarded < b->not_discarded) return -1;
     if (a->not_discarded > b->not_discarded) return 1;
+    if (a->is_hot > b->is_hot) return -1;
+    if (a->is_hot < b->is_hot) return 1;
     if (a->instructions_id < b->instructions_id) return -1;
     if (a->instructions_id > b->instructions_id) return 1;
     return 0;
@@ -2770,9 +2779,26 @@ class CodeSerializationCluster : public SerializationCluster {
     info.code = code;
     info.instructions_id = instructions_id;
     info.not_discarded = Code::IsDiscarded(code) ? 0 : 1;
+    info.is_hot = IsProfiledHot(code) ? 1 : 0;
     order_list->Add(info);
   }
 
+  static bool IsProfiledHot(CodePtr code) {
+#if defined(DART_PRECOMPILER)
+    if (!FLAG_precompiled_mode) return false;
+    const AotProfile* profile = AotProfile::Get();
+    if (profile == nullptr) return false;
+    const ObjectPtr owner = WeakSerializationReference::Unwrap(
+        code->untag()->owner());
+    if (!owner->IsFunction()) return false;
+    const AotProfile::FunctionProfile* function_profile =
+        profile->Lookup(Function::Handle(static_cast<FunctionPtr>(owner)));
+    return (function_profile != nullptr) && function_profile->is_hot;
+#else
+    return false;
+#endif  // defined(DART_PRECOMPILER)
+  }
+
   static void Sort(Serializer* s, GrowableArray<CodePtr>* codes) {
     GrowableArray<CodeOrderInfo> order_list;
     IntMap<intptr_t> order_map;
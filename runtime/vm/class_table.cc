@@ -76,6 +76,7 @@ void ClassTable::Register(const Class& cls) {
   cls.set_id(cid);
   classes_.At<kClassIndex>(cid) = cls.ptr();
   classes_.At<kSizeIndex>(cid) = static_cast<int32_t>(instance_size);
+  classes_.At<kPretenureIndex>(cid) = 0;
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
   classes_.At<kClassNameIndex>(cid) = nullptr;
 #endif  // !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
@@ -395,6 +395,17 @@ class ClassTable : public MallocAllocated {
     classes_.At<kUnboxedFieldBitmapIndex>(cid) = map;
   }
 
+  // Whether instances of [cid] should be allocated directly in old space.
+  // Driven by the scavenger's survival feedback.
+  bool ShouldPretenure(intptr_t cid) const {
+    return !IsTopLevelCid(cid) && (classes_.At<kPretenureIndex>(cid) != 0);
+  }
+
+  void SetPretenure(intptr_t cid, bool pretenure) {
+    ASSERT(!IsTopLevelCid(cid));
+    classes_.At<kPretenureIndex>(cid) = pretenure ? 1 : 0;
+  }
+
 #if !defined(PRODUCT)
   bool ShouldTraceAllocationFor(intptr_t cid) {
     return !IsTopLevelCid(cid) &&
@@ -559,6 +570,7 @@ class ClassTable : public MallocAllocated {
     kClassIndex = 0,
     kSizeIndex,
     kUnboxedFieldBitmapIndex,
+    kPretenureIndex,
 #if !defined(PRODUCT)
     kAllocationTracingStateIndex,
 #endif
@@ -573,6 +585,7 @@ class ClassTable : public MallocAllocated {
                   uint32_t,
                   UnboxedFieldBitmap,
                   uint8_t,
+                  uint8_t,
                   const char*>
       classes_;
 #elif defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
@@ -580,10 +593,15 @@ class ClassTable : public MallocAllocated {
                   ClassPtr,
                   uint32_t,
                   UnboxedFieldBitmap,
+                  uint8_t,
                   const char*>
       classes_;
 #else
-  CidIndexedTable<ClassIdTagType, ClassPtr, uint32_t, UnboxedFieldBitmap>
+  CidIndexedTable<ClassIdTagType,
+                  ClassPtr,
+                  uint32_t,
+                  UnboxedFieldBitmap,
+                  uint8_t>
       classes_;
 #endif
 
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "vm/bit_vector.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/flow_graph_compiler.h"
@@ -976,6 +977,70 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
     instr->ReplaceWith(call, current_iterator());
     return;
   }
+
+  if (TryDevirtualizeUsingProfile(instr)) {
+    return;
+  }
+}
+
+// Uses the receiver classes which the training run of a profile observed
+// at the call site to create a polymorphic call which is not complete. The
+// inliner inlines its frequent targets behind class id checks and calls the
+// remaining targets through a normal instance call.
+bool AotCallSpecializer::TryDevirtualizeUsingProfile(InstanceCallInstr* instr) {
+  const AotProfile* aot_profile = AotProfile::Get();
+  if ((aot_profile == nullptr) || !instr->HasICData()) {
+    return false;
+  }
+  // The generic fallback of an already devirtualized call site keeps the
+  // ICData created below.
+  if (instr->ic_data()->rebind_rule() != ICData::kInstance) {
+    return false;
+  }
+  // Calls of inlined functions keep the ICData of their own function.
+  const Function& owner = Function::Handle(Z, instr->ic_data()->Owner());
+  const AotProfile::FunctionProfile* profile = aot_profile->Lookup(owner);
+  if (profile == nullptr) {
+    return false;
+  }
+  const AotProfile::CallSite* site =
+      profile->LookupCallSite(instr->token_pos(), instr->function_name());
+  if (site == nullptr) {
+    return false;
+  }
+
+  const Array& args_desc_array =
+      Array::Handle(Z, instr->GetArgumentsDescriptor());
+  const ICData& ic_data = ICData::Handle(
+      Z, ICData::New(flow_graph()->function(), instr->function_name(),
+                     args_desc_array, DeoptId::kNone,
+                     /*num_args_tested=*/1, ICData::kOptimized));
+  Class& cls = Class::Handle(Z);
+  Function& target = Function::Handle(Z);
+  for (const AotProfile::Receiver& receiver : site->receivers) {
+    if ((receiver.cid == kIllegalCid) || (receiver.count <= 0) ||
+        ic_data.HasReceiverClassId(receiver.cid)) {
+      continue;
+    }
+    cls = isolate_group()->class_table()->At(receiver.cid);
+    target = instr->ResolveForReceiverClass(cls, /*allow_add=*/false);
+    if (target.IsNull() || target.IsInvokeFieldDispatcher() ||
+        target.IsNoSuchMethodDispatcher()) {
+      continue;
+    }
+    ic_data.AddReceiverCheck(
+        receiver.cid, target,
+        Utils::Minimum<int64_t>(receiver.count, kSmiMax));
+  }
+  if (ic_data.NumberOfChecksIs(0)) {
+    return false;
+  }
+
+  const CallTargets* targets = CallTargets::Create(Z, ic_data);
+  PolymorphicInstanceCallInstr* call = PolymorphicInstanceCallInstr::FromCall(
+      Z, instr, *targets, /*complete=*/false);
+  instr->ReplaceWith(call, current_iterator());
+  return true;
 }
 
 void AotCallSpecializer::VisitStaticCall(StaticCallInstr* instr) {
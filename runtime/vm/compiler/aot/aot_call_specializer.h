@@ -77,6 +77,10 @@ class AotCallSpecializer : public CallSpecializer {
   bool TryExpandCallThroughGetter(const Class& receiver_class,
                                   InstanceCallInstr* call);
 
+  // Replace an instance call by a polymorphic call over the receiver
+  // classes which the profile of a training run recorded for it.
+  bool TryDevirtualizeUsingProfile(InstanceCallInstr* call);
+
   Definition* TryOptimizeDivisionOperation(TemplateDartCall<0>* instr,
                                            Token::Kind op_kind,
                                            Value* left_value,
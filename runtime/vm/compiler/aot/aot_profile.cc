@@ -0,0 +1,446 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/aot_profile.h"
+
+#include <errno.h>  // NOLINT
+#include <stdlib.h>
+
+#include "platform/text_buffer.h"
+#include "vm/class_table.h"
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/isolate.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/program_visitor.h"
+
+namespace dart {
+
+DEFINE_FLAG(charp,
+            write_aot_profile_to,
+            nullptr,
+            "Write receiver classes and branch counts observed by this run "
+            "into the given file when an isolate exits, to be used with "
+            "--read_aot_profile_from.");
+
+#if defined(DART_PRECOMPILER)
+DEFINE_FLAG(charp,
+            read_aot_profile_from,
+            nullptr,
+            "Guide AOT compilation by the profile of a training run written "
+            "with --write_aot_profile_to.");
+#endif  // defined(DART_PRECOMPILER)
+
+DECLARE_FLAG(int, optimization_counter_threshold);
+
+const char* AotProfile::FunctionKey(Zone* zone, const Function& function) {
+  const auto& cls = Class::Handle(zone, function.Owner());
+  const auto& lib = Library::Handle(zone, cls.library());
+  const char* url =
+      lib.IsNull() ? "" : String::Handle(zone, lib.url()).ToCString();
+  return OS::SCreate(zone, "%s\t%s\t%" Pd32, url,
+                     function.QualifiedScrubbedNameCString(),
+                     function.token_pos().Serialize());
+}
+
+const char* AotProfile::ClassKey(Zone* zone, const Class& cls) {
+  const auto& lib = Library::Handle(zone, cls.library());
+  const char* url =
+      lib.IsNull() ? "" : String::Handle(zone, lib.url()).ToCString();
+  return OS::SCreate(zone, "%s\t%s", url, cls.ScrubbedNameCString());
+}
+
+AotProfile::FunctionProfile::~FunctionProfile() {
+  for (CallSite* site : call_sites) {
+    free(const_cast<char*>(site->selector));
+    for (const Receiver& receiver : site->receivers) {
+      free(const_cast<char*>(receiver.class_key));
+    }
+    delete site;
+  }
+}
+
+AotProfile::~AotProfile() {
+  for (FunctionProfile* function : functions_) {
+    delete function;
+  }
+  auto it = function_indices_.GetIterator();
+  while (auto pair = it.Next()) {
+    free(const_cast<char*>(pair->key));
+  }
+}
+
+const AotProfile::CallSite* AotProfile::FunctionProfile::LookupCallSite(
+    TokenPosition token_pos,
+    const String& selector) const {
+  if (call_sites.is_empty() || !token_pos.IsReal()) {
+    return nullptr;
+  }
+  const char* name = String::ScrubName(selector);
+  for (CallSite* site : call_sites) {
+    if ((site->token_pos == token_pos.Serialize()) &&
+        (strcmp(site->selector, name) == 0)) {
+      return site;
+    }
+  }
+  return nullptr;
+}
+
+namespace {
+
+// Writes a function record, followed by the receiver classes seen by the
+// instance calls of the unoptimized code and its edge counters.
+class ProfileWriter : public FunctionVisitor {
+ public:
+  ProfileWriter(Zone* zone, BaseTextBuffer* buffer)
+      : zone_(zone),
+        buffer_(buffer),
+        class_table_(IsolateGroup::Current()->class_table()),
+        ic_data_array_(Array::Handle(zone)),
+        edge_counters_(Array::Handle(zone)),
+        edge_counter_deopt_ids_(Array::Handle(zone)),
+        code_(Code::Handle(zone)),
+        descriptors_(PcDescriptors::Handle(zone)),
+        ic_data_(ICData::Handle(zone)),
+        selector_(String::Handle(zone)),
+        cls_(Class::Handle(zone)) {}
+
+  void VisitFunction(const Function& function) {
+    if (!function.WasExecuted()) {
+      return;
+    }
+    ic_data_array_ = function.ic_data_array();
+    if (ic_data_array_.IsNull()) {
+      return;
+    }
+    const intptr_t usage_count =
+        Utils::Maximum<intptr_t>(0, function.usage_counter());
+    const bool is_hot = function.HasOptimizedCode() ||
+                        (usage_count >= FLAG_optimization_counter_threshold);
+    buffer_->Printf("function\t%" Pd "\t%d\t%s\n", usage_count,
+                    is_hot ? 1 : 0, AotProfile::FunctionKey(zone_, function));
+
+    WriteCallSites(function);
+
+    edge_counters_ ^=
+        ic_data_array_.At(Function::ICDataArrayIndices::kEdgeCounters);
+    edge_counter_deopt_ids_ ^=
+        ic_data_array_.At(Function::ICDataArrayIndices::kEdgeCounterDeoptIds);
+    // Functions compiled before the flag was set have no deopt ids.
+    if (!edge_counters_.IsNull() && !edge_counter_deopt_ids_.IsNull() &&
+        (edge_counters_.Length() == edge_counter_deopt_ids_.Length())) {
+      buffer_->AddString("edges");
+      for (intptr_t i = 0; i < edge_counters_.Length(); ++i) {
+        buffer_->Printf(
+            "\t%" Pd "\t%" Pd,
+            Smi::Value(Smi::RawCast(edge_counter_deopt_ids_.At(i))),
+            Smi::Value(Smi::RawCast(edge_counters_.At(i))));
+      }
+      buffer_->AddString("\n");
+    }
+  }
+
+ private:
+  void WriteCallSites(const Function& function) {
+    // ICData only knows its deopt id, the token positions of the calls come
+    // from the descriptors of the unoptimized code.
+    code_ = function.unoptimized_code();
+    if (code_.IsNull()) {
+      return;
+    }
+    token_positions_.Clear();
+    descriptors_ = code_.pc_descriptors();
+    PcDescriptors::Iterator it(descriptors_, UntaggedPcDescriptors::kIcCall);
+    while (it.MoveNext()) {
+      const intptr_t deopt_id = it.DeoptId();
+      while (token_positions_.length() <= deopt_id) {
+        token_positions_.Add(TokenPosition::kNoSource);
+      }
+      token_positions_[deopt_id] = it.TokenPos();
+    }
+
+    for (intptr_t i = Function::ICDataArrayIndices::kFirstICData;
+         i < ic_data_array_.Length(); ++i) {
+      ic_data_ ^= ic_data_array_.At(i);
+      if ((ic_data_.rebind_rule() != ICData::kInstance) ||
+          (ic_data_.NumberOfChecks() == 0) ||
+          (ic_data_.deopt_id() >= token_positions_.length()) ||
+          !token_positions_[ic_data_.deopt_id()].IsReal()) {
+        continue;
+      }
+      const TokenPosition token_pos = token_positions_[ic_data_.deopt_id()];
+      selector_ = ic_data_.target_name();
+      // Calls testing two arguments have an entry per pair of classes.
+      ic_data_ = ic_data_.AsUnaryClassChecks();
+      buffer_->Printf("call\t%" Pd32 "\t%s", token_pos.Serialize(),
+                      String::ScrubName(selector_));
+      for (intptr_t j = 0; j < ic_data_.NumberOfChecks(); ++j) {
+        const intptr_t count = ic_data_.GetCountAt(j);
+        if (count <= 0) {
+          continue;
+        }
+        cls_ = class_table_->At(ic_data_.GetReceiverClassIdAt(j));
+        buffer_->Printf("\t%s\t%" Pd, AotProfile::ClassKey(zone_, cls_),
+                        count);
+      }
+      buffer_->AddString("\n");
+    }
+  }
+
+  Zone* const zone_;
+  BaseTextBuffer* const buffer_;
+  ClassTable* const class_table_;
+  Array& ic_data_array_;
+  Array& edge_counters_;
+  Array& edge_counter_deopt_ids_;
+  Code& code_;
+  PcDescriptors& descriptors_;
+  ICData& ic_data_;
+  String& selector_;
+  Class& cls_;
+  GrowableArray<TokenPosition> token_positions_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProfileWriter);
+};
+
+}  // namespace
+
+void AotProfile::Write(Thread* thread, const char* filename) {
+  auto file_open = Dart::file_open_callback();
+  auto file_write = Dart::file_write_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_write == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.\n");
+    return;
+  }
+
+  TextBuffer buffer(64 * KB);
+  WriteTo(thread, &buffer);
+
+  void* file = file_open(filename, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to write AOT profile: %s\n", filename);
+    return;
+  }
+  file_write(buffer.buffer(), buffer.length(), file);
+  file_close(file);
+}
+
+void AotProfile::WriteTo(Thread* thread, BaseTextBuffer* buffer) {
+  buffer->AddString("# Dart AOT profile\n");
+  ProfileWriter writer(thread->zone(), buffer);
+  ProgramVisitor::WalkProgram(thread->zone(), thread->isolate_group(),
+                              &writer);
+}
+
+#if defined(DART_PRECOMPILER)
+
+AotProfile* AotProfile::profile_ = nullptr;
+
+void AotProfile::Init() {
+  ASSERT(profile_ == nullptr);
+  if (FLAG_read_aot_profile_from != nullptr) {
+    profile_ = Read(FLAG_read_aot_profile_from);
+  }
+}
+
+void AotProfile::Cleanup() {
+  delete profile_;
+  profile_ = nullptr;
+}
+
+AotProfile* AotProfile::Read(const char* filename) {
+  auto file_open = Dart::file_open_callback();
+  auto file_read = Dart::file_read_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_read == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.\n");
+    return nullptr;
+  }
+  void* file = file_open(filename, /*write=*/false);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to read AOT profile: %s\n", filename);
+    return nullptr;
+  }
+  uint8_t* data = nullptr;
+  intptr_t length = -1;
+  file_read(&data, &length, file);
+  file_close(file);
+  if ((data == nullptr) || (length < 0)) {
+    OS::PrintErr("warning: Failed to read AOT profile: %s\n", filename);
+    free(data);
+    return nullptr;
+  }
+
+  // Parse a NUL-terminated copy which is split into fields in place.
+  char* contents = reinterpret_cast<char*>(malloc(length + 1));
+  memmove(contents, data, length);
+  contents[length] = '\0';
+  free(data);
+
+  AotProfile* profile = Parse(contents);
+  if (profile == nullptr) {
+    OS::PrintErr("warning: Malformed AOT profile: %s\n", filename);
+  }
+  free(contents);
+  return profile;
+}
+
+// Returns the field at the cursor and advances the cursor past it, or
+// returns nullptr at the end of the line.
+static char* NextField(char** cursor) {
+  char* field = *cursor;
+  if (field == nullptr) {
+    return nullptr;
+  }
+  char* end = strchr(field, '\t');
+  if (end != nullptr) {
+    *end = '\0';
+    *cursor = end + 1;
+  } else {
+    *cursor = nullptr;
+  }
+  return field;
+}
+
+static bool ParseInt64(const char* field, int64_t* value) {
+  if ((field == nullptr) || (*field == '\0')) {
+    return false;
+  }
+  char* end = nullptr;
+  errno = 0;
+  *value = strtoll(field, &end, 10);
+  return (errno == 0) && (*end == '\0');
+}
+
+AotProfile* AotProfile::Parse(char* contents) {
+  AotProfile* profile = new AotProfile();
+  if (!profile->ParseRecords(contents)) {
+    delete profile;
+    return nullptr;
+  }
+  return profile;
+}
+
+bool AotProfile::ParseRecords(char* contents) {
+  FunctionProfile* current = nullptr;
+  char* line = contents;
+  while (line != nullptr) {
+    char* next = strchr(line, '\n');
+    if (next != nullptr) {
+      *next++ = '\0';
+    }
+    const intptr_t length = strlen(line);
+    if ((length > 0) && (line[length - 1] == '\r')) {
+      line[length - 1] = '\0';
+    }
+    if ((*line == '\0') || (*line == '#')) {
+      line = next;
+      continue;
+    }
+
+    char* cursor = line;
+    const char* tag = NextField(&cursor);
+    int64_t value = 0;
+    if (strcmp(tag, "function") == 0) {
+      current = new FunctionProfile();
+      functions_.Add(current);
+      if (!ParseInt64(NextField(&cursor), &current->usage_count) ||
+          !ParseInt64(NextField(&cursor), &value) || (cursor == nullptr)) {
+        return false;
+      }
+      current->is_hot = (value != 0);
+      // The rest of the line is the function key.
+      if (function_indices_.LookupValue(cursor) ==
+          CStringIntMapKeyValueTrait::kNoValue) {
+        function_indices_.Insert(
+            {Utils::StrDup(cursor), functions_.length() - 1});
+      }
+    } else if (strcmp(tag, "call") == 0) {
+      if ((current == nullptr) || !ParseInt64(NextField(&cursor), &value) ||
+          (value < kMinInt32) || (value > kMaxInt32)) {
+        return false;
+      }
+      const char* selector = NextField(&cursor);
+      if (selector == nullptr) {
+        return false;
+      }
+      CallSite* site = new CallSite();
+      site->token_pos = static_cast<int32_t>(value);
+      site->selector = Utils::StrDup(selector);
+      current->call_sites.Add(site);
+      while (cursor != nullptr) {
+        const char* url = NextField(&cursor);
+        const char* name = NextField(&cursor);
+        if ((name == nullptr) || !ParseInt64(NextField(&cursor), &value) ||
+            (value < 0)) {
+          return false;
+        }
+        site->receivers.Add(
+            {Utils::SCreate("%s\t%s", url, name), value, kIllegalCid});
+      }
+    } else if (strcmp(tag, "edges") == 0) {
+      if ((current == nullptr) || !current->edge_counts.is_empty()) {
+        return false;
+      }
+      while (cursor != nullptr) {
+        int64_t deopt_id = 0;
+        if (!ParseInt64(NextField(&cursor), &deopt_id) ||
+            !ParseInt64(NextField(&cursor), &value) || (deopt_id < 0) ||
+            (deopt_id > kMaxInt32) || (value < 0)) {
+          return false;
+        }
+        current->edge_counts.Add({static_cast<intptr_t>(deopt_id), value});
+      }
+    } else {
+      return false;
+    }
+    line = next;
+  }
+  return true;
+}
+
+void AotProfile::ResolveClassIds(Thread* thread) {
+  Zone* zone = thread->zone();
+  ClassTable* class_table = thread->isolate_group()->class_table();
+  CStringIntMap class_ids(zone);
+  auto& cls = Class::Handle(zone);
+  for (intptr_t cid = kIllegalCid + 1; cid < class_table->NumCids(); ++cid) {
+    if (!class_table->HasValidClassAt(cid)) {
+      continue;
+    }
+    cls = class_table->At(cid);
+    const char* key = ClassKey(zone, cls);
+    if (class_ids.LookupValue(key) == CStringIntMapKeyValueTrait::kNoValue) {
+      class_ids.Insert({key, cid});
+    }
+  }
+  for (FunctionProfile* function : functions_) {
+    for (CallSite* site : function->call_sites) {
+      for (Receiver& receiver : site->receivers) {
+        const intptr_t cid = class_ids.LookupValue(receiver.class_key);
+        receiver.cid =
+            (cid == CStringIntMapKeyValueTrait::kNoValue) ? kIllegalCid : cid;
+      }
+    }
+  }
+}
+
+const AotProfile::FunctionProfile* AotProfile::Lookup(
+    const Function& function) const {
+  const intptr_t index =
+      function_indices_.LookupValue(FunctionKey(Thread::Current()->zone(),
+                                                function));
+  if (index == CStringIntMapKeyValueTrait::kNoValue) {
+    return nullptr;
+  }
+  return functions_[index];
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
@@ -0,0 +1,130 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
+#define RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "platform/growable_array.h"
+#include "vm/allocation.h"
+#include "vm/hash_map.h"
+#include "vm/token_position.h"
+
+namespace dart {
+
+class BaseTextBuffer;
+class Class;
+class Function;
+class String;
+class Thread;
+
+// Type feedback and branch counts of a training run, used to guide AOT
+// compilation.
+//
+// A JIT run started with --write_aot_profile_to writes the profile when its
+// isolate group shuts down, and gen_snapshot reads it with
+// --read_aot_profile_from. The profile is a text file with one tab separated
+// record per line:
+//
+//   function <usage count> <hot> <function key>
+//   call <token pos> <selector> (<library url> <class name> <count>)*
+//   edges (<block deopt id> <count>)*
+//
+// Call and edges records belong to the preceding function record. Functions
+// and classes are identified by name since their ids differ between runs,
+// and call sites by their token position and (scrubbed) selector. Edge
+// counts are keyed by the deopt id of their block and are only used if each
+// block of the compiled graph matches exactly one of them.
+class AotProfile : public MallocAllocated {
+ public:
+  struct Receiver {
+    const char* class_key;
+    int64_t count;
+    // Class id of the receiver class in the program being compiled, or
+    // kIllegalCid if it does not exist (see ResolveClassIds).
+    intptr_t cid;
+  };
+
+  struct CallSite : public MallocAllocated {
+    int32_t token_pos;
+    const char* selector;
+    MallocGrowableArray<Receiver> receivers;
+  };
+
+  struct EdgeCount {
+    intptr_t block_deopt_id;
+    int64_t count;
+  };
+
+  struct FunctionProfile : public MallocAllocated {
+    ~FunctionProfile();
+
+    int64_t usage_count = 0;
+    // Whether the training run optimized the function or would have.
+    bool is_hot = false;
+    MallocGrowableArray<CallSite*> call_sites;
+    MallocGrowableArray<EdgeCount> edge_counts;
+
+    const CallSite* LookupCallSite(TokenPosition token_pos,
+                                   const String& selector) const;
+  };
+
+  ~AotProfile();
+
+  // Writes the profile of all functions of the current isolate group.
+  static void Write(Thread* thread, const char* filename);
+  static void WriteTo(Thread* thread, BaseTextBuffer* buffer);
+
+#if defined(DART_PRECOMPILER)
+  // Reads the profile given with --read_aot_profile_from, if any. The
+  // profile lives until the VM shuts down, since both the precompiler and
+  // the snapshot writer use it.
+  static void Init();
+  static void Cleanup();
+
+  // Returns the profile read by Init, or nullptr.
+  static AotProfile* Get() { return profile_; }
+
+#if defined(TESTING)
+  static void SetForTesting(AotProfile* profile) { profile_ = profile; }
+#endif
+
+  // Parses the contents of a profile file, which are modified in place.
+  // Returns nullptr if they are malformed.
+  static AotProfile* Parse(char* contents);
+
+  // Maps the receiver classes of all call sites to the class ids of the
+  // current isolate group.
+  void ResolveClassIds(Thread* thread);
+
+  // Returns the profile of the given function, or nullptr.
+  const FunctionProfile* Lookup(const Function& function) const;
+#endif  // defined(DART_PRECOMPILER)
+
+  static const char* FunctionKey(Zone* zone, const Function& function);
+  static const char* ClassKey(Zone* zone, const Class& cls);
+
+ private:
+  AotProfile() {}
+
+#if defined(DART_PRECOMPILER)
+  static AotProfile* Read(const char* filename);
+  bool ParseRecords(char* contents);
+
+  static AotProfile* profile_;
+#endif  // defined(DART_PRECOMPILER)
+
+  MallocGrowableArray<FunctionProfile*> functions_;
+  // Maps function keys to indices into functions_.
+  MallocDirectChainedHashMap<CStringIntMapKeyValueTrait> function_indices_;
+
+  DISALLOW_COPY_AND_ASSIGN(AotProfile);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
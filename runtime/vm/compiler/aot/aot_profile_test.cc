@@ -0,0 +1,224 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/aot_profile.h"
+
+#include "platform/text_buffer.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(DART_PRECOMPILER)
+
+DECLARE_FLAG(charp, write_aot_profile_to);
+
+static bool ParsesProfile(const char* contents) {
+  char* copy = Utils::StrDup(contents);
+  AotProfile* profile = AotProfile::Parse(copy);
+  free(copy);
+  const bool is_valid = (profile != nullptr);
+  delete profile;
+  return is_valid;
+}
+
+ISOLATE_UNIT_TEST_CASE(AotProfile_ParseMalformed) {
+  EXPECT(ParsesProfile(""));
+  EXPECT(ParsesProfile("# Dart AOT profile\n\n"));
+  EXPECT(ParsesProfile("function\t10\t1\tfile:///a.dart\tfoo\t42\r\n"
+                       "call\t50\tbar\tfile:///a.dart\tA\t7\n"
+                       "call\t60\tbaz\n"
+                       "edges\t1\t10\t5\t3\n"));
+
+  // Unknown records and records which do not follow a function record.
+  EXPECT(!ParsesProfile("method\t10\t1\tfile:///a.dart\tfoo\t42\n"));
+  EXPECT(!ParsesProfile("call\t50\tbar\n"));
+  EXPECT(!ParsesProfile("edges\t1\t10\n"));
+
+  // Malformed function records.
+  EXPECT(!ParsesProfile("function\t10\t1\n"));
+  EXPECT(!ParsesProfile("function\tten\t1\tfile:///a.dart\tfoo\t42\n"));
+  EXPECT(!ParsesProfile("function\t10\t1x\tfile:///a.dart\tfoo\t42\n"));
+  EXPECT(!ParsesProfile(
+      "function\t99999999999999999999\t1\tfile:///a.dart\tfoo\t42\n"));
+
+  // Malformed call records.
+  EXPECT(!ParsesProfile("function\t10\t1\tfile:///a.dart\tfoo\t42\n"
+                        "call\t50\n"));
+  EXPECT(!ParsesProfile("function\t10\t1\tfile:///a.dart\tfoo\t42\n"
+                        "call\t4294967296\tbar\n"));
+  EXPECT(!ParsesProfile("function\t10\t1\tfile:///a.dart\tfoo\t42\n"
+                        "call\t50\tbar\tfile:///a.dart\tA\n"));
+  EXPECT(!ParsesProfile("function\t10\t1\tfile:///a.dart\tfoo\t42\n"
+                        "call\t50\tbar\tfile:///a.dart\tA\t-7\n"));
+
+  // Malformed edges records.
+  EXPECT(!ParsesProfile("function\t10\t1\tfile:///a.dart\tfoo\t42\n"
+                        "edges\t1\t10\t5\n"));
+  EXPECT(!ParsesProfile("function\t10\t1\tfile:///a.dart\tfoo\t42\n"
+                        "edges\t1\t10\t\n"));
+  EXPECT(!ParsesProfile("function\t10\t1\tfile:///a.dart\tfoo\t42\n"
+                        "edges\t1\t-10\n"));
+  EXPECT(!ParsesProfile("function\t10\t1\tfile:///a.dart\tfoo\t42\n"
+                        "edges\t-1\t10\n"));
+  EXPECT(!ParsesProfile("function\t10\t1\tfile:///a.dart\tfoo\t42\n"
+                        "edges\t1\t10\n"
+                        "edges\t1\t10\n"));
+}
+
+static const char* kPolymorphicScript = R"(
+  abstract interface class A {
+    int f();
+  }
+  class B implements A {
+    int f() => 1;
+  }
+  class C implements A {
+    int f() => 2;
+  }
+  @pragma('vm:never-inline')
+  int foo(A a, int n) {
+    int sum = 0;
+    for (int i = 0; i < n; i++) {
+      sum += a.f();
+    }
+    return sum;
+  }
+  main() {
+    for (int i = 0; i < 3; i++) {
+      foo(B(), 2);
+    }
+    foo(C(), 1);
+  }
+)";
+
+// Runs the script, then writes and parses back the profile of the run.
+static AotProfile* ProfileOf(Thread* thread, const Library& root_library) {
+  Invoke(root_library, "main");
+  TextBuffer buffer(1 * KB);
+  AotProfile::WriteTo(thread, &buffer);
+  char* contents = buffer.Steal();
+  AotProfile* profile = AotProfile::Parse(contents);
+  free(contents);
+  return profile;
+}
+
+ISOLATE_UNIT_TEST_CASE(AotProfile_WriteAndRead) {
+  // Block deopt ids are only recorded when the profile is written.
+  SetFlagScope<const char*> sfs(&FLAG_write_aot_profile_to, "unused");
+  const auto& root_library =
+      Library::Handle(LoadTestScript(kPolymorphicScript));
+  AotProfile* profile = ProfileOf(thread, root_library);
+  EXPECT(profile != nullptr);
+  if (profile == nullptr) return;
+
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  const AotProfile::FunctionProfile* foo = profile->Lookup(function);
+  EXPECT(foo != nullptr);
+  if (foo == nullptr) {
+    delete profile;
+    return;
+  }
+  EXPECT(foo->usage_count > 0);
+
+  const AotProfile::CallSite* call_f = nullptr;
+  for (const AotProfile::CallSite* site : foo->call_sites) {
+    if (strcmp(site->selector, "f") == 0) {
+      call_f = site;
+    }
+  }
+  EXPECT(call_f != nullptr);
+  if (call_f != nullptr) {
+    EXPECT_EQ(2, call_f->receivers.length());
+    for (const AotProfile::Receiver& receiver : call_f->receivers) {
+      const char* name = strrchr(receiver.class_key, '\t') + 1;
+      if (strcmp(name, "B") == 0) {
+        EXPECT_EQ(6, receiver.count);
+      } else {
+        EXPECT_STREQ("C", name);
+        EXPECT_EQ(1, receiver.count);
+      }
+    }
+  }
+
+  // There is a count for every block of the unoptimized code, and the
+  // function entry was counted once per call.
+  const auto& ic_data_array = Array::Handle(function.ic_data_array());
+  auto& deopt_ids = Array::Handle();
+  deopt_ids ^=
+      ic_data_array.At(Function::ICDataArrayIndices::kEdgeCounterDeoptIds);
+  EXPECT(!deopt_ids.IsNull());
+  EXPECT_EQ(deopt_ids.Length(), foo->edge_counts.length());
+  bool has_entry_count = false;
+  for (intptr_t i = 0; i < foo->edge_counts.length(); ++i) {
+    if (i < deopt_ids.Length()) {
+      EXPECT_EQ(Smi::Value(Smi::RawCast(deopt_ids.At(i))),
+                foo->edge_counts[i].block_deopt_id);
+    }
+    has_entry_count |= (foo->edge_counts[i].count == 4);
+  }
+  EXPECT(has_entry_count);
+
+  delete profile;
+}
+
+static PolymorphicInstanceCallInstr* FindPolymorphicCall(
+    FlowGraph* flow_graph) {
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (auto call = it.Current()->AsPolymorphicInstanceCall()) {
+        return call;
+      }
+    }
+  }
+  return nullptr;
+}
+
+// The receiver classes of a.f() seen by the training run turn the call into
+// a polymorphic call which is not complete, as interface A may have other
+// implementations.
+ISOLATE_UNIT_TEST_CASE(AotProfile_DevirtualizeCall) {
+  const auto& root_library =
+      Library::Handle(LoadTestScript(kPolymorphicScript));
+  AotProfile* profile = ProfileOf(thread, root_library);
+  EXPECT(profile != nullptr);
+  if (profile == nullptr) return;
+  profile->ResolveClassIds(thread);
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+
+  {
+    TestPipeline pipeline(function, CompilerPass::kAOT);
+    FlowGraph* flow_graph = pipeline.RunPasses({
+        CompilerPass::kComputeSSA,
+        CompilerPass::kApplyICData,
+    });
+    EXPECT(FindPolymorphicCall(flow_graph) == nullptr);
+  }
+
+  AotProfile::SetForTesting(profile);
+  {
+    TestPipeline pipeline(function, CompilerPass::kAOT);
+    FlowGraph* flow_graph = pipeline.RunPasses({
+        CompilerPass::kComputeSSA,
+        CompilerPass::kApplyICData,
+    });
+    PolymorphicInstanceCallInstr* call = FindPolymorphicCall(flow_graph);
+    EXPECT(call != nullptr);
+    if (call != nullptr) {
+      EXPECT(!call->complete());
+      EXPECT_EQ(2, call->targets().length());
+      EXPECT_EQ(7, call->targets().AggregateCallCount());
+    }
+  }
+  AotProfile::SetForTesting(nullptr);
+  delete profile;
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
@@ -16,8 +16,10 @@
 #include "vm/compiler/aot/precompiler_tracer.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
+#include "vm/compiler/backend/block_scheduler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/constant_propagator.h"
+#include "vm/compiler/backend/escape_analysis.h"
 #include "vm/compiler/backend/flow_graph.h"
 #include "vm/compiler/backend/flow_graph_compiler.h"
 #include "vm/compiler/backend/il_printer.h"
@@ -27,6 +29,7 @@
 #include "vm/compiler/backend/redundancy_elimination.h"
 #include "vm/compiler/backend/type_propagator.h"
 #include "vm/compiler/cha.h"
+#include "vm/compiler/compilation_report.h"
 #include "vm/compiler/compiler_pass.h"
 #include "vm/compiler/compiler_state.h"
 #include "vm/compiler/compiler_timings.h"
@@ -423,6 +426,8 @@ Precompiler::Precompiler(Thread* thread)
       consts_to_retain_(),
       seen_table_selectors_(),
       api_uses_(),
+      escape_summaries_(),
+      partial_inlining_sizes_(),
       error_(Error::Handle()),
       get_runtime_type_is_unique_(false) {
   ASSERT(Precompiler::singleton_ == nullptr);
@@ -479,6 +484,13 @@ void Precompiler::DoCompileAll() {
 
       ClassFinalizer::SortClasses();
 
+      // Receiver classes of the profile are mapped to class ids, which do
+      // not change anymore during compilation.
+      profile_ = AotProfile::Get();
+      if (profile_ != nullptr) {
+        profile_->ResolveClassIds(T);
+      }
+
       // Collects type usage information which allows us to decide when/how to
       // optimize runtime type tests.
       TypeUsageInfo type_usage_info(T);
@@ -596,6 +608,7 @@ void Precompiler::DoCompileAll() {
         PRECOMPILER_TIMER_SCOPE(this, Drop);
 
         DropFunctions();
+        MarkClassesWithOnlyFinalInstanceFields();
         DropFields();
         DropTransitiveUserDefinedConstants();
         TraceTypesFromRetainedClasses();
@@ -1464,6 +1477,30 @@ bool Precompiler::IsHitByTableSelector(const Function& function) {
   return seen_table_selectors_.HasKey(selector_id);
 }
 
+void Precompiler::RecordFunctionSummary(FunctionSummaryMap* map,
+                                        const Function& function,
+                                        uint64_t value) {
+  if (auto pair = map->Lookup(&function)) {
+    pair->value = value;
+    return;
+  }
+  map->Insert(FunctionSummaryKeyValueTrait::Pair(
+      &Function::ZoneHandle(Z, function.ptr()), value));
+}
+
+void Precompiler::RecordEscapeSummary(const Function& function,
+                                      uint64_t summary) {
+  // Functions can be compiled more than once if the global object pool
+  // grew underneath them.
+  RecordFunctionSummary(&escape_summaries_, function, summary);
+}
+
+void Precompiler::RecordPartialInliningSize(const Function& function,
+                                            intptr_t size) {
+  ASSERT(size > 0);
+  RecordFunctionSummary(&partial_inlining_sizes_, function, size);
+}
+
 void Precompiler::AddApiUse(const Object& obj) {
   api_uses_.Insert(&Object::ZoneHandle(Z, obj.ptr()));
 }
@@ -2339,6 +2376,44 @@ void Precompiler::DropFunctions() {
   IG->object_store()->set_closure_functions_table(Object::null_array());
 }
 
+// The runtime cannot inspect fields which are dropped, so record which classes
+// only have final and non-late instance fields (see
+// Class::HasOnlyFinalInstanceFieldsBit).
+void Precompiler::MarkClassesWithOnlyFinalInstanceFields() {
+  HANDLESCOPE(T);
+  Class& cls = Class::Handle(Z);
+  Class& super = Class::Handle(Z);
+  Array& fields = Array::Handle(Z);
+  Field& field = Field::Handle(Z);
+
+  SafepointWriteRwLocker ml(T, T->isolate_group()->program_lock());
+  ClassTable* class_table = IG->class_table();
+  const intptr_t num_cids = class_table->NumCids();
+  for (intptr_t cid = kNumPredefinedCids; cid < num_cids; cid++) {
+    if (!class_table->IsValidIndex(cid)) continue;
+    if (!class_table->HasValidClassAt(cid)) continue;
+    cls = class_table->At(cid);
+    bool only_final = true;
+    for (super = cls.ptr(); only_final && (super.id() != kInstanceCid);
+         super = super.SuperClass(class_table)) {
+      if (super.id() < kNumPredefinedCids) {
+        only_final = false;
+        break;
+      }
+      fields = super.fields();
+      for (intptr_t i = 0; i < fields.Length(); i++) {
+        field ^= fields.At(i);
+        if (field.is_static()) continue;
+        if (!field.is_final() || field.is_late()) {
+          only_final = false;
+          break;
+        }
+      }
+    }
+    cls.set_has_only_final_instance_fields(only_final);
+  }
+}
+
 void Precompiler::DropFields() {
   HANDLESCOPE(T);
   Library& lib = Library::Handle(Z);
@@ -3612,6 +3687,10 @@ bool PrecompileParsedFunctionHelper::Compile() {
                                /*is_optimizing=*/true,
                                CompilerState::ShouldTrace(function));
   compiler_state.set_function(function);
+  if (CompilationReport::IsEnabled()) {
+    compiler_state.set_report(new (zone) CompilationReport(
+        function, /*is_aot=*/true, /*is_optimizing=*/true));
+  }
 
   {
     ZoneGrowableArray<const ICData*>* ic_data_array =
@@ -3629,6 +3708,7 @@ bool PrecompileParsedFunctionHelper::Compile() {
   }
 
   flow_graph->PopulateWithICData(function);
+  BlockScheduler::AssignEdgeWeights(flow_graph);
 
   {
     TIMELINE_DURATION(thread(), CompilerVerbose, "OptimizationPasses");
@@ -3641,6 +3721,8 @@ bool PrecompileParsedFunctionHelper::Compile() {
   }
 
   ASSERT(precompiler_ != nullptr);
+  precompiler_->RecordEscapeSummary(function,
+                                    EscapeAnalysis::ComputeSummary(flow_graph));
 
   // When generating code in bare instruction mode all code objects
   // share the same global object pool. To reduce interleaving of
@@ -3652,7 +3734,12 @@ bool PrecompileParsedFunctionHelper::Compile() {
   // failure to commit object pool into the global object pool.
   GenerateNecessaryAllocationStubs(flow_graph);
 
-  return GenerateCode(flow_graph);
+  const bool success = GenerateCode(flow_graph);
+  if (success && (compiler_state.report() != nullptr)) {
+    compiler_state.report()->Finish(
+        Code::Handle(zone, function.CurrentCode()));
+  }
+  return success;
 }
 
 void Precompiler::CompileFunction(Precompiler* precompiler,
@@ -10,6 +10,7 @@
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 
 #include "vm/allocation.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/dispatch_table_generator.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/hash_map.h"
@@ -239,6 +240,34 @@ class InstanceKeyValueTrait {
 
 typedef DirectChainedHashMap<InstanceKeyValueTrait> InstanceSet;
 
+class FunctionSummaryKeyValueTrait {
+ public:
+  // Typedefs needed for the DirectChainedHashMap template.
+  typedef const Function* Key;
+  typedef uint64_t Value;
+
+  struct Pair {
+    Key key;
+    Value value;
+    Pair() : key(nullptr), value(0) {}
+    Pair(const Key key, const Value& value) : key(key), value(value) {}
+    Pair(const Pair& other) : key(other.key), value(other.value) {}
+    Pair& operator=(const Pair&) = default;
+  };
+
+  static Key KeyOf(Pair kv) { return kv.key; }
+
+  static Value ValueOf(Pair kv) { return kv.value; }
+
+  static inline uword Hash(Key key) { return key->Hash(); }
+
+  static inline bool IsKeyEqual(Pair pair, Key key) {
+    return pair.key->ptr() == key->ptr();
+  }
+};
+
+typedef DirectChainedHashMap<FunctionSummaryKeyValueTrait> FunctionSummaryMap;
+
 class Precompiler : public ValueObject {
  public:
   static ErrorPtr CompileAll();
@@ -279,6 +308,23 @@ class Precompiler : public ValueObject {
   Thread* thread() const { return thread_; }
   Zone* zone() const { return zone_; }
 
+  // Parameter escape summaries of compiled functions (see EscapeAnalysis).
+  void RecordEscapeSummary(const Function& function, uint64_t summary);
+  uint64_t EscapeSummaryFor(const Function& function) const {
+    return escape_summaries_.LookupValue(&function);
+  }
+
+  // Sizes of the fast paths of functions which are only partially inlined
+  // (see CallSiteInliner::OutlineColdPath).
+  void RecordPartialInliningSize(const Function& function, intptr_t size);
+  intptr_t PartialInliningSizeFor(const Function& function) const {
+    return partial_inlining_sizes_.LookupValue(&function);
+  }
+
+  // Profile of a training run given with --read_aot_profile_from, or
+  // nullptr.
+  const AotProfile* profile() const { return profile_; }
+
  private:
   static Precompiler* singleton_;
 
@@ -330,6 +376,9 @@ class Precompiler : public ValueObject {
   const char* MustRetainFunction(const Function& function);
   void AddApiUse(const Object& obj);
   bool HasApiUse(const Object& obj);
+  void RecordFunctionSummary(FunctionSummaryMap* map,
+                             const Function& function,
+                             uint64_t value);
 
   void ProcessFunction(const Function& function);
   void CheckForNewDynamicFunctions();
@@ -341,6 +390,7 @@ class Precompiler : public ValueObject {
   void FinalizeDispatchTable();
   void ReplaceFunctionStaticCallEntries();
   void DropFunctions();
+  void MarkClassesWithOnlyFinalInstanceFields();
   void DropFields();
   void VisitConstantInstance(ObjectPtr instance,
                              WeakTable* visited,
@@ -403,6 +453,8 @@ class Precompiler : public ValueObject {
   InstanceSet consts_to_retain_;
   TableSelectorSet seen_table_selectors_;
   ProgramElementSet api_uses_;
+  FunctionSummaryMap escape_summaries_;
+  FunctionSummaryMap partial_inlining_sizes_;
   Error& error_;
 
   compiler::DispatchTableGenerator* dispatch_table_generator_;
@@ -411,6 +463,7 @@ class Precompiler : public ValueObject {
 
   Phase phase_ = Phase::kPreparation;
   PrecompilerTracer* tracer_ = nullptr;
+  AotProfile* profile_ = nullptr;
   RetainedReasonsWriter* retained_reasons_writer_ = nullptr;
   bool is_tracing_ = false;
 };
@@ -8,6 +8,11 @@
 #include "vm/code_patcher.h"
 #include "vm/compiler/backend/flow_graph.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/hash_map.h"
+
+#if defined(DART_PRECOMPILER)
+#include "vm/compiler/aot/precompiler.h"
+#endif
 
 namespace dart {
 
@@ -46,25 +51,71 @@ static void SetEdgeWeight(BlockEntryInstr* block,
   }
 }
 
-void BlockScheduler::AssignEdgeWeights(FlowGraph* flow_graph) {
-  if (!FLAG_reorder_basic_blocks) {
-    return;
+#if defined(DART_PRECOMPILER)
+// Returns the edge counters of a training run for the function of the given
+// graph, or null if there are none or they do not fit the graph.
+static ArrayPtr ProfiledEdgeCounters(FlowGraph* flow_graph) {
+  Precompiler* precompiler = Precompiler::Instance();
+  if ((precompiler == nullptr) || (precompiler->profile() == nullptr)) {
+    return Array::null();
   }
-  if (CompilerState::Current().is_aot()) {
-    return;
+  const Function& function = flow_graph->parsed_function().function();
+  const AotProfile::FunctionProfile* profile =
+      precompiler->profile()->Lookup(function);
+  const intptr_t block_count = flow_graph->preorder().length();
+  if ((profile == nullptr) || (profile->edge_counts.length() != block_count)) {
+    return Array::null();
+  }
+  // AOT graphs are built differently from unoptimized JIT graphs, so the
+  // counters of the training run are matched with blocks by deopt id and
+  // only used if every block matches exactly one of them.
+  Zone* zone = flow_graph->zone();
+  IntMap<BlockEntryInstr*> blocks(zone);
+  for (BlockEntryInstr* block : flow_graph->preorder()) {
+    if ((block->deopt_id() == DeoptId::kNone) ||
+        (blocks.Lookup(block->deopt_id()) != nullptr)) {
+      return Array::null();
+    }
+    blocks.Insert(block->deopt_id(), block);
   }
+  const Array& edge_counters = Array::Handle(zone, Array::New(block_count));
+  for (const auto& edge_count : profile->edge_counts) {
+    BlockEntryInstr* block = blocks.Lookup(edge_count.block_deopt_id);
+    if ((block == nullptr) ||
+        (edge_counters.At(block->preorder_number()) != Object::null())) {
+      return Array::null();
+    }
+    const int64_t count =
+        Utils::Minimum<int64_t>(edge_count.count, Smi::kMaxValue);
+    edge_counters.SetAt(block->preorder_number(),
+                        Smi::Handle(zone, Smi::New(count)));
+  }
+  return edge_counters.ptr();
+}
+#endif  // defined(DART_PRECOMPILER)
 
-  const Function& function = flow_graph->parsed_function().function();
-  const Array& ic_data_array =
-      Array::Handle(flow_graph->zone(), function.ic_data_array());
-  if (ic_data_array.IsNull()) {
-    DEBUG_ASSERT(IsolateGroup::Current()->HasAttemptedReload() ||
-                 function.ForceOptimize());
+void BlockScheduler::AssignEdgeWeights(FlowGraph* flow_graph) {
+  if (!FLAG_reorder_basic_blocks) {
     return;
   }
+
   Array& edge_counters = Array::Handle();
-  edge_counters ^=
-      ic_data_array.At(Function::ICDataArrayIndices::kEdgeCounters);
+  if (CompilerState::Current().is_aot()) {
+#if defined(DART_PRECOMPILER)
+    edge_counters = ProfiledEdgeCounters(flow_graph);
+#endif
+  } else {
+    const Function& function = flow_graph->parsed_function().function();
+    const Array& ic_data_array =
+        Array::Handle(flow_graph->zone(), function.ic_data_array());
+    if (ic_data_array.IsNull()) {
+      DEBUG_ASSERT(IsolateGroup::Current()->HasAttemptedReload() ||
+                   function.ForceOptimize());
+      return;
+    }
+    edge_counters ^=
+        ic_data_array.At(Function::ICDataArrayIndices::kEdgeCounters);
+  }
   if (edge_counters.IsNull()) {
     return;
   }
@@ -155,6 +206,35 @@ static void Union(GrowableArray<Chain*>* chains,
   }
 }
 
+// Returns true if profiling found that the branch to the block was never
+// taken while the other branch was.
+static bool IsNeverEntered(BlockEntryInstr* block) {
+  TargetEntryInstr* target = block->AsTargetEntry();
+  if ((target == nullptr) || (target->edge_weight() != 0.0) ||
+      (target->PredecessorCount() != 1)) {
+    return false;
+  }
+  BranchInstr* branch =
+      target->PredecessorAt(0)->last_instruction()->AsBranch();
+  if (branch == nullptr) {
+    return false;
+  }
+  TargetEntryInstr* other = (branch->true_successor() == target)
+                                ? branch->false_successor()
+                                : branch->true_successor();
+  return other->edge_weight() > 0.0;
+}
+
+static void EmitChain(FlowGraph* flow_graph,
+                      Chain* chain,
+                      FunctionEntryInstr* checked_entry) {
+  for (Link* link = chain->first; link != nullptr; link = link->next) {
+    if ((link->block != checked_entry) && !link->block->IsGraphEntry()) {
+      flow_graph->CodegenBlockOrder()->Add(link->block);
+    }
+  }
+}
+
 void BlockScheduler::ReorderBlocks(FlowGraph* flow_graph) {
   if (!flow_graph->should_reorder_blocks()) {
     return;
@@ -225,25 +305,32 @@ void BlockScheduler::ReorderBlocksJIT(FlowGraph* flow_graph) {
     flow_graph->CodegenBlockOrder()->Add(checked_entry);
   }
   // Build a new block order.  Emit each chain when its first block occurs
-  // in the original reverse postorder ordering.
+  // in the original reverse postorder ordering. Chains which were never
+  // entered are emitted after all other chains, so that the cold code does
+  // not occupy the instruction cache lines of the hot code.
   // Note: the resulting order is not topologically sorted and can't be
   // used a replacement for reverse_postorder in algorithms that expect
   // topological sort.
+  GrowableArray<Chain*> cold_chains;
   for (intptr_t i = block_count - 1; i >= 0; --i) {
     if (chains[i]->first->block == flow_graph->postorder()[i]) {
-      for (Link* link = chains[i]->first; link != nullptr; link = link->next) {
-        if ((link->block != checked_entry) && (link->block != graph_entry)) {
-          flow_graph->CodegenBlockOrder()->Add(link->block);
-        }
+      if (IsNeverEntered(chains[i]->first->block)) {
+        cold_chains.Add(chains[i]);
+        continue;
       }
+      EmitChain(flow_graph, chains[i], checked_entry);
     }
   }
+  for (Chain* chain : cold_chains) {
+    EmitChain(flow_graph, chain, checked_entry);
+  }
 }
 
 // AOT block order is based on reverse post order but with two changes:
 //
-// - Blocks which always throw and their direct predecessors are considered
-// *cold* and moved to the end of the order.
+// - Blocks which always throw or call the slow path of a partially inlined
+// function, and their direct predecessors are considered *cold* and moved
+// to the end of the order.
 // - Blocks which belong to the same loop are kept together (where possible)
 // and not interspersed with other blocks.
 //
@@ -289,6 +376,10 @@ class AOTBlockScheduler {
         if (last->IsThrow() || last->IsReThrow() || last->IsStop()) {
           marks |= kColdMark;
         } else {
+          if (CallsOutlinedColdPath(block) || IsNeverEntered(block)) {
+            marks |= kColdMark;
+          }
+
           // When visiting a block inside a loop with two successors
           // push the successor with lesser nesting *last*, so that it is
           // visited first. This helps to keep blocks which belong to the
@@ -346,11 +437,23 @@ class AOTBlockScheduler {
     }
   }
 
+  static bool CallsOutlinedColdPath(BlockEntryInstr* block) {
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      StaticCallInstr* call = it.Current()->AsStaticCall();
+      if ((call != nullptr) && call->is_outlined_cold_path()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   // The block was added to the stack.
   static constexpr uint8_t kSeenMark = 1 << 0;
   // The block was visited and all of its successors were added to the stack.
   static constexpr uint8_t kVisitedMark = 1 << 1;
-  // The block terminates with unconditional throw or rethrow.
+  // The block terminates with unconditional throw or rethrow, calls the
+  // slow path of a partially inlined function, or was never entered by the
+  // training run of a profile.
   static constexpr uint8_t kColdMark = 1 << 2;
   // The block should not move to cold section.
   static constexpr uint8_t kPinnedMark = 1 << 3;
@@ -0,0 +1,83 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/block_scheduler.h"
+
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+// Returns the target of a branch which was never taken while the other
+// target of the branch was, or nullptr if there is no such block.
+static TargetEntryInstr* FindNeverEnteredTarget(FlowGraph* flow_graph) {
+  TargetEntryInstr* result = nullptr;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    BranchInstr* branch = block_it.Current()->last_instruction()->AsBranch();
+    if (branch == nullptr) continue;
+    TargetEntryInstr* true_successor = branch->true_successor();
+    TargetEntryInstr* false_successor = branch->false_successor();
+    if ((true_successor->edge_weight() == 0.0) &&
+        (false_successor->edge_weight() > 0.0)) {
+      EXPECT(result == nullptr);
+      result = true_successor;
+    } else if ((false_successor->edge_weight() == 0.0) &&
+               (true_successor->edge_weight() > 0.0)) {
+      EXPECT(result == nullptr);
+      result = false_successor;
+    }
+  }
+  return result;
+}
+
+ISOLATE_UNIT_TEST_CASE(BlockScheduler_JITMovesNeverEnteredBlocksLast) {
+  const char* kScriptChars =
+      R"(
+      int foo(int x, int n) {
+        if (x < 0) {
+          x = x * x - 7;
+        }
+        for (int i = 0; i < n; i++) {
+          x += i;
+        }
+        return x;
+      }
+      main() {
+        for (int i = 0; i < 100; i++) {
+          foo(i, i % 5);
+        }
+      }
+    )";
+  const auto& root_library = Library::Handle(LoadTestScript(kScriptChars));
+  Invoke(root_library, "main");
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  ASSERT(flow_graph->should_reorder_blocks());
+
+  TargetEntryInstr* cold = FindNeverEnteredTarget(flow_graph);
+  EXPECT(cold != nullptr);
+  if (cold == nullptr) return;
+
+  // The block of x < 0 comes before the loop in reverse postorder, but it
+  // is emitted after the return at the end of the function.
+  const auto& order = *flow_graph->CodegenBlockOrder();
+  intptr_t cold_index = -1;
+  intptr_t last_return_index = -1;
+  for (intptr_t i = 0; i < order.length(); ++i) {
+    if (order[i] == cold) {
+      cold_index = i;
+    } else if (order[i]->last_instruction()->IsDartReturn()) {
+      last_return_index = i;
+    }
+  }
+  EXPECT(last_return_index >= 0);
+  EXPECT(last_return_index < cold_index);
+}
+
+}  // namespace dart
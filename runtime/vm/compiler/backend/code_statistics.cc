@@ -12,6 +12,9 @@ CombinedCodeStatistics::CombinedCodeStatistics() {
   object_header_bytes_ = 0;
   return_const_count_ = 0;
   return_const_with_load_field_count_ = 0;
+  spill_count_ = 0;
+  reload_count_ = 0;
+  rematerialization_count_ = 0;
   intptr_t i = 0;
 
 #define DO(type, attrs)                                                        \
@@ -105,6 +108,11 @@ void CombinedCodeStatistics::DumpStatistics() {
   OS::PrintErr("% 8" Pd " return-constant-with-load-field functions\n",
                return_const_with_load_field_count_);
   OS::PrintErr("--------------------\n");
+  OS::PrintErr("% 8" Pd " spills\n", spill_count_);
+  OS::PrintErr("% 8" Pd " reloads\n", reload_count_);
+  OS::PrintErr("% 8" Pd " rematerialized constants\n",
+               rematerialization_count_);
+  OS::PrintErr("--------------------\n");
 }
 
 int CombinedCodeStatistics::CompareEntries(const void* a, const void* b) {
@@ -125,6 +133,9 @@ CodeStatistics::CodeStatistics(compiler::Assembler* assembler)
   instruction_bytes_ = 0;
   unaccounted_bytes_ = 0;
   alignment_bytes_ = 0;
+  spill_count_ = 0;
+  reload_count_ = 0;
+  rematerialization_count_ = 0;
 
   stack_index_ = -1;
   for (intptr_t i = 0; i < kStackSize; i++)
@@ -132,9 +143,33 @@ CodeStatistics::CodeStatistics(compiler::Assembler* assembler)
 }
 
 void CodeStatistics::Begin(Instruction* instruction) {
+  if (auto* parallel_move = instruction->AsParallelMove()) {
+    CountMoves(parallel_move);
+  } else if (auto* goto_instr = instruction->AsGoto()) {
+    // Phi moves are attached to the goto.
+    if (goto_instr->HasParallelMove()) {
+      CountMoves(goto_instr->parallel_move());
+    }
+  }
   SpecialBegin(static_cast<intptr_t>(instruction->statistics_tag()));
 }
 
+void CodeStatistics::CountMoves(ParallelMoveInstr* parallel_move) {
+  for (intptr_t i = 0; i < parallel_move->NumMoves(); i++) {
+    const MoveOperands* move = parallel_move->MoveOperandsAt(i);
+    if (move->IsRedundant()) continue;
+    const Location src = move->src();
+    const Location dest = move->dest();
+    if (src.IsConstant()) {
+      if (dest.IsMachineRegister()) rematerialization_count_++;
+    } else if (src.IsMachineRegister() && dest.HasStackIndex()) {
+      spill_count_++;
+    } else if (src.HasStackIndex() && dest.IsMachineRegister()) {
+      reload_count_++;
+    }
+  }
+}
+
 void CodeStatistics::End(Instruction* instruction) {
   SpecialEnd(static_cast<intptr_t>(instruction->statistics_tag()));
 }
@@ -200,6 +235,9 @@ void CodeStatistics::AppendTo(CombinedCodeStatistics* stat) {
   ASSERT(stat->unaccounted_bytes_ >= 0);
   stat->alignment_bytes_ += alignment_bytes_;
   stat->object_header_bytes_ += Instructions::HeaderSize();
+  stat->spill_count_ += spill_count_;
+  stat->reload_count_ += reload_count_;
+  stat->rematerialization_count_ += rematerialization_count_;
 
   if (returns_constant) stat->return_const_count_++;
   if (returns_const_with_load_field_) {
@@ -68,6 +68,9 @@ class CombinedCodeStatistics {
   intptr_t object_header_bytes_;
   intptr_t return_const_count_;
   intptr_t return_const_with_load_field_count_;
+  intptr_t spill_count_;
+  intptr_t reload_count_;
+  intptr_t rematerialization_count_;
 };
 
 class CodeStatistics {
@@ -84,6 +87,14 @@ class CodeStatistics {
 
   void Finalize();
 
+  // Counts the moves inserted by the register allocator which store a
+  // register to a spill slot, load it back or materialize a constant.
+  void CountMoves(ParallelMoveInstr* parallel_move);
+
+  intptr_t spill_count() const { return spill_count_; }
+  intptr_t reload_count() const { return reload_count_; }
+  intptr_t rematerialization_count() const { return rematerialization_count_; }
+
  private:
   static constexpr int kStackSize = 8;
 
@@ -98,6 +109,9 @@ class CodeStatistics {
   intptr_t instruction_bytes_;
   intptr_t unaccounted_bytes_;
   intptr_t alignment_bytes_;
+  intptr_t spill_count_;
+  intptr_t reload_count_;
+  intptr_t rematerialization_count_;
 
   intptr_t stack_[kStackSize];
   intptr_t stack_index_;
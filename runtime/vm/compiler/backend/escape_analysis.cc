@@ -0,0 +1,140 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/escape_analysis.h"
+
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/object.h"
+
+#if defined(DART_PRECOMPILER)
+#include "vm/compiler/aot/precompiler.h"
+#endif
+
+namespace dart {
+
+// Returns true if the given use neither stores the value anywhere nor
+// passes it to code that might.
+static bool IsLocalUse(Value* use) {
+  Instruction* instr = use->instruction();
+  if (instr->IsMaterializeObject()) {
+    // Deoptimization state, which is rematerialized along with the object.
+    return true;
+  }
+  if (auto load = instr->AsLoadField()) {
+    return use == load->instance();
+  }
+  if (auto store = instr->AsStoreField()) {
+    return use == store->instance();
+  }
+  if (auto load = instr->AsLoadIndexed()) {
+    return use == load->array();
+  }
+  if (auto store = instr->AsStoreIndexed()) {
+    return use == store->array();
+  }
+  if (auto call = instr->AsClosureCall()) {
+    // The closure itself is not accessible to the code of the closure.
+    return use == call->Receiver();
+  }
+  return instr->IsLoadClassId() || instr->IsStrictCompare() ||
+         instr->IsInstanceOf() || instr->IsCheckClass() ||
+         instr->IsCheckClassId();
+}
+
+bool EscapeAnalysis::IsNonEscapingArgument(Instruction* call, Value* use) {
+  StaticCallInstr* static_call = call->AsStaticCall();
+  if (static_call == nullptr) {
+    return false;
+  }
+  // Only positional arguments are in the order of the parameters.
+  const Array& names = static_call->argument_names();
+  const intptr_t first = static_call->FirstArgIndex();
+  const intptr_t positional =
+      static_call->ArgumentCount() - (names.IsNull() ? 0 : names.Length());
+  for (intptr_t i = first; i < positional; ++i) {
+    if (static_call->ArgumentValueAt(i) == use) {
+      const intptr_t param = i - first;
+      return (param < kMaxParameters) &&
+             ((SummaryFor(static_call->function()) &
+               (static_cast<Summary>(1) << param)) != 0);
+    }
+  }
+  return false;
+}
+
+bool EscapeAnalysis::DoesNotEscape(Definition* def) {
+  // Redefinitions of the value are followed as aliases.
+  GrowableArray<Definition*> aliases;
+  aliases.Add(def);
+  for (intptr_t i = 0; i < aliases.length(); ++i) {
+    for (Value* use = aliases[i]->input_use_list(); use != nullptr;
+         use = use->next_use()) {
+      Instruction* instr = use->instruction();
+      if (instr->IsRedefinition() || instr->IsCheckNull() ||
+          instr->IsAssertAssignable()) {
+        Definition* alias = instr->AsDefinition();
+        if ((use->use_index() != 0) || !alias->HasSSATemp()) {
+          return false;
+        }
+        if (!aliases.Contains(alias)) {
+          aliases.Add(alias);
+        }
+        continue;
+      }
+      if (!IsLocalUse(use) && !IsNonEscapingArgument(instr, use)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+EscapeAnalysis::Summary EscapeAnalysis::ComputeSummary(FlowGraph* flow_graph) {
+  const Function& function = flow_graph->function();
+  if (flow_graph->IsCompiledForOsr()) {
+    return 0;
+  }
+  // Values of parameters also flow into catch entries, which are not
+  // tracked.
+  for (TryEntryInstr* try_entry : flow_graph->try_entries()) {
+    if (try_entry != nullptr) {
+      return 0;
+    }
+  }
+  const intptr_t count =
+      Utils::Minimum(function.num_fixed_parameters(), kMaxParameters);
+  Summary summary = (count == kMaxParameters)
+                        ? ~static_cast<Summary>(0)
+                        : ((static_cast<Summary>(1) << count) - 1);
+  // Parameters without a definition are not used at all.
+  GraphEntryInstr* graph_entry = flow_graph->graph_entry();
+  for (FunctionEntryInstr* entry :
+       {graph_entry->normal_entry(), graph_entry->unchecked_entry()}) {
+    if (entry == nullptr) {
+      continue;
+    }
+    for (Definition* def : *entry->initial_definitions()) {
+      ParameterInstr* param = def->AsParameter();
+      if ((param == nullptr) || (param->param_index() < 0) ||
+          (param->param_index() >= count)) {
+        continue;
+      }
+      if (!DoesNotEscape(param)) {
+        summary &= ~(static_cast<Summary>(1) << param->param_index());
+      }
+    }
+  }
+  return summary;
+}
+
+EscapeAnalysis::Summary EscapeAnalysis::SummaryFor(const Function& function) {
+#if defined(DART_PRECOMPILER)
+  if (Precompiler* precompiler = Precompiler::Instance()) {
+    return precompiler->EscapeSummaryFor(function);
+  }
+#endif
+  return 0;
+}
+
+}  // namespace dart
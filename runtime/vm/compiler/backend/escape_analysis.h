@@ -0,0 +1,55 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_ESCAPE_ANALYSIS_H_
+#define RUNTIME_VM_COMPILER_BACKEND_ESCAPE_ANALYSIS_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+#include "vm/compiler/backend/il.h"
+
+namespace dart {
+
+class FlowGraph;
+class Function;
+
+// Interprocedural escape analysis of function parameters.
+//
+// A parameter does not escape a function if the function only reads and
+// writes the fields of the passed object, compares it, calls it (for
+// closures) or passes it on to callees where it does not escape either.
+// An allocation passed for such a parameter becomes an allocation sinking
+// candidate once the callee is inlined, so the inliner uses this analysis
+// to favor such call sites; see AllocationSinking::IsSinkableArgument.
+//
+// Summaries of compiled functions are recorded by the precompiler and used
+// for calls to those functions from functions compiled later. The analysis
+// only guides heuristics, it is never relied upon for correctness.
+class EscapeAnalysis : public AllStatic {
+ public:
+  // Summary of a function: bit i is set if the i-th fixed parameter
+  // (counting the receiver, but not the type arguments) does not escape.
+  typedef uint64_t Summary;
+  static constexpr intptr_t kMaxParameters = sizeof(Summary) * kBitsPerByte;
+
+  // Returns true if the value of def does not escape the graph.
+  static bool DoesNotEscape(Definition* def);
+
+  // Computes the summary of the function of the given flow graph.
+  static Summary ComputeSummary(FlowGraph* flow_graph);
+
+  // Returns the summary recorded for the given function, or 0 if the
+  // function was not compiled yet.
+  static Summary SummaryFor(const Function& function);
+
+ private:
+  static bool IsNonEscapingArgument(Instruction* call, Value* use);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_ESCAPE_ANALYSIS_H_
@@ -0,0 +1,148 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/escape_analysis.h"
+
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(int, inlining_callee_call_sites_threshold);
+DECLARE_FLAG(int, inlining_sinkable_argument_size_threshold);
+DECLARE_FLAG(int, inlining_size_threshold);
+
+static EscapeAnalysis::Summary ComputeEscapeSummary(const char* script_chars) {
+  const auto& root_library = Library::Handle(LoadTestScript(script_chars));
+  Invoke(root_library, "main");
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kInlining,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kCanonicalize,
+  });
+  return EscapeAnalysis::ComputeSummary(flow_graph);
+}
+
+ISOLATE_UNIT_TEST_CASE(EscapeAnalysis_Parameters) {
+  const char* kScriptChars =
+      R"(
+      class A {
+        int x;
+        A(this.x);
+      }
+      final list = <A>[];
+      int foo(A a, A b, A c) {
+        list.add(b);
+        c.x = a.x;
+        return c.x;
+      }
+      main() {
+        foo(A(1), A(2), A(3));
+      }
+    )";
+  // a is only read and c only written, but b is stored into the list.
+  EXPECT_EQ(0x5u, ComputeEscapeSummary(kScriptChars));
+}
+
+ISOLATE_UNIT_TEST_CASE(EscapeAnalysis_ClosureCall) {
+  const char* kScriptChars =
+      R"(
+      Object? escaped;
+      int foo(int Function(int) f, int Function(int) g) {
+        escaped = g;
+        return f(1) + g(2);
+      }
+      main() {
+        foo((x) => x, (x) => x + 1);
+      }
+    )";
+  // Calling a closure does not let it escape.
+  EXPECT_EQ(0x1u, ComputeEscapeSummary(kScriptChars));
+}
+
+// Compiles foo through the whole JIT pipeline with only small callees
+// inlined by size, and counts the allocations and calls to norm left in it.
+static void CountAllocationsAndCalls(const Library& root_library,
+                                     intptr_t* allocations,
+                                     intptr_t* calls) {
+  SetFlagScope<int> size(&FLAG_inlining_size_threshold, 10);
+  SetFlagScope<int> call_sites(&FLAG_inlining_callee_call_sites_threshold, -1);
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  *allocations = 0;
+  *calls = 0;
+  for (auto block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (it.Current()->IsAllocateObject()) {
+        ++*allocations;
+      } else if (auto call = it.Current()->AsStaticCall()) {
+        if (strcmp(String::Handle(call->function().name()).ToCString(),
+                   "norm") == 0) {
+          ++*calls;
+        }
+      }
+    }
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(EscapeAnalysis_SinkArgumentOfInlinedCallee) {
+  const char* kScriptChars =
+      R"(
+      class Point {
+        final int x;
+        final int y;
+        Point(this.x, this.y);
+      }
+      Object? escaped;
+      int norm(Point p) {
+        final dx = p.x - p.y;
+        final dy = p.x + p.y;
+        return p.x * p.x + p.y * p.y + dx * dy - (dx ~/ 3);
+      }
+      @pragma('vm:never-inline')
+      int keep(Point p) {
+        escaped = p;
+        return p.x;
+      }
+      int foo(int a, int b) => norm(Point(a, b)) + keep(Point(b, a));
+      main() {
+        for (int i = 0; i < 100; i++) {
+          foo(i, 2);
+        }
+      }
+    )";
+  const auto& root_library = Library::Handle(LoadTestScript(kScriptChars));
+  Invoke(root_library, "main");
+  intptr_t allocations = 0;
+  intptr_t calls = 0;
+
+  // The point passed to norm does not escape it, so norm is inlined even
+  // though it is above the size threshold, and the point is sunk. The point
+  // passed to keep escapes and is still allocated.
+  CountAllocationsAndCalls(root_library, &allocations, &calls);
+  EXPECT_EQ(1, allocations);
+  EXPECT_EQ(0, calls);
+
+  // Without the sinkable argument heuristic norm is called with a point.
+  {
+    SetFlagScope<int> sinkable(&FLAG_inlining_sinkable_argument_size_threshold,
+                               0);
+    CountAllocationsAndCalls(root_library, &allocations, &calls);
+  }
+  EXPECT_EQ(2, allocations);
+  EXPECT_EQ(1, calls);
+}
+
+}  // namespace dart
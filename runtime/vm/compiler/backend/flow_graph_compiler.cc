@@ -71,6 +71,7 @@ DECLARE_FLAG(int, stacktrace_every);
 DECLARE_FLAG(charp, stacktrace_filter);
 DECLARE_FLAG(int, gc_every);
 DECLARE_FLAG(bool, trace_compiler);
+DECLARE_FLAG(charp, write_aot_profile_to);
 
 DEFINE_FLAG(bool,
             align_all_loops,
@@ -173,7 +174,8 @@ FlowGraphCompiler::FlowGraphCompiler(
                                         .LookupClass(Symbols::List()))),
       pending_deoptimization_env_(nullptr),
       deopt_id_to_ic_data_(deopt_id_to_ic_data),
-      edge_counters_array_(Array::ZoneHandle()) {
+      edge_counters_array_(Array::ZoneHandle()),
+      edge_counter_deopt_ids_array_(Array::ZoneHandle()) {
   ASSERT(flow_graph->parsed_function().function().ptr() ==
          parsed_function.function().ptr());
   if (is_optimizing) {
@@ -248,6 +250,17 @@ void FlowGraphCompiler::InitCompiler() {
       edge_counters.SetAt(i, Object::smi_zero());
     }
     edge_counters_array_ = edge_counters.ptr();
+
+    // Blocks of the AOT graph are matched with the counters by deopt id.
+    if (FLAG_write_aot_profile_to != nullptr) {
+      const Array& deopt_ids =
+          Array::Handle(Array::New(num_counters, Heap::kOld));
+      for (intptr_t i = 0; i < num_counters; ++i) {
+        deopt_ids.SetAt(
+            i, Smi::Handle(Smi::New(flow_graph_.preorder()[i]->deopt_id())));
+      }
+      edge_counter_deopt_ids_array_ = deopt_ids.ptr();
+    }
   }
 }
 
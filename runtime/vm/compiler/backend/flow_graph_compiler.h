@@ -948,6 +948,9 @@ class FlowGraphCompiler : public ValueObject {
   void AddDispatchTableCallTarget(const compiler::TableSelector* selector);
 
   ArrayPtr edge_counters_array() const { return edge_counters_array_.ptr(); }
+  ArrayPtr edge_counter_deopt_ids_array() const {
+    return edge_counter_deopt_ids_array_.ptr();
+  }
 
   ArrayPtr InliningIdToFunction() const;
 
@@ -1271,6 +1274,9 @@ class FlowGraphCompiler : public ValueObject {
 
   ZoneGrowableArray<const ICData*>* deopt_id_to_ic_data_;
   Array& edge_counters_array_;
+  // Deopt ids of the blocks counted by edge_counters_array_, indexed by
+  // preorder number. Only recorded for --write_aot_profile_to.
+  Array& edge_counter_deopt_ids_array_;
 
   // Instruction currently running EmitNativeCode().
   Instruction* current_instruction_ = nullptr;
@@ -1399,6 +1399,8 @@ class Instruction : public ZoneAllocated {
   // GetDeoptId and/or CopyDeoptIdFrom.
   friend class CallSiteInliner;
   friend class LICM;
+  friend class LoopUnroller;
+  friend class LoopVectorizer;
   friend class ConditionInstr;
   friend class Scheduler;
   friend class BlockEntryInstr;
@@ -2964,6 +2966,7 @@ class PhiInstr : public VariadicDefinition {
   // Direct access to inputs_ in order to resize it due to unreachable
   // predecessors.
   friend class ConstantPropagator;
+  friend class CallSiteInliner;
 
   JoinEntryInstr* block_;
   Representation representation_;
@@ -5580,6 +5583,7 @@ class StaticCallInstr : public TemplateDartCall<0> {
         rebind_rule_(rebind_rule),
         result_type_(nullptr),
         is_known_list_constructor_(false),
+        is_outlined_cold_path_(false),
         entry_kind_(Code::EntryKind::kNormal),
         identity_(AliasIdentity::Unknown()) {
     DEBUG_ASSERT(function.IsNotTemporaryScopedHandle());
@@ -5605,6 +5609,7 @@ class StaticCallInstr : public TemplateDartCall<0> {
         rebind_rule_(rebind_rule),
         result_type_(nullptr),
         is_known_list_constructor_(false),
+        is_outlined_cold_path_(false),
         entry_kind_(Code::EntryKind::kNormal),
         identity_(AliasIdentity::Unknown()) {
     DEBUG_ASSERT(function.IsNotTemporaryScopedHandle());
@@ -5696,6 +5701,11 @@ class StaticCallInstr : public TemplateDartCall<0> {
     is_known_list_constructor_ = value;
   }
 
+  // True for calls which execute the cold path of a partially inlined
+  // function, see CallSiteInliner::OutlineColdPath.
+  bool is_outlined_cold_path() const { return is_outlined_cold_path_; }
+  void set_is_outlined_cold_path(bool value) { is_outlined_cold_path_ = value; }
+
   Code::EntryKind entry_kind() const { return entry_kind_; }
 
   void set_entry_kind(Code::EntryKind value) { entry_kind_ = value; }
@@ -5727,6 +5737,8 @@ class StaticCallInstr : public TemplateDartCall<0> {
   F(CompileType*, result_type_)                                                \
   /* 'True' for recognized list constructors. */                               \
   F(bool, is_known_list_constructor_)                                          \
+  /* 'True' for calls of the cold path of a partially inlined function. */     \
+  F(bool, is_outlined_cold_path_)                                              \
   F(Code::EntryKind, entry_kind_)                                              \
   F(AliasIdentity, identity_)
 
@@ -6844,6 +6856,7 @@ class LoadIndexedInstr : public TemplateDefinition<2, NoThrow> {
   intptr_t index_scale() const { return index_scale_; }
   intptr_t class_id() const { return class_id_; }
   bool aligned() const { return alignment_ == kAlignedAccess; }
+  CompileType* result_type() const { return result_type_; }
   bool sanitize() const {
     if (FLAG_target_thread_sanitizer) return true;
     if (FLAG_target_address_sanitizer || FLAG_target_memory_sanitizer) {
@@ -7132,6 +7145,8 @@ class StoreIndexedInstr : public TemplateInstruction<3, NoThrow> {
   intptr_t index_scale() const { return index_scale_; }
   intptr_t class_id() const { return class_id_; }
   bool aligned() const { return alignment_ == kAlignedAccess; }
+  StoreBarrierType emit_store_barrier() const { return emit_store_barrier_; }
+  virtual TokenPosition token_pos() const { return token_pos_; }
   bool sanitize() const {
     if (FLAG_target_thread_sanitizer) return true;
     if (FLAG_target_address_sanitizer || FLAG_target_memory_sanitizer) {
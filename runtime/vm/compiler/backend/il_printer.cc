@@ -922,6 +922,9 @@ void StaticCallInstr::PrintOperandsTo(BaseTextBuffer* f) const {
   if (entry_kind() == Code::EntryKind::kUnchecked) {
     f->AddString(", using unchecked entrypoint");
   }
+  if (is_outlined_cold_path()) {
+    f->AddString(", cold path");
+  }
   if (function().recognized_kind() != MethodRecognizer::kUnknown) {
     f->Printf(", recognized_kind = %s",
               MethodRecognizer::KindToCString(function().recognized_kind()));
@@ -8,10 +8,13 @@
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/block_scheduler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
+#include "vm/compiler/backend/escape_analysis.h"
 #include "vm/compiler/backend/flow_graph_checker.h"
 #include "vm/compiler/backend/flow_graph_compiler.h"
 #include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/redundancy_elimination.h"
 #include "vm/compiler/backend/type_propagator.h"
+#include "vm/compiler/compilation_report.h"
 #include "vm/compiler/compiler_pass.h"
 #include "vm/compiler/compiler_timings.h"
 #include "vm/compiler/frontend/flow_graph_builder.h"
@@ -57,6 +60,26 @@ DEFINE_FLAG(int,
             inlining_callee_size_threshold,
             160,
             "Do not inline callees larger than threshold");
+DEFINE_FLAG(int,
+            inlining_sinkable_argument_size_threshold,
+            50,
+            "Inline functions that have threshold or fewer instructions if "
+            "an allocation passed to them can be sunk afterwards.");
+DEFINE_FLAG(int,
+            inlining_hot_callee_size_threshold,
+            50,
+            "Inline functions that have threshold or fewer instructions if "
+            "they were hot in the training run of the AOT profile.");
+DEFINE_FLAG(bool,
+            partial_inlining,
+            true,
+            "Inline the fast path of functions which are too large to be "
+            "inlined and call the function on the slow path (AOT only).");
+DEFINE_FLAG(int,
+            partial_inlining_size_threshold,
+            40,
+            "Partially inline functions with a fast path of threshold or "
+            "fewer instructions");
 DEFINE_FLAG(int,
             inlining_small_leaf_size_threshold,
             50,
@@ -98,6 +121,10 @@ DECLARE_FLAG(bool, print_flow_graph_optimized);
       inlined_info_.Add(InlinedInfo(caller, target, inlining_depth_,           \
                                     instance_call, comment));                  \
     }                                                                          \
+    if (report_ != nullptr) {                                                  \
+      report_->AddInliningDecision(*(caller), *(target), inlining_depth_,      \
+                                   (instance_call)->GetDeoptId(), comment);    \
+    }                                                                          \
   } while (false)
 
 // Test if a call is recursive by looking in the deoptimization environment.
@@ -157,55 +184,58 @@ class GraphInfoCollector : public ValueObject {
     instruction_count_ = 0;
     for (BlockIterator block_it = graph.postorder_iterator(); !block_it.Done();
          block_it.Advance()) {
-      // Skip any blocks from the prologue to make them not count towards the
-      // inlining instruction budget.
-      const intptr_t block_id = block_it.Current()->block_id();
-      if (graph.prologue_info().Contains(block_id)) {
+      CollectBlock(graph, block_it.Current());
+    }
+  }
+
+  // Adds the instructions of the given block to the counts.
+  void CollectBlock(const FlowGraph& graph, BlockEntryInstr* block) {
+    // Skip any blocks from the prologue to make them not count towards the
+    // inlining instruction budget.
+    if (graph.prologue_info().Contains(block->block_id())) {
+      return;
+    }
+
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* current = it.Current();
+      // Don't count instructions that won't generate any code.
+      if (current->IsRedefinition()) {
         continue;
       }
-
-      for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
-           it.Advance()) {
-        Instruction* current = it.Current();
-        // Don't count instructions that won't generate any code.
-        if (current->IsRedefinition()) {
-          continue;
-        }
-        // UnboxedConstant is often folded into the indexing
-        // instructions (similar to Constant instructions which
-        // belong to initial definitions and not counted here).
-        if (current->IsUnboxedConstant()) {
-          continue;
-        }
-        ++instruction_count_;
-        // Count inputs of certain instructions as if separate MoveArgument
-        // instructions are used for inputs. This is done in order to
-        // preserve inlining behavior and avoid code size growth after
-        // MoveArgument insertion was moved to the end of the
-        // compilation pipeline.
-        if (current->IsAllocateObject()) {
-          instruction_count_ += current->InputCount();
-        } else if (current->ArgumentCount() > 0) {
-          ASSERT(!current->HasMoveArguments());
-          instruction_count_ += current->ArgumentCount();
-        }
-        if (current->IsInstanceCall() || current->IsStaticCall() ||
-            current->IsClosureCall() || current->IsDispatchTableCall()) {
+      // UnboxedConstant is often folded into the indexing
+      // instructions (similar to Constant instructions which
+      // belong to initial definitions and not counted here).
+      if (current->IsUnboxedConstant()) {
+        continue;
+      }
+      ++instruction_count_;
+      // Count inputs of certain instructions as if separate MoveArgument
+      // instructions are used for inputs. This is done in order to
+      // preserve inlining behavior and avoid code size growth after
+      // MoveArgument insertion was moved to the end of the
+      // compilation pipeline.
+      if (current->IsAllocateObject()) {
+        instruction_count_ += current->InputCount();
+      } else if (current->ArgumentCount() > 0) {
+        ASSERT(!current->HasMoveArguments());
+        instruction_count_ += current->ArgumentCount();
+      }
+      if (current->IsInstanceCall() || current->IsStaticCall() ||
+          current->IsClosureCall() || current->IsDispatchTableCall()) {
+        ++call_site_count_;
+        continue;
+      }
+      if (current->IsPolymorphicInstanceCall()) {
+        PolymorphicInstanceCallInstr* call =
+            current->AsPolymorphicInstanceCall();
+        // These checks make sure that the number of call-sites counted does
+        // not change relative to the time when the current set of inlining
+        // parameters was fixed.
+        // TODO(fschneider): Determine new heuristic parameters that avoid
+        // these checks entirely.
+        if (!call->IsSureToCallSingleRecognizedTarget() &&
+            (call->token_kind() != Token::kEQ)) {
           ++call_site_count_;
-          continue;
-        }
-        if (current->IsPolymorphicInstanceCall()) {
-          PolymorphicInstanceCallInstr* call =
-              current->AsPolymorphicInstanceCall();
-          // These checks make sure that the number of call-sites counted does
-          // not change relative to the time when the current set of inlining
-          // parameters was fixed.
-          // TODO(fschneider): Determine new heuristic parameters that avoid
-          // these checks entirely.
-          if (!call->IsSureToCallSingleRecognizedTarget() &&
-              (call->token_kind() != Token::kEQ)) {
-            ++call_site_count_;
-          }
         }
       }
     }
@@ -689,6 +719,10 @@ static bool IsSmallLeafOrReduction(int inlining_depth,
             instruction_count +=
                 (inl_size == 0 ? kAvgListedMethodSize : inl_size);
           }
+        } else if (current->AsStaticCall()->is_outlined_cold_path()) {
+          // The slow path of a partially inlined function does not make its
+          // fast path any less of a leaf.
+          instruction_count += current->AsStaticCall()->ArgumentCount();
         } else {
           ++call_count;
           instruction_count += current->AsStaticCall()->ArgumentCount();
@@ -996,7 +1030,8 @@ class CallSiteInliner : public ValueObject {
         collected_call_sites_(nullptr),
         inlining_call_sites_(nullptr),
         function_cache_(),
-        inlined_info_() {}
+        inlined_info_(),
+        report_(CompilerState::Current().report()) {}
 
   FlowGraph* caller_graph() const { return caller_graph_; }
 
@@ -1022,7 +1057,8 @@ class CallSiteInliner : public ValueObject {
   // Inlining heuristics based on Cooper et al. 2008.
   InliningDecision ShouldWeInline(const Function& callee,
                                   intptr_t instr_count,
-                                  intptr_t call_site_count) {
+                                  intptr_t call_site_count,
+                                  bool has_sinkable_arguments = false) {
     // Pragma or size heuristics.
     if (inliner_->AlwaysInline(callee)) {
       return InliningDecision::Yes("AlwaysInline");
@@ -1047,6 +1083,14 @@ class CallSiteInliner : public ValueObject {
       return InliningDecision::Yes("need to count first");
     } else if (instr_count <= FLAG_inlining_size_threshold) {
       return InliningDecision::Yes("--inlining-size-threshold");
+    } else if (has_sinkable_arguments &&
+               (instr_count <=
+                FLAG_inlining_sinkable_argument_size_threshold)) {
+      return InliningDecision::Yes(
+          "--inlining-sinkable-argument-size-threshold");
+    } else if ((instr_count <= FLAG_inlining_hot_callee_size_threshold) &&
+               IsProfiledHot(callee)) {
+      return InliningDecision::Yes("--inlining-hot-callee-size-threshold");
     } else if (call_site_count <= FLAG_inlining_callee_call_sites_threshold) {
       return InliningDecision::Yes("--inlining-callee-call-sites-threshold");
     }
@@ -1232,8 +1276,20 @@ class CallSiteInliner : public ValueObject {
         constant_arg_count == 0 ? function.optimized_instruction_count() : 0;
     const intptr_t call_site_count =
         constant_arg_count == 0 ? function.optimized_call_site_count() : 0;
-    volatile InliningDecision decision =
-        ShouldWeInline(function, instruction_count, call_site_count);
+    const bool has_sinkable_arguments = HasSinkableArguments(
+        function, *arguments, call_data->first_arg_index, argument_names);
+    InliningDecision early_decision =
+        ShouldWeInline(function, instruction_count, call_site_count,
+                       has_sinkable_arguments);
+    if (!early_decision.value && (instruction_count > 0)) {
+      // Functions which were partially inlined before are judged by the size
+      // of their fast path, which only has the call of the slow path.
+      const intptr_t fast_path_count = PartialInliningSizeFor(function);
+      if (fast_path_count > 0) {
+        early_decision = ShouldWeInline(function, fast_path_count, 1);
+      }
+    }
+    volatile InliningDecision decision = early_decision;
     if (!decision.value) {
       TRACE_INLINING(
           THR_Print("     Bailout: early heuristics (%s) with "
@@ -1460,8 +1516,24 @@ class CallSiteInliner : public ValueObject {
         // Use heuristics do decide if this call should be inlined.
         {
           COMPILER_TIMINGS_TIMER_SCOPE(thread(), MakeInliningDecision);
-          InliningDecision decision =
-              ShouldWeInline(function, instruction_count, call_site_count);
+          InliningDecision decision = ShouldWeInline(
+              function, instruction_count, call_site_count,
+              HasNonEscapingSinkableArguments(
+                  function, *arguments, call_data->first_arg_index,
+                  *param_stubs));
+          intptr_t fast_path_count = 0;
+          if (!decision.value &&
+              OutlineColdPath(function, entry_kind, callee_graph,
+                              *param_stubs, exit_collector,
+                              &fast_path_count)) {
+            RecordPartialInliningSize(function, fast_path_count);
+            decision = ShouldWeInline(function, fast_path_count, 1);
+            if (decision.value) {
+              TRACE_INLINING(THR_Print("     Partially inlined\n"));
+              instruction_count = fast_path_count;
+              call_site_count = 1;
+            }
+          }
           if (!decision.value) {
             // If size is larger than all thresholds, don't consider it again.
 
@@ -1469,7 +1541,13 @@ class CallSiteInliner : public ValueObject {
             // can identify highly-specialized functions that should always
             // be considered for inlining, without relying on a pragma.
             if ((instruction_count > FLAG_inlining_size_threshold) &&
-                (call_site_count > FLAG_inlining_callee_call_sites_threshold)) {
+                (instruction_count >
+                 FLAG_inlining_sinkable_argument_size_threshold) &&
+                (call_site_count > FLAG_inlining_callee_call_sites_threshold) &&
+                (PartialInliningSizeFor(function) == 0) &&
+                ((instruction_count >
+                  FLAG_inlining_hot_callee_size_threshold) ||
+                 !IsProfiledHot(function))) {
               // Will keep trying to inline the function if it can be
               // specialized based on argument types.
               if (!FlowGraphInliner::FunctionHasAlwaysConsiderInliningPragma(
@@ -1691,6 +1769,283 @@ class CallSiteInliner : public ValueObject {
     ASSERT(!call_data->call->HasMoveArguments());
   }
 
+  // Returns true if an allocation is passed for a parameter which does not
+  // escape the callee according to its summary.
+  static bool HasSinkableArguments(const Function& function,
+                                   const GrowableArray<Value*>& arguments,
+                                   intptr_t first_arg_index,
+                                   const Array& argument_names) {
+    const EscapeAnalysis::Summary summary =
+        EscapeAnalysis::SummaryFor(function);
+    if (summary == 0) {
+      return false;
+    }
+    const intptr_t positional =
+        arguments.length() -
+        (argument_names.IsNull() ? 0 : argument_names.Length());
+    for (intptr_t i = first_arg_index; i < positional; ++i) {
+      const intptr_t param = i - first_arg_index;
+      if ((param < EscapeAnalysis::kMaxParameters) &&
+          ((summary & (static_cast<EscapeAnalysis::Summary>(1) << param)) !=
+           0) &&
+          AllocationSinking::IsSinkableArgument(arguments[i])) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns true if an allocation is passed for a parameter which does not
+  // escape the callee graph built for this call site.
+  static bool HasNonEscapingSinkableArguments(
+      const Function& function,
+      const GrowableArray<Value*>& arguments,
+      intptr_t first_arg_index,
+      const ZoneGrowableArray<Definition*>& param_stubs) {
+    const intptr_t first_param_stub = function.IsGeneric() ? 1 : 0;
+    for (intptr_t i = 0; i < function.NumParameters(); ++i) {
+      Value* argument = arguments[first_arg_index + i];
+      if ((argument != nullptr) &&
+          AllocationSinking::IsSinkableArgument(argument) &&
+          EscapeAnalysis::DoesNotEscape(param_stubs[first_param_stub + i])) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns the size of the fast path of the given function if it was
+  // partially inlined before, or 0.
+  intptr_t PartialInliningSizeFor(const Function& function) const {
+#if defined(DART_PRECOMPILER)
+    if (inliner_->precompiler_ != nullptr) {
+      return inliner_->precompiler_->PartialInliningSizeFor(function);
+    }
+#endif
+    return 0;
+  }
+
+  // Returns true if the AOT profile marks the given function as hot.
+  bool IsProfiledHot(const Function& function) const {
+#if defined(DART_PRECOMPILER)
+    if ((inliner_->precompiler_ != nullptr) &&
+        (inliner_->precompiler_->profile() != nullptr)) {
+      const AotProfile::FunctionProfile* profile =
+          inliner_->precompiler_->profile()->Lookup(function);
+      return (profile != nullptr) && profile->is_hot;
+    }
+#endif
+    return false;
+  }
+
+  void RecordPartialInliningSize(const Function& function, intptr_t size) {
+#if defined(DART_PRECOMPILER)
+    if (inliner_->precompiler_ != nullptr) {
+      inliner_->precompiler_->RecordPartialInliningSize(function, size);
+    }
+#endif
+  }
+
+  // Returns true if executing the instruction a second time with the same
+  // inputs does not change the behavior of the program: it has no visible
+  // effect other than possibly throwing, which it did not do the first time.
+  static bool CanReexecute(Instruction* instr) {
+    if (!instr->MayHaveVisibleEffect()) {
+      return true;
+    }
+    return instr->IsCheckStackOverflow() || instr->IsAssertAssignable() ||
+           instr->IsAssertSubtype() || instr->IsCheckCondition() ||
+           instr->IsCheckNull() || instr->IsCheckClass() ||
+           instr->IsCheckClassId() || instr->IsCheckSmi() ||
+           instr->IsCheckBoundBase();
+  }
+
+  // Splits the callee graph of a function which is too large to be inlined
+  // into a fast path, which is inlined, and a slow path, which is replaced
+  // by a call of the function itself:
+  //
+  //     B0: prefix; Branch(c, B1, B2)        B0: prefix; Branch(c, B1, B2)
+  //     B1: fast path, no calls         =>   B1: fast path, no calls
+  //     B2: slow path, calls                 B2: v <- StaticCall(f, args)
+  //                                              Return(v)
+  //
+  // where the slow path consists of the blocks dominated by its first
+  // block. The call executes the prefix once more, so the prefix must not
+  // have any visible effects. Control flow from the slow path back into the
+  // fast path (e.g. a rare "grow" branch followed by the common code) is
+  // dropped along with the slow path.
+  //
+  // Only done in AOT, where the call does not need to resume in unoptimized
+  // code. Returns true if the graph was split, and the size of what is left
+  // in fast_path_count.
+  bool OutlineColdPath(const Function& function,
+                       Code::EntryKind entry_kind,
+                       FlowGraph* callee_graph,
+                       const ZoneGrowableArray<Definition*>& param_stubs,
+                       InlineExitCollector* exit_collector,
+                       intptr_t* fast_path_count) {
+    if (!FLAG_partial_inlining || !CompilerState::Current().is_aot() ||
+        function.IsGeneric() || function.HasOptionalParameters() ||
+        function.IsClosureFunction() || function.ForceOptimize() ||
+        (callee_graph->graph_entry()->SuccessorCount() != 1)) {
+      return false;
+    }
+    for (TryEntryInstr* try_entry : callee_graph->try_entries()) {
+      if (try_entry != nullptr) {
+        return false;
+      }
+    }
+
+    // Find the first branch. Everything up to it runs again in the call.
+    BlockEntryInstr* block = callee_graph->graph_entry()->normal_entry();
+    BranchInstr* branch = nullptr;
+    while (branch == nullptr) {
+      for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+        if (!it.Current()->IsGoto() && !it.Current()->IsBranch() &&
+            !CanReexecute(it.Current())) {
+          return false;
+        }
+      }
+      Instruction* last = block->last_instruction();
+      branch = last->AsBranch();
+      if (branch == nullptr) {
+        if (!last->IsGoto() ||
+            (last->SuccessorAt(0)->PredecessorCount() != 1)) {
+          return false;
+        }
+        block = last->SuccessorAt(0);
+      }
+    }
+    if (!CanReexecute(branch->condition())) {
+      return false;
+    }
+
+    // The slow path is the successor whose blocks have all calls.
+    const intptr_t block_count = callee_graph->preorder().length();
+    BitVector* cold_blocks = new (Z) BitVector(Z, block_count);
+    TargetEntryInstr* cold_entry = nullptr;
+    intptr_t hot_count = 0;
+    for (TargetEntryInstr* successor :
+         {branch->true_successor(), branch->false_successor()}) {
+      GraphInfoCollector cold_info;
+      GraphInfoCollector hot_info;
+      cold_blocks->Clear();
+      for (BlockEntryInstr* b : callee_graph->preorder()) {
+        if (successor->Dominates(b)) {
+          cold_blocks->Add(b->preorder_number());
+          cold_info.CollectBlock(*callee_graph, b);
+        } else {
+          hot_info.CollectBlock(*callee_graph, b);
+        }
+      }
+      if ((cold_info.call_site_count() > 0) &&
+          (hot_info.call_site_count() == 0)) {
+        cold_entry = successor;
+        hot_count = hot_info.instruction_count();
+        break;
+      }
+    }
+    if (cold_entry == nullptr) {
+      return false;
+    }
+    // The call and the return replacing the slow path.
+    const intptr_t num_params = function.NumParameters();
+    *fast_path_count = hot_count + num_params + 2;
+    if (*fast_path_count > FLAG_partial_inlining_size_threshold) {
+      return false;
+    }
+
+    // Drop the slow path. Phis in the fast path lose their inputs from it.
+    for (BlockEntryInstr* b : callee_graph->preorder()) {
+      if (cold_blocks->Contains(b->preorder_number())) {
+        if (b != cold_entry) {
+          b->ClearAllInstructions();
+        }
+      } else if (JoinEntryInstr* join = b->AsJoinEntry()) {
+        RemoveColdPhiInputs(join, cold_blocks);
+      }
+    }
+    for (ForwardInstructionIterator it(cold_entry); !it.Done(); it.Advance()) {
+      it.Current()->UnuseAllInputs();
+    }
+    // Detach the dropped instructions, so that exits among them are found
+    // to be unreachable.
+    cold_entry->next()->set_previous(nullptr);
+
+    // Only the outermost environment is used in AOT (for catch entry
+    // moves), so the environments of the new instructions only need the
+    // parameters and the arguments of the call.
+    GrowableArray<Definition*> env_defs(2 * num_params);
+    InputsArray arguments(Z, num_params);
+    for (intptr_t i = 0; i < num_params; ++i) {
+      env_defs.Add(param_stubs[i]);
+      arguments.Add(new (Z) Value(param_stubs[i]));
+    }
+    const ParsedFunction& parsed_function = callee_graph->parsed_function();
+    Environment* return_env =
+        Environment::From(Z, env_defs, function.num_fixed_parameters(), 0,
+                          parsed_function);
+    for (intptr_t i = 0; i < num_params; ++i) {
+      env_defs.Add(param_stubs[i]);
+    }
+    Environment* call_env =
+        Environment::From(Z, env_defs, function.num_fixed_parameters(), 0,
+                          parsed_function);
+
+    auto& compiler_state = CompilerState::Current();
+    StaticCallInstr* call = new (Z) StaticCallInstr(
+        branch->source(), function, /*type_args_len=*/0, Object::null_array(),
+        std::move(arguments), compiler_state.GetNextDeoptId(),
+        /*call_count=*/0, ICData::kNoRebind);
+    call->set_entry_kind(entry_kind);
+    call->set_is_outlined_cold_path(true);
+    call->InitResultType(Z);
+    callee_graph->AppendTo(cold_entry, call, call_env, FlowGraph::kValue);
+    DartReturnInstr* ret =
+        new (Z) DartReturnInstr(branch->source(), new (Z) Value(call),
+                                compiler_state.GetNextDeoptId());
+    callee_graph->AppendTo(call, ret, return_env, FlowGraph::kEffect);
+    cold_entry->set_last_instruction(ret);
+    exit_collector->AddExit(ret);
+
+    callee_graph->DiscoverBlocks();
+    GrowableArray<BitVector*> dominance_frontier;
+    callee_graph->ComputeDominators(&dominance_frontier);
+#if defined(DEBUG)
+    FlowGraphChecker(callee_graph).Check("OutlineColdPath (callee)");
+#endif
+    return true;
+  }
+
+  // Removes the inputs of the phis of the join which flow in from the given
+  // blocks. Predecessors are kept in block id order when they are
+  // recomputed, so the remaining inputs only need to be compacted.
+  static void RemoveColdPhiInputs(JoinEntryInstr* join,
+                                  BitVector* cold_blocks) {
+    const intptr_t pred_count = join->PredecessorCount();
+    intptr_t live_count = 0;
+    for (intptr_t pred_idx = 0; pred_idx < pred_count; ++pred_idx) {
+      BlockEntryInstr* pred = join->PredecessorAt(pred_idx);
+      const bool is_cold = cold_blocks->Contains(pred->preorder_number());
+      for (PhiIterator it(join); !it.Done(); it.Advance()) {
+        PhiInstr* phi = it.Current();
+        if (is_cold) {
+          phi->InputAt(pred_idx)->RemoveFromUseList();
+        } else if (live_count < pred_idx) {
+          phi->SetInputAt(live_count, phi->InputAt(pred_idx));
+        }
+      }
+      if (!is_cold) {
+        ++live_count;
+      }
+    }
+    if (live_count < pred_count) {
+      for (PhiIterator it(join); !it.Done(); it.Advance()) {
+        it.Current()->inputs_.TruncateTo(live_count);
+      }
+    }
+  }
+
   static intptr_t CountConstants(const GrowableArray<Value*>& arguments) {
     intptr_t count = 0;
     for (intptr_t i = 0; i < arguments.length(); i++) {
@@ -1722,6 +2077,14 @@ class CallSiteInliner : public ValueObject {
     for (intptr_t call_idx = 0; call_idx < call_info.length(); ++call_idx) {
       StaticCallInstr* call = call_info[call_idx].call;
       const Function& target = call->function();
+      if (call->is_outlined_cold_path()) {
+        // The rest of a partially inlined function, see OutlineColdPath.
+        TRACE_INLINING(THR_Print("  => %s\n     Bailout: cold path\n",
+                                 target.ToFullyQualifiedCString()));
+        PRINT_INLINING_TREE("Cold path", &call_info[call_idx].caller(),
+                            &call->function(), call);
+        continue;
+      }
       if (!inliner_->AlwaysInline(target) &&
           (call_info[call_idx].ratio * 100) < FLAG_inlining_hotness) {
         if (trace_inlining()) {
@@ -1821,8 +2184,11 @@ class CallSiteInliner : public ValueObject {
                              call_info.length()));
     for (intptr_t call_idx = 0; call_idx < call_info.length(); ++call_idx) {
       PolymorphicInstanceCallInstr* call = call_info[call_idx].call;
-      // PolymorphicInliner introduces deoptimization paths.
-      if (!call->complete() && !FLAG_polymorphic_with_deopt) {
+      // PolymorphicInliner introduces deoptimization paths, except in AOT
+      // where receivers which are not covered by the call use a generic
+      // instance call.
+      if (!call->complete() && !FLAG_polymorphic_with_deopt &&
+          !(CompilerState::Current().is_aot() && call->HasICData())) {
         TRACE_INLINING(THR_Print("  => %s\n     Bailout: call with checks\n",
                                  call->function_name().ToCString()));
         continue;
@@ -1947,6 +2313,7 @@ class CallSiteInliner : public ValueObject {
   CallSites* inlining_call_sites_;
   GrowableArray<ParsedFunction*> function_cache_;
   GrowableArray<InlinedInfo> inlined_info_;
+  CompilationReport* const report_;
 
   DISALLOW_COPY_AND_ASSIGN(CallSiteInliner);
 };
@@ -2117,13 +2484,19 @@ TargetEntryInstr* PolymorphicInliner::BuildDecisionGraph() {
       new (Z) LoadClassIdInstr(new (Z) Value(receiver), cid_representation);
   owner_->caller_graph()->AllocateSSAIndex(load_cid);
   cursor = AppendInstruction(cursor, load_cid);
+  // AOT code cannot deoptimize, so receivers of an incomplete call which are
+  // not covered by any variant fall through to a generic instance call.
+  const bool needs_generic_fallback = !call_->complete() &&
+                                      CompilerState::Current().is_aot() &&
+                                      non_inlined_variants_->is_empty();
   for (intptr_t i = 0; i < inlined_variants_.length(); ++i) {
     const CidRange& variant = inlined_variants_[i];
     bool is_last_test = (i == inlined_variants_.length() - 1);
     // 1. Guard the body with a class id check.  We don't need any check if
     // it's the last test and global analysis has told us that the call is
     // complete.
-    if (is_last_test && non_inlined_variants_->is_empty()) {
+    if (is_last_test && non_inlined_variants_->is_empty() &&
+        !needs_generic_fallback) {
       // If it is the last variant use a check class id instruction which can
       // deoptimize, followed unconditionally by the body. Omit the check if
       // we know that we have covered all possible classes.
@@ -2275,6 +2648,35 @@ TargetEntryInstr* PolymorphicInliner::BuildDecisionGraph() {
                       fallback_return);
     exit_collector_->AddExit(fallback_return);
     cursor = nullptr;
+  } else if (needs_generic_fallback) {
+    InputsArray args(Z, call_->ArgumentCount());
+    for (intptr_t i = 0, n = call_->ArgumentCount(); i < n; ++i) {
+      args.Add(call_->ArgumentValueAt(i)->CopyWithType(Z));
+    }
+    InstanceCallInstr* fallback_call = new (Z) InstanceCallInstr(
+        call_->source(), call_->function_name(), call_->token_kind(),
+        std::move(args), call_->type_args_len(), call_->argument_names(),
+        call_->ic_data()->NumArgsTested(), call_->deopt_id(),
+        call_->interface_target(), call_->tearoff_interface_target());
+    fallback_call->set_ic_data(call_->ic_data());
+    if (call_->result_type() != nullptr) {
+      fallback_call->SetResultType(Z, *call_->result_type());
+    }
+    fallback_call->set_entry_kind(call_->entry_kind());
+    fallback_call->set_has_unique_selector(call_->has_unique_selector());
+    if (call_->is_call_on_this()) {
+      fallback_call->mark_as_call_on_this();
+    }
+    owner_->caller_graph()->AllocateSSAIndex(fallback_call);
+    fallback_call->InheritDeoptTarget(zone(), call_);
+    DartReturnInstr* fallback_return = new DartReturnInstr(
+        call_->source(), new Value(fallback_call), DeoptId::kNone);
+    fallback_return->InheritDeoptTargetAfter(owner_->caller_graph(), call_,
+                                             fallback_call);
+    AppendInstruction(AppendInstruction(cursor, fallback_call),
+                      fallback_return);
+    exit_collector_->AddExit(fallback_return);
+    cursor = nullptr;
   }
   return entry;
 }
@@ -368,6 +368,68 @@ ISOLATE_UNIT_TEST_CASE(Inliner_List_of_inlined) {
                       String::Cast(it.AsConstant()->value()).Equals("100"));
 }
 
+// Verifies that the fast path of a function which is too large to be
+// inlined is inlined, and that the call of its slow path is moved to the end
+// of the code.
+ISOLATE_UNIT_TEST_CASE(Inliner_PartialInlining) {
+  const char* kScript = R"(
+    class Cache {
+      int? value;
+    }
+
+    @pragma("vm:never-inline")
+    int slow(int x) => x * 7 + 1;
+
+    int compute(Cache cache, int key) {
+      final v = cache.value;
+      if (v != null) {
+        return v;
+      }
+      int result = 0;
+      for (int i = 0; i < key; i++) {
+        result += slow(i) * slow(i + 1) - slow(i + 2);
+        result ^= slow(result) + slow(key);
+      }
+      cache.value = result;
+      return result;
+    }
+
+    int foo(Cache cache) => compute(cache, 10);
+
+    main() {
+      foo(Cache());
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  StaticCallInstr* cold_call = nullptr;
+  intptr_t num_calls = 0;
+  intptr_t call_position = -1;
+  intptr_t return_position = -1;
+  const auto& order = *flow_graph->CodegenBlockOrder();
+  for (intptr_t i = 0; i < order.length(); ++i) {
+    for (ForwardInstructionIterator it(order[i]); !it.Done(); it.Advance()) {
+      if (auto call = it.Current()->AsStaticCall()) {
+        cold_call = call;
+        call_position = i;
+        ++num_calls;
+      } else if (it.Current()->IsDartReturn()) {
+        return_position = i;
+      }
+    }
+  }
+  EXPECT_EQ(1, num_calls);
+  RELEASE_ASSERT(cold_call != nullptr);
+  EXPECT(cold_call->is_outlined_cold_path());
+  EXPECT_STREQ("compute", cold_call->function().UserVisibleNameCString());
+  EXPECT(call_position > return_position);
+}
+
 #endif  // defined(DART_PRECOMPILER)
 
 // Test that when force-optimized functions get inlined, deopt_id and
@@ -17,6 +17,13 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            aot_coalescing_register_allocator,
+            false,
+            "In AOT mode, allocate phis to the registers of their inputs and "
+            "prefer evicting values which are not used inside of loops. "
+            "Experimental: compare --print_instruction_stats before enabling.");
+
 #if !defined(PRODUCT)
 #define INCLUDE_LINEAR_SCAN_TRACING_CODE
 #endif
@@ -114,7 +121,9 @@ FlowGraphAllocator::FlowGraphAllocator(const FlowGraph& flow_graph,
       quad_spill_slots_(),
       untagged_spill_slots_(),
       cpu_spill_slot_count_(0),
-      intrinsic_mode_(intrinsic_mode) {
+      intrinsic_mode_(intrinsic_mode),
+      coalescing_(!intrinsic_mode && CompilerState::Current().is_aot() &&
+                  FLAG_aot_coalescing_register_allocator) {
   for (intptr_t i = 0; i < vreg_count_; i++) {
     live_ranges_.Add(nullptr);
   }
@@ -2463,6 +2472,13 @@ bool FlowGraphAllocator::AllocateFreeRegister(LiveRange* unallocated) {
     }
   }
 
+  // Try to coalesce a phi with one of its inputs so that the phi move on
+  // the corresponding edge becomes redundant. Inputs on back edges are
+  // allocated after the phi and are hinted with its location instead.
+  if (!hint.IsMachineRegister() && coalescing_) {
+    hint = PhiInputHint(unallocated);
+  }
+
   if (hint.IsMachineRegister()) {
     if (!blocked_registers_[hint.register_code()]) {
       free_until =
@@ -2597,6 +2613,47 @@ bool FlowGraphAllocator::AllocateFreeRegister(LiveRange* unallocated) {
   return true;
 }
 
+Location FlowGraphAllocator::PhiInputHint(LiveRange* range) {
+  const intptr_t vreg = range->vreg();
+  if ((vreg < 0) || (live_ranges_[vreg] != range)) {
+    return Location::NoLocation();
+  }
+  JoinEntryInstr* join = BlockEntryAt(range->Start())->AsJoinEntry();
+  if ((join == nullptr) || (join->start_pos() != range->Start())) {
+    return Location::NoLocation();
+  }
+  for (PhiIterator it(join); !it.Done(); it.Advance()) {
+    PhiInstr* phi = it.Current();
+    intptr_t pair_index;
+    if (phi->vreg(0) == vreg) {
+      pair_index = 0;
+    } else if (phi->HasPairRepresentation() && (phi->vreg(1) == vreg)) {
+      pair_index = 1;
+    } else {
+      continue;
+    }
+    for (intptr_t i = 0; i < phi->InputCount(); i++) {
+      Definition* input = phi->InputAt(i)->definition();
+      if (input->IsConstant()) continue;
+      const intptr_t pos = join->PredecessorAt(i)->end_pos() - 1;
+      for (LiveRange* sibling = live_ranges_[input->vreg(pair_index)];
+           sibling != nullptr; sibling = sibling->next_sibling()) {
+        if (sibling->CanCover(pos)) {
+          const Location loc = sibling->assigned_location();
+          if (loc.IsMachineRegister() && (loc.kind() == register_kind_)) {
+            TRACE_ALLOC(THR_Print("found phi input hint %s for v%" Pd "\n",
+                                  loc.Name(), vreg));
+            return loc;
+          }
+          break;
+        }
+      }
+    }
+    break;
+  }
+  return Location::NoLocation();
+}
+
 bool FlowGraphAllocator::RangeHasOnlyUnconstrainedUsesInLoop(LiveRange* range,
                                                              intptr_t loop_id) {
   if (range->vreg() >= 0) {
@@ -2681,6 +2738,36 @@ void FlowGraphAllocator::AllocateAnyRegister(LiveRange* unallocated) {
 
   ASSERT(candidate != kNoRegister);
 
+  // For a range starting at a loop header, the register whose interference
+  // is used the farthest away might still be used inside of the loop, and
+  // evicting it would add reloads to every iteration. Prefer a register
+  // which is cheap to evict instead if it is free long enough.
+  BlockEntryInstr* header = BlockEntryAt(unallocated->Start());
+  if (coalescing_ && header->IsLoopHeader() &&
+      (header->start_pos() == unallocated->Start()) &&
+      !IsCheapToEvictRegisterInLoop(header->loop_info(), candidate)) {
+    LoopInfo* loop_info = header->loop_info();
+    for (int i = 0; i < NumberOfRegisters(); ++i) {
+      const int reg = (i + kRegisterAllocationBias) % NumberOfRegisters();
+      if (blocked_registers_[reg] || (reg == candidate) ||
+          !IsCheapToEvictRegisterInLoop(loop_info, reg)) {
+        continue;
+      }
+      intptr_t reg_free_until = register_use_pos - 1;
+      intptr_t reg_blocked_at = kMaxPosition;
+      if (UpdateFreeUntil(reg, unallocated, &reg_free_until,
+                          &reg_blocked_at)) {
+        TRACE_ALLOC(THR_Print("preferring %s for v%" Pd
+                              ": cheap to evict in loop\n",
+                              MakeRegisterLocation(reg).Name(),
+                              unallocated->vreg()));
+        candidate = reg;
+        blocked_at = reg_blocked_at;
+        break;
+      }
+    }
+  }
+
   TRACE_ALLOC(THR_Print("assigning blocked register "));
   TRACE_ALLOC(MakeRegisterLocation(candidate).Print());
   TRACE_ALLOC(THR_Print(" to live range v%" Pd " until %" Pd "\n",
@@ -221,6 +221,11 @@ class FlowGraphAllocator : public ValueObject {
   // the unallocated live range as possible.
   void AllocateAnyRegister(LiveRange* unallocated);
 
+  // Returns the register assigned to one of the inputs of the phi defined
+  // by the given live range at the end of the corresponding predecessor, or
+  // no location. Allocating the phi there makes that phi move redundant.
+  Location PhiInputHint(LiveRange* range);
+
   // Returns true if the given range has only unconstrained uses in
   // the given loop.
   bool RangeHasOnlyUnconstrainedUsesInLoop(LiveRange* range, intptr_t loop_id);
@@ -395,6 +400,10 @@ class FlowGraphAllocator : public ValueObject {
 
   const bool intrinsic_mode_;
 
+  // Whether to spend more compilation time on better allocation decisions
+  // (see --aot_coalescing_register_allocator).
+  const bool coalescing_;
+
   DISALLOW_COPY_AND_ASSIGN(FlowGraphAllocator);
 };
 
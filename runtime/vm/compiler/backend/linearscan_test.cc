@@ -7,13 +7,18 @@
 #include <utility>
 
 #include "vm/compiler/backend/block_builder.h"
+#include "vm/compiler/backend/code_statistics.h"
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
 #include "vm/unit_test.h"
 #include "vm/zone_text_buffer.h"
 
 namespace dart {
 
+DECLARE_FLAG(bool, aot_coalescing_register_allocator);
+
 class DummyDef : public Definition {
  public:
   explicit DummyDef(
@@ -216,4 +221,133 @@ ISOLATE_UNIT_TEST_CASE(LinearScan_TestSameAsFirstOrSecondNoFlip2) {
   EXPECT_PROPERTY(binop->InputAt(1)->definition(), &it == rhs);
 }
 
+struct AllocatorMoves {
+  // Moves which are not redundant on the edges into joins.
+  intptr_t join_moves;
+  // Spills and reloads inside of loops, as counted by
+  // --print_instruction_stats.
+  intptr_t spills_in_loops;
+  intptr_t reloads_in_loops;
+};
+
+static AllocatorMoves CountAllocatorMoves(const Library& root_library,
+                                          const char* name,
+                                          CompilerPass::PipelineMode mode,
+                                          bool coalescing) {
+  SetFlagScope<bool> sfs(&FLAG_aot_coalescing_register_allocator, coalescing);
+  const auto& function = Function::Handle(GetFunction(root_library, name));
+  TestPipeline pipeline(function, mode);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  compiler::ObjectPoolBuilder object_pool_builder;
+  compiler::Assembler assembler(&object_pool_builder);
+  CodeStatistics stats(&assembler);
+  intptr_t join_moves = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    BlockEntryInstr* block = block_it.Current();
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      ParallelMoveInstr* parallel_move = it.Current()->AsParallelMove();
+      GotoInstr* goto_instr = it.Current()->AsGoto();
+      if ((goto_instr != nullptr) && goto_instr->HasParallelMove()) {
+        parallel_move = goto_instr->parallel_move();
+        for (intptr_t i = 0; i < parallel_move->NumMoves(); i++) {
+          if (!parallel_move->MoveOperandsAt(i)->IsRedundant()) {
+            join_moves++;
+          }
+        }
+      }
+      if ((parallel_move != nullptr) && (block->loop_info() != nullptr)) {
+        stats.CountMoves(parallel_move);
+      }
+    }
+  }
+  return {join_moves, stats.spill_count(), stats.reload_count()};
+}
+
+ISOLATE_UNIT_TEST_CASE(LinearScan_AOTCoalescesPhiWithInput) {
+  const char* kScript = R"(
+    @pragma('vm:never-inline')
+    int foo(int a, int b, bool c) {
+      int x;
+      if (c) {
+        x = a * 3;
+      } else {
+        x = b * 5;
+      }
+      return (x < a) ? 1 : 2;
+    }
+
+    main() {
+      foo(1, 2, true);
+      foo(3, 4, false);
+    }
+  )";
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+
+  const AllocatorMoves before =
+      CountAllocatorMoves(root_library, "foo", CompilerPass::kAOT, false);
+  const AllocatorMoves after =
+      CountAllocatorMoves(root_library, "foo", CompilerPass::kAOT, true);
+
+  // The phi x is allocated to the register of one of its inputs, so at most
+  // the move on the other edge is left.
+  EXPECT(after.join_moves <= before.join_moves);
+  EXPECT(after.join_moves <= 1);
+}
+
+static const char* kLoopPressureScript = R"(
+  @pragma('vm:never-inline')
+  int foo(List<int> l, int n) {
+    final a = l[0], b = l[1], c = l[2], d = l[3];
+    final e = l[4], f = l[5], g = l[6], h = l[7];
+    final i = l[8], j = l[9], k = l[10], m = l[11];
+    int sum = 0;
+    for (int x = 0; x < n; x++) {
+      sum = (sum ^ (a * x)) + b;
+    }
+    return sum + a + b + c + d + e + f + g + h + i + j + k + m;
+  }
+
+  main() {
+    final l = List<int>.generate(12, (i) => i);
+    for (int i = 0; i < 10; i++) {
+      foo(l, 100);
+    }
+  }
+)";
+
+ISOLATE_UNIT_TEST_CASE(LinearScan_AOTEvictsValuesUnusedInLoop) {
+  const auto& root_library =
+      Library::Handle(LoadTestScript(kLoopPressureScript));
+  Invoke(root_library, "main");
+
+  const AllocatorMoves before =
+      CountAllocatorMoves(root_library, "foo", CompilerPass::kAOT, false);
+  const AllocatorMoves after =
+      CountAllocatorMoves(root_library, "foo", CompilerPass::kAOT, true);
+
+  // Values which are only used after the loop are spilled rather than
+  // reloaded in every iteration.
+  EXPECT(after.spills_in_loops + after.reloads_in_loops <=
+         before.spills_in_loops + before.reloads_in_loops);
+  EXPECT(after.join_moves <= before.join_moves);
+}
+
+ISOLATE_UNIT_TEST_CASE(LinearScan_JITIgnoresCoalescing) {
+  const auto& root_library =
+      Library::Handle(LoadTestScript(kLoopPressureScript));
+  Invoke(root_library, "main");
+
+  const AllocatorMoves before =
+      CountAllocatorMoves(root_library, "foo", CompilerPass::kJIT, false);
+  const AllocatorMoves after =
+      CountAllocatorMoves(root_library, "foo", CompilerPass::kJIT, true);
+
+  EXPECT_EQ(before.join_moves, after.join_moves);
+  EXPECT_EQ(before.spills_in_loops, after.spills_in_loops);
+  EXPECT_EQ(before.reloads_in_loops, after.reloads_in_loops);
+}
+
 }  // namespace dart
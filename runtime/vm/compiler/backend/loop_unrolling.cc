@@ -0,0 +1,660 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_unrolling.h"
+
+#include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/range_analysis.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/flags.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool, loop_unrolling, true, "Unroll and peel small inner loops.");
+DEFINE_FLAG(int,
+            max_loop_unroll_factor,
+            4,
+            "Maximum number of body copies in a partially unrolled loop.");
+DEFINE_FLAG(int,
+            max_loop_peel_trip_count,
+            8,
+            "Maximum constant trip count of a fully unrolled loop.");
+DEFINE_FLAG(int,
+            loop_unrolling_budget,
+            64,
+            "Maximum number of instructions in an unrolled loop.");
+DEFINE_FLAG(bool, trace_loop_unrolling, false, "Trace loop unrolling.");
+
+// Quick access to the locally defined zone() method.
+#define Z (zone())
+
+#define TRACE_LOOP_UNROLLING(statement)                                        \
+  if (FLAG_support_il_printer && FLAG_trace_loop_unrolling &&                  \
+      CompilerState::ShouldTrace()) {                                          \
+    statement;                                                                 \
+  }
+
+LoopUnroller::LoopUnroller(FlowGraph* flow_graph)
+    : flow_graph_(flow_graph),
+      header_(nullptr),
+      back_edge_(nullptr),
+      exit_(nullptr),
+      exit_join_(nullptr) {}
+
+bool LoopUnroller::Optimize() {
+  if (!FLAG_loop_unrolling || (FLAG_optimization_level <= 1) ||
+      flow_graph_->is_huge_method()) {
+    return false;
+  }
+
+  // Partial unrolling only trades code size for fewer back edges, so it
+  // gets a smaller budget in AOT unless optimizing for speed.
+  const intptr_t budget = (FLAG_optimization_level >= 3)
+                              ? 2 * FLAG_loop_unrolling_budget
+                              : FLAG_loop_unrolling_budget;
+  const intptr_t unroll_budget =
+      (CompilerState::Current().is_aot() && (FLAG_optimization_level < 3))
+          ? budget / 2
+          : budget;
+
+  // Collect the candidates first, since every transformation invalidates
+  // the loop hierarchy. Loop headers survive the transformation.
+  GrowableArray<BlockEntryInstr*> headers;
+  for (BlockEntryInstr* header : flow_graph_->GetLoopHierarchy().headers()) {
+    if (header->loop_info()->inner() == nullptr) {
+      headers.Add(header);
+    }
+  }
+
+  bool changed = false;
+  for (BlockEntryInstr* header : headers) {
+    const LoopHierarchy& loop_hierarchy = flow_graph_->GetLoopHierarchy();
+    loop_hierarchy.ComputeInduction();
+    LoopInfo* loop = header->loop_info();
+    intptr_t size = 0;
+    if ((loop == nullptr) || (loop->header() != header) ||
+        !CanTransform(loop, &size)) {
+      continue;
+    }
+
+    const int64_t trip_count = TripCount(loop);
+    if ((trip_count > 0) && (trip_count <= FLAG_max_loop_peel_trip_count) &&
+        (trip_count * size <= budget)) {
+      TRACE_LOOP_UNROLLING(THR_Print("Peeling loop B%" Pd " %" Pd64 " times\n",
+                                     header->block_id(), trip_count));
+      Transform(loop, trip_count, /*peel=*/true);
+    } else if (loop->control() != nullptr) {
+      const intptr_t factor = Utils::Minimum<intptr_t>(
+          FLAG_max_loop_unroll_factor, unroll_budget / size);
+      if ((factor < 2) || ((trip_count >= 0) && (trip_count < factor))) {
+        continue;
+      }
+      TRACE_LOOP_UNROLLING(THR_Print("Unrolling loop B%" Pd " by %" Pd "\n",
+                                     header->block_id(), factor));
+      Transform(loop, factor - 1, /*peel=*/false);
+    } else {
+      continue;
+    }
+    changed = true;
+
+    // The copies changed the block order and the dominator tree.
+    flow_graph_->DiscoverBlocks();
+    GrowableArray<BitVector*> dominance_frontier;
+    flow_graph_->ComputeDominators(&dominance_frontier);
+  }
+  return changed;
+}
+
+bool LoopUnroller::CanTransform(LoopInfo* loop, intptr_t* size) {
+  // Innermost loop with a single entry and a single back edge.
+  JoinEntryInstr* header = loop->header()->AsJoinEntry();
+  if ((loop->inner() != nullptr) || (header == nullptr) ||
+      (header->PredecessorCount() != 2) || (loop->back_edges().length() != 1) ||
+      !loop->back_edges()[0]->last_instruction()->IsGoto()) {
+    return false;
+  }
+
+  // The only exit is taken by the branch ending the header.
+  BranchInstr* branch = header->last_instruction()->AsBranch();
+  if (branch == nullptr) {
+    return false;
+  }
+  const bool true_exits = !loop->Contains(branch->true_successor());
+  const bool false_exits = !loop->Contains(branch->false_successor());
+  if (true_exits == false_exits) {
+    return false;
+  }
+  TargetEntryInstr* exit =
+      true_exits ? branch->true_successor() : branch->false_successor();
+  if (exit->InsideTryBlock()) {
+    return false;
+  }
+
+  intptr_t count = 0;
+  for (BlockIterator it = flow_graph_->reverse_postorder_iterator();
+       !it.Done(); it.Advance()) {
+    BlockEntryInstr* block = it.Current();
+    if (!loop->Contains(block)) {
+      continue;
+    }
+    if ((!block->IsJoinEntry() && !block->IsTargetEntry()) ||
+        block->InsideTryBlock()) {
+      return false;
+    }
+    if (block != header) {
+      for (intptr_t i = 0, n = block->SuccessorCount(); i < n; ++i) {
+        if (!loop->Contains(block->SuccessorAt(i))) {
+          return false;
+        }
+      }
+    }
+    for (ForwardInstructionIterator instr_it(block); !instr_it.Done();
+         instr_it.Advance()) {
+      Instruction* current = instr_it.Current();
+      if (!CanCopy(current)) {
+        return false;
+      }
+      if (!current->IsGoto() && !current->IsCheckStackOverflow()) {
+        count++;
+      }
+    }
+  }
+
+  // Header definitions that are used after the loop are merged by phis
+  // at the exit, which cannot hold untagged values.
+  for (ForwardInstructionIterator it(header); !it.Done(); it.Advance()) {
+    Definition* def = it.Current()->AsDefinition();
+    if ((def != nullptr) && (def->representation() == kUntagged)) {
+      for (Value::Iterator use_it(def->input_use_list()); !use_it.Done();
+           use_it.Advance()) {
+        if (!loop->Contains(use_it.Current()->instruction()->GetBlock())) {
+          return false;
+        }
+      }
+    }
+  }
+
+  *size = count;
+  return count > 0;
+}
+
+bool LoopUnroller::CanCopy(Instruction* instr) {
+  if (instr->IsGoto() || instr->IsCheckStackOverflow()) {
+    return true;
+  }
+  if (auto branch = instr->AsBranch()) {
+    ConditionInstr* condition = branch->condition();
+    return (condition->InputCount() == 2) &&
+           (condition->IsRelationalOp() || condition->IsEqualityCompare() ||
+            condition->IsStrictCompare() || condition->IsTestInt());
+  }
+  if (auto op = instr->AsBinaryIntegerOp()) {
+    switch (op->op_kind()) {
+      case Token::kSHL:
+      case Token::kSHR:
+      case Token::kUSHR:
+        // The range of a variable shift count is recorded on the shift
+        // itself by range analysis and cannot be reconstructed.
+        return op->right()->BindsToConstant();
+      default:
+        return true;
+    }
+  }
+  if (auto unbox = instr->AsUnbox()) {
+    switch (unbox->representation()) {
+      case kUnboxedInt32:
+      case kUnboxedUint32:
+      case kUnboxedInt64:
+      case kUnboxedDouble:
+      case kUnboxedFloat:
+      case kUnboxedFloat32x4:
+      case kUnboxedFloat64x2:
+      case kUnboxedInt32x4:
+        return true;
+      default:
+        return false;
+    }
+  }
+  if (auto load = instr->AsLoadField()) {
+    return !load->calls_initializer();
+  }
+  return instr->IsUnaryIntegerOp() || instr->IsBox() ||
+         instr->IsIntConverter() || instr->IsLoadIndexed() ||
+         instr->IsStoreIndexed() || instr->IsCheckArrayBound() ||
+         instr->IsGenericCheckBound() || instr->IsCheckSmi() ||
+         instr->IsBinaryDoubleOp();
+}
+
+int64_t LoopUnroller::TripCount(LoopInfo* loop) {
+  InductionVar* control = loop->control();
+  int64_t stride = 0;
+  int64_t initial = 0;
+  if (!InductionVar::IsLinear(control, &stride) ||
+      !InductionVar::IsConstant(control->initial(), &initial)) {
+    return -1;
+  }
+  for (const auto& bound : control->bounds()) {
+    int64_t limit = 0;
+    if ((bound.branch_ != loop->header()->last_instruction()) ||
+        !InductionVar::IsConstant(bound.limit_, &limit)) {
+      continue;
+    }
+    // The bound is strict: i < U (i++) or i > L (i--).
+    uint64_t count = 0;
+    if ((stride == 1) && (initial < limit)) {
+      count = static_cast<uint64_t>(limit) - static_cast<uint64_t>(initial);
+    } else if ((stride == -1) && (initial > limit)) {
+      count = static_cast<uint64_t>(initial) - static_cast<uint64_t>(limit);
+    }
+    return static_cast<int64_t>(
+        Utils::Minimum<uint64_t>(count, static_cast<uint64_t>(kMaxInt64)));
+  }
+  return -1;
+}
+
+void LoopUnroller::Transform(LoopInfo* loop, intptr_t copies, bool peel) {
+  ASSERT(copies > 0);
+  header_ = loop->header()->AsJoinEntry();
+  back_edge_ = loop->back_edges()[0];
+  BranchInstr* branch = header_->last_instruction()->AsBranch();
+  exit_ = loop->Contains(branch->true_successor()) ? branch->false_successor()
+                                                   : branch->true_successor();
+
+  blocks_.Clear();
+  in_loop_.Clear();
+  for (BlockIterator it = flow_graph_->reverse_postorder_iterator();
+       !it.Done(); it.Advance()) {
+    BlockEntryInstr* block = it.Current();
+    if (loop->Contains(block)) {
+      blocks_.Add(block);
+      in_loop_.Insert(BlockKV::Pair(block, block));
+    }
+  }
+  ASSERT(blocks_[0] == header_);
+
+  // Predecessors of the header and the matching header phi inputs. They
+  // are tracked here as the copies are emitted, since the predecessor
+  // lists are only recomputed at the end.
+  const intptr_t back_index = (header_->PredecessorAt(0) == back_edge_) ? 0 : 1;
+  const intptr_t entry_index = 1 - back_index;
+  BlockEntryInstr* entry_pred = header_->PredecessorAt(entry_index);
+  BlockEntryInstr* back_pred = back_edge_;
+  GrowableArray<Definition*> entry_values;
+  header_phis_.Clear();
+  back_values_.Clear();
+  for (PhiIterator it(header_); !it.Done(); it.Advance()) {
+    PhiInstr* phi = it.Current();
+    header_phis_.Add(phi);
+    entry_values.Add(phi->InputAt(entry_index)->definition());
+    back_values_.Add(phi->InputAt(back_index)->definition());
+  }
+  GrowableArray<Definition*> back_values(back_values_.length());
+  back_values.AddArray(back_values_);
+
+  SplitExit();
+
+  // Peeled copies are chained on the entry edge, unrolled copies on the
+  // back edge. Each copy continues with the values its back edge computed.
+  BlockEntryInstr*& from = peel ? entry_pred : back_pred;
+  GrowableArray<Definition*>& values = peel ? entry_values : back_values;
+  for (intptr_t i = 0; i < copies; ++i) {
+    from = CopyLoop(from, values);
+    for (intptr_t j = 0; j < header_phis_.length(); ++j) {
+      values[j] = Lookup(back_values_[j]);
+    }
+    for (intptr_t j = 0; j < exit_defs_.length(); ++j) {
+      exit_values_[j]->Add(Lookup(exit_defs_[j]));
+    }
+  }
+
+  // Rewire the header phis. Predecessors are ordered by block id.
+  const bool entry_first = entry_pred->block_id() < back_pred->block_id();
+  for (intptr_t j = 0; j < header_phis_.length(); ++j) {
+    PhiInstr* phi = header_phis_[j];
+    phi->InputAt(0)->BindTo(entry_first ? entry_values[j] : back_values[j]);
+    phi->InputAt(1)->BindTo(entry_first ? back_values[j] : entry_values[j]);
+  }
+
+  // Merge the header definitions used after the loop. The original exit
+  // got its block id before any of the copies, so it comes first.
+  GrowableArray<PhiInstr*> exit_phis(exit_defs_.length());
+  for (intptr_t j = 0; j < exit_defs_.length(); ++j) {
+    Definition* def = exit_defs_[j];
+    ZoneGrowableArray<Definition*>* copy_values = exit_values_[j];
+    PhiInstr* phi = new (Z) PhiInstr(exit_join_, copy_values->length() + 1);
+    phi->set_representation(def->representation());
+    phi->mark_alive();
+    flow_graph_->AllocateSSAIndex(phi);
+    exit_join_->InsertPhi(phi);
+    for (intptr_t k = 0; k <= copy_values->length(); ++k) {
+      Definition* input = (k == 0) ? def : (*copy_values)[k - 1];
+      Value* value = new (Z) Value(input);
+      phi->SetInputAt(k, value);
+      input->AddInputUse(value);
+    }
+    phi->UpdateType(*def->Type());
+    if (def->range() != nullptr) {
+      phi->set_range(Range(Range::ConstantMin(def->range()),
+                           Range::ConstantMax(def->range())));
+    }
+    exit_phis.Add(phi);
+  }
+  for (const ExitUse& exit_use : exit_uses_) {
+    PhiInstr* phi = exit_phis[exit_use.def_index];
+    if (exit_use.is_env_use) {
+      exit_use.use->BindToEnvironment(phi);
+    } else {
+      exit_use.use->BindTo(phi);
+    }
+  }
+
+  def_map_.Clear();
+  block_map_.Clear();
+  exit_defs_.Clear();
+  exit_values_.Clear();
+  exit_uses_.Clear();
+}
+
+void LoopUnroller::SplitExit() {
+  // Move the exit target into a join, which keeps the block id of the
+  // target so that its successor sees the same order of predecessors.
+  // The exits of all copies jump to the join as well.
+  exit_join_ = new (Z)
+      JoinEntryInstr(exit_->block_id(), exit_->try_index(),
+                     exit_->GetDeoptId(), exit_->stack_depth());
+  exit_join_->LinkTo(exit_->next());
+  exit_join_->set_last_instruction(exit_->last_instruction());
+  if (Environment* env = exit_->env()) {
+    Environment* copy = env->DeepCopy(Z);
+    exit_join_->SetEnvironment(env);
+    for (Environment::DeepIterator it(copy); !it.Done(); it.Advance()) {
+      it.CurrentValue()->definition()->AddEnvUse(it.CurrentValue());
+    }
+    exit_->SetEnvironment(copy);
+  }
+  exit_->set_block_id(flow_graph_->allocate_block_id());
+  GotoInstr* jump = new (Z) GotoInstr(exit_join_, DeoptId::kNone);
+  exit_->LinkTo(jump);
+  exit_->set_last_instruction(jump);
+
+  // Only definitions of the header dominate the exit. Uses in the exit
+  // target itself remain with the original loop.
+  auto record_uses = [&](Definition* def) {
+    const intptr_t def_index = exit_defs_.length();
+    for (intptr_t pass = 0; pass < 2; ++pass) {
+      const bool is_env_use = pass == 1;
+      for (Value::Iterator it(is_env_use ? def->env_use_list()
+                                         : def->input_use_list());
+           !it.Done(); it.Advance()) {
+        Value* use = it.Current();
+        BlockEntryInstr* block = use->instruction()->GetBlock();
+        if (!in_loop_.HasKey(block) && (block != exit_)) {
+          exit_uses_.Add({def_index, use, is_env_use});
+        }
+      }
+    }
+    if (!exit_uses_.is_empty() &&
+        (exit_uses_.Last().def_index == def_index)) {
+      exit_defs_.Add(def);
+      exit_values_.Add(new (Z) ZoneGrowableArray<Definition*>());
+    }
+  };
+  for (PhiInstr* phi : header_phis_) {
+    record_uses(phi);
+  }
+  for (ForwardInstructionIterator it(header_); !it.Done(); it.Advance()) {
+    if (Definition* def = it.Current()->AsDefinition()) {
+      record_uses(def);
+    }
+  }
+}
+
+BlockEntryInstr* LoopUnroller::CopyLoop(
+    BlockEntryInstr* from,
+    const GrowableArray<Definition*>& header_values) {
+  def_map_.Clear();
+  block_map_.Clear();
+  for (intptr_t j = 0; j < header_phis_.length(); ++j) {
+    def_map_.Insert(DefinitionKV::Pair(header_phis_[j], header_values[j]));
+  }
+
+  // Allocate block ids in the order of the original ids, so that joins in
+  // the copy order their predecessors (and phi inputs) like the original.
+  GrowableArray<BlockEntryInstr*> by_id(blocks_.length());
+  by_id.AddArray(blocks_);
+  by_id.Sort([](BlockEntryInstr* const* a, BlockEntryInstr* const* b) {
+    return static_cast<int>((*a)->block_id() - (*b)->block_id());
+  });
+  for (BlockEntryInstr* block : by_id) {
+    block_map_.Insert(BlockKV::Pair(block, CopyBlock(block)));
+  }
+  TargetEntryInstr* exit = new (Z)
+      TargetEntryInstr(flow_graph_->allocate_block_id(), exit_->try_index(),
+                       DeoptId::kNone, exit_->stack_depth());
+  exit->set_edge_weight(exit_->edge_weight());
+  GotoInstr* jump = new (Z) GotoInstr(exit_join_, DeoptId::kNone);
+  exit->LinkTo(jump);
+  exit->set_last_instruction(jump);
+  block_map_.Insert(BlockKV::Pair(exit_, exit));
+
+  // Copy the blocks in reverse postorder, so that definitions are copied
+  // before their uses. Phi inputs are filled in once all blocks exist.
+  for (BlockEntryInstr* block : blocks_) {
+    BlockEntryInstr* copy = LookupBlock(block);
+    if (block != header_) {
+      if (JoinEntryInstr* join = block->AsJoinEntry()) {
+        for (PhiIterator it(join); !it.Done(); it.Advance()) {
+          PhiInstr* phi = it.Current();
+          PhiInstr* phi_copy =
+              new (Z) PhiInstr(copy->AsJoinEntry(), phi->InputCount());
+          phi_copy->set_representation(phi->representation());
+          if (phi->is_alive()) {
+            phi_copy->mark_alive();
+          }
+          copy->AsJoinEntry()->InsertPhi(phi_copy);
+          CopyAttributes(phi, phi_copy);
+        }
+      }
+    }
+    CopyEnvironment(block, copy);
+
+    Instruction* cursor = copy;
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* current = it.Current();
+      if (current->IsCheckStackOverflow()) {
+        // One check per iteration of the original loop is enough.
+        continue;
+      }
+      Instruction* current_copy = CopyInstruction(current);
+      if (current->has_inlining_id()) {
+        current_copy->set_inlining_id(current->inlining_id());
+      }
+      cursor = cursor->AppendInstruction(current_copy);
+      CopyEnvironment(current, current_copy);
+      if (Definition* def = current->AsDefinition()) {
+        if (def->HasSSATemp()) {
+          CopyAttributes(def, current_copy->AsDefinition());
+        }
+      }
+    }
+    copy->set_last_instruction(cursor);
+  }
+
+  for (BlockEntryInstr* block : blocks_) {
+    JoinEntryInstr* join = block->AsJoinEntry();
+    if ((block == header_) || (join == nullptr)) {
+      continue;
+    }
+    for (PhiIterator it(join); !it.Done(); it.Advance()) {
+      PhiInstr* phi = it.Current();
+      PhiInstr* phi_copy = Lookup(phi)->AsPhi();
+      for (intptr_t i = 0, n = phi->InputCount(); i < n; ++i) {
+        Value* input = CopyInput(phi->InputAt(i));
+        phi_copy->SetInputAt(i, input);
+        input->definition()->AddInputUse(input);
+      }
+    }
+  }
+
+  from->last_instruction()->AsGoto()->set_successor(
+      LookupBlock(header_)->AsJoinEntry());
+  return LookupBlock(back_edge_);
+}
+
+BlockEntryInstr* LoopUnroller::CopyBlock(BlockEntryInstr* block) {
+  const intptr_t block_id = flow_graph_->allocate_block_id();
+  if (block->IsJoinEntry()) {
+    return new (Z) JoinEntryInstr(block_id, block->try_index(),
+                                  block->GetDeoptId(), block->stack_depth());
+  }
+  TargetEntryInstr* target =
+      new (Z) TargetEntryInstr(block_id, block->try_index(),
+                               block->GetDeoptId(), block->stack_depth());
+  target->set_edge_weight(block->AsTargetEntry()->edge_weight());
+  return target;
+}
+
+Instruction* LoopUnroller::CopyInstruction(Instruction* instr) {
+  const intptr_t deopt_id = instr->GetDeoptId();
+  if (auto jump = instr->AsGoto()) {
+    // The back edge of every copy returns to the original header.
+    JoinEntryInstr* successor = jump->successor();
+    if (successor != header_) {
+      successor = LookupBlock(successor)->AsJoinEntry();
+    }
+    GotoInstr* copy = new (Z) GotoInstr(successor, deopt_id);
+    copy->set_edge_weight(jump->edge_weight());
+    return copy;
+  }
+  if (auto branch = instr->AsBranch()) {
+    ConditionInstr* condition = branch->condition();
+    ConditionInstr* new_condition = condition->CopyWithNewOperands(
+        CopyInput(condition->InputAt(0)), CopyInput(condition->InputAt(1)));
+    new_condition->SetDeoptId(*condition);
+    BranchInstr* copy = new (Z) BranchInstr(new_condition, deopt_id);
+    *copy->true_successor_address() =
+        LookupBlock(branch->true_successor())->AsTargetEntry();
+    *copy->false_successor_address() =
+        LookupBlock(branch->false_successor())->AsTargetEntry();
+    return copy;
+  }
+  if (auto op = instr->AsBinaryIntegerOp()) {
+    BinaryIntegerOpInstr* copy = BinaryIntegerOpInstr::Make(
+        op->representation(), op->op_kind(), CopyInput(op->left()),
+        CopyInput(op->right()), deopt_id, op->can_overflow(),
+        op->is_truncating(), /*range=*/nullptr);
+    ASSERT(copy != nullptr);
+    return copy;
+  }
+  if (auto op = instr->AsUnaryIntegerOp()) {
+    UnaryIntegerOpInstr* copy =
+        UnaryIntegerOpInstr::Make(op->representation(), op->op_kind(),
+                                  CopyInput(op->value()), deopt_id,
+                                  /*range=*/nullptr);
+    ASSERT(copy != nullptr);
+    return copy;
+  }
+  if (auto box = instr->AsBox()) {
+    return BoxInstr::Create(box->from_representation(),
+                            CopyInput(box->value()));
+  }
+  if (auto unbox = instr->AsUnbox()) {
+    return UnboxInstr::Create(unbox->representation(),
+                              CopyInput(unbox->value()), deopt_id,
+                              unbox->value_mode());
+  }
+  if (auto conv = instr->AsIntConverter()) {
+    return new (Z)
+        IntConverterInstr(conv->from(), conv->to(), CopyInput(conv->value()));
+  }
+  if (auto load = instr->AsLoadIndexed()) {
+    return new (Z) LoadIndexedInstr(
+        CopyInput(load->array()), CopyInput(load->index()),
+        load->index_unboxed(), load->index_scale(), load->class_id(),
+        load->aligned() ? kAlignedAccess : kUnalignedAccess, deopt_id,
+        load->source(), load->result_type());
+  }
+  if (auto store = instr->AsStoreIndexed()) {
+    return new (Z) StoreIndexedInstr(
+        CopyInput(store->array()), CopyInput(store->index()),
+        CopyInput(store->value()), store->emit_store_barrier(),
+        store->index_unboxed(), store->index_scale(), store->class_id(),
+        store->aligned() ? kAlignedAccess : kUnalignedAccess, deopt_id,
+        store->source());
+  }
+  if (auto load = instr->AsLoadField()) {
+    ASSERT(!load->calls_initializer());
+    return new (Z) LoadFieldInstr(
+        CopyInput(load->instance()), load->slot(), load->loads_inner_pointer(),
+        load->source(), /*calls_initializer=*/false, deopt_id,
+        load->memory_order());
+  }
+  if (auto check = instr->AsCheckArrayBound()) {
+    return new (Z) CheckArrayBoundInstr(CopyInput(check->length()),
+                                        CopyInput(check->index()), deopt_id);
+  }
+  if (auto check = instr->AsGenericCheckBound()) {
+    return new (Z) GenericCheckBoundInstr(
+        CopyInput(check->length()), CopyInput(check->index()), deopt_id,
+        check->IsPhantom() ? GenericCheckBoundInstr::Mode::kPhantom
+                           : GenericCheckBoundInstr::Mode::kReal);
+  }
+  if (auto check = instr->AsCheckSmi()) {
+    return new (Z)
+        CheckSmiInstr(CopyInput(check->value()), deopt_id, check->source());
+  }
+  if (auto op = instr->AsBinaryDoubleOp()) {
+    return new (Z) BinaryDoubleOpInstr(op->op_kind(), CopyInput(op->left()),
+                                       CopyInput(op->right()), deopt_id,
+                                       op->source(), op->representation());
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
+Value* LoopUnroller::CopyInput(Value* value) {
+  Value* copy = value->CopyWithType(Z);
+  copy->set_definition(Lookup(value->definition()));
+  return copy;
+}
+
+void LoopUnroller::CopyEnvironment(Instruction* from, Instruction* to) {
+  if (from->env() == nullptr) {
+    return;
+  }
+  Environment* env = from->env()->DeepCopy(Z);
+  for (Environment::DeepIterator it(env); !it.Done(); it.Advance()) {
+    Value* value = it.CurrentValue();
+    value->set_definition(Lookup(value->definition()));
+    value->definition()->AddEnvUse(value);
+  }
+  to->SetEnvironment(env);
+}
+
+void LoopUnroller::CopyAttributes(Definition* from, Definition* to) {
+  flow_graph_->AllocateSSAIndex(to);
+  if (from->HasType()) {
+    to->UpdateType(*from->Type());
+  }
+  // Symbolic bounds may refer to definitions of the original loop, which
+  // do not hold for the copy. Their constant approximation does.
+  if (Range* range = from->range()) {
+    to->set_range(
+        Range(Range::ConstantMin(range), Range::ConstantMax(range)));
+  }
+  def_map_.Insert(DefinitionKV::Pair(from, to));
+}
+
+Definition* LoopUnroller::Lookup(Definition* def) {
+  Definition* copy = def_map_.LookupValue(def);
+  return (copy != nullptr) ? copy : def;
+}
+
+BlockEntryInstr* LoopUnroller::LookupBlock(BlockEntryInstr* block) {
+  BlockEntryInstr* copy = block_map_.LookupValue(block);
+  ASSERT(copy != nullptr);
+  return copy;
+}
+
+}  // namespace dart
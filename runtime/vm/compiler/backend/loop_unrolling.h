@@ -0,0 +1,113 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_UNROLLING_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_UNROLLING_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/hash_map.h"
+
+namespace dart {
+
+// Unrolls and peels small innermost loops.
+//
+// A loop with a constant trip count that fits the size budget is fully
+// unrolled by peeling all of its iterations in front of the loop; constant
+// propagation then removes the remaining loop. Other counted loops are
+// partially unrolled by replicating the body on the back edge.
+//
+// Every copy keeps the exit test of the original header, so the transform
+// is correct regardless of the trip count; the induction information only
+// guides the decision. The pass runs after range analysis: copies execute
+// a subset of the dynamic instances of the original instructions, so they
+// inherit ranges and overflow facts, and bounds checks that were removed
+// from the original body stay removed in every copy. Range analysis is run
+// again afterwards (see RangeAnalysis::ReanalyzeBoundsChecks) to remove the
+// checks that became redundant in the copies.
+class LoopUnroller : public ValueObject {
+ public:
+  explicit LoopUnroller(FlowGraph* flow_graph);
+
+  // Returns true if any loop was transformed.
+  bool Optimize();
+
+ private:
+  typedef RawPointerKeyValueTrait<Definition, Definition*> DefinitionKV;
+  typedef RawPointerKeyValueTrait<BlockEntryInstr, BlockEntryInstr*> BlockKV;
+
+  // A use of a header definition outside of the loop, which has to be
+  // redirected to a phi in the exit join once the loop has several exits.
+  struct ExitUse {
+    intptr_t def_index;
+    Value* use;
+    bool is_env_use;
+  };
+
+  Zone* zone() const { return flow_graph_->zone(); }
+
+  // Checks that the loop has the shape handled by this pass and that all
+  // of its instructions can be copied. Sets size to the number of
+  // instructions in the loop body.
+  bool CanTransform(LoopInfo* loop, intptr_t* size);
+  static bool CanCopy(Instruction* instr);
+
+  // Returns the constant trip count of the loop, or -1 if unknown.
+  static int64_t TripCount(LoopInfo* loop);
+
+  // Peels (peel == true) or unrolls the given number of copies of the loop.
+  void Transform(LoopInfo* loop, intptr_t copies, bool peel);
+
+  // Moves the exit target of the loop into a new join block and records
+  // header definitions used after the loop.
+  void SplitExit();
+
+  // Emits a copy of the original loop that is entered through the goto of
+  // block from. Header phis are replaced by header_values. Returns the back
+  // edge block of the copy, which jumps to the original header.
+  BlockEntryInstr* CopyLoop(BlockEntryInstr* from,
+                            const GrowableArray<Definition*>& header_values);
+
+  BlockEntryInstr* CopyBlock(BlockEntryInstr* block);
+  Instruction* CopyInstruction(Instruction* instr);
+  Value* CopyInput(Value* value);
+  void CopyEnvironment(Instruction* from, Instruction* to);
+  void CopyAttributes(Definition* from, Definition* to);
+  Definition* Lookup(Definition* def);
+  BlockEntryInstr* LookupBlock(BlockEntryInstr* block);
+
+  FlowGraph* flow_graph_;
+
+  // Loop being transformed.
+  JoinEntryInstr* header_;
+  BlockEntryInstr* back_edge_;
+  TargetEntryInstr* exit_;
+  JoinEntryInstr* exit_join_;
+  // Original loop blocks in reverse postorder, with the header first.
+  GrowableArray<BlockEntryInstr*> blocks_;
+  DirectChainedHashMap<BlockKV> in_loop_;
+  // Header phis and their back edge inputs in the original loop.
+  GrowableArray<PhiInstr*> header_phis_;
+  GrowableArray<Definition*> back_values_;
+  // Header definitions with uses after the loop, their values at each
+  // exit of the transformed loop, and the uses themselves.
+  GrowableArray<Definition*> exit_defs_;
+  GrowableArray<ZoneGrowableArray<Definition*>*> exit_values_;
+  GrowableArray<ExitUse> exit_uses_;
+
+  // Mappings from the original loop to the copy being emitted.
+  DirectChainedHashMap<DefinitionKV> def_map_;
+  DirectChainedHashMap<BlockKV> block_map_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopUnroller);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_UNROLLING_H_
@@ -0,0 +1,262 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Unit tests for loop unrolling and peeling.
+
+#include "vm/compiler/backend/loop_unrolling.h"
+
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/jit/compiler.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(int, max_loop_unroll_factor);
+
+struct LoopShape {
+  intptr_t num_loops;
+  intptr_t num_branches;
+  intptr_t num_bounds_checks;
+};
+
+// Helper method to count loops, branches and bounds checks.
+static LoopShape ComputeLoopShape(FlowGraph* flow_graph) {
+  intptr_t num_branches = 0;
+  intptr_t num_bounds_checks = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    BlockEntryInstr* block = block_it.Current();
+    if (block->last_instruction()->IsBranch()) {
+      num_branches++;
+    }
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      if (it.Current()->IsCheckBoundBase()) {
+        num_bounds_checks++;
+      }
+    }
+  }
+  return {flow_graph->GetLoopHierarchy().num_loops(), num_branches,
+          num_bounds_checks};
+}
+
+// Helper method to build CFG, run loop unrolling followed by branch
+// optimization, and compute the loop shape before and after.
+static std::pair<LoopShape, LoopShape> ApplyLoopUnrolling(
+    const char* script_chars) {
+  // Load the script and exercise the code once
+  // while exercising the given compiler passes.
+  const auto& root_library = Library::Handle(LoadTestScript(script_chars));
+  Invoke(root_library, "main");
+  std::initializer_list<CompilerPass::Id> passes = {
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kInlining,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kSelectRepresentations,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kConstantPropagation,
+      CompilerPass::kCSE,
+      CompilerPass::kLICM,
+      CompilerPass::kRangeAnalysis,
+  };
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses(passes);
+  const LoopShape before = ComputeLoopShape(flow_graph);
+  pipeline.RunAdditionalPasses({
+      CompilerPass::kLoopUnrolling,
+      CompilerPass::kOptimizeBranches,
+  });
+  const LoopShape after = ComputeLoopShape(flow_graph);
+  return {before, after};
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopUnrolling_PeelConstantTripCount) {
+  const char* kScriptChars =
+      R"(
+      int foo(int n) {
+        int sum = 0;
+        for (int i = 0; i < 4; i++) {
+          sum += i * n;
+        }
+        return sum;
+      }
+      main() {
+        foo(3);
+      }
+    )";
+  auto result = ApplyLoopUnrolling(kScriptChars);
+  EXPECT_EQ(1, result.first.num_loops);
+  // All iterations are peeled and the remaining loop is never entered.
+  EXPECT_EQ(0, result.second.num_loops);
+  EXPECT_EQ(0, result.second.num_branches);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopUnrolling_UnrollUnknownTripCount) {
+  const char* kScriptChars =
+      R"(
+      int foo(int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+          sum += i;
+        }
+        return sum;
+      }
+      main() {
+        foo(100);
+      }
+    )";
+  auto result = ApplyLoopUnrolling(kScriptChars);
+  EXPECT_EQ(1, result.first.num_loops);
+  EXPECT_EQ(1, result.second.num_loops);
+  // Every copy of the body keeps the exit test.
+  EXPECT_EQ(result.first.num_branches + FLAG_max_loop_unroll_factor - 1,
+            result.second.num_branches);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopUnrolling_KeepLoopWithCall) {
+  const char* kScriptChars =
+      R"(
+      @pragma('vm:never-inline')
+      bar(int i) => i;
+      int foo(int n) {
+        int sum = 0;
+        for (int i = 0; i < 4; i++) {
+          sum += bar(i) as int;
+        }
+        return sum;
+      }
+      main() {
+        foo(3);
+      }
+    )";
+  auto result = ApplyLoopUnrolling(kScriptChars);
+  EXPECT_EQ(1, result.first.num_loops);
+  EXPECT_EQ(1, result.second.num_loops);
+  EXPECT_EQ(result.first.num_branches, result.second.num_branches);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopUnrolling_UnrollRemovesBoundsChecks) {
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      int foo(Int32List list) {
+        int sum = 0;
+        for (int i = 0; i < list.length; i++) {
+          sum += list[i];
+        }
+        return sum;
+      }
+      main() {
+        foo(Int32List(100));
+      }
+    )";
+  auto result = ApplyLoopUnrolling(kScriptChars);
+  EXPECT_EQ(1, result.second.num_loops);
+  EXPECT_EQ(result.first.num_branches + FLAG_max_loop_unroll_factor - 1,
+            result.second.num_branches);
+  // The exit test repeated in every copy guards its access.
+  EXPECT_EQ(0, result.second.num_bounds_checks);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopUnrolling_PeelRemovesBoundsChecks) {
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      int foo(Int32List list) {
+        if (list.length < 4) return 0;
+        int sum = 0;
+        for (int i = 0; i < 4; i++) {
+          sum += list[i];
+        }
+        return sum;
+      }
+      main() {
+        foo(Int32List(4));
+      }
+    )";
+  auto result = ApplyLoopUnrolling(kScriptChars);
+  EXPECT_EQ(1, result.first.num_loops);
+  EXPECT_EQ(0, result.second.num_loops);
+  // The length test dominates all peeled accesses.
+  EXPECT_EQ(0, result.second.num_bounds_checks);
+}
+
+// Runs optimized code of unrolled loops with trip counts that leave
+// remainder iterations, loops left through early returns, and peeled loops
+// whose bounds checks fail.
+ISOLATE_UNIT_TEST_CASE(LoopUnrolling_Execution) {
+  const char* kScriptChars =
+      R"(
+      @pragma('vm:never-inline')
+      int sumTo(int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+          sum += i * 3 + 1;
+        }
+        return sum;
+      }
+      @pragma('vm:never-inline')
+      int indexOf(List<int> list, int value) {
+        for (int i = 0; i < list.length; i++) {
+          if (list[i] == value) return i;
+        }
+        return -1;
+      }
+      @pragma('vm:never-inline')
+      int sumFirstThree(List<int> list) {
+        int sum = 0;
+        for (int i = 0; i < 3; i++) {
+          sum += list[i];
+        }
+        return sum;
+      }
+      bool check() {
+        for (int n = 0; n < 20; n++) {
+          if (sumTo(n) != n * (3 * n - 1) ~/ 2) return false;
+        }
+        final list = List<int>.generate(11, (i) => i * i);
+        for (int i = 0; i < list.length; i++) {
+          if (indexOf(list, i * i) != i) return false;
+        }
+        if (indexOf(list, 2) != -1) return false;
+        if (indexOf(<int>[], 0) != -1) return false;
+        if (sumFirstThree(list) != 5) return false;
+        try {
+          sumFirstThree(<int>[1, 2]);
+          return false;
+        } on RangeError {
+          // Expected.
+        }
+        return true;
+      }
+      main() => check();
+    )";
+  const auto& root_library = Library::Handle(LoadTestScript(kScriptChars));
+  Object& result = Object::Handle(Invoke(root_library, "main"));
+  EXPECT(result.ptr() == Bool::True().ptr());
+
+  const char* kNames[] = {"sumTo", "indexOf", "sumFirstThree"};
+  Function& function = Function::Handle();
+  for (const char* name : kNames) {
+    function = GetFunction(root_library, name);
+    Compiler::CompileOptimizedFunction(thread, function);
+    EXPECT(function.HasOptimizedCode());
+  }
+  result = Invoke(root_library, "main");
+  EXPECT(result.ptr() == Bool::True().ptr());
+  // Only the failing bounds check deoptimizes.
+  function = GetFunction(root_library, "sumTo");
+  EXPECT(function.HasOptimizedCode());
+  function = GetFunction(root_library, "indexOf");
+  EXPECT(function.HasOptimizedCode());
+}
+
+}  // namespace dart
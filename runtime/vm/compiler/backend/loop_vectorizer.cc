@@ -0,0 +1,870 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+
+#include <cmath>
+#include <limits>
+
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/range_analysis.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/flags.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            loop_vectorization,
+            true,
+            "Vectorize element-wise loops over typed data.");
+DEFINE_FLAG(bool, trace_loop_vectorization, false, "Trace loop vectorization.");
+
+// Quick access to the locally defined zone() method.
+#define Z (zone())
+
+#define TRACE_LOOP_VECTORIZATION(statement)                                    \
+  if (FLAG_support_il_printer && FLAG_trace_loop_vectorization &&              \
+      CompilerState::ShouldTrace()) {                                          \
+    statement;                                                                 \
+  }
+
+// Size of a vector register in bytes.
+static constexpr intptr_t kVectorSize = 16;
+
+static bool SupportsVectorization() {
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+  return FlowGraphCompiler::SupportsUnboxedSimd128();
+#else
+  return false;
+#endif
+}
+
+// Returns true if def holds an integer which can be unboxed to int64
+// without a check.
+static bool IsInt64Value(Definition* def) {
+  return (def->representation() == kUnboxedInt64) ||
+         ((def->representation() == kTagged) && def->Type()->IsInt());
+}
+
+// Returns true if the double value is exactly representable as float32.
+static bool IsFloat32Exact(double value) {
+  if (std::isnan(value)) {
+    return false;
+  }
+  if (std::isinf(value)) {
+    return true;
+  }
+  return (std::fabs(value) <= std::numeric_limits<float>::max()) &&
+         (static_cast<double>(static_cast<float>(value)) == value);
+}
+
+// Binds the inputs of a new phi. Once the blocks are rediscovered, the
+// predecessors of a join (and the phi inputs) are ordered by block id.
+struct PhiInput {
+  BlockEntryInstr* block;
+  Definition* value;
+};
+
+static void BindPhiInputs(PhiInstr* phi, GrowableArray<PhiInput>* inputs) {
+  inputs->Sort([](const PhiInput* a, const PhiInput* b) {
+    return static_cast<int>(a->block->block_id() - b->block->block_id());
+  });
+  for (intptr_t i = 0; i < inputs->length(); ++i) {
+    Definition* def = (*inputs)[i].value;
+    Value* value = new Value(def);
+    phi->SetInputAt(i, value);
+    def->AddInputUse(value);
+  }
+}
+
+LoopVectorizer::LoopVectorizer(FlowGraph* flow_graph)
+    : flow_graph_(flow_graph),
+      header_(nullptr),
+      body_(nullptr),
+      pre_header_(nullptr),
+      phi_(nullptr),
+      increment_(nullptr),
+      condition_(nullptr),
+      element_size_(0),
+      unboxed_index_(nullptr),
+      tagged_index_(nullptr) {}
+
+bool LoopVectorizer::Optimize() {
+  if (!FLAG_loop_vectorization || !SupportsVectorization() ||
+      (FLAG_optimization_level <= 1) || flow_graph_->is_huge_method()) {
+    return false;
+  }
+
+  // Collect the candidates first, since every transformation invalidates
+  // the loop hierarchy. Loop headers survive the transformation.
+  GrowableArray<BlockEntryInstr*> headers;
+  for (BlockEntryInstr* header : flow_graph_->GetLoopHierarchy().headers()) {
+    if (header->loop_info()->inner() == nullptr) {
+      headers.Add(header);
+    }
+  }
+
+  bool changed = false;
+  for (BlockEntryInstr* header : headers) {
+    const LoopHierarchy& loop_hierarchy = flow_graph_->GetLoopHierarchy();
+    loop_hierarchy.ComputeInduction();
+    LoopInfo* loop = header->loop_info();
+    if ((loop == nullptr) || (loop->header() != header) ||
+        !CanVectorize(loop)) {
+      continue;
+    }
+    TRACE_LOOP_VECTORIZATION(THR_Print("Vectorizing loop B%" Pd " by %" Pd
+                                       "\n",
+                                       header->block_id(),
+                                       kVectorSize / element_size_));
+    Transform();
+    changed = true;
+
+    // The vector loop changed the block order and the dominator tree.
+    flow_graph_->DiscoverBlocks();
+    GrowableArray<BitVector*> dominance_frontier;
+    flow_graph_->ComputeDominators(&dominance_frontier);
+  }
+  return changed;
+}
+
+bool LoopVectorizer::CanVectorize(LoopInfo* loop) {
+  // Innermost loop with a single entry, consisting of a header which only
+  // tests the induction variable and a body which is the back edge.
+  header_ = loop->header()->AsJoinEntry();
+  if ((loop->inner() != nullptr) || (header_ == nullptr) ||
+      (header_->PredecessorCount() != 2) ||
+      (loop->back_edges().length() != 1) || header_->InsideTryBlock()) {
+    return false;
+  }
+  BranchInstr* branch = header_->last_instruction()->AsBranch();
+  if (branch == nullptr) {
+    return false;
+  }
+  condition_ = branch->condition()->AsRelationalOp();
+  body_ = branch->true_successor();
+  if ((condition_ == nullptr) || (condition_->kind() != Token::kLT) ||
+      (body_ != loop->back_edges()[0]) ||
+      !body_->last_instruction()->IsGoto()) {
+    return false;
+  }
+  for (ForwardInstructionIterator it(header_); !it.Done(); it.Advance()) {
+    if ((it.Current() != branch) && !it.Current()->IsCheckStackOverflow()) {
+      return false;
+    }
+  }
+
+  // The only phi is the induction variable i, which counts up from a
+  // non-negative constant to a loop invariant limit.
+  phi_ = nullptr;
+  for (PhiIterator it(header_); !it.Done(); it.Advance()) {
+    if (phi_ != nullptr) {
+      return false;
+    }
+    phi_ = it.Current();
+  }
+  if ((phi_ == nullptr) || (condition_->left()->definition() != phi_)) {
+    return false;
+  }
+  if (phi_->representation() == kTagged) {
+    if (phi_->Type()->ToCid() != kSmiCid) {
+      return false;
+    }
+  } else if (phi_->representation() != kUnboxedInt64) {
+    return false;
+  }
+  Definition* limit = condition_->right()->definition();
+  if (loop->Contains(limit->GetBlock()) || !IsInt64Value(limit)) {
+    return false;
+  }
+  InductionVar* induc = loop->LookupInduction(phi_);
+  int64_t stride = 0;
+  int64_t initial = 0;
+  if (!InductionVar::IsLinear(induc, &stride) || (stride != 1) ||
+      !InductionVar::IsConstant(induc->initial(), &initial) || (initial < 0)) {
+    return false;
+  }
+
+  const intptr_t back_index = (header_->PredecessorAt(0) == body_) ? 0 : 1;
+  pre_header_ = header_->PredecessorAt(1 - back_index);
+  increment_ = phi_->InputAt(back_index)->definition();
+  if (!pre_header_->last_instruction()->IsGoto() ||
+      (increment_->GetBlock() != body_)) {
+    return false;
+  }
+
+  if (!ClassifyBody()) {
+    return false;
+  }
+
+  // Skip loops that never complete a vector iteration.
+  const intptr_t lanes = kVectorSize / element_size_;
+  if (condition_->right()->BindsToConstant() &&
+      condition_->right()->BoundConstant().IsInteger()) {
+    const int64_t count =
+        Integer::Cast(condition_->right()->BoundConstant()).Value() -
+        initial;
+    if (count < lanes) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LoopVectorizer::ClassifyBody() {
+  kinds_.Clear();
+  arrays_.Clear();
+  array_cids_.Clear();
+  lengths_.Clear();
+  element_size_ = 0;
+  bool has_store = false;
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current->IsGoto() || (current == increment_)) {
+      continue;
+    }
+    const Kind kind = Classify(current);
+    if (kind == kUnsupported) {
+      TRACE_LOOP_VECTORIZATION(THR_Print("Cannot vectorize loop B%" Pd
+                                         ": %s\n",
+                                         header_->block_id(),
+                                         current->ToCString()));
+      return false;
+    }
+    if (Definition* def = current->AsDefinition()) {
+      kinds_.Insert(KindKV::Pair(def, kind));
+    }
+    has_store = has_store || current->IsStoreIndexed();
+  }
+  return has_store;
+}
+
+LoopVectorizer::Kind LoopVectorizer::Classify(Instruction* instr) {
+  if (auto load = instr->AsLoadIndexed()) {
+    return ClassifyAccess(load->array(), load->index(), load->class_id(),
+                          load->index_scale());
+  }
+  if (auto store = instr->AsStoreIndexed()) {
+    if ((ClassifyAccess(store->array(), store->index(), store->class_id(),
+                        store->index_scale()) == kUnsupported) ||
+        ((KindOf(store->value()) != kLanes) &&
+         !IsSupportedFill(store->value(), store->class_id()))) {
+      return kUnsupported;
+    }
+    return kLanes;
+  }
+  if (auto check = instr->AsCheckBoundBase()) {
+    // Replaced by testing the last lane of each vector iteration.
+    Definition* length = check->length()->definition();
+    if ((KindOf(check->index()) != kIndex) ||
+        (KindOf(check->length()) != kInvariant) || !IsInt64Value(length)) {
+      return kUnsupported;
+    }
+    if ((length != condition_->right()->definition()) &&
+        !lengths_.Contains(length)) {
+      lengths_.Add(length);
+    }
+    return kIndex;
+  }
+  if (auto check = instr->AsCheckWritable()) {
+    // Arrays are checked to be internal typed data before entering the
+    // vector loop, which is always writable.
+    if ((check->kind() != CheckWritableInstr::kWriteUnmodifiableTypedData) ||
+        (KindOf(check->value()) != kInvariant)) {
+      return kUnsupported;
+    }
+    return kArray;
+  }
+
+  // The remaining instructions are element-wise computations, which are
+  // only vectorized if they cannot deoptimize.
+  if (instr->CanDeoptimize() || instr->MayThrow()) {
+    return kUnsupported;
+  }
+  if (auto op = instr->AsBinaryDoubleOp()) {
+    return ClassifyDoubleOp(op);
+  }
+  if (auto op = instr->AsBinaryIntegerOp()) {
+    return ClassifyIntegerOp(op);
+  }
+  if (auto conv = instr->AsFloatToDouble()) {
+    return (KindOf(conv->value()) == kLanes) ? kLanes : kUnsupported;
+  }
+  if (auto conv = instr->AsDoubleToFloat()) {
+    // Rounding the result of a single double operation on float32 values
+    // to float32 yields the result of the float32 operation.
+    const Kind input = KindOf(conv->value());
+    return ((input == kLanes) || (input == kRoundedLanes)) ? kLanes
+                                                           : kUnsupported;
+  }
+  if (instr->IsBox() || instr->IsUnbox() || instr->IsIntConverter()) {
+    Definition* def = instr->AsDefinition();
+    const Kind input = KindOf(instr->InputAt(0));
+    if (input == kIndex) {
+      return ((def->representation() == kTagged) ||
+              (def->representation() == kUnboxedInt64))
+                 ? kIndex
+                 : kUnsupported;
+    }
+    // Integer conversions keep the low bits of the value, which are all
+    // that is stored into the array.
+    const Representation from = instr->IsBox()
+                                    ? instr->AsBox()->from_representation()
+                                    : instr->InputAt(0)->definition()
+                                          ->representation();
+    const Representation to = def->representation();
+    const bool is_integer =
+        ((from == kTagged) || RepresentationUtils::IsUnboxedInteger(from)) &&
+        ((to == kTagged) || RepresentationUtils::IsUnboxedInteger(to));
+    return ((input == kLanes) && is_integer) ? kLanes : kUnsupported;
+  }
+  return kUnsupported;
+}
+
+LoopVectorizer::Kind LoopVectorizer::ClassifyAccess(Value* array,
+                                                    Value* index,
+                                                    intptr_t class_id,
+                                                    intptr_t index_scale) {
+  intptr_t size = 0;
+  switch (class_id) {
+    case kTypedDataUint8ArrayCid:
+      size = 1;
+      break;
+    case kTypedDataInt32ArrayCid:
+    case kTypedDataFloat32ArrayCid:
+      size = 4;
+      break;
+    case kTypedDataFloat64ArrayCid:
+      size = 8;
+      break;
+    default:
+      return kUnsupported;
+  }
+  // All accesses are at index i and have the same number of lanes.
+  if ((index_scale != size) || (KindOf(index) != kIndex) ||
+      ((element_size_ != 0) && (element_size_ != size))) {
+    return kUnsupported;
+  }
+  element_size_ = size;
+
+  // Payloads of external arrays have already been extracted, and may
+  // overlap with each other.
+  Definition* def = ArrayOf(array);
+  if ((def == nullptr) || (def->representation() != kTagged)) {
+    return kUnsupported;
+  }
+  if (def->Type()->ToCid() != class_id) {
+    for (intptr_t i = 0; i < arrays_.length(); ++i) {
+      if ((arrays_[i] == def) && (array_cids_[i] != class_id)) {
+        return kUnsupported;
+      }
+    }
+    if (!arrays_.Contains(def)) {
+      arrays_.Add(def);
+      array_cids_.Add(class_id);
+    }
+  }
+  return kLanes;
+}
+
+LoopVectorizer::Kind LoopVectorizer::ClassifyDoubleOp(
+    BinaryDoubleOpInstr* op) {
+  switch (op->op_kind()) {
+    case Token::kADD:
+    case Token::kSUB:
+    case Token::kMUL:
+    case Token::kDIV:
+      break;
+    default:
+      return kUnsupported;
+  }
+  const Kind left = KindOf(op->left());
+  const Kind right = KindOf(op->right());
+  if ((left != kLanes) && (right != kLanes)) {
+    return kUnsupported;
+  }
+  if (((left != kLanes) && !IsSupportedInvariant(op->left())) ||
+      ((right != kLanes) && !IsSupportedInvariant(op->right()))) {
+    return kUnsupported;
+  }
+  if (element_size_ == 8) {
+    return (op->representation() == kUnboxedDouble) ? kLanes : kUnsupported;
+  }
+  ASSERT(element_size_ == 4);
+  // A double operation on float32 values is exact after rounding to
+  // float32, but not once its result is used by another operation.
+  return (op->representation() == kUnboxedFloat) ? kLanes : kRoundedLanes;
+}
+
+LoopVectorizer::Kind LoopVectorizer::ClassifyIntegerOp(
+    BinaryIntegerOpInstr* op) {
+  switch (op->op_kind()) {
+    case Token::kADD:
+    case Token::kSUB:
+      // Carries would cross byte lanes.
+      if (element_size_ != 4) {
+        return kUnsupported;
+      }
+      break;
+    case Token::kBIT_AND:
+    case Token::kBIT_OR:
+    case Token::kBIT_XOR:
+      break;
+    default:
+      return kUnsupported;
+  }
+  const Kind left = KindOf(op->left());
+  const Kind right = KindOf(op->right());
+  if ((left != kLanes) && (right != kLanes)) {
+    return kUnsupported;
+  }
+  if (((left != kLanes) && !IsSupportedInvariant(op->left())) ||
+      ((right != kLanes) && !IsSupportedInvariant(op->right()))) {
+    return kUnsupported;
+  }
+  return kLanes;
+}
+
+bool LoopVectorizer::IsSupportedInvariant(Value* value) const {
+  if (KindOf(value) != kInvariant) {
+    return false;
+  }
+  Definition* def = value->definition();
+  if (ConstantInstr* constant = def->AsConstant()) {
+    const Object& object = constant->value();
+    if (object.IsInteger()) {
+      return !RepresentationUtils::IsUnboxed(def->representation()) ||
+             RepresentationUtils::IsUnboxedInteger(def->representation());
+    }
+    if (!object.IsDouble()) {
+      return false;
+    }
+    return (element_size_ == 8) ||
+           IsFloat32Exact(Double::Cast(object).value());
+  }
+  // Other invariants are only supported as operands of floating point
+  // operations, and must be float32 values for float32 lanes.
+  if (element_size_ == 8) {
+    return def->representation() == kUnboxedDouble;
+  }
+  return (element_size_ == 4) && ((def->representation() == kUnboxedFloat) ||
+                                  def->IsFloatToDouble());
+}
+
+bool LoopVectorizer::IsSupportedFill(Value* value, intptr_t class_id) const {
+  if (KindOf(value) != kInvariant) {
+    return false;
+  }
+  const bool is_float = (class_id == kTypedDataFloat64ArrayCid) ||
+                        (class_id == kTypedDataFloat32ArrayCid);
+  Definition* def = value->definition();
+  if (ConstantInstr* constant = def->AsConstant()) {
+    // Splatting rounds a double constant to float32 like the scalar store.
+    return is_float ? constant->value().IsDouble()
+                    : constant->value().IsInteger();
+  }
+  // Only floating point values can be splatted at run time.
+  if (class_id == kTypedDataFloat64ArrayCid) {
+    return def->representation() == kUnboxedDouble;
+  }
+  if (class_id == kTypedDataFloat32ArrayCid) {
+    return def->representation() == kUnboxedFloat;
+  }
+  return false;
+}
+
+LoopVectorizer::Kind LoopVectorizer::KindOf(Value* value) const {
+  Definition* def = value->definition();
+  if (def == phi_) {
+    return kIndex;
+  }
+  if (def == increment_) {
+    return kUnsupported;
+  }
+  // Definitions of the body are classified before their uses. The header
+  // only defines the induction variable.
+  if (KindKV::Pair* pair = kinds_.Lookup(def)) {
+    return static_cast<Kind>(pair->value);
+  }
+  return kInvariant;
+}
+
+Definition* LoopVectorizer::ArrayOf(Value* value) const {
+  switch (KindOf(value)) {
+    case kInvariant:
+      return value->definition();
+    case kArray:
+      return value->definition()->AsCheckWritable()->value()->definition();
+    default:
+      return nullptr;
+  }
+}
+
+void LoopVectorizer::Transform() {
+  const intptr_t lanes = kVectorSize / element_size_;
+  const Representation rep = phi_->representation();
+  const intptr_t back_index = (header_->PredecessorAt(0) == body_) ? 0 : 1;
+  Definition* initial = phi_->InputAt(1 - back_index)->definition();
+  Definition* back_value = phi_->InputAt(back_index)->definition();
+  vector_map_.Clear();
+  splat_map_.Clear();
+  unboxed_index_ = nullptr;
+  tagged_index_ = nullptr;
+
+  // Limits of the last lane, computed in the pre-header.
+  GrowableArray<Definition*> limits;
+  limits.Add(UnboxedInt64(condition_->right()->definition()));
+  for (Definition* length : lengths_) {
+    limits.Add(UnboxedInt64(length));
+  }
+
+  JoinEntryInstr* vector_header = new (Z)
+      JoinEntryInstr(flow_graph_->allocate_block_id(), header_->try_index(),
+                     DeoptId::kNone, header_->stack_depth());
+  JoinEntryInstr* vector_exit = new (Z)
+      JoinEntryInstr(flow_graph_->allocate_block_id(), header_->try_index(),
+                     DeoptId::kNone, header_->stack_depth());
+
+  // Enter the vector loop only if the arrays of unknown class are internal
+  // typed data.
+  GrowableArray<TargetEntryInstr*> entry_exits;
+  GotoInstr* entry_goto = pre_header_->last_instruction()->AsGoto();
+  BlockEntryInstr* entry_block = pre_header_;
+  if (arrays_.is_empty()) {
+    entry_goto->set_successor(vector_header);
+  } else {
+    Instruction* cursor = entry_goto->previous();
+    GrowableArray<Definition*> class_ids(arrays_.length());
+    for (Definition* array : arrays_) {
+      LoadClassIdInstr* load_cid =
+          new (Z) LoadClassIdInstr(new (Z) Value(array));
+      cursor = flow_graph_->AppendTo(cursor, load_cid, nullptr,
+                                     FlowGraph::kValue);
+      class_ids.Add(load_cid);
+    }
+    for (intptr_t i = 0; i < arrays_.length(); ++i) {
+      ConstantInstr* cid = flow_graph_->GetConstant(
+          Smi::ZoneHandle(Z, Smi::New(array_cids_[i])));
+      ConditionInstr* compare = new (Z) EqualityCompareInstr(
+          InstructionSource(), Token::kEQ, new (Z) Value(class_ids[i]),
+          new (Z) Value(cid), kTagged, DeoptId::kNone, /*null_aware=*/false);
+      entry_block = AppendGuard(entry_block, cursor, compare, &entry_exits);
+      cursor = entry_block;
+    }
+    GotoInstr* jump = new (Z) GotoInstr(vector_header, DeoptId::kNone);
+    cursor->AppendInstruction(jump);
+    entry_block->set_last_instruction(jump);
+  }
+
+  // The vector loop header tests that the last lane of the next vector
+  // iteration is within all limits.
+  PhiInstr* vector_phi = new (Z) PhiInstr(vector_header, 2);
+  vector_phi->set_representation(rep);
+  vector_phi->mark_alive();
+  flow_graph_->AllocateSSAIndex(vector_phi);
+  vector_header->InsertPhi(vector_phi);
+  vector_phi->UpdateType(*phi_->Type());
+  if (Range* range = phi_->range()) {
+    vector_phi->set_range(
+        Range(Range::ConstantMin(range), Range::ConstantMax(range)));
+  }
+
+  Instruction* cursor = vector_header;
+  for (ForwardInstructionIterator it(header_); !it.Done(); it.Advance()) {
+    CheckStackOverflowInstr* check = it.Current()->AsCheckStackOverflow();
+    if (check == nullptr) {
+      continue;
+    }
+    CheckStackOverflowInstr* copy = new (Z) CheckStackOverflowInstr(
+        check->source(), check->stack_depth(), check->loop_depth(),
+        check->GetDeoptId(), CheckStackOverflowInstr::kOsrAndPreemption);
+    cursor = cursor->AppendInstruction(copy);
+    // The state at the start of a vector iteration is the state at the
+    // start of the scalar iteration vi.
+    if (check->env() != nullptr) {
+      Environment* env = check->env()->DeepCopy(Z);
+      for (Environment::DeepIterator env_it(env); !env_it.Done();
+           env_it.Advance()) {
+        Value* value = env_it.CurrentValue();
+        if (value->definition() == phi_) {
+          value->set_definition(vector_phi);
+        }
+        value->definition()->AddEnvUse(value);
+      }
+      copy->SetEnvironment(env);
+    }
+  }
+
+  if (rep == kUnboxedInt64) {
+    unboxed_index_ = vector_phi;
+  } else {
+    tagged_index_ = vector_phi;
+    unboxed_index_ = UnboxInstr::Create(kUnboxedInt64,
+                                        new (Z) Value(vector_phi),
+                                        DeoptId::kNone,
+                                        UnboxInstr::ValueMode::kHasValidType);
+    cursor = flow_graph_->AppendTo(cursor, unboxed_index_, nullptr,
+                                   FlowGraph::kValue);
+  }
+  Definition* last_lane = BinaryIntegerOpInstr::Make(
+      kUnboxedInt64, Token::kADD, new (Z) Value(unboxed_index_),
+      new (Z) Value(flow_graph_->GetConstant(
+          Smi::ZoneHandle(Z, Smi::New(lanes - 1)), kUnboxedInt64)),
+      DeoptId::kNone, /*can_overflow=*/false, /*is_truncating=*/false,
+      /*range=*/nullptr);
+  cursor =
+      flow_graph_->AppendTo(cursor, last_lane, nullptr, FlowGraph::kValue);
+
+  GrowableArray<TargetEntryInstr*> loop_exits;
+  BlockEntryInstr* block = vector_header;
+  for (Definition* limit : limits) {
+    ConditionInstr* compare = new (Z) RelationalOpInstr(
+        InstructionSource(), Token::kLT, new (Z) Value(last_lane),
+        new (Z) Value(limit), kUnboxedInt64, DeoptId::kNone);
+    block = AppendGuard(block, cursor, compare, &loop_exits);
+    cursor = block;
+  }
+
+  // The vector body, which advances by the number of lanes.
+  TargetEntryInstr* vector_body = block->AsTargetEntry();
+  cursor = EmitBody(cursor);
+  Definition* next = BinaryIntegerOpInstr::Make(
+      rep, Token::kADD, new (Z) Value(vector_phi),
+      new (Z) Value(
+          flow_graph_->GetConstant(Smi::ZoneHandle(Z, Smi::New(lanes)), rep)),
+      DeoptId::kNone, /*can_overflow=*/false, /*is_truncating=*/false,
+      /*range=*/nullptr);
+  cursor = flow_graph_->AppendTo(cursor, next, nullptr, FlowGraph::kValue);
+  GotoInstr* back_edge = new (Z) GotoInstr(vector_header, DeoptId::kNone);
+  cursor->AppendInstruction(back_edge);
+  vector_body->set_last_instruction(back_edge);
+
+  GrowableArray<PhiInput> header_inputs;
+  header_inputs.Add({entry_block, initial});
+  header_inputs.Add({vector_body, next});
+  BindPhiInputs(vector_phi, &header_inputs);
+
+  // All failed tests continue with the scalar loop, which starts from the
+  // first element that was not processed by the vector loop.
+  Definition* exit_index = vector_phi;
+  GrowableArray<PhiInput> exit_inputs;
+  for (TargetEntryInstr* exit : entry_exits) {
+    exit_inputs.Add({exit, initial});
+  }
+  for (TargetEntryInstr* exit : loop_exits) {
+    exit_inputs.Add({exit, vector_phi});
+  }
+  for (const PhiInput& input : exit_inputs) {
+    GotoInstr* jump = new (Z) GotoInstr(vector_exit, DeoptId::kNone);
+    input.block->AppendInstruction(jump);
+    input.block->set_last_instruction(jump);
+  }
+  if (!entry_exits.is_empty()) {
+    PhiInstr* exit_phi = new (Z) PhiInstr(vector_exit, exit_inputs.length());
+    exit_phi->set_representation(rep);
+    exit_phi->mark_alive();
+    flow_graph_->AllocateSSAIndex(exit_phi);
+    vector_exit->InsertPhi(exit_phi);
+    BindPhiInputs(exit_phi, &exit_inputs);
+    exit_phi->UpdateType(*phi_->Type());
+    if (Range* range = phi_->range()) {
+      exit_phi->set_range(
+          Range(Range::ConstantMin(range), Range::ConstantMax(range)));
+    }
+    exit_index = exit_phi;
+  }
+  GotoInstr* jump = new (Z) GotoInstr(header_, DeoptId::kNone);
+  vector_exit->AppendInstruction(jump);
+  vector_exit->set_last_instruction(jump);
+
+  // The scalar loop is now entered from the exit of the vector loop.
+  const bool exit_first = vector_exit->block_id() < body_->block_id();
+  phi_->InputAt(0)->BindTo(exit_first ? exit_index : back_value);
+  phi_->InputAt(1)->BindTo(exit_first ? back_value : exit_index);
+}
+
+TargetEntryInstr* LoopVectorizer::AppendGuard(
+    BlockEntryInstr* block,
+    Instruction* cursor,
+    ConditionInstr* condition,
+    GrowableArray<TargetEntryInstr*>* exits) {
+  BranchInstr* branch = new (Z) BranchInstr(condition, DeoptId::kNone);
+  cursor->AppendInstruction(branch);
+  block->set_last_instruction(branch);
+  TargetEntryInstr* true_target = NewTarget();
+  TargetEntryInstr* false_target = NewTarget();
+  *branch->true_successor_address() = true_target;
+  *branch->false_successor_address() = false_target;
+  exits->Add(false_target);
+  return true_target;
+}
+
+Instruction* LoopVectorizer::EmitBody(Instruction* cursor) {
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current->IsGoto() || (current == increment_)) {
+      continue;
+    }
+    if (Definition* vector = EmitInstruction(current, &cursor)) {
+      vector_map_.Insert(DefinitionKV::Pair(current->AsDefinition(), vector));
+    }
+  }
+  return cursor;
+}
+
+Definition* LoopVectorizer::EmitInstruction(Instruction* instr,
+                                            Instruction** cursor) {
+  // Vector accesses keep the scale of the element type, so that lane k
+  // accesses element vi + k.
+  if (auto load = instr->AsLoadIndexed()) {
+    LoadIndexedInstr* vector = new (Z) LoadIndexedInstr(
+        new (Z) Value(ArrayOf(load->array())),
+        new (Z) Value(IndexFor(load->index_unboxed(), cursor)),
+        load->index_unboxed(), load->index_scale(),
+        VectorArrayCid(load->class_id()), kUnalignedAccess, DeoptId::kNone,
+        load->source());
+    *cursor = flow_graph_->AppendTo(*cursor, vector, nullptr,
+                                    FlowGraph::kValue);
+    return vector;
+  }
+  if (auto store = instr->AsStoreIndexed()) {
+    StoreIndexedInstr* vector = new (Z) StoreIndexedInstr(
+        new (Z) Value(ArrayOf(store->array())),
+        new (Z) Value(IndexFor(store->index_unboxed(), cursor)),
+        new (Z) Value(VectorOf(store->value())), kNoStoreBarrier,
+        store->index_unboxed(), store->index_scale(),
+        VectorArrayCid(store->class_id()), kUnalignedAccess, DeoptId::kNone,
+        store->source());
+    *cursor = flow_graph_->AppendTo(*cursor, vector, nullptr,
+                                    FlowGraph::kEffect);
+    return nullptr;
+  }
+  if (auto op = instr->AsBinaryDoubleOp()) {
+    const intptr_t cid = (element_size_ == 8) ? kFloat64x2Cid : kFloat32x4Cid;
+    SimdOpInstr* vector =
+        SimdOpInstr::Create(SimdOpInstr::KindForOperator(cid, op->op_kind()),
+                            new (Z) Value(VectorOf(op->left())),
+                            new (Z) Value(VectorOf(op->right())),
+                            DeoptId::kNone);
+    *cursor = flow_graph_->AppendTo(*cursor, vector, nullptr,
+                                    FlowGraph::kValue);
+    return vector;
+  }
+  if (auto op = instr->AsBinaryIntegerOp()) {
+    SimdOpInstr* vector = SimdOpInstr::Create(
+        SimdOpInstr::KindForOperator(kInt32x4Cid, op->op_kind()),
+        new (Z) Value(VectorOf(op->left())),
+        new (Z) Value(VectorOf(op->right())), DeoptId::kNone);
+    *cursor = flow_graph_->AppendTo(*cursor, vector, nullptr,
+                                    FlowGraph::kValue);
+    return vector;
+  }
+  switch (static_cast<Kind>(kinds_.LookupValue(instr->AsDefinition()))) {
+    case kLanes:
+    case kRoundedLanes:
+      // Conversions between representations of the same lanes.
+      return VectorOf(instr->InputAt(0));
+    default:
+      // Bounds checks, writability checks and conversions of the index.
+      return nullptr;
+  }
+}
+
+Definition* LoopVectorizer::IndexFor(bool unboxed, Instruction** cursor) {
+  if (unboxed) {
+    return unboxed_index_;
+  }
+  if (tagged_index_ == nullptr) {
+    tagged_index_ =
+        BoxInstr::Create(kUnboxedInt64, new (Z) Value(unboxed_index_));
+    *cursor = flow_graph_->AppendTo(*cursor, tagged_index_, nullptr,
+                                    FlowGraph::kValue);
+  }
+  return tagged_index_;
+}
+
+Definition* LoopVectorizer::VectorOf(Value* value) {
+  Definition* def = value->definition();
+  if (Definition* vector = vector_map_.LookupValue(def)) {
+    return vector;
+  }
+  return Splat(def);
+}
+
+Definition* LoopVectorizer::Splat(Definition* def) {
+  if (Definition* splat = splat_map_.LookupValue(def)) {
+    return splat;
+  }
+  Definition* result = nullptr;
+  ConstantInstr* constant = def->AsConstant();
+  if ((constant != nullptr) && constant->value().IsInteger()) {
+    // Integer lanes are 32 bits wide, or four replicated bytes.
+    const int64_t value = Integer::Cast(constant->value()).Value();
+    const int32_t lane =
+        (element_size_ == 1)
+            ? static_cast<int32_t>(static_cast<uint32_t>(value & 0xFF) *
+                                   0x01010101u)
+            : static_cast<int32_t>(value);
+    Int32x4& vector = Int32x4::ZoneHandle(
+        Z, Int32x4::New(lane, lane, lane, lane, Heap::kOld));
+    vector ^= vector.Canonicalize(Thread::Current());
+    result = flow_graph_->GetConstant(vector, kUnboxedInt32x4);
+  } else {
+    Definition* value = def;
+    if (constant != nullptr) {
+      value = flow_graph_->GetConstant(constant->value(), kUnboxedDouble);
+    } else if (def->representation() == kUnboxedFloat) {
+      value = InsertInPreHeader(
+          new (Z) FloatToDoubleInstr(new (Z) Value(def), DeoptId::kNone));
+    }
+    result = InsertInPreHeader(SimdOpInstr::Create(
+        (element_size_ == 8) ? MethodRecognizer::kFloat64x2Splat
+                             : MethodRecognizer::kFloat32x4Splat,
+        new (Z) Value(value), DeoptId::kNone));
+  }
+  splat_map_.Insert(DefinitionKV::Pair(def, result));
+  return result;
+}
+
+Definition* LoopVectorizer::InsertInPreHeader(Definition* def) {
+  flow_graph_->InsertBefore(pre_header_->last_instruction(), def, nullptr,
+                            FlowGraph::kValue);
+  return def;
+}
+
+Definition* LoopVectorizer::UnboxedInt64(Definition* def) {
+  if (def->representation() == kUnboxedInt64) {
+    return def;
+  }
+  if (ConstantInstr* constant = def->AsConstant()) {
+    return flow_graph_->GetConstant(constant->value(), kUnboxedInt64);
+  }
+  ASSERT(def->representation() == kTagged);
+  return InsertInPreHeader(
+      UnboxInstr::Create(kUnboxedInt64, new (Z) Value(def), DeoptId::kNone,
+                         UnboxInstr::ValueMode::kHasValidType));
+}
+
+TargetEntryInstr* LoopVectorizer::NewTarget() {
+  return new (Z)
+      TargetEntryInstr(flow_graph_->allocate_block_id(), header_->try_index(),
+                       DeoptId::kNone, header_->stack_depth());
+}
+
+intptr_t LoopVectorizer::VectorArrayCid(intptr_t class_id) {
+  switch (class_id) {
+    case kTypedDataFloat64ArrayCid:
+      return kTypedDataFloat64x2ArrayCid;
+    case kTypedDataFloat32ArrayCid:
+      return kTypedDataFloat32x4ArrayCid;
+    default:
+      // Int32 lanes, or 16 bytes accessed as four 32-bit lanes.
+      ASSERT((class_id == kTypedDataInt32ArrayCid) ||
+             (class_id == kTypedDataUint8ArrayCid));
+      return kTypedDataInt32x4ArrayCid;
+  }
+}
+
+}  // namespace dart
@@ -0,0 +1,140 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/hash_map.h"
+
+namespace dart {
+
+// Vectorizes simple element-wise loops over typed data into SimdOp IL.
+//
+// The pass handles innermost counted loops of the form
+//
+//     for (int i = c; i < n; i++) {
+//       a[i] = f(b[i], c[i], ...);
+//     }
+//
+// where every access is at index i, c is a non-negative constant and f is a
+// tree of element-wise operations which have an exact 128-bit counterpart:
+// +, -, *, / on Float64List (Float64x2) and on Float32List (Float32x4,
+// only where the rounding of the scalar code is preserved); +, -, &, |, ^
+// on Int32List (Int32x4); &, |, ^ and plain copies on Uint8List.
+//
+// The stored value may also be loop invariant, which fills the array: a
+// constant, or a double or float32 value computed before the loop. Integer
+// values that are only known at run time are not supported, because there
+// is no SIMD operation to replicate them into the lanes.
+//
+// A vector loop is inserted in front of the original loop, which remains
+// as the scalar epilogue:
+//
+//     pre-header:  [v <- LoadClassId(a); Branch v == cid] ...
+//     vector loop: vi <- phi(c, vi + L)
+//                  Branch vi + (L - 1) < n, vi + (L - 1) < length ...
+//                    vector body; goto vector loop
+//     exit:        goto scalar loop with i = vi
+//
+// Arrays that are not known to be internal typed data are checked on entry,
+// so that accesses to different arrays never partially overlap (views) and
+// stores never hit unmodifiable data. Bounds checks of the scalar body are
+// replaced by checking the last lane of every vector iteration against the
+// checked length; the scalar loop performs the remaining iterations and
+// throws in the same place as before.
+class LoopVectorizer : public ValueObject {
+ public:
+  explicit LoopVectorizer(FlowGraph* flow_graph);
+
+  // Returns true if any loop was vectorized.
+  bool Optimize();
+
+ private:
+  // Classification of the definitions in the loop body.
+  enum Kind {
+    kUnsupported = 0,
+    // Defined outside of the loop.
+    kInvariant,
+    // The induction variable, possibly converted or bounds checked.
+    kIndex,
+    // A loop invariant array, redefined by CheckWritable.
+    kArray,
+    // Element values which have an exact vector counterpart.
+    kLanes,
+    // A float32 value computed in double precision by a single operation.
+    // Only exact once rounded to float32 again.
+    kRoundedLanes,
+  };
+
+  typedef RawPointerKeyValueTrait<Definition, Definition*> DefinitionKV;
+  typedef RawPointerKeyValueTrait<Definition, intptr_t> KindKV;
+
+  Zone* zone() const { return flow_graph_->zone(); }
+
+  // Checks that the loop has the shape handled by this pass and classifies
+  // all instructions of the loop body.
+  bool CanVectorize(LoopInfo* loop);
+  bool ClassifyBody();
+  Kind Classify(Instruction* instr);
+  Kind ClassifyAccess(Value* array, Value* index, intptr_t class_id,
+                      intptr_t index_scale);
+  Kind ClassifyDoubleOp(BinaryDoubleOpInstr* op);
+  Kind ClassifyIntegerOp(BinaryIntegerOpInstr* op);
+  bool IsSupportedInvariant(Value* value) const;
+  bool IsSupportedFill(Value* value, intptr_t class_id) const;
+  Kind KindOf(Value* value) const;
+  Definition* ArrayOf(Value* value) const;
+
+  // Emits the vector loop in front of the original loop.
+  void Transform();
+  TargetEntryInstr* AppendGuard(BlockEntryInstr* block,
+                                Instruction* cursor,
+                                ConditionInstr* condition,
+                                GrowableArray<TargetEntryInstr*>* exits);
+  Instruction* EmitBody(Instruction* cursor);
+  Definition* EmitInstruction(Instruction* instr, Instruction** cursor);
+  Definition* IndexFor(bool unboxed, Instruction** cursor);
+  Definition* VectorOf(Value* value);
+  Definition* Splat(Definition* def);
+  Definition* InsertInPreHeader(Definition* def);
+  Definition* UnboxedInt64(Definition* def);
+  TargetEntryInstr* NewTarget();
+  static intptr_t VectorArrayCid(intptr_t class_id);
+
+  FlowGraph* flow_graph_;
+
+  // Loop being vectorized.
+  JoinEntryInstr* header_;
+  TargetEntryInstr* body_;
+  BlockEntryInstr* pre_header_;
+  PhiInstr* phi_;
+  Definition* increment_;
+  RelationalOpInstr* condition_;
+  intptr_t element_size_;
+  // Arrays that have to be checked for being internal typed data, along
+  // with the expected class id, and lengths checked in the body.
+  GrowableArray<Definition*> arrays_;
+  GrowableArray<intptr_t> array_cids_;
+  GrowableArray<Definition*> lengths_;
+  DirectChainedHashMap<KindKV> kinds_;
+
+  // State of the emitted vector loop.
+  Definition* unboxed_index_;
+  Definition* tagged_index_;
+  DirectChainedHashMap<DefinitionKV> vector_map_;
+  DirectChainedHashMap<DefinitionKV> splat_map_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopVectorizer);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
@@ -0,0 +1,388 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Unit tests for loop vectorization.
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+
+#include <string>
+
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/jit/compiler.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+struct VectorShape {
+  intptr_t num_loops;
+  intptr_t num_simd_ops;
+};
+
+// Helper method to count loops and SIMD operations.
+static VectorShape ComputeVectorShape(FlowGraph* flow_graph) {
+  intptr_t num_simd_ops = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (it.Current()->IsSimdOp()) {
+        num_simd_ops++;
+      }
+    }
+  }
+  return {flow_graph->GetLoopHierarchy().num_loops(), num_simd_ops};
+}
+
+// Helper method to build CFG, run loop vectorization, and compute the
+// shape of foo before and after.
+static std::pair<VectorShape, VectorShape> ApplyLoopVectorization(
+    const char* script_chars) {
+  const auto& root_library = Library::Handle(LoadTestScript(script_chars));
+  Invoke(root_library, "main");
+  std::initializer_list<CompilerPass::Id> passes = {
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kInlining,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kSelectRepresentations,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kConstantPropagation,
+      CompilerPass::kCSE,
+      CompilerPass::kLICM,
+      CompilerPass::kRangeAnalysis,
+  };
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses(passes);
+  const VectorShape before = ComputeVectorShape(flow_graph);
+  pipeline.RunAdditionalPasses({
+      CompilerPass::kLoopVectorization,
+  });
+  const VectorShape after = ComputeVectorShape(flow_graph);
+  return {before, after};
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_Float64Add) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      void foo(Float64List a, Float64List b, Float64List c) {
+        for (int i = 0; i < a.length; i++) {
+          a[i] = b[i] + c[i] * 2.0;
+        }
+      }
+      main() {
+        final a = Float64List(100);
+        foo(a, Float64List(100), Float64List(100));
+      }
+    )";
+  auto result = ApplyLoopVectorization(kScriptChars);
+  EXPECT_EQ(1, result.first.num_loops);
+  EXPECT_EQ(0, result.first.num_simd_ops);
+  // The original loop remains as the scalar epilogue.
+  EXPECT_EQ(2, result.second.num_loops);
+  EXPECT(result.second.num_simd_ops > 0);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_Uint8Xor) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      void foo(Uint8List a, Uint8List b) {
+        for (int i = 0; i < a.length; i++) {
+          a[i] = b[i] ^ 0x5a;
+        }
+      }
+      main() {
+        final a = Uint8List(100);
+        foo(a, Uint8List(100));
+      }
+    )";
+  auto result = ApplyLoopVectorization(kScriptChars);
+  EXPECT_EQ(1, result.first.num_loops);
+  EXPECT_EQ(2, result.second.num_loops);
+  EXPECT(result.second.num_simd_ops > 0);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_KeepUint8Add) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+  // Byte additions would carry into neighbouring lanes.
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      void foo(Uint8List a, Uint8List b) {
+        for (int i = 0; i < a.length; i++) {
+          a[i] = b[i] + 1;
+        }
+      }
+      main() {
+        final a = Uint8List(100);
+        foo(a, Uint8List(100));
+      }
+    )";
+  auto result = ApplyLoopVectorization(kScriptChars);
+  EXPECT_EQ(1, result.first.num_loops);
+  EXPECT_EQ(1, result.second.num_loops);
+  EXPECT_EQ(0, result.second.num_simd_ops);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_KeepReduction) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      double foo(Float64List a) {
+        double sum = 0.0;
+        for (int i = 0; i < a.length; i++) {
+          sum += a[i];
+        }
+        return sum;
+      }
+      main() {
+        foo(Float64List(100));
+      }
+    )";
+  auto result = ApplyLoopVectorization(kScriptChars);
+  EXPECT_EQ(1, result.first.num_loops);
+  EXPECT_EQ(1, result.second.num_loops);
+  EXPECT_EQ(0, result.second.num_simd_ops);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_Float64Fill) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      void foo(Float64List a) {
+        for (int i = 0; i < a.length; i++) {
+          a[i] = 1.5;
+        }
+      }
+      main() {
+        foo(Float64List(100));
+      }
+    )";
+  auto result = ApplyLoopVectorization(kScriptChars);
+  EXPECT_EQ(1, result.first.num_loops);
+  EXPECT_EQ(2, result.second.num_loops);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_KeepInt32VariableFill) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+  // There is no operation to replicate an integer into Int32x4 lanes.
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      void foo(Int32List a, int v) {
+        for (int i = 0; i < a.length; i++) {
+          a[i] = v;
+        }
+      }
+      main() {
+        foo(Int32List(100), 7);
+      }
+    )";
+  auto result = ApplyLoopVectorization(kScriptChars);
+  EXPECT_EQ(1, result.first.num_loops);
+  EXPECT_EQ(1, result.second.num_loops);
+}
+
+// Kernels and drivers of the execution test. '$' is replaced by a prefix, so
+// that the optimized kernels and the unoptimized reference kernels collect
+// separate type feedback.
+static const char* kExecutionKernels = R"(
+@pragma('vm:never-inline')
+void $addF64(Float64List a, Float64List b, Float64List c) {
+  for (int i = 0; i < a.length; i++) {
+    a[i] = b[i] + c[i] * 2.0;
+  }
+}
+@pragma('vm:never-inline')
+void $mulF32(Float32List a, Float32List b, Float32List c) {
+  for (int i = 0; i < a.length; i++) {
+    a[i] = b[i] * c[i];
+  }
+}
+@pragma('vm:never-inline')
+void $mulAddF32(Float32List a, Float32List b, Float32List c) {
+  for (int i = 0; i < a.length; i++) {
+    a[i] = b[i] * c[i] + b[i];
+  }
+}
+@pragma('vm:never-inline')
+void $xorU8(Uint8List a, Uint8List b) {
+  for (int i = 0; i < a.length; i++) {
+    a[i] = b[i] ^ 0x5a;
+  }
+}
+@pragma('vm:never-inline')
+void $addI32(Int32List a, Int32List b) {
+  for (int i = 0; i < a.length; i++) {
+    a[i] = a[i] + b[i];
+  }
+}
+@pragma('vm:never-inline')
+void $fillF64(Float64List a, double v) {
+  for (int i = 0; i < a.length; i++) {
+    a[i] = v;
+  }
+}
+@pragma('vm:never-inline')
+void $fillF32(Float32List a) {
+  for (int i = 0; i < a.length; i++) {
+    a[i] = 0.1;
+  }
+}
+@pragma('vm:never-inline')
+void $fillU8(Uint8List a) {
+  for (int i = 0; i < a.length; i++) {
+    a[i] = 0x1a5;
+  }
+}
+String $check(int n) {
+  final out = StringBuffer();
+  final a = Float64List(n);
+  final b = Float64List(n);
+  final c = Float64List(n);
+  final fa = Float32List(n);
+  final fb = Float32List(n);
+  final fc = Float32List(n);
+  final ua = Uint8List(n);
+  final ub = Uint8List(n);
+  final ia = Int32List(n);
+  for (int i = 0; i < n; i++) {
+    b[i] = i * 0.1;
+    c[i] = 1.0 / (i + 3);
+    fb[i] = 1.0 / (i + 3);
+    fc[i] = (i + 1) * 0.7;
+    ub[i] = i * 13;
+    ia[i] = i * 0x10000001;
+  }
+  $addF64(a, b, c);
+  out.write(a);
+  $addF64(b, b, b);
+  out.write(b);
+  $fillF64(a, n / 3);
+  out.write(a);
+  $mulF32(fa, fb, fc);
+  out.write(fa);
+  $mulAddF32(fa, fb, fc);
+  out.write(fa);
+  $fillF32(fa);
+  out.write(fa);
+  $xorU8(ua, ub);
+  out.write(ua);
+  $fillU8(ua);
+  out.write(ua);
+  $addI32(ia, ia);
+  out.write(ia);
+  return out.toString();
+}
+String $checkViews() {
+  final out = StringBuffer();
+  final f64 = Float64List(20);
+  final u8 = Uint8List(40);
+  final i32 = Int32List(20);
+  for (int i = 0; i < u8.length; i++) {
+    u8[i] = i * 7;
+  }
+  for (int i = 0; i < f64.length; i++) {
+    f64[i] = i * 0.5;
+    i32[i] = i * 3;
+  }
+  $addF64(Float64List.sublistView(f64, 1), Float64List.sublistView(f64, 0, 19),
+      Float64List.sublistView(f64, 2));
+  out.write(f64);
+  $xorU8(Uint8List.sublistView(u8, 3), u8);
+  out.write(u8);
+  $addI32(Int32List.sublistView(i32, 1), i32);
+  out.write(i32);
+  return out.toString();
+}
+)";
+
+static std::string ExecutionKernels(const char* prefix) {
+  std::string kernels(kExecutionKernels);
+  for (size_t pos = kernels.find('$'); pos != std::string::npos;
+       pos = kernels.find('$', pos)) {
+    kernels.replace(pos, 1, prefix);
+  }
+  return kernels;
+}
+
+// Compares the results of vectorized kernels with the same kernels run
+// unoptimized, for trip counts 0 to 40, arrays passed more than once and
+// overlapping views of one buffer.
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_Execution) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+  std::string script = R"(
+    import 'dart:typed_data';
+    warmup() {
+      for (int n = 0; n < 10; n++) {
+        opt_check(n);
+      }
+    }
+    String optimized() {
+      final out = StringBuffer();
+      for (int n = 0; n <= 40; n++) {
+        out.write(opt_check(n));
+      }
+      return out.toString();
+    }
+    String optimizedViews() => opt_checkViews();
+    String reference() {
+      final out = StringBuffer();
+      for (int n = 0; n <= 40; n++) {
+        out.write(ref_check(n));
+      }
+      return out.toString();
+    }
+    String referenceViews() => ref_checkViews();
+  )";
+  script += ExecutionKernels("opt_");
+  script += ExecutionKernels("ref_");
+  const auto& root_library = Library::Handle(LoadTestScript(script.c_str()));
+  Invoke(root_library, "warmup");
+
+  const char* kKernels[] = {"opt_addF64", "opt_mulF32", "opt_mulAddF32",
+                            "opt_xorU8",  "opt_addI32", "opt_fillF64",
+                            "opt_fillF32", "opt_fillU8"};
+  Function& function = Function::Handle();
+  for (const char* name : kKernels) {
+    function = GetFunction(root_library, name);
+    Compiler::CompileOptimizedFunction(thread, function);
+    EXPECT(function.HasOptimizedCode());
+  }
+
+  String& expected = String::Handle();
+  String& actual = String::Handle();
+  expected ^= Invoke(root_library, "reference");
+  actual ^= Invoke(root_library, "optimized");
+  EXPECT_STREQ(expected.ToCString(), actual.ToCString());
+  for (const char* name : kKernels) {
+    function = GetFunction(root_library, name);
+    EXPECT(function.HasOptimizedCode());
+  }
+
+  // Views fail the class checks and run through the scalar loop, or
+  // deoptimize.
+  expected ^= Invoke(root_library, "referenceViews");
+  actual ^= Invoke(root_library, "optimizedViews");
+  EXPECT_STREQ(expected.ToCString(), actual.ToCString());
+}
+
+#endif  // defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+}  // namespace dart
@@ -75,6 +75,16 @@ void RangeAnalysis::Analyze() {
   RemoveConstraints();
 }
 
+void RangeAnalysis::ReanalyzeBoundsChecks() {
+  CollectValues();
+  InsertConstraints();
+  flow_graph_->GetLoopHierarchy().ComputeInduction();
+  InferRanges();
+  EliminateRedundantBoundsChecks();
+  MarkUnreachableBlocks();
+  RemoveConstraints();
+}
+
 // Helper method to chase to a constrained definition.
 static Definition* UnwrapConstraint(Definition* defn) {
   while (defn->IsConstraint()) {
@@ -476,6 +476,11 @@ class RangeAnalysis : public ValueObject {
   // operations when proven redundant.
   void Analyze();
 
+  // Recompute ranges after a loop transformation has copied instructions,
+  // and remove bounds checks that became redundant. Unlike Analyze() this
+  // leaves the representations of integer operations as they are.
+  void ReanalyzeBoundsChecks();
+
   static bool IsIntegerDefinition(Definition* defn) {
     return defn->Type()->IsInt();
   }
@@ -19,6 +19,15 @@ namespace dart {
 
 DEFINE_FLAG(bool, dead_store_elimination, true, "Eliminate dead stores");
 DEFINE_FLAG(bool, load_cse, true, "Use redundant load elimination.");
+DEFINE_FLAG(bool,
+            load_pre,
+            true,
+            "Eliminate loads which are redundant on some of the paths "
+            "reaching them.");
+DEFINE_FLAG(bool,
+            hoist_common_instructions,
+            true,
+            "Hoist instructions computed on both sides of a branch.");
 DEFINE_FLAG(bool,
             optimize_lazy_initializer_calls,
             true,
@@ -1884,6 +1893,13 @@ class LoadOptimizer : public ValueObject {
 
     ComputeInitialSets();
     ComputeOutSets();
+    if (FLAG_load_pre && InsertPartiallyRedundantLoads()) {
+      // Recompute availability from scratch to account for inserted loads.
+      for (intptr_t i = 0, n = out_.length(); i < n; ++i) {
+        out_[i] = nullptr;
+      }
+      ComputeOutSets();
+    }
     ComputeOutValues();
     if (graph_->is_licm_allowed()) {
       MarkLoopInvariantLoads();
@@ -2509,6 +2525,112 @@ class LoadOptimizer : public ValueObject {
     }
   }
 
+  // Returns true if copies of the given upwards exposed load can be inserted
+  // at the end of predecessors of the join block containing it.
+  bool CanInsertCopiesOf(JoinEntryInstr* join, LoadFieldInstr* load) {
+    if (load->calls_initializer() ||
+        (load->loads_inner_pointer() != InnerPointerAccess::kNotUntagged) ||
+        (load->memory_order() != compiler::Assembler::kRelaxedNonAtomic)) {
+      return false;
+    }
+    // The instance must be available in all predecessors and must not be
+    // a phi of the join: such places are translated by phi moves.
+    BlockEntryInstr* instance_block =
+        load->instance()->definition()->GetBlock();
+    if ((instance_block == join) || !instance_block->Dominates(join)) {
+      return false;
+    }
+    // The load must be executed whenever the join is entered, otherwise a
+    // check preceding it might be what makes the load valid.
+    for (Instruction* instr = join->next(); instr != load;
+         instr = instr->next()) {
+      if (instr->CanDeoptimize() || instr->MayThrow()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Makes loads which are available on some but not all incoming edges of a
+  // join fully redundant by inserting copies of them at the end of the
+  // predecessors where they are not available. ForwardLoads then replaces
+  // the load in the join with a phi. Since the load in the join is executed
+  // on every path through it, no path executes more loads than before.
+  //
+  // Loop headers are left to LICM, which hoists loop invariant loads into
+  // the pre-header.
+  bool InsertPartiallyRedundantLoads() {
+    if (graph_->function().ProhibitsInstructionHoisting()) {
+      return false;
+    }
+    bool inserted = false;
+    GrowableArray<BlockEntryInstr*> missing(4);
+    for (BlockIterator block_it = graph_->reverse_postorder_iterator();
+         !block_it.Done(); block_it.Advance()) {
+      JoinEntryInstr* join = block_it.Current()->AsJoinEntry();
+      if ((join == nullptr) || join->IsLoopHeader()) {
+        continue;
+      }
+      ZoneGrowableArray<Definition*>* loads =
+          exposed_values_[join->preorder_number()];
+      if (loads == nullptr) {
+        continue;
+      }
+      for (intptr_t i = 0; i < loads->length(); i++) {
+        LoadFieldInstr* load = (*loads)[i]->AsLoadField();
+        if ((load == nullptr) || !CanInsertCopiesOf(join, load)) {
+          continue;
+        }
+        const intptr_t place_id = GetPlaceId(load);
+        missing.Clear();
+        bool can_insert = true;
+        for (intptr_t j = 0; j < join->PredecessorCount(); j++) {
+          BlockEntryInstr* pred = join->PredecessorAt(j);
+          if (out_[pred->preorder_number()]->Contains(place_id)) {
+            continue;
+          }
+          // Inserting into a predecessor with several successors would
+          // put the load on paths which do not reach the join.
+          if (!pred->last_instruction()->IsGoto() ||
+              (pred->try_index() != join->try_index())) {
+            can_insert = false;
+            break;
+          }
+          missing.Add(pred);
+        }
+        if (!can_insert || missing.is_empty() ||
+            (missing.length() == join->PredecessorCount())) {
+          continue;
+        }
+
+        for (BlockEntryInstr* pred : missing) {
+          LoadFieldInstr* copy = new (Z) LoadFieldInstr(
+              load->instance()->CopyWithType(Z), load->slot(),
+              load->loads_inner_pointer(), load->source());
+          graph_->InsertBefore(pred->last_instruction(), copy,
+                               /*env=*/nullptr, FlowGraph::kValue);
+          SetPlaceId(copy, place_id);
+          gen_[pred->preorder_number()]->Add(place_id);
+          ZoneGrowableArray<Definition*>* pred_out_values =
+              out_values_[pred->preorder_number()];
+          if (pred_out_values == nullptr) {
+            out_values_[pred->preorder_number()] = pred_out_values =
+                CreateBlockOutValues();
+          }
+          (*pred_out_values)[place_id] = copy;
+          if (FLAG_trace_optimization && graph_->should_print()) {
+            THR_Print("Inserting copy v%" Pd " of load v%" Pd " into B%" Pd
+                      "\n",
+                      copy->ssa_temp_index(), load->ssa_temp_index(),
+                      pred->block_id());
+          }
+        }
+        inserted = true;
+      }
+    }
+    return inserted;
+  }
+
   // Compute out_values mappings by propagating them in reverse postorder once
   // through the graph. Generate phis on back edges where eager merge is
   // impossible.
@@ -3070,10 +3192,95 @@ bool DominatorBasedCSE::Optimize(FlowGraph* graph,
   return changed;
 }
 
+// Returns true if the given instruction can be moved from the start of a
+// branch target into the block ending with the branch. Instructions which
+// can deoptimize or have visible effects end the range of instructions
+// considered for hoisting, since later instructions might depend on them.
+static bool IsHoistingBarrier(Instruction* instr) {
+  return instr->CanDeoptimize() || instr->MayHaveVisibleEffect();
+}
+
+static bool InputsDominate(Instruction* instr, BlockEntryInstr* block) {
+  for (intptr_t i = 0; i < instr->InputCount(); ++i) {
+    if (!instr->InputAt(i)->definition()->GetBlock()->Dominates(block)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DominatorBasedCSE::HoistCommonInstructions(FlowGraph* graph,
+                                                BlockEntryInstr* block) {
+  BranchInstr* branch = block->last_instruction()->AsBranch();
+  if (branch == nullptr) {
+    return false;
+  }
+  TargetEntryInstr* true_target = branch->true_successor();
+  TargetEntryInstr* false_target = branch->false_successor();
+  if ((true_target->try_index() != block->try_index()) ||
+      (false_target->try_index() != block->try_index())) {
+    return false;
+  }
+
+  // Bound the quadratic matching below.
+  const intptr_t kMaxCandidates = 32;
+  GrowableArray<Definition*> candidates(kMaxCandidates);
+  for (ForwardInstructionIterator it(false_target); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (IsHoistingBarrier(current)) break;
+    if (current->AllowsCSE() && current->IsDefinition()) {
+      candidates.Add(current->AsDefinition());
+      if (candidates.length() == kMaxCandidates) break;
+    }
+  }
+  if (candidates.is_empty()) {
+    return false;
+  }
+
+  bool changed = false;
+  for (ForwardInstructionIterator it(true_target); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (IsHoistingBarrier(current)) break;
+    if (!current->AllowsCSE() || !current->IsDefinition() ||
+        !InputsDominate(current, block)) {
+      continue;
+    }
+    for (intptr_t i = 0; i < candidates.length(); ++i) {
+      Definition* other = candidates[i];
+      if ((other == nullptr) || !other->Equals(*current)) {
+        continue;
+      }
+      if (FLAG_trace_optimization && graph->should_print()) {
+        THR_Print("Hoisting v%" Pd " and v%" Pd " from B%" Pd " and B%" Pd
+                  " to B%" Pd "\n",
+                  current->AsDefinition()->ssa_temp_index(),
+                  other->ssa_temp_index(), true_target->block_id(),
+                  false_target->block_id(), block->block_id());
+      }
+      current->RemoveEnvironment();
+      it.RemoveCurrentFromGraph();
+      // Using kind kEffect will not assign a fresh ssa temporary index.
+      graph->InsertBefore(branch, current, /*env=*/nullptr,
+                          FlowGraph::kEffect);
+      other->ReplaceUsesWith(current->AsDefinition());
+      other->RemoveFromGraph();
+      candidates[i] = nullptr;
+      changed = true;
+      break;
+    }
+  }
+  return changed;
+}
+
 bool DominatorBasedCSE::OptimizeRecursive(FlowGraph* graph,
                                           BlockEntryInstr* block,
                                           CSEInstructionSet* map) {
   bool changed = false;
+  // Hoist first, so that hoisted instructions take part in CSE of the block.
+  if (FLAG_hoist_common_instructions &&
+      !graph->function().ProhibitsInstructionHoisting()) {
+    changed = HoistCommonInstructions(graph, block) || changed;
+  }
   for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
     Instruction* current = it.Current();
     if (current->AllowsCSE()) {
@@ -3497,6 +3704,32 @@ bool AllocationSinking::IsSafeUse(Value* use, SafeUseCheck check_type) {
   return false;
 }
 
+bool AllocationSinking::IsSinkableArgument(Value* argument) {
+  // Objects with few fields which are commonly created only to be passed
+  // to a helper: closures, records and small instances.
+  const intptr_t kMaxSinkableArgumentFields = 8;
+  Definition* alloc = argument->definition();
+  if (auto alloc_object = alloc->AsAllocateObject()) {
+    const intptr_t size =
+        compiler::target::Class::GetInstanceSize(alloc_object->cls());
+    if (size > compiler::target::kWordSize +
+                   kMaxSinkableArgumentFields *
+                       compiler::target::kCompressedWordSize) {
+      return false;
+    }
+  } else if (!alloc->IsAllocateClosure() && !alloc->IsAllocateRecord() &&
+             !alloc->IsAllocateSmallRecord()) {
+    return false;
+  }
+  for (Value* use = alloc->input_use_list(); use != nullptr;
+       use = use->next_use()) {
+    if ((use != argument) && !IsSafeUse(use, kOptimisticCheck)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // Right now we are attempting to sink allocation only into
 // deoptimization exit. So candidate should only be used in StoreField
 // instructions that write into fields of the allocated object.
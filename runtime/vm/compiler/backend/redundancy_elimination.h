@@ -34,6 +34,11 @@ class AllocationSinking : public ZoneAllocated {
 
   void DetachMaterializations();
 
+  // Returns true if the given call argument is an allocation which would
+  // become an allocation sinking candidate if the call was inlined and the
+  // callee did not let the corresponding parameter escape.
+  static bool IsSinkableArgument(Value* argument);
+
  private:
   // Helper class to collect deoptimization exits that might need to
   // rematerialize an object: that is either instructions that reference
@@ -78,7 +83,7 @@ class AllocationSinking : public ZoneAllocated {
 
   bool IsAllocationSinkingCandidate(Definition* alloc, SafeUseCheck check_type);
 
-  bool IsSafeUse(Value* use, SafeUseCheck check_type);
+  static bool IsSafeUse(Value* use, SafeUseCheck check_type);
 
   Zone* zone() const { return flow_graph_->zone(); }
 
@@ -102,6 +107,10 @@ class DominatorBasedCSE : public AllStatic {
   static bool OptimizeRecursive(FlowGraph* graph,
                                 BlockEntryInstr* entry,
                                 CSEInstructionSet* map);
+
+  // Moves instructions computed at the start of both targets of the branch
+  // ending the given block into the block.
+  static bool HoistCommonInstructions(FlowGraph* graph, BlockEntryInstr* block);
 };
 
 class DeadStoreElimination : public AllStatic {
@@ -928,6 +928,214 @@ ISOLATE_UNIT_TEST_CASE(LoadOptimizer_RedundantStoresAndLoads) {
   EXPECT_EQ(1, aft_stores);
 }
 
+static FlowGraph* OptimizeBeforeCSE(const Library& root_library,
+                                     const char* name) {
+  const auto& function = Function::Handle(GetFunction(root_library, name));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  return pipeline.RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kSelectRepresentations,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kConstantPropagation,
+  });
+}
+
+ISOLATE_UNIT_TEST_CASE(LoadOptimizer_PartiallyRedundantLoad) {
+  const char* kScript = R"(
+    class A {
+      int f;
+      A(this.f);
+    }
+
+    int foo(A a, bool c) {
+      int x = 0;
+      if (c) {
+        x = a.f;
+      }
+      return x + a.f;
+    }
+
+    main() {
+      foo(A(1), true);
+      foo(A(2), false);
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+  FlowGraph* flow_graph = OptimizeBeforeCSE(root_library, "foo");
+  ASSERT(flow_graph != nullptr);
+
+  DominatorBasedCSE::Optimize(flow_graph);
+
+  // The load after the if is available on one path, so a copy of it is
+  // inserted on the other path and the join merges both with a phi.
+  intptr_t loads = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    BlockEntryInstr* block = block_it.Current();
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      if (it.Current()->IsLoadField()) {
+        EXPECT(!block->IsJoinEntry());
+        loads++;
+      }
+    }
+  }
+  EXPECT_EQ(2, loads);
+}
+
+ISOLATE_UNIT_TEST_CASE(CSE_HoistCommonInstructions) {
+  const char* kScript = R"(
+    class A {
+      final int f;
+      A(this.f);
+    }
+
+    int foo(A a, bool c) {
+      if (c) {
+        return a.f + 1;
+      } else {
+        return a.f - 1;
+      }
+    }
+
+    main() {
+      foo(A(1), true);
+      foo(A(2), false);
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+  FlowGraph* flow_graph = OptimizeBeforeCSE(root_library, "foo");
+  ASSERT(flow_graph != nullptr);
+
+  DominatorBasedCSE::Optimize(flow_graph);
+
+  // The load of the final field is computed once before the branch.
+  intptr_t loads = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    BlockEntryInstr* block = block_it.Current();
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      if (it.Current()->IsLoadField()) {
+        EXPECT(block->last_instruction()->IsBranch());
+        loads++;
+      }
+    }
+  }
+  EXPECT_EQ(1, loads);
+}
+
+// Runs the passes up to and including LICM and returns the number of loads
+// of Dart fields left in the function, and how many of them are in loops.
+static std::pair<intptr_t, intptr_t> CountLoadsAfterLICM(
+    const Library& root_library,
+    const char* name) {
+  const auto& function = Function::Handle(GetFunction(root_library, name));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kSelectRepresentations,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kConstantPropagation,
+      CompilerPass::kCSE,
+      CompilerPass::kLICM,
+  });
+  EXPECT_EQ(1, flow_graph->GetLoopHierarchy().num_loops());
+  intptr_t loads = 0;
+  intptr_t loads_in_loops = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    BlockEntryInstr* block = block_it.Current();
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      LoadFieldInstr* load = it.Current()->AsLoadField();
+      if ((load != nullptr) && load->slot().IsDartField()) {
+        loads++;
+        if (block->loop_info() != nullptr) {
+          loads_in_loops++;
+        }
+      }
+    }
+  }
+  return {loads, loads_in_loops};
+}
+
+ISOLATE_UNIT_TEST_CASE(LICM_LoadThroughPhiReceiver) {
+  const char* kScript = R"(
+    class A {
+      int x;
+      A(this.x);
+    }
+
+    int foo(bool c, A a, A b, int n) {
+      final r = c ? a : b;
+      int sum = 0;
+      for (int i = 0; i < n; i++) {
+        sum += r.x;
+      }
+      return sum;
+    }
+
+    main() {
+      final a = A(1);
+      final b = A(2);
+      for (int i = 0; i < 100; i++) {
+        foo(i.isEven, a, b, 10);
+      }
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+
+  // The receiver of the load is a phi merging a and b before the loop, and
+  // nothing in the loop writes the field, so the load is moved out of it.
+  const auto loads = CountLoadsAfterLICM(root_library, "foo");
+  EXPECT_EQ(1, loads.first);
+  EXPECT_EQ(0, loads.second);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoadOptimizer_LoopCarriedLoadThroughPhiReceiver) {
+  const char* kScript = R"(
+    class A {
+      int x;
+      A(this.x);
+    }
+
+    int foo(bool c, A a, A b, int n) {
+      final r = c ? a : b;
+      r.x = 0;
+      for (int i = 0; i < n; i++) {
+        r.x = r.x + i;
+      }
+      return r.x;
+    }
+
+    main() {
+      final a = A(1);
+      final b = A(2);
+      for (int i = 0; i < 100; i++) {
+        foo(i.isEven, a, b, 10);
+      }
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+
+  // The value stored in one iteration is carried around the back edge by a
+  // phi in the loop header, and the load after the loop reads the same phi.
+  const auto loads = CountLoadsAfterLICM(root_library, "foo");
+  EXPECT_EQ(0, loads.first);
+}
+
 ISOLATE_UNIT_TEST_CASE(LoadOptimizer_RedundantStaticFieldInitialization) {
   const char* kScript = R"(
     int getX() => 2;
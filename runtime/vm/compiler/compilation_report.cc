@@ -0,0 +1,247 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/compilation_report.h"
+
+#include "platform/text_buffer.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/dart.h"
+#include "vm/deopt_instructions.h"
+#include "vm/flags.h"
+#include "vm/json_writer.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/runtime_entry.h"
+#include "vm/timeline.h"
+
+namespace dart {
+
+DEFINE_FLAG(charp,
+            compilation_report_to,
+            nullptr,
+            "Write a JSON report of every compilation (pass timings, IL sizes, "
+            "inlining decisions and deoptimizations) to the given file.");
+
+Mutex CompilationReport::mutex_;
+void* CompilationReport::file_ = nullptr;
+#if defined(TESTING)
+BaseTextBuffer* CompilationReport::buffer_ = nullptr;
+#endif
+bool CompilationReport::needs_comma_ = false;
+
+bool CompilationReport::IsEnabled() {
+  if (file_ != nullptr) {
+    return true;
+  }
+#if defined(TESTING)
+  if (buffer_ != nullptr) {
+    return true;
+  }
+#endif
+#if defined(SUPPORT_TIMELINE)
+  return Timeline::GetCompilerVerboseStream()->enabled();
+#else
+  return false;
+#endif
+}
+
+CompilationReport::CompilationReport(const Function& function,
+                                     bool is_aot,
+                                     bool is_optimizing)
+    : function_(function),
+      function_name_(function.ToFullyQualifiedCString()),
+      is_aot_(is_aot),
+      is_optimizing_(is_optimizing),
+      start_micros_(OS::GetCurrentMonotonicMicros()) {}
+
+bool CompilationReport::IsReportedGraph(const FlowGraph* flow_graph) const {
+  return flow_graph->function().ptr() == function_.ptr();
+}
+
+void CompilationReport::AddPass(const char* name,
+                                intptr_t round,
+                                int64_t elapsed_micros,
+                                intptr_t instructions_before,
+                                intptr_t instructions_after) {
+  passes_.Add(
+      {name, round, elapsed_micros, instructions_before, instructions_after});
+}
+
+void CompilationReport::AddInliningDecision(const Function& caller,
+                                            const Function& callee,
+                                            intptr_t depth,
+                                            intptr_t deopt_id,
+                                            const char* bailout_reason) {
+  inlining_decisions_.Add({caller.ToFullyQualifiedCString(),
+                           callee.ToFullyQualifiedCString(), depth, deopt_id,
+                           bailout_reason});
+}
+
+void CompilationReport::Finish(const Code& code) {
+  JSONWriter writer;
+  PrintJSON(&writer, code);
+  const char* json = writer.ToCString();
+  Emit(json);
+
+#if defined(SUPPORT_TIMELINE)
+  TimelineStream* stream = Timeline::GetCompilerVerboseStream();
+  if (stream->enabled()) {
+    TimelineEvent* event = stream->StartEvent();
+    if (event != nullptr) {
+      event->Duration("CompilationReport", start_micros_,
+                      OS::GetCurrentMonotonicMicros());
+      event->SetNumArguments(2);
+      event->CopyArgument(0, "function", function_name_);
+      event->CopyArgument(1, "report", json);
+      event->Complete();
+    }
+  }
+#endif  // defined(SUPPORT_TIMELINE)
+}
+
+void CompilationReport::PrintJSON(JSONWriter* writer, const Code& code) const {
+  writer->OpenObject();
+  writer->PrintProperty("kind", "compilation");
+  writer->PrintProperty("function", function_name_);
+  writer->PrintProperty("mode", is_aot_ ? "aot" : "jit");
+  writer->PrintPropertyBool("optimized", is_optimizing_);
+  writer->PrintProperty64("micros",
+                          OS::GetCurrentMonotonicMicros() - start_micros_);
+  writer->PrintProperty("codeSize", static_cast<intptr_t>(code.Size()));
+  writer->PrintProperty(
+      "deoptimizationCounter",
+      static_cast<intptr_t>(function_.deoptimization_counter()));
+
+  writer->OpenArray("passes");
+  for (const auto& pass : passes_) {
+    writer->OpenObject();
+    writer->PrintProperty("name", pass.name);
+    writer->PrintProperty("round", pass.round);
+    writer->PrintProperty64("micros", pass.elapsed_micros);
+    writer->PrintProperty("instructionsBefore", pass.instructions_before);
+    writer->PrintProperty("instructionsAfter", pass.instructions_after);
+    writer->CloseObject();
+  }
+  writer->CloseArray();
+
+  writer->OpenArray("inlining");
+  for (const auto& decision : inlining_decisions_) {
+    writer->OpenObject();
+    writer->PrintProperty("caller", decision.caller);
+    writer->PrintProperty("callee", decision.callee);
+    writer->PrintProperty("depth", decision.depth);
+    writer->PrintProperty("deoptId", decision.deopt_id);
+    writer->PrintPropertyBool("inlined", decision.bailout_reason == nullptr);
+    if (decision.bailout_reason != nullptr) {
+      writer->PrintProperty("reason", decision.bailout_reason);
+    }
+    writer->CloseObject();
+  }
+  writer->CloseArray();
+
+  // Deoptimization exits of the generated code grouped by reason.
+  intptr_t deopt_exits[ICData::kDeoptNumReasons] = {};
+  const Array& deopt_table = Array::Handle(code.deopt_info_array());
+  if (!deopt_table.IsNull()) {
+    Smi& offset = Smi::Handle();
+    TypedData& info = TypedData::Handle();
+    Smi& reason_and_flags = Smi::Handle();
+    const intptr_t length = DeoptTable::GetLength(deopt_table);
+    for (intptr_t i = 0; i < length; i++) {
+      DeoptTable::GetEntry(deopt_table, i, &offset, &info, &reason_and_flags);
+      deopt_exits[DeoptTable::ReasonField::decode(reason_and_flags.Value())]++;
+    }
+  }
+  writer->OpenArray("deoptExits");
+  for (intptr_t i = 0; i < ICData::kDeoptNumReasons; i++) {
+    if (deopt_exits[i] == 0) continue;
+    writer->OpenObject();
+    writer->PrintProperty(
+        "reason",
+        DeoptReasonToCString(static_cast<ICData::DeoptReasonId>(i)));
+    writer->PrintProperty("count", deopt_exits[i]);
+    writer->CloseObject();
+  }
+  writer->CloseArray();
+
+  writer->CloseObject();
+}
+
+void CompilationReport::ReportDeoptimization(const Code& code,
+                                             const char* reason,
+                                             intptr_t deoptimization_counter) {
+  const Function& function = Function::Handle(code.function());
+  JSONWriter writer;
+  writer.OpenObject();
+  writer.PrintProperty("kind", "deoptimization");
+  writer.PrintProperty("function", function.ToFullyQualifiedCString());
+  writer.PrintProperty("reason", reason);
+  writer.PrintProperty("deoptimizationCounter", deoptimization_counter);
+  writer.CloseObject();
+  Emit(writer.ToCString());
+}
+
+void CompilationReport::Emit(const char* json) {
+  MutexLocker ml(&mutex_);
+#if defined(TESTING)
+  if (buffer_ != nullptr) {
+    buffer_->AddString(needs_comma_ ? ",\n" : "[\n");
+    buffer_->AddString(json);
+    needs_comma_ = true;
+    return;
+  }
+#endif
+  if (file_ == nullptr) {
+    return;
+  }
+  if (needs_comma_) {
+    Dart::file_write_callback()(",\n", 2, file_);
+  }
+  Dart::file_write_callback()(json, strlen(json), file_);
+  needs_comma_ = true;
+}
+
+void CompilationReport::Init() {
+  ASSERT(file_ == nullptr);
+  if (FLAG_compilation_report_to == nullptr) {
+    return;
+  }
+  Dart_FileOpenCallback file_open = Dart::file_open_callback();
+  if ((file_open == nullptr) || (Dart::file_write_callback() == nullptr) ||
+      (Dart::file_close_callback() == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.\n");
+    return;
+  }
+  file_ = file_open(FLAG_compilation_report_to, /*write=*/true);
+  if (file_ == nullptr) {
+    OS::PrintErr("Failed to open compilation report file %s\n",
+                 FLAG_compilation_report_to);
+    return;
+  }
+  Dart::file_write_callback()("[\n", 2, file_);
+  needs_comma_ = false;
+}
+
+void CompilationReport::Cleanup() {
+  MutexLocker ml(&mutex_);
+  if (file_ == nullptr) {
+    return;
+  }
+  Dart::file_write_callback()("\n]\n", 3, file_);
+  Dart::file_close_callback()(file_);
+  file_ = nullptr;
+}
+
+#if defined(TESTING)
+void CompilationReport::SetBufferForTesting(BaseTextBuffer* buffer) {
+  MutexLocker ml(&mutex_);
+  if (buffer_ != nullptr) {
+    buffer_->AddString(needs_comma_ ? "\n]\n" : "[\n]\n");
+  }
+  buffer_ = buffer;
+  needs_comma_ = false;
+}
+#endif  // defined(TESTING)
+
+}  // namespace dart
@@ -0,0 +1,121 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_COMPILATION_REPORT_H_
+#define RUNTIME_VM_COMPILER_COMPILATION_REPORT_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+class BaseTextBuffer;
+class Code;
+class FlowGraph;
+class Function;
+class JSONWriter;
+
+// Structured report of a single compilation of a function: the time spent in
+// each compiler pass and the IL instruction count before and after it, the
+// inlining decisions taken and the size and deoptimization exits of the
+// generated code.
+//
+// Reports are collected if --compilation_report_to=<file> is given, in which
+// case the file receives a JSON array with one object per compilation (and,
+// in JIT mode, one per deoptimization), or if the dart:compiler.verbose
+// timeline stream is enabled, in which case each report is attached to a
+// "CompilationReport" timeline event.
+class CompilationReport : public ZoneAllocated {
+ public:
+  static bool IsEnabled();
+
+  CompilationReport(const Function& function, bool is_aot, bool is_optimizing);
+
+  // Whether passes run on the given graph belong to this report rather than
+  // to the graph of a callee being inlined.
+  bool IsReportedGraph(const FlowGraph* flow_graph) const;
+
+  void AddPass(const char* name,
+               intptr_t round,
+               int64_t elapsed_micros,
+               intptr_t instructions_before,
+               intptr_t instructions_after);
+
+  // Records an inlining decision, [bailout_reason] is nullptr if the call
+  // was inlined.
+  void AddInliningDecision(const Function& caller,
+                           const Function& callee,
+                           intptr_t depth,
+                           intptr_t deopt_id,
+                           const char* bailout_reason);
+
+  // Records the size and deoptimization exits of the generated code and
+  // emits the report.
+  void Finish(const Code& code);
+
+  // Emits a record for a deoptimization of optimized [code].
+  static void ReportDeoptimization(const Code& code,
+                                   const char* reason,
+                                   intptr_t deoptimization_counter);
+
+  // Opens the file given by --compilation_report_to, if any. Called once on
+  // VM startup, before anything is compiled.
+  static void Init();
+
+  // Terminates the JSON array and closes the report file.
+  static void Cleanup();
+
+#if defined(TESTING)
+  // Starts collecting the JSON array of reports in [buffer] instead of the
+  // report file, or terminates the array and stops if [buffer] is nullptr.
+  static void SetBufferForTesting(BaseTextBuffer* buffer);
+#endif
+
+ private:
+  struct Pass {
+    const char* name;
+    intptr_t round;
+    int64_t elapsed_micros;
+    intptr_t instructions_before;
+    intptr_t instructions_after;
+  };
+
+  struct InliningDecision {
+    const char* caller;
+    const char* callee;
+    intptr_t depth;
+    intptr_t deopt_id;
+    const char* bailout_reason;
+  };
+
+  void PrintJSON(JSONWriter* writer, const Code& code) const;
+
+  static void Emit(const char* json);
+
+  const Function& function_;
+  const char* const function_name_;
+  const bool is_aot_;
+  const bool is_optimizing_;
+  const int64_t start_micros_;
+  GrowableArray<Pass> passes_;
+  GrowableArray<InliningDecision> inlining_decisions_;
+
+  static Mutex mutex_;
+  static void* file_;
+#if defined(TESTING)
+  static BaseTextBuffer* buffer_;
+#endif
+  static bool needs_comma_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilationReport);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_COMPILATION_REPORT_H_
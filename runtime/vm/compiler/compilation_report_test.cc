@@ -0,0 +1,106 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/compilation_report.h"
+
+#include "platform/text_buffer.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/jit/compiler.h"
+#include "vm/dart_entry.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+ISOLATE_UNIT_TEST_CASE(CompilationReport_OptimizedJIT) {
+  // There is no C++ JSON decoder, so the report is checked in Dart.
+  const char* kScript = R"(
+    import 'dart:convert';
+
+    int bar(int x) => x + 1;
+
+    @pragma('vm:never-inline')
+    int baz(int x) => x * 2;
+
+    int foo(int n) {
+      int sum = 0;
+      for (int i = 0; i < n; i++) {
+        sum += bar(i) + baz(i);
+      }
+      return sum;
+    }
+
+    main() {
+      for (int i = 0; i < 10; i++) {
+        foo(10);
+      }
+    }
+
+    String validate(String report) {
+      final failures = <String>[];
+      void check(bool condition, String what) {
+        if (!condition) failures.add(what);
+      }
+
+      final records = json.decode(report) as List;
+      final compilations = records
+          .where((r) =>
+              r['kind'] == 'compilation' &&
+              (r['function'] as String).endsWith('foo'))
+          .toList();
+      if (compilations.length != 1) {
+        return 'expected one compilation of foo in $report';
+      }
+      final foo = compilations.single;
+      check(foo['mode'] == 'jit', 'mode');
+      check(foo['optimized'] == true, 'optimized');
+      check(foo['codeSize'] > 0, 'codeSize');
+
+      final passes = foo['passes'] as List;
+      check(passes.any((p) => p['name'] == 'Inlining'), 'Inlining pass');
+      check(
+          passes.every((p) =>
+              p['micros'] >= 0 &&
+              p['instructionsBefore'] > 0 &&
+              p['instructionsAfter'] > 0),
+          'pass sizes');
+
+      final inlining = foo['inlining'] as List;
+      check(
+          inlining.any((d) =>
+              (d['callee'] as String).endsWith('bar') &&
+              d['inlined'] == true),
+          'bar inlined');
+      check(
+          inlining.any((d) =>
+              (d['callee'] as String).endsWith('baz') &&
+              d['inlined'] == false &&
+              d['reason'] == 'vm:never-inline'),
+          'baz not inlined');
+
+      return failures.isEmpty ? 'ok' : failures.join(', ');
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+
+  TextBuffer report(1 * KB);
+  CompilationReport::SetBufferForTesting(&report);
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  Compiler::CompileOptimizedFunction(thread, function);
+  CompilationReport::SetBufferForTesting(nullptr);
+  EXPECT(function.HasOptimizedCode());
+
+  const auto& validate =
+      Function::Handle(GetFunction(root_library, "validate"));
+  const auto& args = Array::Handle(Array::New(1));
+  args.SetAt(0, String::Handle(String::New(report.buffer())));
+  const auto& result =
+      Object::Handle(DartEntry::InvokeFunction(validate, args));
+  EXPECT_STREQ("ok", result.IsString() ? String::Cast(result).ToCString()
+                                       : result.ToCString());
+}
+
+}  // namespace dart
@@ -12,10 +12,13 @@
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/inliner.h"
 #include "vm/compiler/backend/linearscan.h"
+#include "vm/compiler/backend/loop_unrolling.h"
+#include "vm/compiler/backend/loop_vectorizer.h"
 #include "vm/compiler/backend/range_analysis.h"
 #include "vm/compiler/backend/redundancy_elimination.h"
 #include "vm/compiler/backend/type_propagator.h"
 #include "vm/compiler/call_specializer.h"
+#include "vm/compiler/compilation_report.h"
 #include "vm/compiler/compiler_timings.h"
 #include "vm/compiler/write_barrier_elimination.h"
 #if defined(DART_PRECOMPILER)
@@ -208,6 +211,15 @@ void CompilerPass::Run(CompilerPassState* state) const {
 
     CompilerState::Current().set_current_pass(this, state);
     PrintGraph(state, kTraceBefore, round);
+    CompilationReport* report = CompilerState::Current().report();
+    if ((report != nullptr) && !report->IsReportedGraph(state->flow_graph())) {
+      // Passes run on callee graphs are accounted for in the Inlining pass.
+      report = nullptr;
+    }
+    const intptr_t instructions_before =
+        report != nullptr ? state->flow_graph()->InstructionCount() : 0;
+    const int64_t start_micros =
+        report != nullptr ? OS::GetCurrentMonotonicMicros() : 0;
     {
       TIMELINE_DURATION(thread, CompilerVerbose, name());
       {
@@ -216,6 +228,12 @@ void CompilerPass::Run(CompilerPassState* state) const {
       }
       thread->CheckForSafepoint();
     }
+    if (report != nullptr) {
+      report->AddPass(name(), round,
+                      OS::GetCurrentMonotonicMicros() - start_micros,
+                      instructions_before,
+                      state->flow_graph()->InstructionCount());
+    }
     PrintGraph(state, kTraceAfter, round);
 #if defined(DEBUG)
     if (CompilerState::Current().is_optimizing()) {
@@ -322,6 +340,8 @@ FlowGraph* CompilerPass::RunPipeline(PipelineMode mode,
   INVOKE_PASS(DSE);
   INVOKE_PASS(TypePropagation);
   INVOKE_PASS(RangeAnalysis);
+  INVOKE_PASS(LoopVectorization);
+  INVOKE_PASS(LoopUnrolling);
   INVOKE_PASS(OptimizeBranches);
   INVOKE_PASS(TypePropagation);
   INVOKE_PASS(TryCatchOptimization);
@@ -463,6 +483,27 @@ COMPILER_PASS(RangeAnalysis, {
   range_analysis.Analyze();
 });
 
+COMPILER_PASS(LoopVectorization, {
+  // Runs before unrolling, which would otherwise hide the element-wise
+  // shape of the loop body. The original loop remains as the epilogue.
+  LoopVectorizer vectorizer(flow_graph);
+  vectorizer.Optimize();
+});
+
+COMPILER_PASS(LoopUnrolling, {
+  // Copies of the loop body inherit the facts established by range
+  // analysis, including removed bounds checks. Fully unrolled loops are
+  // folded away by the constant propagation in OptimizeBranches.
+  //
+  // Ranges are recomputed for the copies, which removes bounds checks that
+  // the exit test repeated in every copy makes redundant.
+  LoopUnroller unroller(flow_graph);
+  if (unroller.Optimize()) {
+    RangeAnalysis range_analysis(flow_graph);
+    range_analysis.ReanalyzeBoundsChecks();
+  }
+});
+
 COMPILER_PASS(OptimizeBranches, {
   // Constant propagation can use information from range analysis to
   // find unreachable branch targets and eliminate branches that have
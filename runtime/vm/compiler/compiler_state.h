@@ -17,6 +17,7 @@
 
 namespace dart {
 
+class CompilationReport;
 class CompilerPass;
 struct CompilerPassState;
 class Function;
@@ -143,6 +144,11 @@ class CompilerState : public ThreadStackResource {
   const CompilerPass* pass() const { return pass_; }
   const CompilerPassState* pass_state() const { return pass_state_; }
 
+  // Report of the current compilation, or nullptr if reports are not
+  // collected (see CompilationReport::IsEnabled).
+  CompilationReport* report() const { return report_; }
+  void set_report(CompilationReport* report) { report_ = report; }
+
   void ReportCrash();
 
   const FunctionPragmas& PragmasOf(const Function& function);
@@ -193,6 +199,7 @@ class CompilerState : public ThreadStackResource {
   const Function* function_ = nullptr;
   const CompilerPass* pass_ = nullptr;
   const CompilerPassState* pass_state_ = nullptr;
+  CompilationReport* report_ = nullptr;
   CachedPragmasMap* cached_pragmas_ = nullptr;
 
   CompilerState* previous_;
@@ -20,6 +20,7 @@
 #include "vm/compiler/backend/redundancy_elimination.h"
 #include "vm/compiler/backend/type_propagator.h"
 #include "vm/compiler/cha.h"
+#include "vm/compiler/compilation_report.h"
 #include "vm/compiler/compiler_pass.h"
 #include "vm/compiler/compiler_state.h"
 #include "vm/compiler/ffi/callback.h"
@@ -85,6 +86,11 @@ DEFINE_FLAG(bool,
             false,
             "Trace only optimizing compiler operations.");
 DEFINE_FLAG(bool, trace_bailout, false, "Print bailout from ssa compiler.");
+DEFINE_FLAG(int,
+            background_compiler_tasks,
+            1,
+            "Maximum number of threads compiling optimized code in the "
+            "background for an isolate group.");
 
 DECLARE_FLAG(bool, trace_failed_optimization_attempts);
 
@@ -437,6 +443,7 @@ CodePtr CompileParsedFunctionHelper::FinalizeCompilation(
     function.SaveICDataMap(
         graph_compiler->deopt_id_to_ic_data(),
         Array::Handle(zone, graph_compiler->edge_counters_array()),
+        Array::Handle(zone, graph_compiler->edge_counter_deopt_ids_array()),
         flow_graph->coverage_array());
     function.set_unoptimized_code(code);
     function.AttachCode(code);
@@ -486,6 +493,10 @@ CodePtr CompileParsedFunctionHelper::Compile() {
       CompilerState compiler_state(thread(), /*is_aot=*/false, optimized(),
                                    CompilerState::ShouldTrace(function));
       compiler_state.set_function(function);
+      if (CompilationReport::IsEnabled()) {
+        compiler_state.set_report(new (zone) CompilationReport(
+            function, /*is_aot=*/false, optimized()));
+      }
 
       {
         // Extract type feedback before the graph is built, as the graph
@@ -603,6 +614,10 @@ CodePtr CompileParsedFunctionHelper::Compile() {
         // Must be called outside of safepoint.
         Code::NotifyCodeObservers(function, *result, optimized());
 
+        if (compiler_state.report() != nullptr) {
+          compiler_state.report()->Finish(*result);
+        }
+
         if (FLAG_disassemble && FlowGraphPrinter::ShouldPrint(function)) {
           Disassembler::DisassembleCode(function, *result, optimized());
         } else if (FLAG_disassemble_optimized && optimized() &&
@@ -943,8 +958,10 @@ void Compiler::AbortBackgroundCompilation(intptr_t deopt_id, const char* msg) {
 // C-heap allocated background compilation queue element.
 class QueueElement {
  public:
-  explicit QueueElement(const Function& function)
-      : next_(nullptr), function_(function.ptr()) {}
+  QueueElement(const Function& function, int64_t enqueue_micros)
+      : next_(nullptr),
+        function_(function.ptr()),
+        enqueue_micros_(enqueue_micros) {}
 
   virtual ~QueueElement() {
     next_ = nullptr;
@@ -956,6 +973,8 @@ class QueueElement {
   void set_next(QueueElement* elem) { next_ = elem; }
   QueueElement* next() const { return next_; }
 
+  int64_t enqueue_micros() const { return enqueue_micros_; }
+
   ObjectPtr function() const { return function_; }
   ObjectPtr* function_untag() {
     return reinterpret_cast<ObjectPtr*>(&function_);
@@ -964,6 +983,7 @@ class QueueElement {
  private:
   QueueElement* next_;
   FunctionPtr function_;
+  int64_t enqueue_micros_;
 
   DISALLOW_COPY_AND_ASSIGN(QueueElement);
 };
@@ -1021,6 +1041,28 @@ class BackgroundCompilationQueue {
     return result;
   }
 
+  // Removes the element for 'obj', which must be present.
+  QueueElement* RemoveObj(const Object& obj) {
+    QueueElement* prev = nullptr;
+    for (QueueElement* p = first_; p != nullptr; p = p->next()) {
+      if (p->function() == obj.ptr()) {
+        Unlink(prev, p);
+        return p;
+      }
+      prev = p;
+    }
+    UNREACHABLE();
+    return nullptr;
+  }
+
+  intptr_t Length() const {
+    intptr_t length = 0;
+    for (QueueElement* p = first_; p != nullptr; p = p->next()) {
+      length++;
+    }
+    return length;
+  }
+
   bool ContainsObj(const Object& obj) const {
     QueueElement* p = first_;
     while (p != nullptr) {
@@ -1041,12 +1083,122 @@ class BackgroundCompilationQueue {
   }
 
  private:
+  void Unlink(QueueElement* prev, QueueElement* elem) {
+    if (prev == nullptr) {
+      ASSERT(first_ == elem);
+      first_ = elem->next();
+    } else {
+      prev->set_next(elem->next());
+    }
+    if (last_ == elem) {
+      last_ = prev;
+    }
+    elem->set_next(nullptr);
+  }
+
   QueueElement* first_;
   QueueElement* last_;
 
   DISALLOW_COPY_AND_ASSIGN(BackgroundCompilationQueue);
 };
 
+void PendingCompilationQueue::Add(const Function& function) {
+  ASSERT(!Contains(function));
+  const int64_t usage = Utils::Maximum<int64_t>(function.usage_counter(), 0);
+  entries_.Add({function.ptr(), usage, usage, next_sequence_++,
+                OS::GetCurrentMonotonicMicros()});
+  indices_.Insert({function.ptr(), entries_.length() - 1});
+  SiftUp(entries_.length() - 1);
+}
+
+void PendingCompilationQueue::Bump(const Function& function) {
+  const auto* pair = indices_.Lookup(function.ptr());
+  ASSERT(pair != nullptr);
+  const intptr_t index = pair->value;
+  const int64_t usage = CurrentUsage(entries_[index], function);
+  const bool hotter = usage > entries_[index].usage;
+  entries_[index].usage = usage;
+  if (hotter) {
+    SiftUp(index);
+  } else {
+    SiftDown(index);
+  }
+}
+
+FunctionPtr PendingCompilationQueue::RemoveHottest(int64_t* enqueue_micros) {
+  ASSERT(!IsEmpty());
+  const Entry hottest = entries_[0];
+  indices_.Remove(hottest.function);
+  const Entry last = entries_.RemoveLast();
+  if (!IsEmpty()) {
+    Place(0, last);
+    SiftDown(0);
+  }
+  if (enqueue_micros != nullptr) {
+    *enqueue_micros = hottest.enqueue_micros;
+  }
+  return hottest.function;
+}
+
+void PendingCompilationQueue::VisitObjectPointers(
+    ObjectPointerVisitor* visitor) {
+  ASSERT(visitor != nullptr);
+  for (intptr_t i = 0; i < entries_.length(); i++) {
+    visitor->VisitPointer(reinterpret_cast<ObjectPtr*>(&entries_[i].function));
+  }
+  // The functions may have moved.
+  RebuildIndices();
+}
+
+int64_t PendingCompilationQueue::CurrentUsage(const Entry& entry,
+                                              const Function& function) {
+  const int64_t counter = function.usage_counter();
+  // The counter restarts from 0 if it was reset while the function waited,
+  // e.g. because its unoptimized code was recompiled.
+  const int64_t calls = (counter < 0) ? (counter - INT32_MIN) : counter;
+  return entry.enqueue_usage + calls;
+}
+
+void PendingCompilationQueue::Place(intptr_t index, const Entry& entry) {
+  entries_[index] = entry;
+  indices_.Update({entry.function, index});
+}
+
+void PendingCompilationQueue::RebuildIndices() {
+  indices_.Clear();
+  for (intptr_t i = 0; i < entries_.length(); i++) {
+    indices_.Insert({entries_[i].function, i});
+  }
+}
+
+void PendingCompilationQueue::SiftUp(intptr_t index) {
+  const Entry entry = entries_[index];
+  while (index > 0) {
+    const intptr_t parent = (index - 1) / 2;
+    if (!IsHotter(entry, entries_[parent])) break;
+    Place(index, entries_[parent]);
+    index = parent;
+  }
+  Place(index, entry);
+}
+
+void PendingCompilationQueue::SiftDown(intptr_t index) {
+  const Entry entry = entries_[index];
+  const intptr_t length = entries_.length();
+  for (;;) {
+    intptr_t child = 2 * index + 1;
+    if (child >= length) break;
+    if ((child + 1 < length) &&
+        IsHotter(entries_[child + 1], entries_[child])) {
+      child++;
+    }
+    if (!IsHotter(entries_[child], entry)) break;
+    Place(index, entries_[child]);
+    index = child;
+  }
+  Place(index, entry);
+}
+
 class BackgroundCompilerTask : public ThreadPool::Task {
  public:
   explicit BackgroundCompilerTask(BackgroundCompiler* background_compiler)
@@ -1064,14 +1216,17 @@ class BackgroundCompilerTask : public ThreadPool::Task {
 BackgroundCompiler::BackgroundCompiler(IsolateGroup* isolate_group)
     : isolate_group_(isolate_group),
       monitor_(),
-      function_queue_(new BackgroundCompilationQueue()),
+      function_queue_(new PendingCompilationQueue()),
+      in_flight_queue_(new BackgroundCompilationQueue()),
       running_(false),
-      done_(true),
-      disabled_depth_(0) {}
+      num_tasks_(0),
+      disabled_depth_(0),
+      latency_count_(0) {}
 
 // Fields all deleted in ::Stop; here clear them.
 BackgroundCompiler::~BackgroundCompiler() {
   delete function_queue_;
+  delete in_flight_queue_;
 }
 
 void BackgroundCompiler::Run() {
@@ -1084,29 +1239,50 @@ void BackgroundCompiler::Run() {
     HANDLESCOPE(thread);
     Function& function = Function::Handle(zone);
     QueueElement* element = nullptr;
+    intptr_t queue_length = 0;
     {
       SafepointMonitorLocker ml(&monitor_);
       if (running_ && !function_queue()->IsEmpty()) {
-        element = function_queue()->Remove();
-        function ^= element->function();
+        int64_t enqueue_micros = 0;
+        function = function_queue()->RemoveHottest(&enqueue_micros);
+        element = new QueueElement(function, enqueue_micros);
+        in_flight_queue_->Add(element);
+        queue_length = function_queue()->Length();
       }
     }
     if (element != nullptr) {
-      delete element;
-      Compiler::CompileOptimizedFunction(thread, function,
-                                         Compiler::kNoOSRDeoptId);
+      {
+        TIMELINE_DURATION(thread, Compiler, "BackgroundCompilation");
+#if defined(SUPPORT_TIMELINE)
+        if (tbes.enabled()) {
+          tbes.SetNumArguments(2);
+          tbes.CopyArgument(0, "function", function.ToQualifiedCString());
+          tbes.FormatArgument(1, "queueLength", "%" Pd, queue_length);
+        }
+#else
+        USE(queue_length);
+#endif
+        Compiler::CompileOptimizedFunction(thread, function,
+                                           Compiler::kNoOSRDeoptId);
+      }
 
+      bool requeue = false;
       // If an optimizable method is not optimized, put it back on
       // the background queue (unless it was passed to foreground).
       if ((!function.HasOptimizedCode() && function.IsOptimizable()) ||
           FLAG_stress_test_background_compilation) {
-        if (Compiler::CanOptimizeFunction(thread, function)) {
-          SafepointMonitorLocker ml(&monitor_);
-          if (running_) {
-            QueueElement* repeat_qelem = new QueueElement(function);
-            function_queue()->Add(repeat_qelem);
-          }
-        }
+        requeue = Compiler::CanOptimizeFunction(thread, function);
+      }
+
+      SafepointMonitorLocker ml(&monitor_);
+      element = in_flight_queue_->RemoveObj(function);
+      if (function.HasOptimizedCode()) {
+        RecordLatencyLocked(OS::GetCurrentMonotonicMicros() -
+                            element->enqueue_micros());
+      }
+      delete element;
+      if (requeue && running_ && !function_queue()->Contains(function)) {
+        function_queue()->Add(function);
       }
     }
   }
@@ -1117,16 +1293,56 @@ void BackgroundCompiler::Run() {
         Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
       // Successfully scheduled a new task.
     } else {
-      // Background compiler done. This notification must happen after the
-      // thread leaves to group to avoid a shutdown race with the thread
-      // registry.
-      running_ = false;
-      done_ = true;
+      // This task is done. This notification must happen after the thread
+      // leaves to group to avoid a shutdown race with the thread registry.
+      if (--num_tasks_ == 0) {
+        // Background compiler done.
+        running_ = false;
+      }
       ml.NotifyAll();
     }
   }
 }
 
+bool BackgroundCompiler::StartTaskLocked() {
+  if (!Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+    return false;
+  }
+  num_tasks_++;
+  return true;
+}
+
+void BackgroundCompiler::RecordLatencyLocked(int64_t micros) {
+  latencies_[latency_count_ % kLatencySamples] = micros;
+  latency_count_++;
+}
+
+intptr_t BackgroundCompiler::QueueLength() {
+  MonitorLocker ml(&monitor_);
+  return function_queue_->Length();
+}
+
+static int CompareLatencies(const int64_t* a, const int64_t* b) {
+  if (*a < *b) return -1;
+  if (*a > *b) return 1;
+  return 0;
+}
+
+int64_t BackgroundCompiler::LatencyPercentile(intptr_t percentile) {
+  ASSERT((percentile >= 0) && (percentile <= 100));
+  MallocGrowableArray<int64_t> samples(kLatencySamples);
+  {
+    MonitorLocker ml(&monitor_);
+    const intptr_t n = Utils::Minimum(latency_count_, kLatencySamples);
+    for (intptr_t i = 0; i < n; i++) {
+      samples.Add(latencies_[i]);
+    }
+  }
+  if (samples.is_empty()) return 0;
+  samples.Sort(CompareLatencies);
+  return samples[((samples.length() - 1) * percentile) / 100];
+}
+
 bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
   Thread* thread = Thread::Current();
   ASSERT(thread->IsDartMutatorThread());
@@ -1134,32 +1350,40 @@ bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
 
   SafepointMonitorLocker ml(&monitor_);
   if (disabled_depth_ > 0) return false;
-  if (!running_ && done_) {
+  if (!running_ && num_tasks_ == 0) {
     running_ = true;
-    done_ = false;
     // If we ever wanted to run the BG compiler on the
     // `IsolateGroup::mutator_pool()` we would need to ensure the BG compiler
     // stops when it's idle - otherwise the [MutatorThreadPool]-based idle
     // notification would not work anymore.
-    if (!Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+    if (!StartTaskLocked()) {
       running_ = false;
-      done_ = true;
       return false;
     }
   }
 
   ASSERT(running_);
-  if (function_queue()->ContainsObj(function)) {
+  if (function_queue()->Contains(function)) {
+    function_queue()->Bump(function);
+    return true;
+  }
+  if (in_flight_queue_->ContainsObj(function)) {
     return true;
   }
-  QueueElement* elem = new QueueElement(function);
-  function_queue()->Add(elem);
+  function_queue()->Add(function);
+  // Add a worker while the backlog exceeds what the current ones will pick up
+  // next. Failing to start one is fine, the existing ones drain the queue.
+  if ((num_tasks_ < FLAG_background_compiler_tasks) &&
+      (function_queue()->Length() > num_tasks_)) {
+    StartTaskLocked();
+  }
   ml.NotifyAll();
   return true;
 }
 
 void BackgroundCompiler::VisitPointers(ObjectPointerVisitor* visitor) {
   function_queue_->VisitObjectPointers(visitor);
+  in_flight_queue_->VisitObjectPointers(visitor);
 }
 
 void BackgroundCompiler::Stop() {
@@ -1175,7 +1399,7 @@ void BackgroundCompiler::StopLocked(Thread* thread,
                                     SafepointMonitorLocker* locker) {
   running_ = false;
   function_queue_->Clear();
-  while (!done_) {
+  while (num_tasks_ > 0) {
     locker->Wait();
   }
 }
@@ -1199,7 +1423,7 @@ void BackgroundCompiler::Disable() {
 
   SafepointMonitorLocker ml(&monitor_);
   disabled_depth_++;
-  if (done_) return;
+  if (num_tasks_ == 0) return;
   StopLocked(thread, &ml);
 }
 
@@ -8,6 +8,7 @@
 #include "vm/allocation.h"
 #include "vm/compiler/api/deopt_id.h"
 #include "vm/growable_array.h"
+#include "vm/hash_map.h"
 #include "vm/runtime_entry.h"
 #include "vm/thread_pool.h"
 
@@ -22,6 +23,7 @@ class FlowGraph;
 class Function;
 class IndirectGotoInstr;
 class Library;
+class ObjectPointerVisitor;
 class ParsedFunction;
 class QueueElement;
 class Script;
@@ -82,9 +84,96 @@ class Compiler : public AllStatic {
   static void AbortBackgroundCompilation(intptr_t deopt_id, const char* msg);
 };
 
-// Class to run optimizing compilation in a background thread.
-// Current implementation: one task per isolate, it dies with the owning
-// isolate.
+// Functions waiting for background compilation, in a binary max-heap keyed by
+// how often they were called. A queued function's usage counter is set to
+// INT32_MIN (see OptimizeInvokedFunction) and keeps counting calls from there,
+// so the key is the usage at the time it was enqueued plus the calls since.
+// A key is only refreshed from the counter when the function's compilation is
+// requested again while it is queued (see Bump), so every operation is
+// O(log n). Ties go to the function enqueued first.
+class PendingCompilationQueue {
+ public:
+  PendingCompilationQueue() : entries_(), indices_(), next_sequence_(0) {}
+  ~PendingCompilationQueue() { Clear(); }
+
+  bool IsEmpty() const { return entries_.is_empty(); }
+  intptr_t Length() const { return entries_.length(); }
+
+  // Adds a function that is not yet queued, keyed by its usage counter.
+  void Add(const Function& function);
+
+  // Refreshes the key of a queued function from its usage counter.
+  void Bump(const Function& function);
+
+  bool Contains(const Function& function) const {
+    return indices_.Lookup(function.ptr()) != nullptr;
+  }
+
+  // Removes the function with the most usage. Its enqueue time is returned in
+  // 'enqueue_micros' if not null.
+  FunctionPtr RemoveHottest(int64_t* enqueue_micros = nullptr);
+
+  void Clear() {
+    entries_.Clear();
+    indices_.Clear();
+  }
+
+  void VisitObjectPointers(ObjectPointerVisitor* visitor);
+
+ private:
+  struct Entry {
+    FunctionPtr function;
+    int64_t enqueue_usage;
+    int64_t usage;
+    int64_t sequence;
+    int64_t enqueue_micros;
+  };
+
+  // Maps a queued function to its index in 'entries_'.
+  class IndexTrait {
+   public:
+    typedef FunctionPtr Key;
+    typedef intptr_t Value;
+
+    struct Pair {
+      Key key;
+      Value value;
+      Pair() : key(nullptr), value(-1) {}
+      Pair(const Key key, const Value& value) : key(key), value(value) {}
+      Pair(const Pair& other) : key(other.key), value(other.value) {}
+      Pair& operator=(const Pair&) = default;
+    };
+
+    static Key KeyOf(Pair kv) { return kv.key; }
+    static Value ValueOf(Pair kv) { return kv.value; }
+    static uword Hash(Key key) {
+      return Utils::WordHash(static_cast<intptr_t>(key));
+    }
+    static bool IsKeyEqual(Pair kv, Key key) { return kv.key == key; }
+  };
+
+  static bool IsHotter(const Entry& a, const Entry& b) {
+    return (a.usage > b.usage) ||
+           ((a.usage == b.usage) && (a.sequence < b.sequence));
+  }
+
+  static int64_t CurrentUsage(const Entry& entry, const Function& function);
+  void Place(intptr_t index, const Entry& entry);
+  void RebuildIndices();
+  void SiftUp(intptr_t index);
+  void SiftDown(intptr_t index);
+
+  MallocGrowableArray<Entry> entries_;
+  MallocDirectChainedHashMap<IndexTrait> indices_;
+  int64_t next_sequence_;
+
+  DISALLOW_COPY_AND_ASSIGN(PendingCompilationQueue);
+};
+
+// Class to run optimizing compilation in background threads.
+// Current implementation: up to --background_compiler_tasks tasks per isolate
+// group, which die with the owning isolate group. The queue is ordered by how
+// often a function was called, see PendingCompilationQueue.
 // No OSR compilation in the background compiler.
 class BackgroundCompiler {
  public:
@@ -102,11 +191,17 @@ class BackgroundCompiler {
 
   void VisitPointers(ObjectPointerVisitor* visitor);
 
-  BackgroundCompilationQueue* function_queue() const { return function_queue_; }
+  PendingCompilationQueue* function_queue() const { return function_queue_; }
   bool is_running() const { return running_; }
 
   void Run();
 
+  // Statistics for the VM service and timeline.
+  intptr_t QueueLength();
+  // Enqueue-to-installation latency of recent compilations at the given
+  // percentile (0-100), or 0 if there were none.
+  int64_t LatencyPercentile(intptr_t percentile);
+
  private:
   friend class NoBackgroundCompilerScope;
 
@@ -114,16 +209,25 @@ class BackgroundCompiler {
   void StopLocked(Thread* thread, SafepointMonitorLocker* done_locker);
   void Enable();
   void Disable();
-  bool IsRunning() { return !done_; }
+  bool IsRunning() { return num_tasks_ > 0; }
+
+  bool StartTaskLocked();
+  void RecordLatencyLocked(int64_t micros);
 
   IsolateGroup* isolate_group_;
 
-  Monitor monitor_;  // Controls access to the queue and running state.
-  BackgroundCompilationQueue* function_queue_;
-  bool running_;  // While true, will try to read queue and compile.
-  bool done_;     // True if the thread is done.
+  Monitor monitor_;  // Controls access to the queues and running state.
+  PendingCompilationQueue* function_queue_;
+  // Functions being compiled, so they are not compiled twice concurrently.
+  BackgroundCompilationQueue* in_flight_queue_;
+  bool running_;        // While true, will try to read queue and compile.
+  intptr_t num_tasks_;  // Number of tasks that are not yet done.
   int16_t disabled_depth_;
 
+  static constexpr intptr_t kLatencySamples = 256;
+  int64_t latencies_[kLatencySamples];
+  intptr_t latency_count_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(BackgroundCompiler);
 };
 
@@ -372,6 +372,25 @@ uword MakeTagWordForNewSpaceObject(classid_t cid, uword instance_size) {
              dart::Object::ShouldHaveImmutabilityBitSet(cid));
 }
 
+uword MakeTagWordForRememberedOldSpaceObject(classid_t cid,
+                                             uword instance_size) {
+  return dart::UntaggedObject::SizeTag::encode(
+             TranslateOffsetInWordsToHost(instance_size)) |
+         dart::UntaggedObject::ClassIdTag::encode(cid) |
+         dart::UntaggedObject::AlwaysSetBit::encode(true) |
+         dart::UntaggedObject::NotMarkedBit::encode(true) |
+         dart::UntaggedObject::ImmutableBit::encode(
+             dart::Object::ShouldHaveImmutabilityBitSet(cid));
+}
+
+uword MakeTagWordForLargeFreeListElement() {
+  return dart::UntaggedObject::SizeTag::encode(0) |
+         dart::UntaggedObject::ClassIdTag::encode(dart::kFreeListElement) |
+         dart::UntaggedObject::AlwaysSetBit::encode(true) |
+         dart::UntaggedObject::NotMarkedBit::encode(true) |
+         dart::UntaggedObject::OldAndNotRememberedBit::encode(true);
+}
+
 word Object::tags_offset() {
   return 0;
 }
@@ -556,6 +575,11 @@ bool Class::TraceAllocation(const dart::Class& klass) {
   return klass.TraceAllocation(dart::IsolateGroup::Current());
 }
 
+bool Class::ShouldPretenure(const dart::Class& klass) {
+  return dart::IsolateGroup::Current()->class_table()->ShouldPretenure(
+      klass.id());
+}
+
 word Instance::first_field_offset() {
   return TranslateOffsetInWords(dart::Instance::NextFieldOffset());
 }
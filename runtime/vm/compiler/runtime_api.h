@@ -355,6 +355,14 @@ bool SizeFitsInSizeTag(uword instance_size);
 // Note: even on 64-bit platforms we only use lower 32-bits of the tag word.
 uword MakeTagWordForNewSpaceObject(classid_t cid, uword instance_size);
 
+// Tags of an old-space object that is already in the remembered set.
+uword MakeTagWordForRememberedOldSpaceObject(classid_t cid,
+                                             uword instance_size);
+
+// Tags of an old-space free list element whose size is stored after its next
+// pointer rather than in the tags, see dart::FreeListElement.
+uword MakeTagWordForLargeFreeListElement();
+
 //
 // Target specific information about objects.
 //
@@ -513,6 +521,9 @@ class Class : public AllStatic {
 
   // Whether to trace allocation for this klass.
   static bool TraceAllocation(const dart::Class& klass);
+
+  // Whether instances of this klass are pretenured into old space.
+  static bool ShouldPretenure(const dart::Class& klass);
 };
 
 class Instance : public AllStatic {
@@ -1176,6 +1187,8 @@ class Thread : public AllStatic {
   static word dispatch_table_array_offset();
   static word top_offset();
   static word end_offset();
+  static word old_space_top_offset();
+  static word old_space_end_offset();
   static word isolate_offset();
   static word isolate_group_offset();
   static word field_table_values_offset();
@@ -365,6 +365,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x458;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x45c;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x460;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x464;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x12c;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -1087,6 +1091,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x8a8;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x8b0;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x8b8;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x8c0;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x258;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -1809,6 +1817,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x450;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x454;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x458;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x45c;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x12c;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -2530,6 +2542,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x8f0;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x8f8;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x900;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x908;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x258;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -3256,6 +3272,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x8b0;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x8b8;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x8c0;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x8c8;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x260;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -3979,6 +3999,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x8f8;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x900;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x908;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x910;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x260;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -4702,6 +4726,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x480;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x484;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x488;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x48c;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x12c;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -5425,6 +5453,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x8e0;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x8e8;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x8f0;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x8f8;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x258;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -6141,6 +6173,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x458;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x45c;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x460;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x464;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x12c;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -6855,6 +6891,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x8a8;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x8b0;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x8b8;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x8c0;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x258;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -7569,6 +7609,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x450;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x454;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x458;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x45c;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x12c;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -8282,6 +8326,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x8f0;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x8f8;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x900;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x908;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x258;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -9000,6 +9048,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x8b0;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x8b8;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x8c0;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x8c8;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x260;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -9715,6 +9767,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x8f8;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x900;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x908;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x910;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x260;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -10430,6 +10486,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x480;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x484;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x488;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x48c;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x12c;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -11145,6 +11205,10 @@ static constexpr dart::compiler::target::word
     Thread_service_extension_stream_offset = 0x8e0;
 static constexpr dart::compiler::target::word Thread_thread_locals_offset =
     0x8e8;
+static constexpr dart::compiler::target::word Thread_old_space_top_offset =
+    0x8f0;
+static constexpr dart::compiler::target::word Thread_old_space_end_offset =
+    0x8f8;
 static constexpr dart::compiler::target::word Thread_optimize_entry_offset =
     0x258;
 static constexpr dart::compiler::target::word Thread_optimize_stub_offset =
@@ -11898,6 +11962,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x458;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x45c;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x460;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x464;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x12c;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
@@ -12698,6 +12766,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x8a8;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x8b0;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x8b8;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x8c0;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x258;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
@@ -13505,6 +13577,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x8f0;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x8f8;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x900;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x908;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x258;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
@@ -14308,6 +14384,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x8b0;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x8b8;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x8c0;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x8c8;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x260;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
@@ -15111,6 +15191,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x8f8;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x900;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x908;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x910;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x260;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
@@ -15916,6 +16000,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x480;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x484;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x488;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x48c;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x12c;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
@@ -16717,6 +16805,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x8e0;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x8e8;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x8f0;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x8f8;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x258;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
@@ -17512,6 +17604,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x458;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x45c;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x460;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x464;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x12c;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
@@ -18303,6 +18399,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x8a8;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x8b0;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x8b8;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x8c0;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x258;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
@@ -19101,6 +19201,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x8f0;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x8f8;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x900;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x908;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x258;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
@@ -19895,6 +19999,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x8b0;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x8b8;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x8c0;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x8c8;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x260;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
@@ -20689,6 +20797,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x8f8;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x900;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x908;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x910;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x260;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
@@ -21485,6 +21597,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x480;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x484;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x488;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x48c;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x12c;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
@@ -22277,6 +22393,10 @@ static constexpr dart::compiler::target::word
     AOT_Thread_service_extension_stream_offset = 0x8e0;
 static constexpr dart::compiler::target::word AOT_Thread_thread_locals_offset =
     0x8e8;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_top_offset =
+    0x8f0;
+static constexpr dart::compiler::target::word AOT_Thread_old_space_end_offset =
+    0x8f8;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_entry_offset =
     0x258;
 static constexpr dart::compiler::target::word AOT_Thread_optimize_stub_offset =
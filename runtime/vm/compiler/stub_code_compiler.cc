@@ -1600,6 +1600,112 @@ void StubCodeCompiler::GenerateAllocateSmallRecordStub(intptr_t num_fields,
   __ Ret();
 }
 
+void StubCodeCompiler::GenerateAllocatePretenuredObject(const Class& cls,
+                                                        Register temp1_reg,
+                                                        Register temp2_reg,
+                                                        Label* slow_case) {
+  const classid_t cid = target::Class::GetId(cls);
+  const intptr_t instance_size = target::Class::GetInstanceSize(cls);
+  const Register result_reg = AllocateObjectABI::kResultReg;
+  const Register new_top_reg = temp1_reg;
+  const Register temp_reg = temp2_reg;
+  // The unused tail of the buffer is kept formatted as a free list element
+  // with its size stored after the next pointer, see FreeListElement.
+  const intptr_t kFreeListNextOffset = target::kWordSize;
+  const intptr_t kFreeListSizeOffset = 2 * target::kWordSize;
+  const intptr_t kFreeListHeaderSize = 3 * target::kWordSize;
+
+  NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, slow_case, temp_reg));
+
+  // Black allocation is left to the runtime.
+  __ LoadFromOffset(temp_reg, THR, target::Thread::write_barrier_mask_offset());
+  __ AndImmediate(temp_reg, target::UntaggedObject::kIncrementalBarrierMask);
+  __ CompareImmediate(temp_reg, 0);
+  __ BranchIf(NOT_EQUAL, slow_case);
+
+  // Leave room in the store buffer block so that remembering the instance
+  // never has to process a full block.
+  __ LoadFromOffset(new_top_reg, THR,
+                    target::Thread::store_buffer_block_offset());
+  __ LoadFromOffset(temp_reg, new_top_reg,
+                    target::StoreBufferBlock::top_offset(), kFourBytes);
+  __ CompareImmediate(temp_reg, target::StoreBufferBlock::kSize - 1);
+  __ BranchIf(GREATER_EQUAL, slow_case);
+
+  __ LoadFromOffset(result_reg, THR, target::Thread::old_space_top_offset());
+  __ AddImmediate(new_top_reg, result_reg, instance_size);
+  // An exact fit would leave no room for the free list element; the runtime
+  // handles it.
+  __ AddImmediate(temp_reg, new_top_reg, kFreeListHeaderSize);
+  __ CompareWithMemoryValue(
+      temp_reg, Address(THR, target::Thread::old_space_end_offset()));
+  __ BranchIf(UNSIGNED_GREATER, slow_case);
+  __ StoreToOffset(new_top_reg, THR, target::Thread::old_space_top_offset());
+
+  __ LoadFromOffset(temp_reg, THR, target::Thread::old_space_end_offset());
+  __ SubRegisters(temp_reg, new_top_reg);
+  __ StoreToOffset(temp_reg, new_top_reg, kFreeListSizeOffset);
+  __ LoadImmediate(temp_reg, target::MakeTagWordForLargeFreeListElement());
+  __ StoreToOffset(temp_reg, new_top_reg, 0);
+  __ LoadImmediate(temp_reg, 0);
+  __ StoreToOffset(temp_reg, new_top_reg, kFreeListNextOffset);
+
+  __ AddImmediate(result_reg, kHeapObjectTag);
+  __ LoadImmediate(temp_reg, target::MakeTagWordForRememberedOldSpaceObject(
+                                 cid, instance_size));
+  __ InitializeHeader(temp_reg, result_reg);
+
+  // The slow path is no longer taken, so the tags register is free.
+  const Register field_reg = AllocateObjectABI::kTagsReg;
+  {
+#if defined(TARGET_ARCH_ARM64) || defined(TARGET_ARCH_RISCV32) ||              \
+    defined(TARGET_ARCH_RISCV64)
+    const Register null_reg = NULL_REG;
+#else
+    const Register null_reg = temp_reg;
+    __ LoadObject(null_reg, NullObject());
+#endif
+    const intptr_t first_field_offset = target::Instance::first_field_offset();
+    const intptr_t kMaxUnrolledFields = 8;
+    if ((instance_size - first_field_offset) <=
+        (kMaxUnrolledFields * target::kCompressedWordSize)) {
+      for (intptr_t offset = first_field_offset; offset < instance_size;
+           offset += target::kCompressedWordSize) {
+        __ StoreCompressedIntoObjectOffsetNoBarrier(result_reg, offset,
+                                                    null_reg);
+      }
+    } else {
+      Label loop;
+      __ AddImmediate(field_reg, result_reg, first_field_offset);
+      __ Bind(&loop);
+      __ StoreCompressedIntoObjectNoBarrier(
+          result_reg, FieldAddress(field_reg, 0), null_reg);
+      __ AddImmediate(field_reg, target::kCompressedWordSize);
+      __ CompareRegisters(field_reg, new_top_reg);
+      __ BranchIf(UNSIGNED_LESS, &loop);
+    }
+  }
+  if (target::Class::NumTypeArguments(cls) > 0) {
+    __ StoreCompressedIntoObjectOffsetNoBarrier(
+        result_reg, target::Class::TypeArgumentsFieldOffset(cls),
+        AllocateObjectABI::kTypeArgumentsReg);
+  }
+
+  // The tags above already have the remembered bit set.
+  const Register block_reg = new_top_reg;
+  __ LoadFromOffset(block_reg, THR,
+                    target::Thread::store_buffer_block_offset());
+  __ LoadFromOffset(temp_reg, block_reg, target::StoreBufferBlock::top_offset(),
+                    kFourBytes);
+  __ AddScaled(field_reg, block_reg, temp_reg, TIMES_WORD_SIZE,
+               target::StoreBufferBlock::pointers_offset());
+  __ StoreToOffset(result_reg, field_reg, 0);
+  __ AddImmediate(temp_reg, 1);
+  __ StoreToOffset(temp_reg, block_reg, target::StoreBufferBlock::top_offset(),
+                   kFourBytes);
+  __ Ret();
+}
+
 void StubCodeCompiler::GenerateAllocateRecord2Stub() {
   GenerateAllocateSmallRecordStub(2, /*has_named_fields=*/false);
 }
@@ -206,6 +206,16 @@ class StubCodeCompiler {
   void GenerateAllocateSmallRecordStub(intptr_t num_fields,
                                        bool has_named_fields);
 
+  // Used by GenerateAllocationStubForClass for pretenured classes. Bump
+  // allocates an instance of [cls] in the thread's old-space allocation buffer
+  // and adds it to the remembered set. Jumps to [slow_case], with the
+  // AllocateObjectABI inputs intact, while marking or when either buffer is
+  // too full.
+  void GenerateAllocatePretenuredObject(const Class& cls,
+                                        Register temp1_reg,
+                                        Register temp2_reg,
+                                        Label* slow_case);
+
   void GenerateSharedStubGeneric(bool save_fpu_registers,
                                  intptr_t self_code_stub_offset_from_thread,
                                  bool allow_return,
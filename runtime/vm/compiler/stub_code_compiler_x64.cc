@@ -2497,9 +2497,11 @@ void StubCodeCompiler::GenerateAllocationStubForClass(
   __ movq(kTagsReg, Immediate(tags));
 
   // Load the appropriate generic alloc. stub.
-  if (!FLAG_use_slow_path && FLAG_inline_alloc &&
-      !target::Class::TraceAllocation(cls) &&
-      target::SizeFitsInSizeTag(instance_size)) {
+  const bool can_inline_alloc = !FLAG_use_slow_path && FLAG_inline_alloc &&
+                                !target::Class::TraceAllocation(cls) &&
+                                target::SizeFitsInSizeTag(instance_size);
+  const bool is_pretenured = target::Class::ShouldPretenure(cls);
+  if (can_inline_alloc && !is_pretenured) {
     RELEASE_ASSERT(AllocateObjectInstr::WillAllocateNewOrRemembered(cls));
     RELEASE_ASSERT(target::Heap::IsAllocatableInNewSpace(instance_size));
 
@@ -2525,6 +2527,12 @@ void StubCodeCompiler::GenerateAllocationStubForClass(
       }
     }
   } else {
+    if (can_inline_alloc) {
+      // Pretenured: bump allocate in old space, or fall back to the runtime.
+      Label slow_case;
+      GenerateAllocatePretenuredObject(cls, R9, RDI, &slow_case);
+      __ Bind(&slow_case);
+    }
     if (!is_cls_parameterized) {
       __ LoadObject(AllocateObjectABI::kTypeArgumentsReg, NullObject());
     }
@@ -17,6 +17,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, background_compiler_tasks);
+
 ISOLATE_UNIT_TEST_CASE(CompileFunction) {
   const char* kScriptChars =
       "class A {\n"
@@ -90,7 +92,8 @@ ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionOnHelperThread) {
   FLAG_background_compilation = true;
 #endif
   auto isolate_group = thread->isolate_group();
-  isolate_group->background_compiler()->EnqueueCompilation(func);
+  func.SetUsageCounter(1000);
+  EXPECT(isolate_group->background_compiler()->EnqueueCompilation(func));
   Monitor* m = new Monitor();
   {
     SafepointMonitorLocker ml(m);
@@ -101,6 +104,148 @@ ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionOnHelperThread) {
   delete m;
 }
 
+ISOLATE_UNIT_TEST_CASE(PendingCompilationQueueHottestFirst) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo() { return 1; }\n"
+      "  static bar() { return 2; }\n"
+      "  static baz() { return 3; }\n"
+      "  static qux() { return 4; }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, nullptr);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+  const char* kNames[] = {"foo", "bar", "baz", "qux"};
+  const intptr_t kNumFunctions = ARRAY_SIZE(kNames);
+  Function* functions[kNumFunctions];
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    functions[i] = &Function::Handle(
+        cls.LookupStaticFunction(String::Handle(String::New(kNames[i]))));
+    EXPECT(!functions[i]->IsNull());
+  }
+  const Function& foo = *functions[0];
+  const Function& bar = *functions[1];
+  const Function& baz = *functions[2];
+  const Function& qux = *functions[3];
+
+  PendingCompilationQueue queue;
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    functions[i]->SetUsageCounter(1000);
+    queue.Add(*functions[i]);
+    EXPECT(queue.Contains(*functions[i]));
+    // As done by OptimizeInvokedFunction.
+    functions[i]->SetUsageCounter(INT32_MIN);
+  }
+  EXPECT_EQ(kNumFunctions, queue.Length());
+  // Calls while queued only count once the function is bumped.
+  baz.SetUsageCounter(INT32_MIN + 100);
+  bar.SetUsageCounter(INT32_MIN + 120);
+  qux.SetUsageCounter(INT32_MIN + 200);
+  queue.Bump(baz);
+  queue.Bump(bar);
+
+  // The hottest function comes first, ties in the order they were added.
+  Function& function = Function::Handle();
+  function = queue.RemoveHottest();
+  EXPECT(function.ptr() == bar.ptr());
+  EXPECT(!queue.Contains(bar));
+  function = queue.RemoveHottest();
+  EXPECT(function.ptr() == baz.ptr());
+  bar.SetUsageCounter(1000);
+  queue.Add(bar);
+  bar.SetUsageCounter(INT32_MIN);
+  function = queue.RemoveHottest();
+  EXPECT(function.ptr() == foo.ptr());
+  function = queue.RemoveHottest();
+  EXPECT(function.ptr() == qux.ptr());
+  function = queue.RemoveHottest();
+  EXPECT(function.ptr() == bar.ptr());
+  EXPECT(queue.IsEmpty());
+}
+
+ISOLATE_UNIT_TEST_CASE(BackgroundCompilerSeveralTasks) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static f0() { return 0; }\n"
+      "  static f1() { return 1; }\n"
+      "  static f2() { return 2; }\n"
+      "  static f3() { return 3; }\n"
+      "  static f4() { return 4; }\n"
+      "  static f5() { return 5; }\n"
+      "  static f6() { return 6; }\n"
+      "  static f7() { return 7; }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, nullptr);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+  const intptr_t kNumFunctions = 8;
+  Function* functions[kNumFunctions];
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    functions[i] = &Function::Handle(cls.LookupStaticFunction(
+        String::Handle(String::NewFormatted("f%" Pd, i))));
+    EXPECT(!functions[i]->IsNull());
+    CompilerTest::TestCompileFunction(*functions[i]);
+    EXPECT(functions[i]->HasCode());
+    EXPECT(!functions[i]->HasOptimizedCode());
+  }
+
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  SetFlagScope<int> sfs(&FLAG_background_compiler_tasks, 4);
+  auto isolate_group = thread->isolate_group();
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    functions[i]->SetUsageCounter(1000 + i);
+    EXPECT(isolate_group->background_compiler()->EnqueueCompilation(
+        *functions[i]));
+    functions[i]->SetUsageCounter(INT32_MIN);
+  }
+  Monitor* m = new Monitor();
+  {
+    SafepointMonitorLocker ml(m);
+    for (intptr_t i = 0; i < kNumFunctions; i++) {
+      while (!functions[i]->HasOptimizedCode()) {
+        ml.Wait(1);
+      }
+    }
+  }
+  delete m;
+
+  // All functions were compiled, and every compilation recorded its latency.
+  auto queue_length = isolate_group->GetBackgroundCompilerQueueLengthMetric();
+  EXPECT_EQ(0, queue_length->Value());
+  const int64_t p50 =
+      isolate_group->GetBackgroundCompilerLatencyP50Metric()->Value();
+  const int64_t p90 =
+      isolate_group->GetBackgroundCompilerLatencyP90Metric()->Value();
+  const int64_t p99 =
+      isolate_group->GetBackgroundCompilerLatencyP99Metric()->Value();
+  EXPECT(p50 > 0);
+  EXPECT(p90 >= p50);
+  EXPECT(p99 >= p90);
+}
+
 ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   // Create a simple function and compile it without optimization.
   const char* kScriptChars =
@@ -11,6 +11,10 @@
 
 #include "vm/app_snapshot.h"
 #include "vm/code_observers.h"
+#if !defined(DART_PRECOMPILED_RUNTIME)
+#include "vm/compiler/aot/aot_profile.h"
+#include "vm/compiler/compilation_report.h"
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
 #include "vm/compiler/runtime_offsets_extracted.h"
 #include "vm/compiler/runtime_offsets_list.h"
 #include "vm/cpu.h"
@@ -391,6 +395,12 @@ char* Dart::DartInit(const Dart_InitializeParams* params) {
   MarkingStack::Init();
   TargetCPUFeatures::Init();
   FfiCallbackMetadata::Init();
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  CompilationReport::Init();
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+#if defined(DART_PRECOMPILER)
+  AotProfile::Init();
+#endif  // defined(DART_PRECOMPILER)
 
 #if defined(DART_INCLUDE_SIMULATOR)
   Simulator::Init();
@@ -797,6 +807,12 @@ char* Dart::Cleanup() {
   Object::Cleanup();
   Page::Cleanup();
   StubCode::Cleanup();
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  CompilationReport::Cleanup();
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+#if defined(DART_PRECOMPILER)
+  AotProfile::Cleanup();
+#endif  // defined(DART_PRECOMPILER)
 #if defined(SUPPORT_TIMELINE)
   if (FLAG_trace_shutdown) {
     OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Shutting down timeline\n",
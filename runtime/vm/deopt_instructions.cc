@@ -11,6 +11,7 @@
 #include "vm/compiler/assembler/disassembler.h"
 #include "vm/compiler/backend/il.h"
 #include "vm/compiler/backend/locations.h"
+#include "vm/compiler/compilation_report.h"
 #include "vm/compiler/jit/compiler.h"
 #include "vm/parser.h"
 #include "vm/stack_frame.h"
@@ -125,6 +126,12 @@ DeoptContext::DeoptContext(const StackFrame* frame,
         frame->fp(), function.ToFullyQualifiedCString(),
         function.deoptimization_counter());
   }
+
+  if ((dest_options != kDestIsAllocated) && CompilationReport::IsEnabled()) {
+    CompilationReport::ReportDeoptimization(
+        code, DeoptReasonToCString(deopt_reason()),
+        function.deoptimization_counter());
+  }
 }
 
 DeoptContext::~DeoptContext() {
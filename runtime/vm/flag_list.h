@@ -144,7 +144,8 @@ constexpr bool FLAG_support_il_printer = false;
     "is counted as one marker task")                                           \
   P(marker_tasks, int, 2,                                                      \
     "The number of tasks to spawn during old gen GC marking (0 means "         \
-    "perform all marking on main thread).")                                    \
+    "perform all marking on main thread, -1 means select an amount based on "  \
+    "the old gen capacity and the number of available processors).")           \
   P(hash_map_probes_limit, int, kMaxInt32,                                     \
     "Limit number of probes while doing lookups in hash maps.")                \
   P(max_polymorphic_checks, int, 4,                                            \
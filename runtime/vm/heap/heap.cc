@@ -36,6 +36,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, huge_pages);
+
 DEFINE_FLAG(bool, write_protect_vm_isolate, true, "Write protect vm_isolate.");
 DEFINE_FLAG(bool,
             disable_heap_verification,
@@ -135,7 +137,14 @@ uword Heap::AllocateOld(Thread* thread, intptr_t size, bool is_exec) {
 
   if (!thread->force_growth()) {
     CollectForDebugging(thread);
-    uword addr = old_space_.TryAllocate(size, is_exec);
+    uword addr;
+    if (!is_exec) {
+      addr = old_space_.TryAllocateThreadLocal(thread, size);
+      if (addr != 0) {
+        return addr;
+      }
+    }
+    addr = old_space_.TryAllocate(size, is_exec);
     if (addr != 0) {
       return addr;
     }
@@ -1000,6 +1009,12 @@ void Heap::PrintMemoryUsageJSON(JSONObject* jsobj) const {
   jsobj->AddProperty64("heapUsage", TotalUsedInWords() * kWordSize);
   jsobj->AddProperty64("heapCapacity", TotalCapacityInWords() * kWordSize);
   jsobj->AddProperty64("externalUsage", TotalExternalInWords() * kWordSize);
+  if (FLAG_huge_pages) {
+    jsobj->AddProperty64("_hugePageAdvisedBytes",
+                         VirtualMemory::HugePageAdvisedBytes());
+    jsobj->AddProperty64("_hugePageBackedBytes",
+                         VirtualMemory::HugePageBackedBytes());
+  }
 }
 #endif  // PRODUCT
 
@@ -1154,6 +1169,14 @@ void Heap::PrintStatsToTimeline(TimelineEventScope* event, GCReason reason) {
                         RoundWordsToKB(stats_.before_.old_.external_in_words));
   event->FormatArgument(arguments + 12, "After.Old.External (kB)", "%" Pd "",
                         RoundWordsToKB(stats_.after_.old_.external_in_words));
+  if (FLAG_huge_pages) {
+    // The bytes actually backed by huge pages are only sampled on request
+    // (see PrintMemoryUsageJSON), since that reads /proc.
+    arguments = event->GetNumArguments();
+    event->SetNumArguments(arguments + 1);
+    event->FormatArgument(arguments, "HugePages.Advised (kB)", "%" Pd "",
+                          VirtualMemory::HugePageAdvisedBytes() / KB);
+  }
 #endif  // defined(SUPPORT_TIMELINE)
 }
 
@@ -474,6 +474,20 @@ class GCTestHelper : public AllStatic {
     thread->heap()->CollectAllGarbage(GCReason::kDebugging, compact);
   }
 
+  // Pretends the last incremental compaction copied at the given speed and
+  // spent the given time forwarding, which sizes the next one.
+  static void SetEvacuationSpeed(intptr_t bytes_per_micro,
+                                 int64_t overhead_micros) {
+    PageSpace* old_space = Thread::Current()->heap()->old_space();
+    old_space->evacuated_bytes_per_micro_ = bytes_per_micro;
+    old_space->evacuation_overhead_micros_ = overhead_micros;
+  }
+
+  // The bytes moved by the last incremental compaction.
+  static intptr_t EvacuatedBytes() {
+    return Thread::Current()->heap()->old_space()->evacuated_bytes_;
+  }
+
   static void WaitForGCTasks() {
     Thread* thread = Thread::Current();
     ASSERT(thread->execution_state() == Thread::kThreadInVM);
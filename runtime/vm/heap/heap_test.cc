@@ -17,6 +17,8 @@
 #include "vm/globals.h"
 #include "vm/heap/become.h"
 #include "vm/heap/heap.h"
+#include "vm/heap/safepoint.h"
+#include "vm/json_stream.h"
 #include "vm/message_handler.h"
 #include "vm/message_snapshot.h"
 #include "vm/object_graph.h"
@@ -27,6 +29,7 @@
 namespace dart {
 
 DECLARE_FLAG(int, early_tenuring_threshold);
+DECLARE_FLAG(bool, huge_pages);
 
 TEST_CASE(OldGC) {
   const char* kScriptChars =
@@ -680,6 +683,31 @@ ISOLATE_UNIT_TEST_CASE(ExternalSizeLimit) {
   // Check that the external size is indeed protected from overflowing.
   EXPECT_LT(heap->old_space()->ExternalInWords(), kMaxAddrSpaceInWords);
 }
+
+ISOLATE_UNIT_TEST_CASE(HugePageMemoryUsage) {
+  Heap* heap = thread->isolate_group()->heap();
+  {
+    JSONStream js;
+    heap->PrintMemoryUsageJSON(&js);
+    EXPECT_NOTSUBSTRING("hugePage", js.ToCString());
+  }
+  SetFlagScope<bool> sfs(&FLAG_huge_pages, true);
+  {
+    JSONStream js;
+    heap->PrintMemoryUsageJSON(&js);
+    EXPECT_SUBSTRING("\"_hugePageAdvisedBytes\":", js.ToCString());
+    EXPECT_SUBSTRING("\"_hugePageBackedBytes\":", js.ToCString());
+  }
+  {
+    JSONStream js;
+    {
+      JSONObject obj(&js);
+      heap->PrintToJSONObject(Heap::kOld, &obj);
+    }
+    EXPECT_SUBSTRING("\"hugePageAdvised\":", js.ToCString());
+    EXPECT_SUBSTRING("\"hugePageBacked\":", js.ToCString());
+  }
+}
 #endif  // !defined(PRODUCT)
 
 ISOLATE_UNIT_TEST_CASE(ArrayTruncationRaces) {
@@ -752,6 +780,219 @@ ISOLATE_UNIT_TEST_CASE(ArrayTruncationPadding) {
   IsolateGroup::Current()->heap()->Verify("truncation padding");
 }
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+DECLARE_FLAG(bool, pretenure_classes);
+DECLARE_FLAG(int, pretenure_sample_interval);
+
+TEST_CASE(PretenureLongLivedAllocationSite) {
+  SetFlagScope<bool> sfs(&FLAG_pretenure_classes, true);
+  // Not sampling keeps every allocation below in old space.
+  SetFlagScope<int> sfs_interval(&FLAG_pretenure_sample_interval, 0);
+  const char* kScriptChars = R"(
+    class Box {
+      final value;
+      Box(this.value);
+    }
+    final retained = <Box>[];
+    fill() {
+      for (var i = 0; i < 20000; i++) {
+        retained.add(Box(i));
+      }
+    }
+    newBox() => Box(0);
+  )";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  EXPECT_VALID(Dart_Invoke(lib, NewString("fill"), 0, nullptr));
+  EXPECT_VALID(Dart_Invoke(lib, NewString("fill"), 0, nullptr));
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectNewSpace();
+  }
+
+  // Every Box survived, so the site now allocates directly in old space.
+  Dart_Handle result = Dart_Invoke(lib, NewString("newBox"), 0, nullptr);
+  EXPECT_VALID(result);
+  intptr_t box_size;
+  {
+    TransitionNativeToVM transition(thread);
+    ObjectPtr box = Api::UnwrapHandle(result);
+    EXPECT(box->IsOldObject());
+    EXPECT(box->untag()->IsRemembered());
+    box_size = box->untag()->HeapSize();
+  }
+
+  // The first allocation refilled the thread's old-space buffer, so the
+  // allocation stub bump allocates the next one from it.
+  const uword top = thread->old_space_top();
+  EXPECT_NE(0, top);
+  result = Dart_Invoke(lib, NewString("newBox"), 0, nullptr);
+  EXPECT_VALID(result);
+  TransitionNativeToVM transition(thread);
+  ObjectPtr box = Api::UnwrapHandle(result);
+  EXPECT_EQ(top, UntaggedObject::ToAddr(box));
+  EXPECT_EQ(top + box_size, thread->old_space_top());
+  EXPECT(box->untag()->IsRemembered());
+  EXPECT(!box->untag()->IsMarked());
+  IsolateGroup::Current()->heap()->Verify("pretenured allocation stub");
+}
+
+TEST_CASE(PretenureStopsWhenSurvivalDrops) {
+  SetFlagScope<bool> sfs(&FLAG_pretenure_classes, true);
+  SetFlagScope<int> sfs_interval(&FLAG_pretenure_sample_interval, 2);
+  const char* kScriptChars = R"(
+    class Box {
+      final value;
+      Box(this.value);
+    }
+    final retained = <Box>[];
+    fill() {
+      for (var i = 0; i < 20000; i++) {
+        retained.add(Box(i));
+      }
+    }
+    var last;
+    churn() {
+      for (var i = 0; i < 400000; i++) {
+        last = Box(i);
+      }
+    }
+    newBox() => Box(0);
+  )";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  EXPECT_VALID(Dart_Invoke(lib, NewString("fill"), 0, nullptr));
+  EXPECT_VALID(Dart_Invoke(lib, NewString("fill"), 0, nullptr));
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectNewSpace();
+  }
+  Dart_Handle result = Dart_Invoke(lib, NewString("newBox"), 0, nullptr);
+  EXPECT_VALID(result);
+  ClassTable* class_table = thread->isolate_group()->class_table();
+  intptr_t cid;
+  {
+    TransitionNativeToVM transition(thread);
+    cid = Api::UnwrapHandle(result)->GetClassId();
+  }
+  EXPECT(class_table->ShouldPretenure(cid));
+
+  // The allocation stub bump allocates in old space and only the objects
+  // sampled on its runtime path are allocated in new space. None of them
+  // survive, so the class is no longer pretenured.
+  EXPECT_VALID(Dart_Invoke(lib, NewString("churn"), 0, nullptr));
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectNewSpace();
+  }
+  EXPECT(!class_table->ShouldPretenure(cid));
+  result = Dart_Invoke(lib, NewString("newBox"), 0, nullptr);
+  EXPECT_VALID(result);
+  TransitionNativeToVM transition(thread);
+  EXPECT(Api::UnwrapHandle(result)->IsNewObject());
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+ISOLATE_UNIT_TEST_CASE(OldSpaceThreadLocalAllocation) {
+  if (!FLAG_old_space_tlab) return;
+  Heap* heap = IsolateGroup::Current()->heap();
+  GCTestHelper::CollectAllGarbage();
+  GCTestHelper::WaitForGCTasks();
+
+  // Consecutive small old-space allocations bump allocate from the same
+  // thread-local buffer.
+  Array& first = Array::Handle(Array::New(4, Heap::kOld));
+  Array& second = Array::Handle(Array::New(4, Heap::kOld));
+  EXPECT_EQ(UntaggedObject::ToAddr(first.ptr()) + Array::InstanceSize(4),
+            UntaggedObject::ToAddr(second.ptr()));
+
+  // The unused tail of the buffer keeps the page walkable.
+  heap->Verify("thread-local allocation buffer");
+
+  // Marking abandons the buffer; the retained objects survive and the tail
+  // is swept.
+  GCTestHelper::CollectAllGarbage();
+  GCTestHelper::WaitForGCTasks();
+  EXPECT(thread->old_space_top() == 0);
+  EXPECT_EQ(4, first.Length());
+  EXPECT_EQ(4, second.Length());
+}
+
+VM_UNIT_TEST_CASE(MarkingStackBlockDeque) {
+  MarkingStack stack;
+  MarkerWorkList::Deque deque;
+  MarkingStackBlock* blocks[MarkerWorkList::Deque::kCapacity];
+  for (intptr_t i = 0; i < MarkerWorkList::Deque::kCapacity; i++) {
+    blocks[i] = stack.PopEmptyBlock();
+    EXPECT(deque.Push(blocks[i]));
+  }
+  // Overflow is left to the caller.
+  MarkingStackBlock* extra = stack.PopEmptyBlock();
+  EXPECT(!deque.Push(extra));
+  stack.PushBlock(extra);
+
+  // Thieves take the oldest block, the owner the newest.
+  EXPECT(deque.Steal() == blocks[0]);
+  EXPECT(deque.Pop() == blocks[MarkerWorkList::Deque::kCapacity - 1]);
+  EXPECT_EQ(MarkerWorkList::Deque::kCapacity - 2, deque.Size());
+  for (intptr_t i = 1; i < MarkerWorkList::Deque::kCapacity - 1; i++) {
+    EXPECT(deque.Pop() == blocks[MarkerWorkList::Deque::kCapacity - 1 - i]);
+  }
+  EXPECT(deque.Pop() == nullptr);
+  EXPECT(deque.Steal() == nullptr);
+  EXPECT(deque.IsEmpty());
+
+  for (intptr_t i = 0; i < MarkerWorkList::Deque::kCapacity; i++) {
+    stack.PushBlock(blocks[i]);
+  }
+}
+
+static void MarkGraphWithTasks(Thread* thread, intptr_t marker_tasks) {
+  SetFlagScope<int> sfs(&FLAG_marker_tasks, marker_tasks);
+  // Long chains hanging off a few roots leave most of the work to be stolen
+  // from the task that visits the roots.
+  const intptr_t kChains = 64;
+  const intptr_t kChainLength = 2000;
+  const Array& roots = Array::Handle(Array::New(kChains, Heap::kOld));
+  const Array& weak_refs = Array::Handle(Array::New(2 * kChains, Heap::kOld));
+  Array& node = Array::Handle();
+  Array& next = Array::Handle();
+  WeakReference& weak = WeakReference::Handle();
+  for (intptr_t i = 0; i < kChains; i++) {
+    node = Array::New(1, Heap::kOld);
+    roots.SetAt(i, node);
+    for (intptr_t j = 0; j < kChainLength; j++) {
+      next = Array::New(1, Heap::kOld);
+      node.SetAt(0, next);
+      node = next.ptr();
+    }
+    weak = WeakReference::New(Heap::kOld);
+    weak.set_target(node);
+    weak_refs.SetAt(2 * i, weak);
+    node = Array::New(1, Heap::kOld);
+    weak = WeakReference::New(Heap::kOld);
+    weak.set_target(node);
+    weak_refs.SetAt(2 * i + 1, weak);
+  }
+  node = Array::null();
+  next = Array::null();
+
+  GCTestHelper::CollectOldSpace();
+  IsolateGroup::Current()->heap()->Verify("parallel marking");
+  for (intptr_t i = 0; i < kChains; i++) {
+    weak ^= weak_refs.At(2 * i);
+    EXPECT(weak.target() != Object::null());
+    weak ^= weak_refs.At(2 * i + 1);
+    EXPECT(weak.target() == Object::null());
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(ParallelMarkingWithSeveralTasks) {
+  MarkGraphWithTasks(thread, 0);
+  MarkGraphWithTasks(thread, 2);
+  MarkGraphWithTasks(thread, 8);
+  // Sized from the old generation and the available processors.
+  MarkGraphWithTasks(thread, -1);
+}
+
 class ConcurrentForceGrowthScopeTask : public ThreadPool::Task {
  public:
   ConcurrentForceGrowthScopeTask(IsolateGroup* isolate_group,
@@ -1343,6 +1584,145 @@ ISOLATE_UNIT_TEST_CASE(CardRememberedWeakArray) {
   TestCardRememberedWeakArray(false);
 }
 
+DECLARE_FLAG(int, evacuation_target_pause);
+
+ISOLATE_UNIT_TEST_CASE(EvacuationHonorsTargetPause) {
+  SetFlagScope<bool> sfs(&FLAG_use_incremental_compactor, true);
+  SetFlagScope<int> sfs2(&FLAG_evacuation_target_pause, 1);
+
+  // Fill many pages and keep every eighth object, leaving each page about an
+  // eighth live.
+  constexpr intptr_t kNumPages = 64;
+  constexpr intptr_t kNumElements = 126;
+  const intptr_t num_objects =
+      kNumPages * kPageSize / Array::InstanceSize(kNumElements);
+  const Array& survivors =
+      Array::Handle(Array::New(num_objects / 8, Heap::kOld));
+  {
+    HANDLESCOPE(thread);
+    Array& object = Array::Handle();
+    for (intptr_t i = 0; i < num_objects; i++) {
+      object = Array::New(kNumElements, Heap::kOld);
+      if ((i % 8) == 0) {
+        survivors.SetAt(i / 8, object);
+      }
+    }
+  }
+  // Marking measures how much of each page is live.
+  GCTestHelper::CollectOldSpace();
+
+  // The next collection evacuates the emptiest pages for as long as the last
+  // evacuation's speed says fits in the target pause.
+  constexpr intptr_t kBudget = 4 * kPageSize;
+  GCTestHelper::SetEvacuationSpeed(kBudget / kMicrosecondsPerMillisecond, 0);
+  GCTestHelper::CollectOldSpace();
+  const intptr_t evacuated = GCTestHelper::EvacuatedBytes();
+  EXPECT(evacuated <= kBudget);
+  // With many candidates each an eighth live, the budget is nearly used up.
+  EXPECT(evacuated > kBudget / 2);
+
+  Object& object = Object::Handle();
+  for (intptr_t i = 0; i < survivors.Length(); i++) {
+    object = survivors.At(i);
+    EXPECT(object.IsArray());
+    EXPECT_EQ(kNumElements, Array::Cast(object).Length());
+  }
+  IsolateGroup::Current()->heap()->Verify("evacuation target pause");
+}
+
+// Counts the cards of a card-remembered array that a scavenge would visit,
+// without cleaning any of them.
+class CountRememberedCardsVisitor : public PredicateObjectPointerVisitor {
+ public:
+  CountRememberedCardsVisitor() {}
+
+  bool PredicateVisitPointers(ObjectPtr* first, ObjectPtr* last) override {
+    count_++;
+    return true;
+  }
+#if defined(DART_COMPRESSED_POINTERS)
+  bool PredicateVisitCompressedPointers(uword heap_base,
+                                        CompressedObjectPtr* first,
+                                        CompressedObjectPtr* last) override {
+    count_++;
+    return true;
+  }
+#endif
+
+  intptr_t count() const { return count_; }
+
+ private:
+  intptr_t count_ = 0;
+};
+
+static intptr_t CountRememberedCards(Thread* thread, const Array& array) {
+  GcSafepointOperationScope safepoint(thread);
+  CountRememberedCardsVisitor visitor;
+  Page::Of(array.ptr())->VisitRememberedCards(array.ptr(), &visitor);
+  return visitor.count();
+}
+
+VM_UNIT_TEST_CASE(CardMarkPromotedArray) {
+  // Pages only get card tables while the flag is set, so set it before the
+  // isolate group allocates any.
+  SetFlagScope<bool> sfs(&FLAG_card_mark_promoted_arrays, true);
+  SetFlagScope<int> sfs2(&FLAG_early_tenuring_threshold, 100);  // I.e., off.
+  TestIsolateScope scope;
+  Thread* thread = Thread::Current();
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  HANDLESCOPE(thread);
+
+  // Small enough for new space, large enough to be card remembered.
+  constexpr intptr_t kNumElements = 4096;
+  constexpr intptr_t kStride = 5 * Page::kSlotsPerCard + 3;
+  constexpr intptr_t kNumStores = 10;
+  Array& array = Array::Handle(Array::New(kNumElements));
+  EXPECT(array.IsNew());
+  GCTestHelper::CollectNewSpace();
+  GCTestHelper::CollectNewSpace();
+  EXPECT(array.IsOld());
+  EXPECT(Page::Of(array.ptr())->has_card_table());
+  EXPECT(array.ptr()->untag()->IsCardRemembered());
+  // Promoted with no new-space targets, so nothing is dirty.
+  EXPECT_EQ(0, CountRememberedCards(thread, array));
+
+  {
+    HANDLESCOPE(thread);
+    Object& element = Object::Handle();
+    // Skip the first card, which is shared with the header and so is never
+    // cleaned.
+    for (intptr_t i = 1; i <= kNumStores; i++) {
+      element = Double::New(i, Heap::kNew);
+      array.SetAt(i * kStride, element);
+    }
+  }
+  // The stores dirty one card each instead of remembering the whole array.
+  EXPECT(!array.ptr()->untag()->IsRemembered());
+  EXPECT_EQ(kNumStores, CountRememberedCards(thread, array));
+
+  // The targets survive in new space, so their cards stay dirty.
+  GCTestHelper::CollectNewSpace();
+  EXPECT_EQ(kNumStores, CountRememberedCards(thread, array));
+
+  // Once the targets are promoted the cards are cleaned.
+  GCTestHelper::CollectNewSpace();
+  EXPECT_EQ(0, CountRememberedCards(thread, array));
+
+  Object& element = Object::Handle();
+  for (intptr_t i = 0; i < kNumElements; i++) {
+    element = array.At(i);
+    if ((i > 0) && ((i % kStride) == 0) && ((i / kStride) <= kNumStores)) {
+      EXPECT(element.IsDouble());
+      EXPECT(element.IsOld());
+      EXPECT(Double::Cast(element).value() == i / kStride);
+    } else {
+      EXPECT(element.IsNull());
+    }
+  }
+  IsolateGroup::Current()->heap()->Verify("card marked promoted array");
+}
+
 struct ExistingObject;
 
 static constexpr uword kMarkBit = 1;
@@ -18,6 +18,14 @@
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            evacuation_target_pause,
+            0,
+            "Target duration in milliseconds of the incremental compactor's "
+            "stop-the-world evacuation. The most fragmented pages are selected "
+            "until their predicted evacuation time reaches the target. 0 bounds "
+            "evacuation by the size of new-space instead.");
+
 void GCIncrementalCompactor::Prologue(PageSpace* old_space) {
   ASSERT(Thread::Current()->OwnsGCSafepoint());
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "StartIncrementalCompact");
@@ -181,8 +189,23 @@ bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
   // Evacuate no more than this amount of objects. This puts a bound on the
   // stop-the-world evacuate step that is similar to the existing longest
   // stop-the-world step of the scavenger.
-  const intptr_t kMaxEvacuatedBytes =
+  intptr_t max_evacuated_bytes =
       (old_space->heap_->new_space()->ThresholdInWords() << kWordSizeLog2) / 4;
+  if ((FLAG_evacuation_target_pause > 0) &&
+      (old_space->evacuated_bytes_per_micro_ > 0)) {
+    // Or, with a target pause, by the copying speed of the last evacuation
+    // once its fixed cost of forwarding the rest of the heap is taken out.
+    // Always allow one page so fragmentation cannot grow without bound.
+    int64_t budget_micros =
+        FLAG_evacuation_target_pause * kMicrosecondsPerMillisecond -
+        old_space->evacuation_overhead_micros_;
+    int64_t budget_bytes = Utils::Maximum<int64_t>(budget_micros, 0) *
+                           old_space->evacuated_bytes_per_micro_;
+    max_evacuated_bytes = static_cast<intptr_t>(
+        Utils::Minimum<int64_t>(Utils::Maximum<int64_t>(budget_bytes,
+                                                        kEvacuationThreshold),
+                                kIntptrMax));
+  }
 
   PrologueState state;
   {
@@ -206,7 +229,7 @@ bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
     intptr_t cumulative_live_bytes = 0;
     for (intptr_t i = 0; i < state.pages.length(); i++) {
       intptr_t live_bytes = state.pages[i].live_bytes;
-      if (cumulative_live_bytes + live_bytes <= kMaxEvacuatedBytes) {
+      if (cumulative_live_bytes + live_bytes <= max_evacuated_bytes) {
         num_candidates++;
         cumulative_live_bytes += live_bytes;
         state.pages[i].page->set_evacuation_candidate(true);
@@ -214,10 +237,11 @@ bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
     }
 
 #if defined(SUPPORT_TIMELINE)
-    tbes.SetNumArguments(2);
+    tbes.SetNumArguments(3);
     tbes.FormatArgument(0, "cumulative_live_bytes", "%" Pd,
                         cumulative_live_bytes);
     tbes.FormatArgument(1, "num_candidates", "%" Pd, num_candidates);
+    tbes.FormatArgument(2, "max_evacuated_bytes", "%" Pd, max_evacuated_bytes);
 #endif
 
     state.page_cursor = 0;
@@ -230,6 +254,7 @@ bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
     if (num_candidates == 0) return false;
   }
 
+  old_space->AbandonThreadAllocationBuffers();
   old_space->ReleaseBumpAllocation();
 
   IsolateGroup* isolate_group = IsolateGroup::Current();
@@ -582,6 +607,18 @@ class EpilogueState {
   void AddNewFreeSize(intptr_t size) { new_free_size_ += size; }
   intptr_t NewFreeSize() { return new_free_size_; }
 
+  void AddEvacuatedSize(intptr_t size) { evacuated_size_ += size; }
+  intptr_t EvacuatedSize() { return evacuated_size_; }
+
+  // Called by every task once all of them have finished evacuating; the first
+  // records the end of the copying phase.
+  void RecordEvacuationEnd() {
+    if (evacuation_end_slice_.exchange(false)) {
+      evacuation_end_micros_ = OS::GetCurrentMonotonicMicros();
+    }
+  }
+  int64_t EvacuationEndMicros() const { return evacuation_end_micros_; }
+
  private:
   Page* evac_page_;
   StoreBufferBlock* block_;
@@ -595,6 +632,9 @@ class EpilogueState {
   RelaxedAtomic<bool> roots_slice_ = {true};
   RelaxedAtomic<bool> reset_progress_bars_slice_ = {true};
   RelaxedAtomic<intptr_t> new_free_size_ = {0};
+  RelaxedAtomic<intptr_t> evacuated_size_ = {0};
+  RelaxedAtomic<bool> evacuation_end_slice_ = {true};
+  int64_t evacuation_end_micros_ = 0;
 };
 
 class EpilogueTask : public SafepointTask {
@@ -618,6 +658,8 @@ class EpilogueTask : public SafepointTask {
 
     barrier_->Sync();
 
+    state_->RecordEvacuationEnd();
+
     IncrementalForwardingVisitor visitor(thread);
     if (state_->TakeOOM()) {
       old_space_->VisitRoots(&visitor);  // OOM reservation.
@@ -719,6 +761,7 @@ class EpilogueTask : public SafepointTask {
 
     old_space_->ReleaseLock(freelist_);
     old_space_->usage_.used_in_words -= (bytes_evacuated >> kWordSizeLog2);
+    state_->AddEvacuatedSize(bytes_evacuated);
 #if defined(SUPPORT_TIMELINE)
     tbes.SetNumArguments(1);
     tbes.FormatArgument(0, "bytes_evacuated", "%" Pd, bytes_evacuated);
@@ -751,6 +794,7 @@ class EpilogueTask : public SafepointTask {
          page = page->next()) {
       page->VisitRememberedCards(visitor, /*only_marked*/ true);
     }
+    old_space_->VisitCardRememberedArrays(visitor, /*only_marked=*/true);
   }
 
   void ForwardNewSpace(IncrementalForwardingVisitor* visitor) {
@@ -813,6 +857,7 @@ class EpilogueTask : public SafepointTask {
 };
 
 void GCIncrementalCompactor::Evacuate(PageSpace* old_space) {
+  const int64_t start = OS::GetCurrentMonotonicMicros();
   IsolateGroup* isolate_group = IsolateGroup::Current();
   isolate_group->ReleaseStoreBuffers();
   EpilogueState state(
@@ -834,6 +879,19 @@ void GCIncrementalCompactor::Evacuate(PageSpace* old_space) {
 
   old_space->heap_->new_space()->set_freed_in_words(state.NewFreeSize() >>
                                                     kWordSizeLog2);
+
+  // Feed back into the selection of the next evacuation candidates: copying
+  // scales with the bytes evacuated, forwarding with the size of the heap.
+  const int64_t end = OS::GetCurrentMonotonicMicros();
+  const int64_t copy_micros = state.EvacuationEndMicros() - start;
+  const intptr_t evacuated = state.EvacuatedSize();
+  old_space->evacuated_bytes_ = evacuated;
+  if ((evacuated > 0) && (copy_micros > 0)) {
+    old_space->evacuated_bytes_per_micro_ =
+        Utils::Maximum<intptr_t>(evacuated / copy_micros, 1);
+  }
+  old_space->evacuation_overhead_micros_ =
+      end - Utils::Maximum(start, state.EvacuationEndMicros());
 }
 
 void GCIncrementalCompactor::CheckPostEvacuate(PageSpace* old_space) {
@@ -41,6 +41,7 @@ class MarkingVisitor : public ObjectPointerVisitor {
         deferred_work_list_(deferred_marking_stack),
         marked_bytes_(0),
         marked_micros_(0),
+        steals_(0),
         concurrent_(true),
         has_evacuation_candidate_(false) {}
   ~MarkingVisitor() { ASSERT(delayed_.IsEmpty()); }
@@ -48,6 +49,7 @@ class MarkingVisitor : public ObjectPointerVisitor {
   uintptr_t marked_bytes() const { return marked_bytes_; }
   int64_t marked_micros() const { return marked_micros_; }
   void AddMicros(int64_t micros) { marked_micros_ += micros; }
+  uintptr_t steals() const { return steals_; }
   void set_concurrent(bool value) { concurrent_ = value; }
 
 #ifdef DEBUG
@@ -202,8 +204,16 @@ class MarkingVisitor : public ObjectPointerVisitor {
         obj->untag()->to(Smi::Value(obj->untag()->length()));
     uword heap_base = obj.heap_base();
 
+    // Only the array's own cards: on a regular page the card table also
+    // covers the objects around it.
     Page* page = Page::Of(obj);
-    for (intptr_t i = 0, n = page->card_table_size(); i < n; i++) {
+    const intptr_t first_card = (reinterpret_cast<uword>(obj_from) -
+                                 reinterpret_cast<uword>(page)) >>
+                                Page::kBytesPerCardLog2;
+    const intptr_t last_card = (reinterpret_cast<uword>(obj_to) -
+                                reinterpret_cast<uword>(page)) >>
+                               Page::kBytesPerCardLog2;
+    for (intptr_t i = first_card; i <= last_card; i++) {
       CompressedObjectPtr* card_from =
           reinterpret_cast<CompressedObjectPtr*>(page) +
           (i << Page::kSlotsPerCardLog2);
@@ -228,7 +238,7 @@ class MarkingVisitor : public ObjectPointerVisitor {
         page->RememberCard(card_from);
       }
 
-      if (((i + 1) % kCardsPerInterruptCheck) == 0) {
+      if (((i - first_card + 1) % kCardsPerInterruptCheck) == 0) {
         if (UNLIKELY(page_space_->pause_concurrent_marking())) {
           YieldConcurrentMarking();
         }
@@ -596,6 +606,25 @@ class MarkingVisitor : public ObjectPointerVisitor {
     return old_work_list_.WaitForWork(num_busy);
   }
 
+  // During parallel marking, old-space blocks overflowing the local output
+  // are kept in this visitor's deque, where idle peers can steal them.
+  void AttachDeque() { old_work_list_.AttachDeque(&deque_); }
+  void DetachDeque() { old_work_list_.DetachDeque(); }
+
+  // Tries to take a block of old-space work from a peer's deque. Victims are
+  // probed starting after our own index to spread thieves across tasks.
+  bool StealWork(MarkingVisitor** visitors, intptr_t num_visitors,
+                 intptr_t index) {
+    for (intptr_t i = 1; i < num_visitors; i++) {
+      MarkingVisitor* victim = visitors[(index + i) % num_visitors];
+      if (old_work_list_.Steal(&victim->deque_)) {
+        steals_++;
+        return true;
+      }
+    }
+    return false;
+  }
+
   void Flush(GCLinkedLists* global_list) {
     old_work_list_.Flush();
     new_work_list_.Flush();
@@ -693,9 +722,11 @@ class MarkingVisitor : public ObjectPointerVisitor {
   MarkerWorkList new_work_list_;
   MarkerWorkList tlab_deferred_work_list_;
   MarkerWorkList deferred_work_list_;
+  MarkerWorkList::Deque deque_;
   GCLinkedLists delayed_;
   uintptr_t marked_bytes_;
   int64_t marked_micros_;
+  uintptr_t steals_;
   bool concurrent_;
   bool has_evacuation_candidate_;
 
@@ -907,12 +938,13 @@ class ParallelMarkTask : public SafepointTask {
                    IsolateGroup* isolate_group,
                    MarkingStack* marking_stack,
                    ThreadBarrier* barrier,
-                   MarkingVisitor* visitor,
+                   intptr_t index,
                    RelaxedAtomic<uintptr_t>* num_busy)
       : SafepointTask(isolate_group, barrier, Thread::kMarkerTask),
         marker_(marker),
         marking_stack_(marking_stack),
-        visitor_(visitor),
+        index_(index),
+        visitor_(marker->visitors_[index]),
         num_busy_(num_busy) {}
 
   void RunEnteredIsolateGroup() override {
@@ -924,6 +956,7 @@ class ParallelMarkTask : public SafepointTask {
       // Phase 1: Iterate over roots and drain marking stack in tasks.
       num_busy_->fetch_add(1u);
       visitor_->set_concurrent(false);
+      visitor_->AttachDeque();
       marker_->IterateRoots(visitor_);
       visitor_->FinishedRoots();
 
@@ -933,7 +966,9 @@ class ParallelMarkTask : public SafepointTask {
       do {
         do {
           visitor_->DrainMarkingStack();
-        } while (visitor_->WaitForWork(num_busy_));
+        } while (visitor_->StealWork(marker_->visitors_, marker_->num_tasks_,
+                                     index_) ||
+                 visitor_->WaitForWork(num_busy_));
         // Wait for all markers to stop.
         barrier_->Sync();
 #if defined(DEBUG)
@@ -964,6 +999,7 @@ class ParallelMarkTask : public SafepointTask {
         }
         barrier_->Sync();
       } while (more_to_mark);
+      visitor_->DetachDeque();
 
       // Phase 2: deferred marking.
       visitor_->ProcessDeferredMarking();
@@ -981,9 +1017,18 @@ class ParallelMarkTask : public SafepointTask {
       marker_->IterateWeakRoots(thread);
       int64_t stop = OS::GetCurrentMonotonicMicros();
       visitor_->AddMicros(stop - start);
+#if defined(SUPPORT_TIMELINE)
+      tbes.SetNumArguments(3);
+      tbes.FormatArgument(0, "Task", "%" Pd "", index_);
+      tbes.FormatArgument(1, "MarkedBytes", "%" Pd "",
+                          visitor_->marked_bytes());
+      tbes.FormatArgument(2, "Steals", "%" Pd "", visitor_->steals());
+#endif
       if (FLAG_log_marker_tasks) {
-        THR_Print("Task marked %" Pd " bytes in %" Pd64 " micros.\n",
-                  visitor_->marked_bytes(), visitor_->marked_micros());
+        THR_Print("Task %" Pd " marked %" Pd " bytes in %" Pd64
+                  " micros, stole %" Pd " blocks.\n",
+                  index_, visitor_->marked_bytes(), visitor_->marked_micros(),
+                  visitor_->steals());
       }
     }
   }
@@ -991,6 +1036,7 @@ class ParallelMarkTask : public SafepointTask {
  private:
   GCMarker* marker_;
   MarkingStack* marking_stack_;
+  intptr_t index_;
   MarkingVisitor* visitor_;
   RelaxedAtomic<uintptr_t>* num_busy_;
 
@@ -1026,6 +1072,11 @@ class ConcurrentMarkTask : public ThreadPool::Task {
       visitor_->DrainMarkingStackWithPauseChecks();
       int64_t stop = OS::GetCurrentMonotonicMicros();
       visitor_->AddMicros(stop - start);
+#if defined(SUPPORT_TIMELINE)
+      tbes.SetNumArguments(1);
+      tbes.FormatArgument(0, "MarkedBytes", "%" Pd "",
+                          visitor_->marked_bytes());
+#endif
       if (FLAG_log_marker_tasks) {
         THR_Print("Task marked %" Pd " bytes in %" Pd64 " micros.\n",
                   visitor_->marked_bytes(), visitor_->marked_micros());
@@ -1075,11 +1126,32 @@ intptr_t GCMarker::MarkedWordsPerMicro() const {
   if (marked_words_per_job_micro == 0) {
     marked_words_per_job_micro = 1;  // Prevent division by zero.
   }
-  intptr_t jobs = FLAG_marker_tasks;
-  if (jobs == 0) {
-    jobs = 1;  // Marking on main thread is still one job.
+  return marked_words_per_job_micro * num_tasks_;
+}
+
+static constexpr intptr_t kMinAutoMarkerTasks = 2;
+static constexpr intptr_t kMaxAutoMarkerTasks = 32;
+// Old-space capacity that justifies one more automatically chosen task.
+static constexpr intptr_t kAutoMarkerTaskCapacityInWords = 64 * MBInWords;
+
+static intptr_t NumMarkerTasks(Heap* heap) {
+  intptr_t num_tasks = FLAG_marker_tasks;
+  if (num_tasks == -1) {
+    // --marker_tasks=-1 => scale with the old generation, bounded by the
+    // available processors.
+    intptr_t max_tasks =
+        Utils::Minimum<intptr_t>(OS::NumberOfAvailableProcessors(),
+                                 kMaxAutoMarkerTasks);
+    num_tasks = heap->old_space()->CapacityInWords() /
+                kAutoMarkerTaskCapacityInWords;
+    num_tasks = Utils::Minimum(num_tasks, max_tasks);
+    num_tasks = Utils::Maximum(num_tasks, kMinAutoMarkerTasks);
+  } else if (num_tasks == 0) {
+    // --marker_tasks=0 => marking on main thread is still one job.
+    num_tasks = 1;
   }
-  return marked_words_per_job_micro * jobs;
+  ASSERT(num_tasks > 0);
+  return num_tasks;
 }
 
 GCMarker::GCMarker(IsolateGroup* isolate_group, Heap* heap)
@@ -1090,11 +1162,12 @@ GCMarker::GCMarker(IsolateGroup* isolate_group, Heap* heap)
       tlab_deferred_marking_stack_(),
       deferred_marking_stack_(),
       global_list_(),
+      num_tasks_(NumMarkerTasks(heap)),
       visitors_(),
       marked_bytes_(0),
       marked_micros_(0) {
-  visitors_ = new MarkingVisitor*[FLAG_marker_tasks];
-  for (intptr_t i = 0; i < FLAG_marker_tasks; i++) {
+  visitors_ = new MarkingVisitor*[num_tasks_];
+  for (intptr_t i = 0; i < num_tasks_; i++) {
     visitors_[i] = nullptr;
   }
 }
@@ -1104,7 +1177,7 @@ GCMarker::~GCMarker() {
   // marker and before finalizing.
   if (isolate_group_->old_marking_stack() != nullptr) {
     isolate_group_->DisableIncrementalBarrier();
-    for (intptr_t i = 0; i < FLAG_marker_tasks; i++) {
+    for (intptr_t i = 0; i < num_tasks_; i++) {
       visitors_[i]->AbandonWork();
       delete visitors_[i];
     }
@@ -1116,7 +1189,7 @@ void GCMarker::StartConcurrentMark(PageSpace* page_space) {
   isolate_group_->EnableIncrementalBarrier(
       &old_marking_stack_, &new_marking_stack_, &deferred_marking_stack_);
 
-  const intptr_t num_tasks = FLAG_marker_tasks;
+  const intptr_t num_tasks = num_tasks_;
 
   {
     // Bulk increase task count before starting any task, instead of
@@ -1292,7 +1365,7 @@ void GCMarker::MarkObjects(PageSpace* page_space) {
 
   Prologue();
 
-  const int num_tasks = FLAG_marker_tasks;
+  const intptr_t num_tasks = num_tasks_;
   RELEASE_ASSERT(num_tasks > 0);
   ThreadBarrier* barrier = new ThreadBarrier(num_tasks, /*initial=*/1);
 
@@ -1319,7 +1392,7 @@ void GCMarker::MarkObjects(PageSpace* page_space) {
     visitor->Flush(&global_list_);
     // Need to move weak property list too.
     tasks.Append(new ParallelMarkTask(this, isolate_group_, &old_marking_stack_,
-                                      barrier, visitor, &num_busy));
+                                      barrier, i, &num_busy));
   }
   visitors_[0]->Adopt(&global_list_);
   isolate_group_->safepoint_handler()->RunTasks(&tasks);
@@ -1350,7 +1423,7 @@ void GCMarker::MarkObjects(PageSpace* page_space) {
 
 void GCMarker::PruneWeak(Scavenger* scavenger) {
   scavenger->PruneWeak(&global_list_);
-  for (intptr_t i = 0, n = FLAG_marker_tasks; i < n; i++) {
+  for (intptr_t i = 0, n = num_tasks_; i < n; i++) {
     scavenger->PruneWeak(visitors_[i]->delayed());
   }
 }
@@ -52,6 +52,8 @@ class GCMarker {
 
   void PruneWeak(Scavenger* scavenger);
 
+  intptr_t num_tasks() const { return num_tasks_; }
+
  private:
   void Prologue();
   void Epilogue();
@@ -84,6 +86,9 @@ class GCMarker {
   // need to be scanned even if they are already marked.
   MarkingStack deferred_marking_stack_;
   GCLinkedLists global_list_;
+  // Fixed for the lifetime of the marker so concurrent and final marking
+  // share visitors.
+  const intptr_t num_tasks_;
   MarkingVisitor** visitors_;
 
   Monitor root_slices_monitor_;
@@ -305,6 +305,70 @@ void Page::VisitRememberedCards(PredicateObjectPointerVisitor* visitor,
   }
 }
 
+void Page::VisitRememberedCards(ArrayPtr obj,
+                                PredicateObjectPointerVisitor* visitor,
+                                bool all_cards) {
+  ASSERT(Thread::Current()->OwnsGCSafepoint() ||
+         (Thread::Current()->task_kind() == Thread::kScavengerTask) ||
+         (Thread::Current()->task_kind() == Thread::kIncrementalCompactorTask));
+  NoSafepointScope no_safepoint;
+
+  ASSERT(!is_large());
+  ASSERT(card_table_ != nullptr);
+  ASSERT(Page::Of(obj) == this);
+  ASSERT(obj->IsArray() || obj->IsImmutableArray());
+  ASSERT(obj->untag()->IsCardRemembered());
+  CompressedObjectPtr* obj_from = obj->untag()->from();
+  CompressedObjectPtr* obj_to =
+      obj->untag()->to(Smi::Value(obj->untag()->length()));
+  uword heap_base = obj.heap_base();
+  const uword obj_start = UntaggedObject::ToAddr(obj);
+  const uword obj_end = obj_start + obj->untag()->HeapSize();
+
+  const uword page_start = reinterpret_cast<uword>(this);
+  const intptr_t first_card =
+      (reinterpret_cast<uword>(obj_from) - page_start) >> kBytesPerCardLog2;
+  const intptr_t last_card =
+      (reinterpret_cast<uword>(obj_to) - page_start) >> kBytesPerCardLog2;
+  for (intptr_t i = first_card; i <= last_card; i++) {
+    const intptr_t word_offset = i >> kBitsPerWordLog2;
+    const uword bit_mask = static_cast<uword>(1) << (i & (kBitsPerWord - 1));
+    if (!all_cards && ((card_table_[word_offset].load() & bit_mask) == 0)) {
+      continue;
+    }
+
+    CompressedObjectPtr* card_from =
+        reinterpret_cast<CompressedObjectPtr*>(this) + (i << kSlotsPerCardLog2);
+    CompressedObjectPtr* card_to =
+        reinterpret_cast<CompressedObjectPtr*>(card_from) +
+        (1 << kSlotsPerCardLog2) - 1;
+    // Minus 1 because to is inclusive.
+
+    const uword card_start = reinterpret_cast<uword>(card_from);
+    const uword card_end = card_start + (1 << kBytesPerCardLog2);
+    if (card_from < obj_from) {
+      // First card overlaps with header or a preceding object.
+      card_from = obj_from;
+    }
+    if (card_to > obj_to) {
+      // Last card overlaps with a following object.
+      card_to = obj_to;
+    }
+
+    bool has_new_target =
+        visitor->PredicateVisitCompressedPointers(heap_base, card_from, card_to);
+
+    if (has_new_target) {
+      if (all_cards) {
+        card_table_[word_offset].fetch_or(bit_mask);
+      }
+    } else if ((card_start >= obj_start) && (card_end <= obj_end)) {
+      // No other object can dirty this card concurrently.
+      card_table_[word_offset].fetch_and(~bit_mask);
+    }
+  }
+}
+
 void Page::ResetProgressBar() {
   progress_bar_ = 0;
 }
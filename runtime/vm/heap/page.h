@@ -73,6 +73,7 @@ class Page {
     kNew = 1 << 4,
     kEvacuationCandidate = 1 << 5,
     kNeverEvacuate = 1 << 6,
+    kCardRememberedArrays = 1 << 7,
   };
   bool is_executable() const { return (flags_ & kExecutable) != 0; }
   bool is_large() const { return (flags_ & kLarge) != 0; }
@@ -90,7 +91,9 @@ class Page {
       flags_ &= ~kEvacuationCandidate;
     }
   }
-  bool is_never_evacuate() const { return (flags_ & kNeverEvacuate) != 0; }
+  bool is_never_evacuate() const {
+    return (flags_ & (kNeverEvacuate | kCardRememberedArrays)) != 0;
+  }
   void set_never_evacuate(bool value) {
     if (value) {
       flags_ |= kNeverEvacuate;
@@ -99,6 +102,19 @@ class Page {
     }
   }
 
+  // A regular page holding card-remembered arrays is pinned: compaction would
+  // move the arrays without their cards.
+  bool has_card_remembered_arrays() const {
+    return (flags_ & kCardRememberedArrays) != 0;
+  }
+  void set_has_card_remembered_arrays(bool value) {
+    if (value) {
+      flags_ |= kCardRememberedArrays;
+    } else {
+      flags_ &= ~kCardRememberedArrays;
+    }
+  }
+
   Page* next() const { return next_; }
   void set_next(Page* next) { next_ = next; }
 
@@ -201,6 +217,15 @@ class Page {
 #endif
   void VisitRememberedCards(PredicateObjectPointerVisitor* visitor,
                             bool only_marked = false);
+  // Visits the remembered cards of one card-remembered array on a regular
+  // page. The array's first and last cards may be shared with neighboring
+  // objects, so only cards covered entirely by the array are cleaned. With
+  // 'all_cards', every card of the array is visited and those holding
+  // new-space targets are remembered, as for a freshly promoted array.
+  void VisitRememberedCards(ArrayPtr obj,
+                            PredicateObjectPointerVisitor* visitor,
+                            bool all_cards = false);
+  bool has_card_table() const { return card_table_ != nullptr; }
   void ResetProgressBar();
 
   Thread* owner() const { return owner_; }
@@ -276,7 +301,7 @@ class Page {
 
   void AllocateCardTable() {
     ASSERT(card_table_ == nullptr);
-    ASSERT(is_large());
+    ASSERT(is_old() && !is_executable());
     size_t size_in_bits = card_table_size();
     size_t size_in_bytes =
         Utils::RoundUp(size_in_bits, kBitsPerWord) >> kBitsPerByteLog2;
@@ -20,11 +20,14 @@
 #include "vm/object_set.h"
 #include "vm/os_thread.h"
 #include "vm/thread_barrier.h"
+#include "vm/thread_registry.h"
 #include "vm/unwinding_records.h"
 #include "vm/virtual_memory.h"
 
 namespace dart {
 
+DECLARE_FLAG(bool, huge_pages);
+
 DEFINE_FLAG(int,
             old_gen_growth_space_ratio,
             20,
@@ -38,6 +41,16 @@ DEFINE_FLAG(int,
             280,
             "The max number of pages the old generation can grow at a time");
 DEFINE_FLAG(bool, log_growth, false, "Log PageSpace growth policy decisions.");
+DEFINE_FLAG(bool,
+            old_space_tlab,
+            true,
+            "Bump allocate small old-space objects from thread-local buffers.");
+DEFINE_FLAG(bool,
+            card_mark_promoted_arrays,
+            false,
+            "Give regular old-space pages card tables and card-remember large "
+            "enough arrays when they are promoted, so scavenges rescan only "
+            "their dirty cards.");
 
 // The initial estimate of how many words we can mark per microsecond (usage
 // before / mark-sweep time). This is a conservative value observed running
@@ -70,6 +83,9 @@ PageSpace::PageSpace(Heap* heap, intptr_t max_capacity_in_words)
       gc_time_micros_(0),
       collections_(0),
       mark_words_per_micro_(kConservativeInitialMarkSpeed),
+      evacuated_bytes_per_micro_(0),
+      evacuation_overhead_micros_(0),
+      evacuated_bytes_(0),
       enable_concurrent_mark_(FLAG_concurrent_mark) {
   ASSERT(heap != nullptr);
 
@@ -206,6 +222,9 @@ Page* PageSpace::AllocatePage(bool is_exec, bool link) {
   page->set_object_end(page->memory_->end());
   if (!is_exec && (heap_ != nullptr) && !heap_->is_vm_isolate()) {
     page->AllocateForwardingPage();
+    if (FLAG_card_mark_promoted_arrays) {
+      page->AllocateCardTable();
+    }
   }
 
   if (is_exec) {
@@ -422,6 +441,66 @@ uword PageSpace::TryAllocateInternal(intptr_t size,
   return result;
 }
 
+uword PageSpace::TryAllocateThreadLocalSlow(Thread* thread, intptr_t size) {
+  if (!FLAG_old_space_tlab || (size > kMaxThreadLocalAllocationSize) ||
+      heap_->is_vm_isolate() || thread->BypassSafepoints()) {
+    return 0;
+  }
+  AbandonThreadAllocationBuffer(thread);
+
+  FreeList* freelist = &freelists_[kDataFreelist];
+  uword block = freelist->TryAllocate(kThreadLocalBufferSize,
+                                      /*is_protected=*/false);
+  if (block == 0) {
+    // Let the regular path grow the heap; its new page populates the freelist
+    // for the next refill.
+    tlab_fallbacks_.fetch_add(1);
+    return 0;
+  }
+  // As with the bump block, account for the whole buffer up front and subtract
+  // the remainder when the buffer is abandoned.
+  Page::Of(block)->add_live_bytes(kThreadLocalBufferSize);
+  usage_.used_in_words += (kThreadLocalBufferSize >> kWordSizeLog2);
+  tlab_refills_.fetch_add(1);
+
+  uword end = block + kThreadLocalBufferSize;
+  uword top = block + size;
+  FreeListElement::AsElement(top, end - top);
+  thread->set_old_space_top(top);
+  thread->set_old_space_end(end);
+  thread->set_old_space_allocations(thread->old_space_allocations() + 1);
+  return block;
+}
+
+void PageSpace::AbandonThreadAllocationBuffer(Thread* thread) {
+  intptr_t allocations = thread->old_space_allocations();
+  if (allocations != 0) {
+    tlab_allocations_.fetch_add(allocations);
+    thread->set_old_space_allocations(0);
+  }
+  uword top = thread->old_space_top();
+  uword end = thread->old_space_end();
+  if (top == end) {
+    return;
+  }
+  intptr_t remaining = end - top;
+  Page::Of(top)->sub_live_bytes(remaining);
+  usage_.used_in_words -= (remaining >> kWordSizeLog2);
+  freelists_[kDataFreelist].Free(top, remaining);
+  thread->set_old_space_top(0);
+  thread->set_old_space_end(0);
+}
+
+void PageSpace::AbandonThreadAllocationBuffers() {
+  ASSERT(Thread::Current()->OwnsGCSafepoint());
+  heap_->isolate_group()->thread_registry()->ForEachThread(
+      [&](Thread* thread) {
+        if (!thread->BypassSafepoints()) {
+          AbandonThreadAllocationBuffer(thread);
+        }
+      });
+}
+
 void PageSpace::AcquireLock(FreeList* freelist) {
   freelist->mutex()->Lock();
 }
@@ -695,12 +774,78 @@ void PageSpace::VisitRememberedCards(
     if (page == tail) break;
     page = page->next();
   }
+
+  VisitCardRememberedArrays(visitor, /*only_marked=*/false);
 }
 
 void PageSpace::ResetProgressBars() const {
   for (Page* page = large_pages_; page != nullptr; page = page->next()) {
     page->ResetProgressBar();
   }
+  card_remembered_arrays_cursor_ = 0;
+}
+
+void PageSpace::AddPromotedCardRememberedArray(ArrayPtr array) {
+  ASSERT(Thread::Current()->task_kind() == Thread::kScavengerTask ||
+         Thread::Current()->OwnsGCSafepoint());
+  MutexLocker ml(&promoted_card_remembered_arrays_lock_);
+  promoted_card_remembered_arrays_.Add(array);
+}
+
+void PageSpace::AcceptPromotedCardRememberedArrays(bool abort) {
+  ASSERT(Thread::Current()->OwnsGCSafepoint());
+  if (!abort) {
+    for (intptr_t i = 0; i < promoted_card_remembered_arrays_.length(); i++) {
+      ArrayPtr array = promoted_card_remembered_arrays_[i];
+      Page::Of(array)->set_has_card_remembered_arrays(true);
+      card_remembered_arrays_.Add(array);
+    }
+  }
+  // After an aborted scavenge the promoted copies are forwarding corpses.
+  promoted_card_remembered_arrays_.Clear();
+}
+
+void PageSpace::VisitCardRememberedArrays(
+    PredicateObjectPointerVisitor* visitor,
+    bool only_marked) const {
+  // Workers claim arrays in small batches, as with a large page's progress
+  // bar. Reset by ResetProgressBars.
+  const intptr_t kBatchSize = 16;
+  const intptr_t length = card_remembered_arrays_.length();
+  for (;;) {
+    intptr_t start = card_remembered_arrays_cursor_.fetch_add(kBatchSize);
+    if (start >= length) break;
+    intptr_t end = Utils::Minimum(start + kBatchSize, length);
+    for (intptr_t i = start; i < end; i++) {
+      ArrayPtr array = card_remembered_arrays_[i];
+      // Become may have turned the array into a forwarding corpse.
+      if (!array->untag()->IsCardRemembered()) continue;
+      if (only_marked && !array->untag()->IsMarked()) continue;
+      Page::Of(array)->VisitRememberedCards(array, visitor);
+    }
+  }
+}
+
+void PageSpace::PruneCardRememberedArrays() {
+  ASSERT(Thread::Current()->OwnsGCSafepoint());
+  if (card_remembered_arrays_.is_empty()) return;
+
+  {
+    MutexLocker ml(&pages_lock_);
+    for (Page* page = pages_; page != nullptr; page = page->next()) {
+      page->set_has_card_remembered_arrays(false);
+    }
+  }
+  intptr_t live = 0;
+  for (intptr_t i = 0; i < card_remembered_arrays_.length(); i++) {
+    ArrayPtr array = card_remembered_arrays_[i];
+    if (!array->untag()->IsMarked() || !array->untag()->IsCardRemembered()) {
+      continue;
+    }
+    Page::Of(array)->set_has_card_remembered_arrays(true);
+    card_remembered_arrays_[live++] = array;
+  }
+  card_remembered_arrays_.TruncateTo(live);
 }
 
 void PageSpace::WriteProtect(bool read_only) {
@@ -728,6 +873,14 @@ void PageSpace::PrintToJSONObject(JSONObject* object) const {
   space.AddProperty64("capacity", CapacityInWords() * kWordSize);
   space.AddProperty64("external", ExternalInWords() * kWordSize);
   space.AddProperty("time", MicrosecondsToSeconds(gc_time_micros()));
+  space.AddProperty64("tlabAllocations", tlab_allocations_.load());
+  space.AddProperty64("tlabRefills", tlab_refills_.load());
+  space.AddProperty64("tlabFallbacks", tlab_fallbacks_.load());
+  if (FLAG_huge_pages) {
+    space.AddProperty64("hugePageAdvised",
+                        VirtualMemory::HugePageAdvisedBytes());
+    space.AddProperty64("hugePageBacked", VirtualMemory::HugePageBackedBytes());
+  }
   if (collections() > 0) {
     int64_t run_time = isolate_group->UptimeMicros();
     run_time = Utils::Maximum(run_time, static_cast<int64_t>(0));
@@ -1060,10 +1213,13 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
     return;
   }
 
-  // Abandon the remainder of the bump allocation block.
+  // Abandon the remainder of the bump allocation block and of the mutators'
+  // allocation buffers so the sweeper sees their free space.
+  AbandonThreadAllocationBuffers();
   ReleaseBumpAllocation();
 
   marker_->MarkObjects(this);
+  PruneCardRememberedArrays();
   usage_.used_in_words = marker_->marked_words() + allocated_black_in_words_;
   allocated_black_in_words_ = 0;
   mark_words_per_micro_ = marker_->MarkedWordsPerMicro();
@@ -1542,6 +1698,11 @@ void PageSpace::SetupImagePage(void* pointer, uword size, bool is_executable) {
 
   VirtualMemory* memory = VirtualMemory::ForImagePage(pointer, size);
   ASSERT(memory != nullptr);
+  if (is_executable) {
+    // Only the 2MB-aligned parts of the instructions can use huge pages, and
+    // only if the OS supports them for the embedder's mapping.
+    VirtualMemory::AdviseHugePages(pointer, size);
+  }
   Page* page = reinterpret_cast<Page*>(malloc(sizeof(Page)));
   uword flags = Page::kImage;
   if (is_executable) {
@@ -6,6 +6,7 @@
 #define RUNTIME_VM_HEAP_PAGES_H_
 
 #include "platform/atomic.h"
+#include "platform/growable_array.h"
 #include "vm/globals.h"
 #include "vm/heap/freelist.h"
 #include "vm/heap/page.h"
@@ -18,6 +19,8 @@
 namespace dart {
 
 DECLARE_FLAG(bool, write_protect_code);
+DECLARE_FLAG(bool, old_space_tlab);
+DECLARE_FLAG(bool, card_mark_promoted_arrays);
 
 // Forward declarations.
 class Heap;
@@ -168,6 +171,31 @@ class PageSpace {
     return AllocateSnapshotLockedSlow(freelist, size);
   }
 
+  // Bump allocates from the thread's old-space allocation buffer, refilling
+  // it from the data freelist when it is exhausted. Returns 0 if the
+  // allocation should take the regular path instead.
+  DART_FORCE_INLINE
+  uword TryAllocateThreadLocal(Thread* thread, intptr_t size) {
+    ASSERT(Utils::IsAligned(size, kObjectAlignment));
+    uword top = thread->old_space_top();
+    uword end = thread->old_space_end();
+    if (LIKELY(static_cast<intptr_t>(end - top) >= size)) {
+      uword new_top = top + size;
+      if (new_top < end) {
+        FreeListElement::AsElement(new_top, end - new_top);
+      }
+      thread->set_old_space_top(new_top);
+      thread->set_old_space_allocations(thread->old_space_allocations() + 1);
+      return top;
+    }
+    return TryAllocateThreadLocalSlow(thread, size);
+  }
+  // Returns the unused part of the thread's allocation buffer to the freelist.
+  void AbandonThreadAllocationBuffer(Thread* thread);
+  // Abandons the allocation buffers of all mutators. Must be called at a
+  // safepoint before the buffers' pages are swept, compacted or verified.
+  void AbandonThreadAllocationBuffers();
+
   bool HasReservation() { return oom_reservation_ != nullptr; }
   void TryReleaseReservation();
   bool MarkReservation();
@@ -237,6 +265,17 @@ class PageSpace {
   void VisitRememberedCards(PredicateObjectPointerVisitor* visitor) const;
   void ResetProgressBars() const;
 
+  // Card-remembered arrays on regular pages. Unlike the array of a large page,
+  // these cannot be found from their page, so they are tracked here. Arrays
+  // promoted during a scavenge are held aside until it completes, since the
+  // scavenge workers concurrently visit the accepted ones.
+  void AddPromotedCardRememberedArray(ArrayPtr array);
+  void AcceptPromotedCardRememberedArrays(bool abort);
+  void VisitCardRememberedArrays(PredicateObjectPointerVisitor* visitor,
+                                 bool only_marked) const;
+  // Drops arrays that were not marked. Called after marking, before sweeping.
+  void PruneCardRememberedArrays();
+
   // Collect the garbage in the page space using mark-sweep or mark-compact.
   void CollectGarbage(Thread* thread, bool compact, bool finalize);
 
@@ -390,6 +429,11 @@ class PageSpace {
                                     bool is_executable,
                                     GrowthPolicy growth_policy);
 
+  static constexpr intptr_t kThreadLocalBufferSize = 16 * KB;
+  static constexpr intptr_t kMaxThreadLocalAllocationSize =
+      kThreadLocalBufferSize / 4;
+  uword TryAllocateThreadLocalSlow(Thread* thread, intptr_t size);
+
   // Attempt to allocate from bump block rather than normal freelist.
   uword TryAllocateDataBumpLocked(FreeList* freelist, intptr_t size);
   uword TryAllocatePromoLockedSlow(FreeList* freelist, intptr_t size);
@@ -476,6 +520,17 @@ class PageSpace {
   SpaceUsage usage_;
   RelaxedAtomic<intptr_t> allocated_black_in_words_;
 
+  MallocGrowableArray<ArrayPtr> card_remembered_arrays_;
+  mutable RelaxedAtomic<intptr_t> card_remembered_arrays_cursor_ = {0};
+  Mutex promoted_card_remembered_arrays_lock_;
+  MallocGrowableArray<ArrayPtr> promoted_card_remembered_arrays_;
+
+  // Thread-local allocation buffer statistics. Allocations are counted per
+  // thread and folded in here when a buffer is abandoned.
+  RelaxedAtomic<intptr_t> tlab_allocations_ = {0};
+  RelaxedAtomic<intptr_t> tlab_refills_ = {0};
+  RelaxedAtomic<intptr_t> tlab_fallbacks_ = {0};
+
   // Keep track of running MarkSweep tasks.
   mutable Monitor tasks_lock_;
   intptr_t tasks_;
@@ -493,6 +548,10 @@ class PageSpace {
   int64_t gc_time_micros_;
   intptr_t collections_;
   intptr_t mark_words_per_micro_;
+  // Measured during the last incremental compaction; 0 until then.
+  intptr_t evacuated_bytes_per_micro_;
+  int64_t evacuation_overhead_micros_;
+  intptr_t evacuated_bytes_;
 
   bool enable_concurrent_mark_;
 
@@ -506,6 +565,7 @@ class PageSpace {
   friend class ConcurrentSweeperTask;
   friend class GCCompactor;
   friend class GCIncrementalCompactor;
+  friend class GCTestHelper;
   friend class PrologueTask;
   friend class EpilogueTask;
   friend class CompactorTask;
@@ -32,7 +32,7 @@ void BlockStack<BlockSize>::Cleanup() {
 }
 
 template <int BlockSize>
-BlockStack<BlockSize>::BlockStack() : monitor_() {}
+BlockStack<BlockSize>::BlockStack() : monitor_(), waiters_(0) {}
 
 template <int BlockSize>
 BlockStack<BlockSize>::~BlockStack() {
@@ -121,7 +121,9 @@ typename BlockStack<BlockSize>::Block* BlockStack<BlockSize>::WaitForWork(
       num_busy->fetch_add(1u);
       return partial_.Pop();
     }
+    waiters_.fetch_add(1);
     ml.Wait();
+    waiters_.fetch_sub(1);
     if (num_busy->load() == 0) {
       return nullptr;
     }
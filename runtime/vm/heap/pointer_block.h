@@ -6,7 +6,9 @@
 #define RUNTIME_VM_HEAP_POINTER_BLOCK_H_
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
 #include "platform/memory_sanitizer.h"
+#include "platform/utils.h"
 #include "vm/globals.h"
 #include "vm/os_thread.h"
 #include "vm/tagged_pointer.h"
@@ -114,6 +116,10 @@ class BlockStack {
 
   Block* WaitForWork(RelaxedAtomic<uintptr_t>* num_busy, bool abort);
 
+  // Whether some worker is blocked in WaitForWork. Racy; only a hint for
+  // deciding whether to publish work here rather than keep it local.
+  bool HasWaiters() const { return waiters_.load() != 0; }
+
   void VisitObjectPointers(ObjectPointerVisitor* visitor);
 
  protected:
@@ -145,6 +151,7 @@ class BlockStack {
   List full_;
   List partial_;
   Monitor monitor_;
+  RelaxedAtomic<intptr_t> waiters_;
 
   // Note: This is shared on the basis of block size.
   static constexpr intptr_t kMaxGlobalEmpty = 100;
@@ -155,12 +162,92 @@ class BlockStack {
   DISALLOW_COPY_AND_ASSIGN(BlockStack);
 };
 
+// A bounded Chase-Lev work-stealing deque of blocks. The owner pushes and
+// pops at the bottom without taking locks; other workers steal the oldest
+// blocks from the top. Ownership of a block transfers with the pop or steal.
+template <typename Block>
+class BlockDeque {
+ public:
+  static constexpr intptr_t kCapacity = 64;
+
+  BlockDeque() : top_(0), bottom_(0) {}
+  ~BlockDeque() { ASSERT(IsEmpty()); }
+
+  // Owner only. Returns false if the deque is full.
+  bool Push(Block* block) {
+    intptr_t bottom = bottom_.load();
+    intptr_t top = top_.load(std::memory_order_acquire);
+    if ((bottom - top) >= kCapacity) {
+      return false;
+    }
+    blocks_[bottom & kMask].store(block);
+    // Publish the block's contents to thieves.
+    bottom_.store(bottom + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Owner only. Returns nullptr if the deque is empty.
+  Block* Pop() {
+    intptr_t bottom = bottom_.load() - 1;
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    intptr_t top = top_.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+      bottom_.store(bottom + 1);
+      return nullptr;
+    }
+    Block* block = blocks_[bottom & kMask].load();
+    if (top == bottom) {
+      // Last block: race with thieves for it.
+      if (!top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst)) {
+        block = nullptr;
+      }
+      bottom_.store(bottom + 1);
+    }
+    return block;
+  }
+
+  // Any thread. Returns nullptr if the deque is empty or the race for the
+  // top block was lost.
+  Block* Steal() {
+    intptr_t top = top_.load(std::memory_order_seq_cst);
+    intptr_t bottom = bottom_.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+      return nullptr;
+    }
+    Block* block = blocks_[top & kMask].load();
+    if (!top_.compare_exchange_strong(top, top + 1,
+                                      std::memory_order_seq_cst)) {
+      return nullptr;
+    }
+    return block;
+  }
+
+  // Racy when called by a thief.
+  intptr_t Size() const {
+    intptr_t size = bottom_.load() - top_.load();
+    return size < 0 ? 0 : size;
+  }
+  bool IsEmpty() const { return Size() == 0; }
+
+ private:
+  static constexpr intptr_t kMask = kCapacity - 1;
+  static_assert(Utils::IsPowerOfTwo(kCapacity), "kCapacity must be 2^n");
+
+  RelaxedAtomic<intptr_t> top_;
+  RelaxedAtomic<intptr_t> bottom_;
+  RelaxedAtomic<Block*> blocks_[kCapacity];
+
+  DISALLOW_COPY_AND_ASSIGN(BlockDeque);
+};
+
 template <typename Stack>
 class BlockWorkList : public ValueObject {
  public:
   typedef typename Stack::Block Block;
+  typedef BlockDeque<Block> Deque;
 
-  explicit BlockWorkList(Stack* stack) : stack_(stack) {
+  explicit BlockWorkList(Stack* stack) : stack_(stack), deque_(nullptr) {
     local_output_ = stack_->PopEmptyBlock();
     local_input_ = stack_->PopEmptyBlock();
   }
@@ -169,6 +256,7 @@ class BlockWorkList : public ValueObject {
     ASSERT(local_output_ == nullptr);
     ASSERT(local_input_ == nullptr);
     ASSERT(stack_ == nullptr);
+    ASSERT(deque_ == nullptr);
   }
 
   // Returns false if no more work was found.
@@ -181,7 +269,13 @@ class BlockWorkList : public ValueObject {
         local_output_ = local_input_;
         local_input_ = temp;
       } else {
-        Block* new_work = stack_->PopNonEmptyBlock();
+        Block* new_work = nullptr;
+        if (deque_ != nullptr) {
+          new_work = deque_->Pop();
+        }
+        if (new_work == nullptr) {
+          new_work = stack_->PopNonEmptyBlock();
+        }
         if (new_work == nullptr) {
           return false;
         }
@@ -219,12 +313,47 @@ class BlockWorkList : public ValueObject {
 
   void Push(ObjectPtr raw_obj) {
     if (UNLIKELY(local_output_->IsFull())) {
-      stack_->PushBlock(local_output_);
+      // Keep full blocks where only thieves pay for synchronization, unless
+      // another worker is idle and waiting to be handed work.
+      if ((deque_ == nullptr) || stack_->HasWaiters() ||
+          !deque_->Push(local_output_)) {
+        stack_->PushBlock(local_output_);
+      }
       local_output_ = stack_->PopEmptyBlock();
     }
     local_output_->Push(raw_obj);
   }
 
+  // Attaches a deque owned by this work list's worker. Blocks overflowing the
+  // local output are kept there until popped or stolen.
+  void AttachDeque(Deque* deque) {
+    ASSERT(deque_ == nullptr);
+    ASSERT(deque->IsEmpty());
+    deque_ = deque;
+  }
+
+  // Moves any blocks left in the deque to the shared stack.
+  void DetachDeque() {
+    ASSERT(deque_ != nullptr);
+    while (Block* block = deque_->Pop()) {
+      stack_->PushBlock(block);
+    }
+    deque_ = nullptr;
+  }
+
+  // Takes the oldest block from another worker's deque. Returns false if
+  // nothing was stolen.
+  bool Steal(Deque* victim) {
+    ASSERT(local_input_->IsEmpty());
+    Block* new_work = victim->Steal();
+    if (new_work == nullptr) {
+      return false;
+    }
+    stack_->PushBlock(local_input_);
+    local_input_ = new_work;
+    return true;
+  }
+
   void Flush() {
     if (!local_output_->IsEmpty()) {
       stack_->PushBlock(local_output_);
@@ -248,6 +377,7 @@ class BlockWorkList : public ValueObject {
   }
 
   void Finalize() {
+    ASSERT(deque_ == nullptr);
     ASSERT(local_output_->IsEmpty());
     stack_->PushBlock(local_output_);
     local_output_ = nullptr;
@@ -259,6 +389,7 @@ class BlockWorkList : public ValueObject {
   }
 
   void AbandonWork() {
+    ASSERT(deque_ == nullptr);
     stack_->PushBlock(local_output_);
     local_output_ = nullptr;
     stack_->PushBlock(local_input_);
@@ -282,6 +413,7 @@ class BlockWorkList : public ValueObject {
   Block* local_output_;
   Block* local_input_;
   Stack* stack_;
+  Deque* deque_;
 };
 
 static constexpr int kStoreBufferBlockSize = 1024;
@@ -47,6 +47,27 @@ DEFINE_FLAG(int,
             90,
             "Grow new gen when less than this percentage is garbage.");
 DEFINE_FLAG(int, new_gen_growth_factor, 2, "Grow new gen by this factor.");
+DEFINE_FLAG(bool,
+            pretenure_classes,
+            false,
+            "Allocate instances of classes that survive scavenges directly in "
+            "old space. Survival is tracked per class, the allocation stub "
+            "being the only allocation site shared by all callers.");
+DEFINE_FLAG(int,
+            pretenure_threshold,
+            85,
+            "Pretenure a class when more than this percentage of its objects "
+            "survive their first scavenge, and stop when fewer do.");
+DEFINE_FLAG(int,
+            pretenure_sample_interval,
+            2,
+            "While a class is pretenured, allocate one in this many of the "
+            "objects its allocation stub cannot bump allocate in old space "
+            "in new space instead, to keep measuring their survival.");
+DEFINE_FLAG(bool, trace_pretenuring, false, "Trace pretenuring decisions.");
+
+// Smaller arrays are cheap enough to rescan in full from the store buffer.
+static constexpr intptr_t kMinPromotedCardArrayLength = 8 * Page::kSlotsPerCard;
 
 // Scavenger uses the kCardRememberedBit to distinguish forwarded and
 // non-forwarded objects. We must choose a bit that is clear for all new-space
@@ -484,6 +505,10 @@ class ScavengerVisitor : public ObjectPointerVisitor,
         uword tags = static_cast<uword>(header);
         tags = UntaggedObject::OldAndNotRememberedBit::update(true, tags);
         tags = UntaggedObject::NewOrEvacuationCandidateBit::update(false, tags);
+        if (UNLIKELY(FLAG_card_mark_promoted_arrays) &&
+            ShouldCardRemember(header, size, new_addr)) {
+          tags = UntaggedObject::CardRememberedBit::update(true, tags);
+        }
         new_obj->untag()->tags_.store(tags, std::memory_order_relaxed);
       }
 
@@ -500,6 +525,10 @@ class ScavengerVisitor : public ObjectPointerVisitor,
           // be traversed later.
           promoted_list_.Push(new_obj);
           bytes_promoted_ += size;
+          if (new_obj->untag()->IsCardRemembered()) {
+            page_space_->AddPromotedCardRememberedArray(
+                static_cast<ArrayPtr>(new_obj));
+          }
         }
       } else {
         ASSERT(IsForwarding(header));
@@ -520,6 +549,16 @@ class ScavengerVisitor : public ObjectPointerVisitor,
     return new_obj;
   }
 
+  // Whether a promoted array is large enough to have its dirty cards rescanned
+  // instead of the whole array being added to the store buffer.
+  static bool ShouldCardRemember(uword header, intptr_t size, uword new_addr) {
+    intptr_t cid = UntaggedObject::ClassIdTag::decode(header);
+    if ((cid != kArrayCid) && (cid != kImmutableArrayCid)) return false;
+    if (size < Array::InstanceSize(kMinPromotedCardArrayLength)) return false;
+    Page* page = Page::Of(new_addr);
+    return page->has_card_table() && !page->is_evacuation_candidate();
+  }
+
   DART_FORCE_INLINE
   bool InstallForwardingPointer(uword addr,
                                 uword* old_header,
@@ -1299,8 +1338,16 @@ void ScavengerVisitor::ProcessToSpace() {
 void ScavengerVisitor::ProcessPromotedList() {
   ObjectPtr obj;
   while (promoted_list_.Pop(&obj)) {
-    VisitingOldObject(obj);
-    ProcessObject(obj);
+    if (UNLIKELY(obj->untag()->IsCardRemembered())) {
+      // Dirty the cards holding new-space targets instead of adding the array
+      // to the store buffer.
+      VisitingOldObject(nullptr);
+      Page::Of(obj)->VisitRememberedCards(static_cast<ArrayPtr>(obj), this,
+                                          /*all_cards=*/true);
+    } else {
+      VisitingOldObject(obj);
+      ProcessObject(obj);
+    }
     // Black allocation.
     if (thread_->is_marking() && obj->untag()->TryAcquireMarkBit()) {
       thread_->MarkingStackAddObject(obj);
@@ -1330,6 +1377,121 @@ void ScavengerVisitor::ProcessWeakPropertiesScoped() {
   });
 }
 
+// Don't pretenure on the basis of only a handful of objects.
+static constexpr intptr_t kMinPretenureSampleInWords = 16 * KBInWords;
+// Pretenured classes are only sampled when their allocation stub falls back
+// to the runtime, roughly once per old-space allocation buffer.
+static constexpr intptr_t kMinPretenuredSamples = 64;
+
+void Scavenger::RecordPretenureFeedback(SemiSpace* from) {
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "PretenureFeedback");
+  ClassTable* class_table = heap_->isolate_group()->class_table();
+  const intptr_t num_cids = class_table->NumCids();
+  while (pretenure_feedback_.length() < num_cids) {
+    pretenure_feedback_.Add(PretenureFeedback());
+  }
+
+  // The from-space still holds the dead objects and the forwarding headers of
+  // the survivors, so walking it gives both halves of the survival rate.
+  for (Page* page = from->head(); page != nullptr; page = page->next()) {
+    uword addr = page->object_start();
+    const uword end = page->object_end();
+    while (addr < end) {
+      ObjectPtr obj = UntaggedObject::FromAddr(addr);
+      uword header = ReadHeaderRelaxed(obj);
+      intptr_t cid;
+      intptr_t size;
+      bool survived = IsForwarding(header);
+      if (survived) {
+        ObjectPtr target = ForwardedObj(header);
+        cid = target->GetClassIdOfHeapObject();
+        size = target->untag()->HeapSize();
+      } else {
+        cid = UntaggedObject::ClassIdTag::decode(header);
+        size = obj->untag()->HeapSize(header);
+      }
+      // Only objects allocated since the previous scavenge sample their site.
+      if ((cid >= kNumPredefinedCids) && (cid < num_cids) &&
+          !page->IsSurvivor(addr)) {
+        PretenureFeedback& feedback = pretenure_feedback_[cid];
+        feedback.allocated_objects++;
+        feedback.allocated_in_words += size >> kWordSizeLog2;
+        if (survived) {
+          feedback.survived_in_words += size >> kWordSizeLog2;
+        }
+      }
+      addr += size;
+    }
+  }
+
+  bool changed = false;
+  MutexLocker ml(&pretenure_lock_);
+  for (intptr_t cid = kNumPredefinedCids; cid < num_cids; cid++) {
+    PretenureFeedback& feedback = pretenure_feedback_[cid];
+    const bool pretenured = class_table->ShouldPretenure(cid);
+    // Pretenured classes are measured on the objects that are still
+    // allocated in new space as samples, see ShouldSamplePretenuredClass.
+    const bool enough_samples =
+        pretenured
+            ? (feedback.allocated_objects >= kMinPretenuredSamples)
+            : (feedback.allocated_in_words >= kMinPretenureSampleInWords);
+    if (!enough_samples) {
+      continue;
+    }
+    const intptr_t survived = feedback.survived_in_words * 100;
+    const intptr_t threshold =
+        feedback.allocated_in_words * FLAG_pretenure_threshold;
+    if (pretenured ? (survived >= threshold) : (survived <= threshold)) {
+      feedback = PretenureFeedback();
+      continue;
+    }
+    class_table->SetPretenure(cid, !pretenured);
+    if (FLAG_trace_pretenuring) {
+      OS::PrintErr("%s cid %" Pd " (%" Pd " of %" Pd " words survived)\n",
+                   pretenured ? "No longer pretenuring" : "Pretenuring", cid,
+                   feedback.survived_in_words, feedback.allocated_in_words);
+    }
+    feedback = PretenureFeedback();
+    pending_pretenure_updates_.Add(cid);
+    changed = true;
+  }
+  if (changed) {
+    has_pending_pretenure_updates_ = true;
+    // Have the stubs replaced at the next interrupt check instead of waiting
+    // for one of them to reach the runtime.
+    Thread::Current()->ScheduleInterrupts(Thread::kVMInterrupt);
+  }
+}
+
+bool Scavenger::ShouldSamplePretenuredClass() {
+  const intptr_t interval = FLAG_pretenure_sample_interval;
+  return (interval > 0) && (((pretenure_samples_ += 1) % interval) == 0);
+}
+
+void Scavenger::UpdatePretenuredAllocationStubs(Thread* thread) {
+  MallocGrowableArray<intptr_t> cids;
+  {
+    MutexLocker ml(&pretenure_lock_);
+    for (intptr_t i = 0; i < pending_pretenure_updates_.length(); i++) {
+      cids.Add(pending_pretenure_updates_[i]);
+    }
+    pending_pretenure_updates_.Clear();
+    has_pending_pretenure_updates_ = false;
+  }
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  // The stub of a pretenured class bump allocates in old space. Stubs are
+  // regenerated lazily on their next call.
+  ClassTable* class_table = thread->isolate_group()->class_table();
+  Class& cls = Class::Handle(thread->zone());
+  for (intptr_t i = 0; i < cids.length(); i++) {
+    cls = class_table->At(cids[i]);
+    if (!cls.IsNull()) {
+      cls.DisableAllocationStub();
+    }
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+}
+
 void Scavenger::UpdateMaxHeapCapacity() {
   ASSERT(to_ != nullptr);
   ASSERT(heap_ != nullptr);
@@ -1902,10 +2064,15 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   }
   delete[] visitors;
 
+  heap_->old_space()->AcceptPromotedCardRememberedArrays(abort_);
+
   if (abort_) {
     ReverseScavenge(&from);
     bytes_promoted = 0;
   } else {
+    if (FLAG_pretenure_classes) {
+      RecordPretenureFeedback(from);
+    }
     if ((ThresholdInWords() - UsedInWords()) < 32 * KBInWords) {
       // Don't scavenge again until the next old-space GC has occurred. Prevents
       // performing one scavenge per allocation as the heap limit is approached.
@@ -1985,6 +2152,9 @@ void Scavenger::ReverseScavenge(SemiSpace** from) {
             UntaggedObject::OldAndNotRememberedBit::update(false, from_header);
         from_header = UntaggedObject::NewOrEvacuationCandidateBit::update(
             true, from_header);
+        // Aliases the forwarding mask in new-space.
+        from_header =
+            UntaggedObject::CardRememberedBit::update(false, from_header);
 
         WriteHeaderRelaxed(from_obj, from_header);
 
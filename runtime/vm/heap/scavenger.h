@@ -11,6 +11,7 @@
 #include "vm/dart.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
+#include "vm/growable_array.h"
 #include "vm/heap/page.h"
 #include "vm/heap/spaces.h"
 #include "vm/isolate.h"
@@ -247,6 +248,19 @@ class Scavenger {
   intptr_t NumScavengeWorkers();
   static intptr_t NumDataFreelists();
 
+  // Pretenuring is decided per class, not per allocation site. Scavenges
+  // sample the survival rate of each class and pretenure the classes whose
+  // objects mostly survive; the allocation stubs of the affected classes are
+  // regenerated by the next mutator to call UpdatePretenuredAllocationStubs,
+  // from its next interrupt check or AllocateObject runtime call.
+  bool HasPendingPretenureUpdates() const {
+    return has_pending_pretenure_updates_.load();
+  }
+  void UpdatePretenuredAllocationStubs(Thread* thread);
+  // Whether an instance of a pretenured class should still be allocated in
+  // new space, so that its survival keeps being measured.
+  bool ShouldSamplePretenuredClass();
+
  private:
   // Ids for time and data records in Heap::GCStats.
   enum {
@@ -289,6 +303,8 @@ class Scavenger {
 
   void VerifyStoreBuffers(const char* msg);
 
+  void RecordPretenureFeedback(SemiSpace* from);
+
   void UpdateMaxHeapCapacity();
   void UpdateMaxHeapUsage();
 
@@ -327,6 +343,19 @@ class Scavenger {
   // Protects new space during the allocation of new TLABs
   mutable Mutex space_lock_;
 
+  struct PretenureFeedback {
+    intptr_t allocated_objects = 0;
+    intptr_t allocated_in_words = 0;
+    intptr_t survived_in_words = 0;
+  };
+  // Indexed by cid. Only accessed at a GC safepoint.
+  MallocGrowableArray<PretenureFeedback> pretenure_feedback_;
+  // Cids whose pretenuring decision changed since their stubs were generated.
+  Mutex pretenure_lock_;
+  MallocGrowableArray<intptr_t> pending_pretenure_updates_;
+  RelaxedAtomic<bool> has_pending_pretenure_updates_ = {false};
+  RelaxedAtomic<intptr_t> pretenure_samples_ = {0};
+
   friend class ScavengerVisitor;
 
   DISALLOW_COPY_AND_ASSIGN(Scavenger);
@@ -56,6 +56,7 @@
 #include "vm/visitor.h"
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/stub_code_compiler.h"
 #endif
@@ -76,6 +77,10 @@ DECLARE_FLAG(bool, reload_every_back_off);
 DECLARE_FLAG(bool, trace_reload);
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+DECLARE_FLAG(charp, write_aot_profile_to);
+#endif
+
 static void DeterministicModeHandler(bool value) {
   if (value) {
     FLAG_background_compilation = false;  // Timing dependent.
@@ -715,17 +720,9 @@ void IsolateGroup::PrintToJSONObject(JSONObject* jsobj, bool ref) {
 }
 
 void IsolateGroup::PrintMemoryUsageJSON(JSONStream* stream) {
-  int64_t used = heap()->TotalUsedInWords();
-  int64_t capacity = heap()->TotalCapacityInWords();
-  int64_t external_used = heap()->TotalExternalInWords();
-
-  JSONObject jsobj(stream);
   // This is the same "MemoryUsage" that the isolate-specific "getMemoryUsage"
   // rpc method returns.
-  jsobj.AddProperty("type", "MemoryUsage");
-  jsobj.AddProperty64("heapUsage", used * kWordSize);
-  jsobj.AddProperty64("heapCapacity", capacity * kWordSize);
-  jsobj.AddProperty64("externalUsage", external_used * kWordSize);
+  heap()->PrintMemoryUsageJSON(stream);
 }
 #endif
 
@@ -2192,6 +2189,20 @@ void IsolateGroup::DeleteReloadContext() {
   delete program_reload_context_;
   program_reload_context_ = nullptr;
 }
+
+void IsolateGroup::SetHasSharedImmutableInstances(intptr_t cid) {
+  MutexLocker ml(&shared_immutable_instances_mutex_);
+  while (has_shared_immutable_instances_.length() <= cid) {
+    has_shared_immutable_instances_.Add(false);
+  }
+  has_shared_immutable_instances_[cid] = true;
+}
+
+bool IsolateGroup::HasSharedImmutableInstances(intptr_t cid) {
+  MutexLocker ml(&shared_immutable_instances_mutex_);
+  return (cid < has_shared_immutable_instances_.length()) &&
+         has_shared_immutable_instances_[cid];
+}
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
 const char* Isolate::MakeRunnable() {
@@ -2702,6 +2713,17 @@ void Isolate::LowLevelCleanup(Isolate* isolate) {
                                         /*bypass_safepoint=*/false);
 #if !defined(DART_PRECOMPILED_RUNTIME)
       BackgroundCompiler::Stop(isolate_group);
+
+      // The profile covers all isolates of the group, so it is written once
+      // the last of them has exited and no compilation is running anymore.
+      if ((FLAG_write_aot_profile_to != nullptr) &&
+          isolate_group->initial_spawn_successful() &&
+          !IsolateGroup::IsSystemIsolateGroup(isolate_group)) {
+        Thread* thread = Thread::Current();
+        StackZone zone(thread);
+        HandleScope handle_scope(thread);
+        AotProfile::Write(thread, FLAG_write_aot_profile_to);
+      }
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
       // Finalize any weak persistent handles with a non-null referent with
@@ -3247,6 +3269,7 @@ void Isolate::PrintJSON(JSONStream* stream, bool ref) {
 
   jsobj.AddProperty("runnable", is_runnable());
   jsobj.AddProperty("livePorts", open_ports_keepalive_);
+  message_handler()->PrintMessageMetricsJSON(&jsobj);
   jsobj.AddProperty("pauseOnExit", message_handler()->should_pause_on_exit());
 #if !defined(DART_PRECOMPILED_RUNTIME)
   jsobj.AddProperty("_isReloading", group()->IsReloading());
@@ -707,6 +707,12 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
 
   void DeleteReloadContext();
   bool CanReload();
+
+  // Records that instances of the class [cid] were proven deeply immutable
+  // and are shared between isolates (see object_graph_copy.cc). Reload
+  // rejects changes to the layout or the finality of their fields.
+  void SetHasSharedImmutableInstances(intptr_t cid);
+  bool HasSharedImmutableInstances(intptr_t cid);
 #else
   bool CanReload() { return false; }
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
@@ -928,6 +934,8 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   // Per-isolate-group copy of FLAG_reload_every.
   RelaxedAtomic<intptr_t> reload_every_n_stack_overflow_checks_;
   ProgramReloadContext* program_reload_context_ = nullptr;
+  Mutex shared_immutable_instances_mutex_;
+  MallocGrowableArray<bool> has_shared_immutable_instances_;
 #endif
   Become* become_ = nullptr;
 
@@ -4578,6 +4578,101 @@ TEST_CASE(IsolateReload_DeeplyImmutableChange_TypeBound) {
   }
 }
 
+DECLARE_FLAG(bool, promote_immutable_objects);
+
+// Instances of A are proven deeply immutable when they are sent, and are
+// shared with the receiver from then on.
+static const char* kSharedImmutableInstancesScript = R"(
+  import 'dart:isolate';
+
+  class A {
+    final int x;
+    A(this.x);
+  }
+  String main() {
+    final port = RawReceivePort();
+    port.sendPort.send(A(123));
+    port.close();
+    return 'okay';
+  }
+)";
+
+TEST_CASE(IsolateReload_SharedImmutableInstancesBecomeMutable) {
+  SetFlagScope<bool> sfs(&FLAG_promote_immutable_objects, true);
+  Dart_Handle lib =
+      TestCase::LoadTestScript(kSharedImmutableInstancesScript, nullptr);
+  EXPECT_VALID(lib);
+  EXPECT_STREQ("okay", SimpleInvokeStr(lib, "main"));
+
+  const char* kReloadScript = R"(
+    import 'dart:isolate';
+
+    class A {
+      int x;
+      A(this.x);
+    }
+    String main() {
+      return 'okay';
+    }
+  )";
+
+  lib = TestCase::ReloadTestScript(kReloadScript);
+  EXPECT_ERROR(lib,
+               "Instances of Library:'file:///test-lib' Class: A are shared "
+               "between isolates as deeply immutable");
+}
+
+TEST_CASE(IsolateReload_SharedImmutableInstancesAddField) {
+  SetFlagScope<bool> sfs(&FLAG_promote_immutable_objects, true);
+  Dart_Handle lib =
+      TestCase::LoadTestScript(kSharedImmutableInstancesScript, nullptr);
+  EXPECT_VALID(lib);
+  EXPECT_STREQ("okay", SimpleInvokeStr(lib, "main"));
+
+  const char* kReloadScript = R"(
+    import 'dart:isolate';
+
+    class A {
+      final int x;
+      final int y = 0;
+      A(this.x);
+    }
+    String main() {
+      return 'okay';
+    }
+  )";
+
+  lib = TestCase::ReloadTestScript(kReloadScript);
+  EXPECT_ERROR(lib,
+               "Instances of Library:'file:///test-lib' Class: A are shared "
+               "between isolates as deeply immutable");
+}
+
+TEST_CASE(IsolateReload_SharedImmutableInstancesNewMethod) {
+  SetFlagScope<bool> sfs(&FLAG_promote_immutable_objects, true);
+  Dart_Handle lib =
+      TestCase::LoadTestScript(kSharedImmutableInstancesScript, nullptr);
+  EXPECT_VALID(lib);
+  EXPECT_STREQ("okay", SimpleInvokeStr(lib, "main"));
+
+  const char* kReloadScript = R"(
+    import 'dart:isolate';
+
+    class A {
+      final int x;
+      A(this.x);
+      int get twice => 2 * x;
+    }
+    String main() {
+      return 'still ${A(1).twice}';
+    }
+  )";
+
+  lib = TestCase::ReloadTestScript(kReloadScript);
+  EXPECT_VALID(lib);
+  EXPECT_STREQ("still 2", SimpleInvokeStr(lib, "main"));
+}
+
 TEST_CASE(IsolateReload_ConstToNonConstClass) {
   const char* kScript = R"(
     class A {
@@ -84,10 +84,7 @@ const char* Message::PriorityAsString(Priority priority) {
   }
 }
 
-MessageQueue::MessageQueue() {
-  head_ = nullptr;
-  tail_ = nullptr;
-}
+MessageQueue::MessageQueue() : head_(nullptr), tail_(nullptr), inbox_() {}
 
 MessageQueue::~MessageQueue() {
   // Ensure that all pending messages have been released.
@@ -101,45 +98,88 @@ void MessageQueue::Enqueue(std::unique_ptr<Message> msg0, bool before_events) {
 
   // Make sure messages are not reused.
   ASSERT(msg->next_ == nullptr);
+
+  if (!before_events) {
+    // Push onto the inbox, the consumer restores FIFO order when it takes
+    // the inbox.
+    Message* inbox = inbox_.load(std::memory_order_relaxed);
+    do {
+      msg->next_ = inbox;
+    } while (!inbox_.compare_exchange_weak(inbox, msg,
+                                           std::memory_order_seq_cst,
+                                           std::memory_order_relaxed));
+    IncrementPending();
+    return;
+  }
+
+  // Messages in the inbox are pending events as well, this message has to be
+  // placed before them.
+  TakeInbox();
+  IncrementPending();
+  ASSERT(msg->dest_port() == Message::kIllegalPort);
   if (head_ == nullptr) {
     // Only element in the queue.
     ASSERT(tail_ == nullptr);
     head_ = msg;
     tail_ = msg;
+  } else if (head_->dest_port() != Message::kIllegalPort) {
+    msg->next_ = head_;
+    head_ = msg;
   } else {
-    ASSERT(tail_ != nullptr);
-    if (!before_events) {
-      // Append at the tail.
-      tail_->next_ = msg;
-      tail_ = msg;
-    } else {
-      ASSERT(msg->dest_port() == Message::kIllegalPort);
-      if (head_->dest_port() != Message::kIllegalPort) {
-        msg->next_ = head_;
-        head_ = msg;
-      } else {
-        Message* cur = head_;
-        while (cur->next_ != nullptr) {
-          if (cur->next_->dest_port() != Message::kIllegalPort) {
-            // Splice in the new message at the break.
-            msg->next_ = cur->next_;
-            cur->next_ = msg;
-            return;
-          }
-          cur = cur->next_;
-        }
-        // All pending messages are isolate library control messages. Append at
-        // the tail.
-        ASSERT(tail_ == cur);
-        ASSERT(tail_->dest_port() == Message::kIllegalPort);
-        tail_->next_ = msg;
-        tail_ = msg;
+    Message* cur = head_;
+    while (cur->next_ != nullptr) {
+      if (cur->next_->dest_port() != Message::kIllegalPort) {
+        // Splice in the new message at the break.
+        msg->next_ = cur->next_;
+        cur->next_ = msg;
+        return;
       }
+      cur = cur->next_;
     }
+    // All pending messages are isolate library control messages. Append at
+    // the tail.
+    ASSERT(tail_ == cur);
+    ASSERT(tail_->dest_port() == Message::kIllegalPort);
+    tail_->next_ = msg;
+    tail_ = msg;
+  }
+}
+
+void MessageQueue::IncrementPending() {
+  const intptr_t pending = pending_.fetch_add(1) + 1;
+  intptr_t high_water_mark = high_water_mark_.load();
+  while (pending > high_water_mark &&
+         !high_water_mark_.compare_exchange_weak(high_water_mark, pending)) {
   }
 }
 
+void MessageQueue::TakeInbox() const {
+  Message* inbox = inbox_.exchange(nullptr, std::memory_order_seq_cst);
+  if (inbox == nullptr) {
+    return;
+  }
+  // Reverse the inbox to get the messages in the order they were posted.
+  Message* first = nullptr;
+  Message* last = inbox;
+  while (inbox != nullptr) {
+    Message* next = inbox->next_;
+    inbox->next_ = first;
+    first = inbox;
+    inbox = next;
+  }
+  if (head_ == nullptr) {
+    ASSERT(tail_ == nullptr);
+    head_ = first;
+  } else {
+    tail_->next_ = first;
+  }
+  tail_ = last;
+}
+
 std::unique_ptr<Message> MessageQueue::Dequeue() {
+  if (head_ == nullptr) {
+    TakeInbox();
+  }
   Message* result = head_;
   if (result != nullptr) {
     head_ = result->next_;
@@ -147,6 +187,7 @@ std::unique_ptr<Message> MessageQueue::Dequeue() {
     if (head_ == nullptr) {
       tail_ = nullptr;
     }
+    pending_.fetch_sub(1);
 #if defined(DEBUG)
     result->next_ = result;  // Make sure to trigger ASSERT in Enqueue.
 #endif                       // DEBUG
@@ -156,12 +197,14 @@ std::unique_ptr<Message> MessageQueue::Dequeue() {
 }
 
 void MessageQueue::Clear() {
+  TakeInbox();
   std::unique_ptr<Message> cur(head_);
   head_ = nullptr;
   tail_ = nullptr;
   while (cur != nullptr) {
     std::unique_ptr<Message> next(cur->next_);
     cur = std::move(next);
+    pending_.fetch_sub(1);
   }
 }
 
@@ -173,6 +216,7 @@ MessageQueue::Iterator::~Iterator() {}
 
 void MessageQueue::Iterator::Reset(const MessageQueue* queue) {
   ASSERT(queue != nullptr);
+  queue->TakeInbox();
   next_ = queue->head_;
 }
 
@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 #include "vm/finalizable_data.h"
 #include "vm/globals.h"
@@ -156,18 +157,29 @@ class Message {
 };
 
 // There is a message queue per isolate.
+//
+// Messages appended at the tail (see Enqueue) are pushed onto a lock-free
+// inbox and can be posted by any number of threads concurrently with each
+// other and with the consumer. All other operations must only be performed by
+// a single consumer at a time (e.g. while holding the MessageHandler monitor);
+// they first move all messages from the inbox to the queue in one batch.
 class MessageQueue {
  public:
   MessageQueue();
   ~MessageQueue();
 
+  // Appends |msg| at the tail of the queue, or before any pending events if
+  // |before_events| is true. Only the latter requires exclusive access.
   void Enqueue(std::unique_ptr<Message> msg, bool before_events);
 
   // Gets the next message from the message queue or nullptr if no
   // message is available.  This function will not block.
   std::unique_ptr<Message> Dequeue();
 
-  bool IsEmpty() { return head_ == nullptr; }
+  bool IsEmpty() const {
+    return head_ == nullptr &&
+           inbox_.load(std::memory_order_seq_cst) == nullptr;
+  }
 
   // Clear all messages from the message queue.
   void Clear();
@@ -192,14 +204,33 @@ class MessageQueue {
 
   intptr_t Length() const;
 
+  // The largest number of messages that were pending at the same time.
+  intptr_t high_water_mark() const { return high_water_mark_.load(); }
+
   // Returns the message with id or nullptr.
   Message* FindMessageById(intptr_t id);
 
   void PrintJSON(JSONStream* stream);
 
  private:
-  Message* head_;
-  Message* tail_;
+  // Moves the messages of the inbox to the tail of the queue. Logically const
+  // since it does not change the sequence of pending messages.
+  void TakeInbox() const;
+
+  // Counts a newly pushed message and raises the high-water mark if needed.
+  // Called from every push site.
+  void IncrementPending();
+
+  mutable Message* head_;
+  mutable Message* tail_;
+
+  // Messages enqueued at the tail and not yet moved to the queue, in reverse
+  // order.
+  mutable std::atomic<Message*> inbox_;
+
+  // Number of pending messages, including those in the inbox.
+  RelaxedAtomic<intptr_t> pending_ = {0};
+  RelaxedAtomic<intptr_t> high_water_mark_ = {0};
 
   DISALLOW_COPY_AND_ASSIGN(MessageQueue);
 };
@@ -121,9 +121,33 @@ bool MessageHandler::Run(ThreadPool* pool,
 
 void MessageHandler::PostMessage(std::unique_ptr<Message> message,
                                  bool before_events) {
-  Message::Priority saved_priority;
-
-  {
+  Message::Priority saved_priority = message->priority();
+  messages_posted_.fetch_add(1);
+
+  // Fast path: a normal message appended to the queue of a handler whose
+  // task is running does not need the monitor, the running task will pick it
+  // up. The task rechecks the queue after clearing task_running_ and
+  // PauseAndHandleAllMessages after setting paused_for_messages_, so either
+  // they see the message or we see the updated flag (all accesses are
+  // sequentially consistent).
+  if (!message->IsOOB() && !before_events && !FLAG_trace_isolates) {
+    queue_->Enqueue(std::move(message), /*before_events=*/false);
+    if (task_running_ && !paused_for_messages_) {
+      MessageNotify(saved_priority);
+      return;
+    }
+    MonitorLocker ml(&monitor_);
+    if (paused_for_messages_) {
+      wakeups_.fetch_add(1);
+      ml.Notify();
+    }
+    if (pool_ != nullptr && !task_running_) {
+      wakeups_.fetch_add(1);
+      task_running_ = true;
+      const bool launched_successfully = pool_->Run<MessageHandlerTask>(this);
+      ASSERT(launched_successfully);
+    }
+  } else {
     MonitorLocker ml(&monitor_);
     if (FLAG_trace_isolates) {
       Isolate* source_isolate = Isolate::Current();
@@ -146,17 +170,18 @@ void MessageHandler::PostMessage(std::unique_ptr<Message> message,
       }
     }
 
-    saved_priority = message->priority();
     if (message->IsOOB()) {
       oob_queue_->Enqueue(std::move(message), before_events);
     } else {
       queue_->Enqueue(std::move(message), before_events);
     }
     if (paused_for_messages_) {
+      wakeups_.fetch_add(1);
       ml.Notify();
     }
 
     if (pool_ != nullptr && !task_running_) {
+      wakeups_.fetch_add(1);
       task_running_ = true;
       const bool launched_successfully = pool_->Run<MessageHandlerTask>(this);
       ASSERT(launched_successfully);
@@ -496,6 +521,15 @@ void MessageHandler::TaskCallback() {
     // for this message handler.
     ASSERT(oob_queue_->IsEmpty());
     task_running_ = false;
+
+    // A normal message may have been posted without the monitor after we
+    // last looked at the queue but before task_running_ was cleared. Its
+    // poster did not schedule a task, so we have to.
+    if ((pool_ != nullptr) && !paused() && !queue_->IsEmpty()) {
+      task_running_ = true;
+      const bool launched_successfully = pool_->Run<MessageHandlerTask>(this);
+      ASSERT(launched_successfully);
+    }
   }
 
   // The handler may have been deleted by another thread here if it is a native
@@ -599,6 +633,14 @@ void MessageHandler::PausedOnExitLocked(MonitorLocker* ml, bool paused) {
 }
 #endif  // !defined(PRODUCT)
 
+#if !defined(PRODUCT)
+void MessageHandler::PrintMessageMetricsJSON(JSONObject* jsobj) const {
+  jsobj->AddProperty64("_messagesPosted", messages_posted());
+  jsobj->AddProperty64("_messageWakeups", wakeups());
+  jsobj->AddProperty("_messageQueueHighWaterMark", queue_high_water_mark());
+}
+#endif  // !defined(PRODUCT)
+
 MessageHandler::AcquiredQueues::AcquiredQueues(MessageHandler* handler)
     : handler_(handler), ml_(&handler->monitor_) {
   ASSERT(handler != nullptr);
@@ -82,6 +82,23 @@ class MessageHandler : public PortHandler {
   // handler.
   bool HasMessages();
 
+  // Number of messages posted to this handler.
+  uint64_t messages_posted() const { return messages_posted_.load(); }
+
+  // Number of times posting a message had to schedule a task or wake up a
+  // thread waiting for messages. Messages posted while the handler is
+  // already running are picked up by it without a wakeup.
+  uint64_t wakeups() const { return wakeups_.load(); }
+
+  // The largest number of normal messages that were pending at once.
+  intptr_t queue_high_water_mark() const {
+    return queue_->high_water_mark();
+  }
+
+#if !defined(PRODUCT)
+  void PrintMessageMetricsJSON(JSONObject* jsobj) const;
+#endif
+
   // Whether to keep this message handler alive or whether it should shutdown.
   virtual bool KeepAliveLocked() { return true; }
 
@@ -233,12 +250,16 @@ class MessageHandler : public PortHandler {
                                bool allow_multiple_normal_messages);
 
   Monitor monitor_;  // Protects all fields in MessageHandler.
+  // Normal messages may be appended to queue_ without holding the monitor,
+  // see PostMessage.
   MessageQueue* queue_;
   MessageQueue* oob_queue_;
   // This flag is not thread safe and can only reliably be accessed on a single
   // thread.
   bool oob_message_handling_allowed_;
-  bool paused_for_messages_;
+  // Only written while holding the monitor, but read without it when posting
+  // normal messages.
+  std::atomic<bool> paused_for_messages_;
 
   // Only accessed by [PortMap], protected by [PortMap]s lock. See ports()
   // getter.
@@ -255,12 +276,17 @@ class MessageHandler : public PortHandler {
   MessageStatus remembered_paused_on_exit_status_;
   int64_t paused_timestamp_;
 #endif
-  bool task_running_;
+  // Only written while holding the monitor, but read without it when posting
+  // normal messages.
+  std::atomic<bool> task_running_;
   ThreadPool* pool_;
   StartCallback start_callback_;
   EndCallback end_callback_;
   CallbackData callback_data_;
 
+  RelaxedAtomic<uint64_t> messages_posted_ = {0};
+  RelaxedAtomic<uint64_t> wakeups_ = {0};
+
   DISALLOW_COPY_AND_ASSIGN(MessageHandler);
 };
 
@@ -4,6 +4,9 @@
 
 #include "vm/message.h"
 #include "platform/assert.h"
+#include "vm/lockers.h"
+#include "vm/os.h"
+#include "vm/os_thread.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -96,6 +99,8 @@ TEST_CASE(MessageQueue_BasicOperations) {
                      nullptr, Message::kNormalPriority);
   queue.Enqueue(std::move(msg), true);
   EXPECT(!queue.IsEmpty());
+  // Messages posted before events count towards the high-water mark too.
+  EXPECT_EQ(4, queue.high_water_mark());
 
   msg = queue.Dequeue();
   EXPECT(msg != nullptr);
@@ -140,4 +145,70 @@ TEST_CASE(MessageQueue_Clear) {
   EXPECT(queue.IsEmpty());
 }
 
+struct MessageQueueProducerArguments {
+  MessageQueue* queue;
+  Dart_Port port;
+  intptr_t count;
+  Monitor* monitor;
+  ThreadJoinId join_id;
+};
+
+static void EnqueueMessages(uword arguments_ptr) {
+  MessageQueueProducerArguments* arguments =
+      reinterpret_cast<MessageQueueProducerArguments*>(arguments_ptr);
+  for (intptr_t i = 0; i < arguments->count; i++) {
+    arguments->queue->Enqueue(
+        Message::New(arguments->port, Smi::New(i), Message::kNormalPriority),
+        false);
+  }
+  MonitorLocker ml(arguments->monitor);
+  arguments->join_id = OSThread::GetCurrentThreadJoinId(OSThread::Current());
+  ml.Notify();
+}
+
+TEST_CASE(MessageQueue_ConcurrentEnqueue) {
+  const intptr_t kNumProducers = 4;
+  const intptr_t kMessagesPerProducer = 1000;
+  MessageQueue queue;
+  Monitor monitor;
+  MessageQueueProducerArguments arguments[kNumProducers];
+  for (intptr_t i = 0; i < kNumProducers; i++) {
+    arguments[i] = {&queue, i + 1, kMessagesPerProducer, &monitor,
+                    OSThread::kInvalidThreadJoinId};
+    OSThread::Start("MessageQueueProducer", EnqueueMessages,
+                    reinterpret_cast<uword>(&arguments[i]));
+  }
+
+  // Consume concurrently with the producers. Messages from a single producer
+  // must be dequeued in the order they were enqueued.
+  intptr_t next[kNumProducers] = {};
+  intptr_t received = 0;
+  while (received < kNumProducers * kMessagesPerProducer) {
+    std::unique_ptr<Message> msg = queue.Dequeue();
+    if (msg == nullptr) {
+      OS::Sleep(1);
+      continue;
+    }
+    const intptr_t producer = msg->dest_port() - 1;
+    EXPECT_EQ(next[producer], Smi::Value(Smi::RawCast(msg->raw_obj())));
+    next[producer]++;
+    received++;
+  }
+  EXPECT(queue.IsEmpty());
+  EXPECT(queue.high_water_mark() >= 1);
+  EXPECT(queue.high_water_mark() <= kNumProducers * kMessagesPerProducer);
+
+  for (intptr_t i = 0; i < kNumProducers; i++) {
+    ThreadJoinId join_id;
+    {
+      MonitorLocker ml(&monitor);
+      while (arguments[i].join_id == OSThread::kInvalidThreadJoinId) {
+        ml.Wait();
+      }
+      join_id = arguments[i].join_id;
+    }
+    OSThread::Join(join_id);
+  }
+}
+
 }  // namespace dart
@@ -4,6 +4,7 @@
 
 #include "vm/metrics.h"
 
+#include "vm/compiler/jit/compiler.h"
 #include "vm/isolate.h"
 #include "vm/json_stream.h"
 #include "vm/log.h"
@@ -182,6 +183,22 @@ int64_t MetricHeapUsed::Value() const {
          isolate_group()->heap()->UsedInWords(Heap::kOld) * kWordSize;
 }
 
+int64_t MetricBackgroundCompilerQueueLength::Value() const {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  return 0;
+#else
+  return isolate_group()->background_compiler()->QueueLength();
+#endif
+}
+
+int64_t MetricBackgroundCompilerLatency::ValueAt(intptr_t percentile) const {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  return 0;
+#else
+  return isolate_group()->background_compiler()->LatencyPercentile(percentile);
+#endif
+}
+
 int64_t MetricIsolateCount::Value() const {
   return Isolate::IsolateListLength();
 }
@@ -41,7 +41,15 @@ class JSONStream;
   V(MaxMetric, HeapNewUsedMax, "heap.new.used.max", kByte)                     \
   V(MaxMetric, HeapNewCapacityMax, "heap.new.capacity.max", kByte)             \
   V(MetricHeapUsed, HeapGlobalUsed, "heap.global.used", kByte)                 \
-  V(MaxMetric, HeapGlobalUsedMax, "heap.global.used.max", kByte)
+  V(MaxMetric, HeapGlobalUsedMax, "heap.global.used.max", kByte)               \
+  V(MetricBackgroundCompilerQueueLength, BackgroundCompilerQueueLength,        \
+    "compiler.background.queue.length", kCounter)                              \
+  V(MetricBackgroundCompilerLatencyP50, BackgroundCompilerLatencyP50,          \
+    "compiler.background.latency.p50", kMicrosecond)                           \
+  V(MetricBackgroundCompilerLatencyP90, BackgroundCompilerLatencyP90,          \
+    "compiler.background.latency.p90", kMicrosecond)                           \
+  V(MetricBackgroundCompilerLatencyP99, BackgroundCompilerLatencyP99,          \
+    "compiler.background.latency.p99", kMicrosecond)
 
 // Metrics for each isolate.
 //
@@ -191,6 +199,36 @@ class MetricHeapUsed : public Metric {
   virtual int64_t Value() const;
 };
 
+class MetricBackgroundCompilerQueueLength : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+// Time from enqueuing a function for background compilation until its
+// optimized code is installed, over recent compilations.
+class MetricBackgroundCompilerLatency : public Metric {
+ protected:
+  int64_t ValueAt(intptr_t percentile) const;
+};
+
+class MetricBackgroundCompilerLatencyP50
+    : public MetricBackgroundCompilerLatency {
+ public:
+  virtual int64_t Value() const { return ValueAt(50); }
+};
+
+class MetricBackgroundCompilerLatencyP90
+    : public MetricBackgroundCompilerLatency {
+ public:
+  virtual int64_t Value() const { return ValueAt(90); }
+};
+
+class MetricBackgroundCompilerLatencyP99
+    : public MetricBackgroundCompilerLatency {
+ public:
+  virtual int64_t Value() const { return ValueAt(99); }
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_METRICS_H_
@@ -3282,6 +3282,11 @@ void Class::set_has_dynamically_extendable_subtypes(bool value) const {
       HasDynamicallyExtendableSubtypesBit::update(value, state_bits()));
 }
 
+void Class::set_has_only_final_instance_fields(bool value) const {
+  ASSERT(IsolateGroup::Current()->program_lock()->IsCurrentThreadWriter());
+  set_state_bits(HasOnlyFinalInstanceFieldsBit::update(value, state_bits()));
+}
+
 // Initialize class fields of type Array with empty array.
 void Class::InitEmptyFields() const {
   if (Object::empty_array().ptr() == Array::null()) {
@@ -11778,6 +11783,7 @@ int32_t Function::SourceFingerprint() const {
 void Function::SaveICDataMap(
     const ZoneGrowableArray<const ICData*>& deopt_id_to_ic_data,
     const Array& edge_counters_array,
+    const Array& edge_counter_deopt_ids_array,
     const Array& coverage_array) const {
 #if !defined(DART_PRECOMPILED_RUNTIME)
   // Already installed nothing to do.
@@ -11806,6 +11812,8 @@ void Function::SaveICDataMap(
     }
   }
   array.SetAt(ICDataArrayIndices::kEdgeCounters, edge_counters_array);
+  array.SetAt(ICDataArrayIndices::kEdgeCounterDeoptIds,
+              edge_counter_deopt_ids_array);
   // Preserve coverage_array which is stored early after graph construction.
   array.SetAt(ICDataArrayIndices::kCoverageData, coverage_array);
   set_ic_data_array(array);
@@ -2086,6 +2086,11 @@ class Class : public Object {
   bool CanReloadPreFinalized(const Class& replacement,
                              ProgramReloadContext* context) const;
 
+  // Tells whether instances which are shared between isolates as deeply
+  // immutable stay deeply immutable with the replacement: their layout must
+  // not change and all their fields must stay final and non-late.
+  bool CanReloadSharedImmutableInstances(const Class& replacement) const;
+
   // Tells whether instances need morphing for reload.
   bool RequiresInstanceMorphing(ClassTable* class_table,
                                 const Class& replacement) const;
@@ -2162,6 +2167,12 @@ class Class : public Object {
   // This class was loaded from bytecode at runtime.
   using IsDeclaredInBytecodeBit =
       BitField<uint32_t, bool, HasDynamicallyExtendableSubtypesBit::kNextBit>;
+  // All instance fields of this class and its superclasses are final and not
+  // late. Computed by the precompiler before it drops fields, so that the
+  // AOT runtime can tell which instances may be promoted to deeply immutable
+  // when they are sent in messages.
+  using HasOnlyFinalInstanceFieldsBit =
+      BitField<uint32_t, bool, IsDeclaredInBytecodeBit::kNextBit>;
 
   void set_name(const String& value) const;
   void set_user_name(const String& value) const;
@@ -2236,6 +2247,11 @@ class Class : public Object {
     return HasDynamicallyExtendableSubtypesBit::decode(state_bits());
   }
 
+  void set_has_only_final_instance_fields(bool value) const;
+  static bool HasOnlyFinalInstanceFields(ClassPtr clazz) {
+    return HasOnlyFinalInstanceFieldsBit::decode(clazz->untag()->state_bits_);
+  }
+
  private:
   void set_functions(const Array& value) const;
   void set_fields(const Array& value) const;
@@ -4145,6 +4161,7 @@ class Function : public Object {
   void SaveICDataMap(
       const ZoneGrowableArray<const ICData*>& deopt_id_to_ic_data,
       const Array& edge_counters_array,
+      const Array& edge_counter_deopt_ids_array,
       const Array& coverage_array) const;
   // Uses 'ic_data_array' to populate the table 'deopt_id_to_ic_data'. Clone
   // ic_data (array and descriptor) if 'clone_ic_data' is true.
@@ -4152,12 +4169,14 @@ class Function : public Object {
                         bool clone_ic_data) const;
 
   // ic_data_array attached to the function stores edge counters in the
-  // first element, coverage data array in the second element and the rest
-  // are ICData objects.
+  // first element, coverage data array in the second element, the deopt ids
+  // of the blocks counted by the edge counters in the third element (only
+  // when an AOT profile is recorded) and the rest are ICData objects.
   struct ICDataArrayIndices {
     static constexpr intptr_t kEdgeCounters = 0;
     static constexpr intptr_t kCoverageData = 1;
-    static constexpr intptr_t kFirstICData = 2;
+    static constexpr intptr_t kEdgeCounterDeoptIds = 2;
+    static constexpr intptr_t kFirstICData = 3;
   };
 
   ArrayPtr ic_data_array() const;
@@ -4,16 +4,22 @@
 
 #include "vm/object_graph_copy.h"
 
+#include <atomic>
 #include <memory>
 
+#include "vm/dart.h"
 #include "vm/dart_api_state.h"
 #include "vm/flags.h"
+#include "vm/hash_map.h"
 #include "vm/heap/weak_table.h"
+#include "vm/lockers.h"
 #include "vm/longjump.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
+#include "vm/os.h"
 #include "vm/snapshot.h"
 #include "vm/symbols.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 
 #define Z zone_
@@ -102,6 +108,29 @@ DEFINE_FLAG(bool,
             gc_on_foc_slow_path,
             false,
             "Cause a GC when falling off the fast path for fast object copy.");
+DEFINE_FLAG(int,
+            object_copy_tasks,
+            -1,
+            "The number of threads copying large typed data payloads of a "
+            "message (-1 = auto, 0 = serial).");
+DEFINE_FLAG(int,
+            parallel_object_copy_threshold,
+            2 * MB,
+            "Typed data payloads of at least this many bytes are copied by "
+            "multiple threads when sending messages.");
+DEFINE_FLAG(int,
+            share_unmodifiable_view_threshold,
+            64 * KB,
+            "An unmodifiable typed data view sent as a message whose backing "
+            "store has at least this many bytes is received backed by "
+            "immutable memory, which can be shared with other isolates of the "
+            "group without copying.");
+DEFINE_FLAG(bool,
+            promote_immutable_objects,
+            false,
+            "Share objects proven to be deeply immutable when sending messages "
+            "instead of copying them. Experimental: this changes the results "
+            "of identical() for objects received from other isolates.");
 
 const char* kFastAllocationFailed = "fast allocation failed";
 
@@ -297,6 +326,157 @@ void UpdateLengthField(intptr_t cid, ObjectPtr from, ObjectPtr to) {
   }
 }
 
+static constexpr intptr_t kMinAutoObjectCopyTasks = 1;
+static constexpr intptr_t kMaxAutoObjectCopyTasks = 4;
+
+static intptr_t NumObjectCopyTasks() {
+  intptr_t num_tasks = FLAG_object_copy_tasks;
+  if (num_tasks == -1) {
+    // --object_copy_tasks=-1 => dynamically choose workers
+    num_tasks = OS::NumberOfAvailableProcessors();
+    if (num_tasks < kMinAutoObjectCopyTasks) {
+      num_tasks = kMinAutoObjectCopyTasks;
+    }
+    if (num_tasks > kMaxAutoObjectCopyTasks) {
+      num_tasks = kMaxAutoObjectCopyTasks;
+    }
+  } else if (num_tasks == 0) {
+    // --object_copy_tasks=0 => serial copy
+    num_tasks = 1;
+  }
+  ASSERT(num_tasks > 0);
+  return num_tasks;
+}
+
+static bool ShouldCopyInParallel(intptr_t length) {
+  return (length >= FLAG_parallel_object_copy_threshold) &&
+         (NumObjectCopyTasks() > 1);
+}
+
+// A copy of a byte range which is split into chunks claimed by the thread
+// initiating the copy and by thread pool workers. Only payload bytes are
+// copied this way: traversing the object graph, forwarding objects and
+// allocating the copies stays on the sending thread.
+//
+// The initiating thread does not wait for workers which have not started by
+// the time all chunks are claimed, so a busy thread pool never delays the
+// copy. Late workers find nothing left to do; the job is reference counted
+// so that it outlives them.
+class ParallelCopyJob {
+ public:
+  static constexpr intptr_t kChunkSize = 256 * KB;
+
+  ParallelCopyJob(uint8_t* dst,
+                  const uint8_t* src,
+                  intptr_t length,
+                  intptr_t num_refs)
+      : dst_(dst),
+        src_(src),
+        length_(length),
+        num_chunks_(Utils::RoundUp(length, kChunkSize) / kChunkSize),
+        refs_(num_refs) {}
+
+  intptr_t num_chunks() const { return num_chunks_; }
+
+  void RunMain() {
+    CopyChunks();
+    MonitorLocker ml(&monitor_);
+    done_ = true;
+    while (active_workers_ > 0) {
+      ml.Wait();
+    }
+  }
+
+  void RunWorker() {
+    {
+      MonitorLocker ml(&monitor_);
+      if (done_) return;
+      active_workers_++;
+    }
+    CopyChunks();
+    MonitorLocker ml(&monitor_);
+    if (--active_workers_ == 0) {
+      ml.Notify();
+    }
+  }
+
+  void Release() {
+    if (refs_.fetch_sub(1) == 1) {
+      delete this;
+    }
+  }
+
+ private:
+  void CopyChunks() {
+    intptr_t chunk;
+    while ((chunk = next_chunk_.fetch_add(1)) < num_chunks_) {
+      const intptr_t offset = chunk * kChunkSize;
+      const intptr_t size = Utils::Minimum(kChunkSize, length_ - offset);
+      memmove(dst_ + offset, src_ + offset, size);
+    }
+  }
+
+  uint8_t* const dst_;
+  const uint8_t* const src_;
+  const intptr_t length_;
+  const intptr_t num_chunks_;
+  RelaxedAtomic<intptr_t> next_chunk_ = {0};
+  std::atomic<intptr_t> refs_;
+
+  Monitor monitor_;
+  intptr_t active_workers_ = 0;
+  bool done_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelCopyJob);
+};
+
+class ParallelCopyTask : public ThreadPool::Task {
+ public:
+  explicit ParallelCopyTask(ParallelCopyJob* job) : job_(job) {}
+
+  void Run() override {
+    job_->RunWorker();
+    job_->Release();
+  }
+
+ private:
+  ParallelCopyJob* const job_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelCopyTask);
+};
+
+// Copies [length] bytes from [src] to [dst], using multiple threads if the
+// range is large enough.
+//
+// The caller must ensure that neither range moves, i.e. it must not check
+// into safepoints while the copy is in progress.
+static void CopyBytes(void* dst, const void* src, intptr_t length) {
+  if (!ShouldCopyInParallel(length)) {
+    memmove(dst, src, length);
+    return;
+  }
+  // Message payloads never alias the source object.
+  ASSERT((static_cast<uint8_t*>(dst) + length <= src) ||
+         (static_cast<const uint8_t*>(src) + length <= dst));
+
+  const intptr_t num_chunks =
+      Utils::RoundUp(length, ParallelCopyJob::kChunkSize) /
+      ParallelCopyJob::kChunkSize;
+  const intptr_t num_workers =
+      Utils::Minimum(NumObjectCopyTasks(), num_chunks) - 1;
+  auto job = new ParallelCopyJob(static_cast<uint8_t*>(dst),
+                                 static_cast<const uint8_t*>(src), length,
+                                 /*num_refs=*/num_workers + 1);
+  for (intptr_t i = 0; i < num_workers; i++) {
+    if (!Dart::thread_pool()->Run<ParallelCopyTask>(job)) {
+      // The thread pool is shutting down, the task will never run.
+      job->Release();
+    }
+  }
+  job->RunMain();
+  job->Release();
+}
+
 void InitializeExternalTypedData(intptr_t cid,
                                  ExternalTypedDataPtr from,
                                  ExternalTypedDataPtr to) {
@@ -306,14 +486,14 @@ void InitializeExternalTypedData(intptr_t cid,
       TypedData::ElementSizeInBytes(cid) * Smi::Value(raw_from->length_);
 
   auto buffer = static_cast<uint8_t*>(malloc(length));
-  memmove(buffer, raw_from->data_, length);
+  CopyBytes(buffer, raw_from->data_, length);
   raw_to->length_ = raw_from->length_;
   raw_to->data_ = buffer;
 }
 
-template <typename T>
+template <typename S, typename T>
 void CopyTypedDataBaseWithSafepointChecks(Thread* thread,
-                                          const T& from,
+                                          const S& from,
                                           const T& to,
                                           intptr_t length) {
   constexpr intptr_t kChunkSize = 100 * 1024;
@@ -323,6 +503,22 @@ void CopyTypedDataBaseWithSafepointChecks(Thread* thread,
 
   // Notice we re-load the data pointer, since T may be TypedData in which case
   // the interior pointer may change after checking into safepoints.
+  if (ShouldCopyInParallel(length)) {
+    // Copy in rounds which keep every thread busy for a few chunks, checking
+    // into safepoints only in between rounds.
+    const intptr_t round_size =
+        NumObjectCopyTasks() * 4 * ParallelCopyJob::kChunkSize;
+    for (intptr_t offset = 0; offset < length; offset += round_size) {
+      {
+        NoSafepointScope no_safepoint(thread);
+        CopyBytes(to.ptr().untag()->data_ + offset,
+                  from.ptr().untag()->data_ + offset,
+                  Utils::Minimum(round_size, length - offset));
+      }
+      thread->CheckForSafepoint();
+    }
+    return;
+  }
   for (intptr_t i = 0; i < chunks; ++i) {
     memmove(to.ptr().untag()->data_ + i * kChunkSize,
             from.ptr().untag()->data_ + i * kChunkSize, kChunkSize);
@@ -778,7 +974,81 @@ class ObjectCopyBase {
         exception_unexpected_object_(Object::Handle(thread->zone())) {}
   ~ObjectCopyBase() {}
 
+  intptr_t promoted_objects() const { return promoted_objects_; }
+
  protected:
+  // Objects shared with the receiver are exactly as reachable for it as they
+  // are for the sender, so weak references to them are kept even if the
+  // message does not otherwise reference them.
+  static bool IsSharedWeakTarget(ObjectPtr target) {
+    return (target != Object::null()) && CanShareObjectAcrossIsolates(target);
+  }
+
+  // Whether [object] can be shared with the receiver instead of being copied,
+  // either because it is known to be deeply immutable or because it can be
+  // proven to be.
+  DART_FORCE_INLINE
+  bool CanShareOrPromoteObject(ObjectPtr object, uword tags) {
+    if (CanShareObject(object, tags)) {
+      return true;
+    }
+    return FLAG_promote_immutable_objects &&
+           TryPromoteToImmutable(object, tags);
+  }
+
+  // Tries to prove that [object] is deeply immutable: it is a record, an
+  // unmodifiable list or an instance of a class whose instance fields are all
+  // final and not late, and everything it references can be shared or is
+  // deeply immutable in the same sense.
+  //
+  // On success the ImmutableBit (see raw_object.h) is set on all objects
+  // examined, so they are shared by pointer in this and all later messages.
+  // All isolates of a group share one heap, so promoted objects need not be
+  // moved anywhere to be referenced from other isolates.
+  //
+  // Each object is examined at most once per attempt, so shared substructure
+  // is not walked again. On failure, the objects on the path to the mutable
+  // object are remembered for the rest of the message, so that attempts on
+  // their referrers and on the parts copied next fail right away.
+  //
+  // Neither allocates nor checks into safepoints, so it can be used on the
+  // fast path.
+  bool TryPromoteToImmutable(ObjectPtr object, uword tags) {
+    if ((promotion_budget_ <= 0) ||
+        !IsPromotionCandidate(UntaggedObject::ClassIdTag::decode(tags)) ||
+        (promotion_states_.LookupValue(object) == kPromotionFailed)) {
+      return false;
+    }
+    promotion_attempt_++;
+    promotion_worklist_.Clear();
+    promotion_visited_.Clear();
+    promotion_states_.Update({object, promotion_attempt_});
+    promotion_worklist_.Add({object, -1});
+    while (!promotion_worklist_.is_empty()) {
+      // Bound the time spent on graphs which turn out to be mutable.
+      if (--promotion_budget_ < 0) {
+        return false;
+      }
+      const PromotionEntry current = promotion_worklist_.RemoveLast();
+      const intptr_t index = promotion_visited_.length();
+      promotion_visited_.Add(current);
+      if (!PushReferencesForPromotion(current.object, index)) {
+        for (intptr_t i = index; i >= 0; i = promotion_visited_[i].parent) {
+          promotion_states_.Update(
+              {promotion_visited_[i].object, kPromotionFailed});
+        }
+        return false;
+      }
+    }
+    for (intptr_t i = 0; i < promotion_visited_.length(); i++) {
+      ObjectPtr promoted = promotion_visited_[i].object;
+      promoted.untag()->SetImmutable();
+      RecordSharedInstanceForReload(promoted->GetClassIdOfHeapObject());
+    }
+    promoted_objects_ += promotion_visited_.length();
+    return true;
+  }
+
   static ObjectPtr LoadPointer(ObjectPtr src, intptr_t offset) {
     return src.untag()->LoadPointer(reinterpret_cast<ObjectPtr*>(
         reinterpret_cast<uint8_t*>(src.untag()) + offset));
@@ -891,6 +1161,193 @@ class ObjectCopyBase {
 
   const char* exception_msg_ = nullptr;
   Object& exception_unexpected_object_;
+
+ private:
+  // Upper bound on the number of objects examined for promotion per message.
+  static constexpr intptr_t kPromotionBudget = 64 * KB;
+
+  enum PromotionCandidate : int8_t {
+    kUnknownCandidate,
+    kCandidate,
+    // A candidate with promoted instances, recorded for hot reload.
+    kRecordedCandidate,
+    kNotCandidate,
+  };
+
+  bool IsPromotionCandidate(intptr_t cid) {
+    if ((cid == kRecordCid) || (cid == kImmutableArrayCid)) {
+      return true;
+    }
+    if ((cid < kNumPredefinedCids) || (cid == expando_cid_)) {
+      return false;
+    }
+    while (promotion_candidates_.length() <= cid) {
+      promotion_candidates_.Add(kUnknownCandidate);
+    }
+    if (promotion_candidates_[cid] == kUnknownCandidate) {
+      promotion_candidates_[cid] =
+          IsPromotionCandidateClass(cid) ? kCandidate : kNotCandidate;
+    }
+    return (promotion_candidates_[cid] == kCandidate) ||
+           (promotion_candidates_[cid] == kRecordedCandidate);
+  }
+
+  // Hot reload must neither make the fields of promoted instances mutable nor
+  // change their layout, so the classes of such instances are recorded in the
+  // isolate group (see Class::CheckReload).
+  void RecordSharedInstanceForReload(intptr_t cid) {
+#if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
+    if ((cid < kNumPredefinedCids) ||
+        (promotion_candidates_[cid] == kRecordedCandidate)) {
+      return;
+    }
+    ASSERT(promotion_candidates_[cid] == kCandidate);
+    thread_->isolate_group()->SetHasSharedImmutableInstances(cid);
+    promotion_candidates_[cid] = kRecordedCandidate;
+#endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
+  }
+
+  bool IsPromotionCandidateClass(intptr_t cid) {
+    auto& cls = Class::Handle(zone_, class_table_->At(cid));
+    if (Class::IsIsolateUnsendable(cls.ptr()) ||
+        (cls.num_native_fields() != 0)) {
+      return false;
+    }
+#if defined(DART_PRECOMPILED_RUNTIME)
+    // The precompiler does not retain the fields of all classes, so it
+    // records the outcome of the check below in the class.
+    return Class::HasOnlyFinalInstanceFields(cls.ptr());
+#else
+    auto& fields = Array::Handle(zone_);
+    auto& field = Field::Handle(zone_);
+    for (; cls.id() != kInstanceCid; cls = cls.SuperClass(class_table_)) {
+      if (cls.id() < kNumPredefinedCids) {
+        return false;
+      }
+      fields = cls.fields();
+      for (intptr_t i = 0; i < fields.Length(); i++) {
+        field ^= fields.At(i);
+        if (field.is_static()) continue;
+        if (!field.is_final() || field.is_late()) {
+          return false;
+        }
+      }
+    }
+    return true;
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+  }
+
+  // Pushes the objects referenced by [object], the [parent]th object visited
+  // in this attempt, which are neither shareable nor examined yet.
+  bool PushReferencesForPromotion(ObjectPtr object, intptr_t parent) {
+    const intptr_t cid = object->GetClassIdOfHeapObject();
+    if (cid == kRecordCid) {
+      const intptr_t num_fields = Record::NumFields(Record::RawCast(object));
+      return PushReferencesForPromotion(object, Record::field_offset(0),
+                                        Record::field_offset(num_fields),
+                                        parent);
+    }
+    if (cid == kImmutableArrayCid) {
+      const intptr_t length = Array::LengthOf(Array::RawCast(object));
+      return PushReferencesForPromotion(
+                 object, Array::type_arguments_offset(),
+                 Array::type_arguments_offset() + kCompressedWordSize,
+                 parent) &&
+             PushReferencesForPromotion(object, Array::data_offset(),
+                                        Array::element_offset(length), parent);
+    }
+    const auto bitmap = class_table_->GetUnboxedFieldsMapAt(cid);
+    const intptr_t instance_size = object.untag()->HeapSize();
+    intptr_t bit = kWordSize >> kCompressedWordSizeLog2;
+    for (intptr_t offset = kWordSize; offset < instance_size;
+         offset += kCompressedWordSize) {
+      if (bitmap.Get(bit++)) continue;
+      if (!PushReferenceForPromotion(LoadCompressedPointer(object, offset),
+                                     parent)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool PushReferencesForPromotion(ObjectPtr object,
+                                  intptr_t offset,
+                                  intptr_t end_offset,
+                                  intptr_t parent) {
+    for (; offset < end_offset; offset += kCompressedWordSize) {
+      if (!PushReferenceForPromotion(LoadCompressedPointer(object, offset),
+                                     parent)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool PushReferenceForPromotion(CompressedObjectPtr value, intptr_t parent) {
+    if (!value.IsHeapObject()) {
+      return true;
+    }
+    ObjectPtr object = value.Decompress(heap_base_);
+    const uword tags = TagsFromUntaggedObject(object.untag());
+    if (CanShareObject(object, tags)) {
+      return true;
+    }
+    if (!IsPromotionCandidate(UntaggedObject::ClassIdTag::decode(tags))) {
+      return false;
+    }
+    const intptr_t state = promotion_states_.LookupValue(object);
+    if (state == kPromotionFailed) {
+      return false;
+    }
+    if (state == promotion_attempt_) {
+      // Already examined or pushed in this attempt.
+      return true;
+    }
+    promotion_states_.Update({object, promotion_attempt_});
+    promotion_worklist_.Add({object, parent});
+    return true;
+  }
+
+  struct PromotionEntry {
+    ObjectPtr object;
+    // Index in [promotion_visited_] of the object which referenced it, or -1.
+    intptr_t parent;
+  };
+
+  // Maps objects examined for promotion in this message to the attempt which
+  // examined them last, or to kPromotionFailed.
+  //
+  // The slow path may move objects between attempts. A stale entry can at
+  // worst make an object at the same address be copied instead of shared.
+  struct PromotionStateTrait {
+    typedef ObjectPtr Key;
+    typedef intptr_t Value;
+
+    struct Pair {
+      Key key;
+      Value value;
+      Pair() : key(nullptr), value(0) {}
+      Pair(const Key key, const Value& value) : key(key), value(value) {}
+      Pair(const Pair& other) : key(other.key), value(other.value) {}
+      Pair& operator=(const Pair&) = default;
+    };
+
+    static Key KeyOf(Pair kv) { return kv.key; }
+    static Value ValueOf(Pair kv) { return kv.value; }
+    static uword Hash(Key key) {
+      return Utils::WordHash(static_cast<intptr_t>(key));
+    }
+    static bool IsKeyEqual(Pair kv, Key key) { return kv.key == key; }
+  };
+  static constexpr intptr_t kPromotionFailed = -1;
+
+  intptr_t promotion_budget_ = kPromotionBudget;
+  intptr_t promoted_objects_ = 0;
+  intptr_t promotion_attempt_ = 0;
+  MallocGrowableArray<PromotionCandidate> promotion_candidates_;
+  MallocGrowableArray<PromotionEntry> promotion_worklist_;
+  MallocGrowableArray<PromotionEntry> promotion_visited_;
+  MallocDirectChainedHashMap<PromotionStateTrait> promotion_states_;
 };
 
 class RetainingPath {
@@ -1374,7 +1831,7 @@ class FastObjectCopyBase : public ObjectCopyBase {
     }
     auto value_decompressed = value.Decompress(heap_base_);
     const uword tags = TagsFromUntaggedObject(value_decompressed.untag());
-    if (CanShareObject(value_decompressed, tags)) {
+    if (CanShareOrPromoteObject(value_decompressed, tags)) {
       StoreCompressedPointerNoBarrier(dst, offset, value);
       return;
     }
@@ -1427,6 +1884,11 @@ class FastObjectCopyBase : public ObjectCopyBase {
     return Marker();
   }
 
+  ObjectPtr ForwardedWeakTarget(ObjectPtr target) {
+    ObjectPtr to = fast_forward_map_.ForwardedObject(target);
+    return to == Marker() && IsSharedWeakTarget(target) ? target : to;
+  }
+
   void EnqueueTransferable(TransferableTypedDataPtr from,
                            TransferableTypedDataPtr to) {
     fast_forward_map_.AddTransferable(from, to);
@@ -1547,7 +2009,7 @@ class SlowObjectCopyBase : public ObjectCopyBase {
 
     auto value_decompressed = value.Decompress(heap_base_);
     const uword tags = TagsFromUntaggedObject(value_decompressed.untag());
-    if (CanShareObject(value_decompressed, tags)) {
+    if (CanShareOrPromoteObject(value_decompressed, tags)) {
       StoreCompressedLargeArrayPointerBarrier(dst.ptr(), offset,
                                               value_decompressed);
       return;
@@ -1582,7 +2044,7 @@ class SlowObjectCopyBase : public ObjectCopyBase {
     }
     auto value_decompressed = value.Decompress(heap_base_);
     const uword tags = TagsFromUntaggedObject(value_decompressed.untag());
-    if (CanShareObject(value_decompressed, tags)) {
+    if (CanShareOrPromoteObject(value_decompressed, tags)) {
       StoreCompressedPointerBarrier(dst.ptr(), offset, value_decompressed);
       return;
     }
@@ -1634,6 +2096,11 @@ class SlowObjectCopyBase : public ObjectCopyBase {
     }
     return to;
   }
+  ObjectPtr ForwardedWeakTarget(ObjectPtr target) {
+    ObjectPtr to = slow_forward_map_.ForwardedObject(target);
+    return to == Marker() && IsSharedWeakTarget(target) ? target : to;
+  }
+
   void EnqueueTransferable(const TransferableTypedData& from,
                            const TransferableTypedData& to) {
     slow_forward_map_.AddTransferable(from, to);
@@ -2179,7 +2646,7 @@ class FastObjectCopy : public ObjectCopy<FastObjectCopyBase> {
       while (i < weak_properties.length()) {
         from_weak_property = weak_properties[i];
         weak_property_key =
-            fast_forward_map_.ForwardedObject(from_weak_property.key());
+            ForwardedWeakTarget(from_weak_property.key());
         if (weak_property_key.ptr() != Marker()) {
           to_weak_property ^=
               fast_forward_map_.ForwardedObject(from_weak_property.ptr());
@@ -2213,7 +2680,7 @@ class FastObjectCopy : public ObjectCopy<FastObjectCopyBase> {
     for (intptr_t i = 0; i < weak_references.length(); i++) {
       from_weak_reference = weak_references[i];
       weak_reference_target =
-          fast_forward_map_.ForwardedObject(from_weak_reference.target());
+          ForwardedWeakTarget(from_weak_reference.target());
       if (weak_reference_target.ptr() != Marker()) {
         to_weak_reference ^=
             fast_forward_map_.ForwardedObject(from_weak_reference.ptr());
@@ -2346,7 +2813,7 @@ class SlowObjectCopy : public ObjectCopy<SlowObjectCopyBase> {
       auto& weak_properties = slow_forward_map_.weak_properties_;
       while (i < weak_properties.length()) {
         const auto& from_weak_property = *weak_properties[i];
-        to = slow_forward_map_.ForwardedObject(from_weak_property.key());
+        to = ForwardedWeakTarget(from_weak_property.key());
         if (to.ptr() != Marker()) {
           weak_property ^=
               slow_forward_map_.ForwardedObject(from_weak_property.ptr());
@@ -2377,7 +2844,7 @@ class SlowObjectCopy : public ObjectCopy<SlowObjectCopyBase> {
     auto& weak_references = slow_forward_map_.weak_references_;
     for (intptr_t i = 0; i < weak_references.length(); i++) {
       const auto& from_weak_reference = *weak_references[i];
-      to = slow_forward_map_.ForwardedObject(from_weak_reference.target());
+      to = ForwardedWeakTarget(from_weak_reference.target());
       if (to.ptr() != Marker()) {
         weak_reference ^=
             slow_forward_map_.ForwardedObject(from_weak_reference.ptr());
@@ -2498,6 +2965,11 @@ class ObjectGraphCopier : public StackResource {
 
   intptr_t copied_objects() { return copied_objects_; }
 
+  intptr_t promoted_objects() {
+    return fast_object_copy_.promoted_objects() +
+           slow_object_copy_.promoted_objects();
+  }
+
  private:
   ObjectPtr CopyObjectGraphInternal(const Object& root,
                                     const char* volatile* exception_msg) {
@@ -2507,10 +2979,19 @@ class ObjectGraphCopier : public StackResource {
       return result_array.ptr();
     }
     const uword tags = TagsFromUntaggedObject(root.ptr().untag());
-    if (CanShareObject(root.ptr(), tags)) {
+    if (fast_object_copy_.CanShareOrPromoteObject(root.ptr(), tags)) {
       result_array.SetAt(0, root);
       return result_array.ptr();
     }
+    if (ShouldCopyToImmutableBackingStore(tags, root)) {
+      const auto& view = TypedDataView::Cast(root);
+      const auto& copy =
+          Object::Handle(zone_, CopyToImmutableBackingStore(view));
+      if (!copy.IsNull()) {
+        result_array.SetAt(0, copy);
+        return result_array.ptr();
+      }
+    }
     if (!fast_object_copy_.CanCopyObject(tags, root.ptr())) {
       ASSERT(fast_object_copy_.exception_msg_ != nullptr);
       *exception_msg = fast_object_copy_.exception_msg_;
@@ -2594,6 +3075,71 @@ class ObjectGraphCopier : public StackResource {
     return result_array.ptr();
   }
 
+  // Whether [root] is an unmodifiable view whose backing store should be
+  // copied into immutable memory instead of the heap.
+  //
+  // A message rooted at a view consists of just the view and its backing
+  // store, so no other object in the copied graph can observe that the
+  // backing store became immutable. The receiver can then send the view on to
+  // any number of isolates of the group by reference.
+  bool ShouldCopyToImmutableBackingStore(uword tags, const Object& root) {
+    const intptr_t cid = UntaggedObject::ClassIdTag::decode(tags);
+    if (!IsUnmodifiableTypedDataViewClassId(cid)) {
+      return false;
+    }
+    const auto& view = TypedDataView::Cast(root);
+    if (view.typed_data() == TypedDataBase::null()) {
+      return false;
+    }
+    const intptr_t length_in_bytes =
+        TypedDataBase::Handle(zone_, view.typed_data()).LengthInBytes();
+    return length_in_bytes >= FLAG_share_unmodifiable_view_threshold;
+  }
+
+  // Returns a copy of [view] backed by an immutable copy of its backing store
+  // allocated outside of the heap, or null if the memory cannot be allocated.
+  //
+  // Every message gets its own copy, since the sender may still write to the
+  // backing store. Fan-out goes through the received view instead: its
+  // backing store has the immutable bit set, so sending it on shares it by
+  // reference (see CanShareObject).
+  ObjectPtr CopyToImmutableBackingStore(const TypedDataView& view) {
+    const auto& from =
+        TypedDataBase::Handle(zone_, TypedDataBase::RawCast(view.typed_data()));
+    const intptr_t from_cid = from.GetClassId();
+    const intptr_t cid =
+        IsExternalTypedDataClassId(from_cid)
+            ? from_cid
+            : from_cid - kTypedDataCidRemainderInternal +
+                  kTypedDataCidRemainderExternal;
+    ASSERT(IsExternalTypedDataClassId(cid));
+    const intptr_t length_in_bytes = from.LengthInBytes();
+    auto buffer = static_cast<uint8_t*>(malloc(length_in_bytes));
+    if (buffer == nullptr) {
+      return Object::null();
+    }
+    const auto& to = ExternalTypedData::Handle(
+        zone_, ExternalTypedData::New(
+                   cid, buffer, from.Length(),
+                   thread_->heap()->SpaceForExternal(length_in_bytes)));
+    to.AddFinalizer(buffer, &FreeExternalTypedData, length_in_bytes);
+    if (IsExternalTypedDataClassId(from_cid)) {
+      CopyTypedDataBaseWithSafepointChecks(
+          thread_, ExternalTypedData::Cast(from), to, length_in_bytes);
+    } else {
+      CopyTypedDataBaseWithSafepointChecks(thread_, TypedData::Cast(from), to,
+                                           length_in_bytes);
+    }
+    to.SetImmutable();
+
+    copied_objects_ = 2;
+    allocated_bytes_ = ExternalTypedData::InstanceSize() +
+                       TypedDataView::InstanceSize() + length_in_bytes;
+    return TypedDataView::New(view.GetClassId(), to,
+                              Smi::Value(view.offset_in_bytes()),
+                              view.Length());
+  }
+
   void SwitchToSlowForwardingList() {
     auto& fast_forward_map = fast_object_copy_.fast_forward_map_;
     auto& slow_forward_map = slow_object_copy_.slow_forward_map_;
@@ -2738,9 +3284,11 @@ ObjectPtr CopyMutableObjectGraph(const Object& object) {
   ObjectPtr result = copier.CopyObjectGraph(object);
 #if defined(SUPPORT_TIMELINE)
   if (tbes.enabled()) {
-    tbes.SetNumArguments(2);
+    tbes.SetNumArguments(3);
     tbes.FormatArgument(0, "CopiedObjects", "%" Pd, copier.copied_objects());
     tbes.FormatArgument(1, "AllocatedBytes", "%" Pd, copier.allocated_bytes());
+    tbes.FormatArgument(2, "PromotedObjects", "%" Pd,
+                        copier.promoted_objects());
   }
 #endif
   return result;
@@ -477,6 +477,20 @@ class InstanceSizeConflict : public ClassReasonForCancelling {
   }
 };
 
+class SharedImmutableInstancesChange : public ClassReasonForCancelling {
+ public:
+  SharedImmutableInstancesChange(Zone* zone, const Class& from, const Class& to)
+      : ClassReasonForCancelling(zone, from, to) {}
+
+ private:
+  StringPtr ToString() {
+    return String::NewFormatted(
+        "Instances of %s are shared between isolates as deeply immutable, "
+        "their fields cannot be changed or made mutable",
+        from_.ToCString());
+  }
+};
+
 // This is executed before iterating over the instances.
 void Class::CheckReload(const Class& replacement,
                         ProgramReloadContext* context) const {
@@ -592,6 +606,15 @@ void Class::CheckReload(const Class& replacement,
     return;
   }
 
+  if (is_finalized() &&
+      IsolateGroup::Current()->HasSharedImmutableInstances(id()) &&
+      !CanReloadSharedImmutableInstances(replacement)) {
+    context->group_reload_context()->AddReasonForCancelling(
+        new (context->zone()) SharedImmutableInstancesChange(
+            context->zone(), *this, replacement));
+    return;
+  }
+
   // Just checking.
   ASSERT(is_enum_class() == replacement.is_enum_class());
   ASSERT(num_native_fields() == replacement.num_native_fields());
@@ -691,6 +714,39 @@ bool Class::RequiresInstanceMorphing(ClassTable* class_table,
   return false;
 }
 
+bool Class::CanReloadSharedImmutableInstances(
+    const Class& replacement) const {
+  const Array& fields = Array::Handle(
+      OffsetToFieldMap(IsolateGroup::Current()->heap_walk_class_table()));
+  const Array& replacement_fields =
+      Array::Handle(replacement.OffsetToFieldMap());
+  if ((fields.Length() != replacement_fields.Length()) ||
+      (host_next_field_offset() != replacement.host_next_field_offset())) {
+    return false;
+  }
+
+  Field& field = Field::Handle();
+  Field& replacement_field = Field::Handle();
+  String& field_name = String::Handle();
+  String& replacement_field_name = String::Handle();
+  for (intptr_t i = 0; i < fields.Length(); i++) {
+    if ((fields.At(i) == Field::null()) ||
+        (replacement_fields.At(i) == Field::null())) {
+      if (fields.At(i) != replacement_fields.At(i)) return false;
+      continue;
+    }
+    field = Field::RawCast(fields.At(i));
+    replacement_field = Field::RawCast(replacement_fields.At(i));
+    field_name = field.name();
+    replacement_field_name = replacement_field.name();
+    if (!field_name.Equals(replacement_field_name)) return false;
+    if (!replacement_field.is_final() || replacement_field.is_late()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool Class::CanReloadFinalized(const Class& replacement,
                                ProgramReloadContext* context) const {
   // Make sure the declaration types argument count matches for the two classes.
@@ -17,14 +17,13 @@
 
 namespace dart {
 
-Mutex* PortMap::mutex_ = nullptr;
-PortSet<PortMap::Entry>* PortMap::ports_ = nullptr;
-Random* PortMap::prng_ = nullptr;
+PortMap::Shard* PortMap::shards_ = nullptr;
 
-Dart_Port PortMap::AllocatePort() {
+Dart_Port PortMap::AllocatePort(intptr_t shard_index) {
+  Shard* shard = &shards_[shard_index];
   Dart_Port result;
 
-  ASSERT(mutex_->IsOwnedByCurrentThread());
+  ASSERT(shard->mutex.IsOwnedByCurrentThread());
 
   // Keep getting new values while we have an illegal port number or the port
   // number is already in use.
@@ -35,7 +34,11 @@ Dart_Port PortMap::AllocatePort() {
 
     // Ensure port ids are representable in JavaScript for the benefit of
     // vm-service clients such as Observatory.
-    result = prng_->NextJSInt() | kMask2;
+    const Dart_Port kShardMask = static_cast<Dart_Port>(kNumShards - 1)
+                                 << kShardShift;
+    result = (shard->prng->NextJSInt() & ~kShardMask) |
+             (static_cast<Dart_Port>(shard_index) << kShardShift) | kMask2;
+    ASSERT(ShardIndexFor(result) == shard_index);
 
     // The two special marker ports are used for the hashset implementation and
     // cannot be used as actual ports.
@@ -45,25 +48,28 @@ Dart_Port PortMap::AllocatePort() {
     }
 
     ASSERT(!static_cast<ObjectPtr>(static_cast<uword>(result))->IsWellFormed());
-  } while (ports_->Contains(result));
+  } while (shard->ports->Contains(result));
 
   ASSERT(result != 0);
-  ASSERT(!ports_->Contains(result));
+  ASSERT(!shard->ports->Contains(result));
   return result;
 }
 
 Dart_Port PortMap::CreatePort(PortHandler* handler) {
   ASSERT(handler != nullptr);
-  PortMap::Locker ml;
-  if (ports_ == nullptr) {
+  // Ports of a handler are allocated in the handler's shard (see Locker).
+  PortMap::Locker ml(handler);
+  const intptr_t shard_index = ShardIndexFor(handler);
+  PortSet<Entry>* shard_ports = shards_[shard_index].ports;
+  if (shard_ports == nullptr) {
     return ILLEGAL_PORT;
   }
 
-  const Dart_Port port = AllocatePort();
+  const Dart_Port port = AllocatePort(shard_index);
   if (auto ports = handler->ports(ml)) {
     ports->Insert(PortHandler::PortSetEntry{port});
   }
-  ports_->Insert(Entry{port, handler});
+  shard_ports->Insert(Entry{port, handler});
 
   if (FLAG_trace_isolates) {
     OS::PrintErr(
@@ -81,24 +87,26 @@ bool PortMap::ClosePort(Dart_Port port, PortHandler** port_handler) {
 
   PortHandler* handler = nullptr;
   {
-    PortMap::Locker ml;
-    if (ports_ == nullptr) {
+    PortMap::Locker ml(port);
+    PortSet<Entry>* shard_ports = ShardFor(port)->ports;
+    if (shard_ports == nullptr) {
       return false;
     }
-    auto it = ports_->TryLookup(port);
-    if (it == ports_->end()) {
+    auto it = shard_ports->TryLookup(port);
+    if (it == shard_ports->end()) {
       return false;
     }
     Entry entry = *it;
     handler = entry.handler;
     ASSERT(handler != nullptr);
+    ASSERT(ShardIndexFor(handler) == ShardIndexFor(port));
 
 #if defined(DEBUG)
     handler->CheckAccess();
 #endif
 
     it.Delete();
-    ports_->Rebalance();
+    shard_ports->Rebalance();
 
     if (auto ports = handler->ports(ml)) {
       auto isolate_it = ports->TryLookup(port);
@@ -114,8 +122,9 @@ bool PortMap::ClosePort(Dart_Port port, PortHandler** port_handler) {
 
 void PortMap::ClosePorts(MessageHandler* handler) {
   {
-    PortMap::Locker ml;
-    if (ports_ == nullptr) {
+    PortMap::Locker ml(handler);
+    PortSet<Entry>* shard_ports = ShardFor(handler)->ports;
+    if (shard_ports == nullptr) {
       return;
     }
 
@@ -124,8 +133,8 @@ void PortMap::ClosePorts(MessageHandler* handler) {
 
     for (auto isolate_it = ports->begin(); isolate_it != ports->end();
          ++isolate_it) {
-      auto it = ports_->TryLookup((*isolate_it).port);
-      ASSERT(it != ports_->end());
+      auto it = shard_ports->TryLookup((*isolate_it).port);
+      ASSERT(it != shard_ports->end());
       Entry entry = *it;
       ASSERT(entry.port == (*isolate_it).port);
       ASSERT(entry.handler == handler);
@@ -133,19 +142,21 @@ void PortMap::ClosePorts(MessageHandler* handler) {
       isolate_it.Delete();
     }
     ASSERT(ports->IsEmpty());
-    ports_->Rebalance();
+    shard_ports->Rebalance();
   }
   handler->OnAllPortsClosed();
 }
 
 bool PortMap::PostMessage(std::unique_ptr<Message> message,
                           bool before_events) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  const Dart_Port dest_port = message->dest_port();
+  Locker ml(dest_port);
+  PortSet<Entry>* shard_ports = ShardFor(dest_port)->ports;
+  if (shard_ports == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(message->dest_port());
-  if (it == ports_->end()) {
+  auto it = shard_ports->TryLookup(dest_port);
+  if (it == shard_ports->end()) {
     // Ownership of external data remains with the poster.
     message->DropFinalizers();
     return false;
@@ -158,26 +169,28 @@ bool PortMap::PostMessage(std::unique_ptr<Message> message,
 
 #if defined(TESTING)
 bool PortMap::PortExists(Dart_Port id) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  Locker ml(id);
+  PortSet<Entry>* shard_ports = ShardFor(id)->ports;
+  if (shard_ports == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(id);
-  return it != ports_->end();
+  auto it = shard_ports->TryLookup(id);
+  return it != shard_ports->end();
 }
 
 Isolate* PortMap::GetIsolate(Dart_Port id) {
-  Locker ml;
+  Locker ml(id);
   return GetIsolateLocked(ml, id);
 }
 #endif  // defined(TESTING)
 
 Isolate* PortMap::GetIsolateLocked(const Locker& ml, Dart_Port id) {
-  if (ports_ == nullptr) {
+  PortSet<Entry>* shard_ports = ShardFor(id)->ports;
+  if (shard_ports == nullptr) {
     return nullptr;
   }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  auto it = shard_ports->TryLookup(id);
+  if (it == shard_ports->end()) {
     // Port does not exist.
     return nullptr;
   }
@@ -187,27 +200,18 @@ Isolate* PortMap::GetIsolateLocked(const Locker& ml, Dart_Port id) {
 }
 
 Dart_Port PortMap::GetOriginId(Dart_Port id) {
-  Locker ml;
-  if (ports_ == nullptr) {
-    return ILLEGAL_PORT;
-  }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
-    // Port does not exist.
-    return ILLEGAL_PORT;
-  }
-
-  auto handler = (*it).handler;
-  Isolate* isolate = handler->isolate();
+  Locker ml(id);
+  Isolate* isolate = GetIsolateLocked(ml, id);
   if (isolate == nullptr) {
-    // Message handler is a native port instead of an isolate.
+    // Either the port does not exist or it belongs to a native port instead
+    // of an isolate.
     return ILLEGAL_PORT;
   }
   return isolate->group()->id();
 }
 
 bool PortMap::IsOwnedByCurrentThread(Dart_Port id) {
-  Locker ml;
+  Locker ml(id);
   Isolate* isolate = GetIsolateLocked(ml, id);
   if (isolate == nullptr) {
     // Either the port is invalid, or the isolate has already shut down.
@@ -218,25 +222,26 @@ bool PortMap::IsOwnedByCurrentThread(Dart_Port id) {
 
 #if defined(TESTING)
 bool PortMap::HasPorts(MessageHandler* handler) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  Locker ml(handler);
+  if (ShardFor(handler)->ports == nullptr) {
     return false;
   }
   // The MessageHandler::ports_ is only accessed by [PortMap], it is guarded
-  // by the [PortMap::mutex_] we already hold.
+  // by the lock of the handler's shard we already hold.
   return !handler->ports_.IsEmpty();
 }
 #endif
 
 bool PortMap::IsReceiverInThisIsolateGroupOrClosed(Dart_Port receiver,
                                                    IsolateGroup* group) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  Locker ml(receiver);
+  PortSet<Entry>* shard_ports = ShardFor(receiver)->ports;
+  if (shard_ports == nullptr) {
     // Port was closed.
     return true;
   }
-  auto it = ports_->TryLookup(receiver);
-  if (it == ports_->end()) {
+  auto it = shard_ports->TryLookup(receiver);
+  if (it == shard_ports->end()) {
     // Port was closed.
     return true;
   }
@@ -249,42 +254,50 @@ bool PortMap::IsReceiverInThisIsolateGroupOrClosed(Dart_Port receiver,
 }
 
 void PortMap::Init() {
-  if (mutex_ == nullptr) {
-    mutex_ = new Mutex();
+  if (shards_ == nullptr) {
+    shards_ = new Shard[kNumShards];
   }
-  ASSERT(mutex_ != nullptr);
-  if (prng_ == nullptr) {
-    prng_ = new Random();
-  }
-  if (ports_ == nullptr) {
-    ports_ = new PortSet<Entry>();
+  ASSERT(shards_ != nullptr);
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    Shard* shard = &shards_[i];
+    if (shard->prng == nullptr) {
+      shard->prng = new Random();
+    }
+    if (shard->ports == nullptr) {
+      shard->ports = new PortSet<Entry>();
+    }
   }
 }
 
 void PortMap::Shutdown() {
   // Tell all handlers which are running their own thread pools to shutdown.
-  for (auto& entry : *ports_) {
-    entry.handler->Shutdown();
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    for (auto& entry : *shards_[i].ports) {
+      entry.handler->Shutdown();
+    }
   }
 }
 
 void PortMap::Cleanup() {
-  ASSERT(ports_ != nullptr);
-  ASSERT(prng_ != nullptr);
-  for (auto it = ports_->begin(); it != ports_->end(); ++it) {
-    const auto& entry = *it;
-    ASSERT(entry.handler != nullptr);
-    delete entry.handler;
-    it.Delete();
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    Shard* shard = &shards_[i];
+    ASSERT(shard->ports != nullptr);
+    ASSERT(shard->prng != nullptr);
+    for (auto it = shard->ports->begin(); it != shard->ports->end(); ++it) {
+      const auto& entry = *it;
+      ASSERT(entry.handler != nullptr);
+      delete entry.handler;
+      it.Delete();
+    }
+    shard->ports->Rebalance();
+
+    // Grab the mutex and delete the port set.
+    MutexLocker ml(&shard->mutex);
+    delete shard->prng;
+    shard->prng = nullptr;
+    delete shard->ports;
+    shard->ports = nullptr;
   }
-  ports_->Rebalance();
-
-  // Grab the mutex and delete the port set.
-  Locker ml;
-  delete prng_;
-  prng_ = nullptr;
-  delete ports_;
-  ports_ = nullptr;
 }
 
 void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
@@ -292,14 +305,16 @@ void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
 #ifndef PRODUCT
   JSONObject jsobj(stream);
   jsobj.AddProperty("type", "_Ports");
+  handler->PrintMessageMetricsJSON(&jsobj);
   Object& msg_handler = Object::Handle();
   {
     JSONArray ports(&jsobj, "ports");
-    SafepointMutexLocker ml(mutex_);
-    if (ports_ == nullptr) {
+    Shard* shard = ShardFor(handler);
+    SafepointMutexLocker ml(&shard->mutex);
+    if (shard->ports == nullptr) {
       return;
     }
-    for (auto& entry : *ports_) {
+    for (auto& entry : *shard->ports) {
       if (entry.handler == handler) {
         JSONObject port(&ports);
         port.AddProperty("type", "_Port");
@@ -313,12 +328,13 @@ void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
 }
 
 void PortMap::DebugDumpForMessageHandler(MessageHandler* handler) {
-  SafepointMutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(handler);
+  SafepointMutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     return;
   }
   Object& msg_handler = Object::Handle();
-  for (auto& entry : *ports_) {
+  for (auto& entry : *shard->ports) {
     if (entry.handler == handler) {
       OS::PrintErr("Port = %" Pd64 "\n", entry.port);
       msg_handler = DartLibraryCalls::LookupHandler(entry.port);
@@ -69,9 +69,15 @@ class PortMap : public AllStatic {
 
   static void DebugDumpForMessageHandler(MessageHandler* handler);
 
+  // Holds the lock of a shard of the port map.
+  //
+  // All ports of a handler are allocated in the same shard, so the lock
+  // guarding a port also guards the set of ports of its handler.
   class Locker : public MutexLocker {
    public:
-    Locker() : MutexLocker(PortMap::mutex_) {}
+    explicit Locker(Dart_Port port) : MutexLocker(&ShardFor(port)->mutex) {}
+    explicit Locker(PortHandler* handler)
+        : MutexLocker(&ShardFor(handler)->mutex) {}
   };
 
  private:
@@ -83,17 +89,44 @@ class PortMap : public AllStatic {
     PortHandler* handler;
   };
 
-  // Allocate a new unique port.
-  static Dart_Port AllocatePort();
-
-  static Isolate* GetIsolateLocked(const Locker& ml, Dart_Port id);
+  // The port map is split into shards so that posting messages to, creating
+  // and closing ports of unrelated handlers do not contend on a single lock.
+  // The shard of a port is encoded in bits [kShardShift, kShardShift +
+  // kShardBits) of its id, the remaining bits are random.
+  static constexpr intptr_t kShardBits = 5;
+  static constexpr intptr_t kNumShards = 1 << kShardBits;
+  static constexpr intptr_t kShardShift = 47;
+
+  struct Shard {
+    // Lock protecting access to the ports of this shard.
+    Mutex mutex;
+    PortSet<Entry>* ports = nullptr;
+    Random* prng = nullptr;
+  };
 
-  // Lock protecting access to the port map.
-  static Mutex* mutex_;
+  static intptr_t ShardIndexFor(Dart_Port port) {
+    return static_cast<intptr_t>((static_cast<uint64_t>(port) >> kShardShift) &
+                                 static_cast<uint64_t>(kNumShards - 1));
+  }
+  static intptr_t ShardIndexFor(PortHandler* handler) {
+    return Utils::WordHash(reinterpret_cast<intptr_t>(handler)) &
+           (kNumShards - 1);
+  }
+  static Shard* ShardFor(Dart_Port port) {
+    return &shards_[ShardIndexFor(port)];
+  }
+  static Shard* ShardFor(PortHandler* handler) {
+    return &shards_[ShardIndexFor(handler)];
+  }
+
+  // Allocate a new unique port in the given shard.
+  static Dart_Port AllocatePort(intptr_t shard_index);
 
-  static PortSet<Entry>* ports_;
+  static Isolate* GetIsolateLocked(const Locker& ml, Dart_Port id);
 
-  static Random* prng_;
+  // Allocated once by Init and never freed, so that the shard locks stay
+  // valid after Cleanup.
+  static Shard* shards_;
 };
 
 // An object handling messages dispatched to one or more ports in the |PortMap|.
@@ -139,8 +172,8 @@ class PortHandler {
   // Returns set of ports associate with this handler if
   // handler supports multiple ports or |nullptr| otherwise.
   //
-  // Only |PortMap| is expected to call this method under locked
-  // PortMap::mutex_.
+  // Only |PortMap| is expected to call this method while holding a
+  // PortMap::Locker for this handler.
   virtual PortSet<PortSetEntry>* ports(PortMap::Locker& locker) = 0;
 };
 
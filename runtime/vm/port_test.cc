@@ -74,6 +74,35 @@ TEST_CASE(PortMap_CreateManyPorts) {
   }
 }
 
+TEST_CASE(PortMap_ManyHandlers) {
+  // Enough handlers to have ports in several shards of the port map.
+  const intptr_t kNumHandlers = 64;
+  PortTestMessageHandler handlers[kNumHandlers];
+  Dart_Port ports[kNumHandlers];
+  for (intptr_t i = 0; i < kNumHandlers; i++) {
+    ports[i] = PortMap::CreatePort(&handlers[i]);
+    EXPECT_NE(0, ports[i]);
+    // Port ids must remain representable as JavaScript integers.
+    EXPECT(ports[i] > 0);
+    EXPECT(ports[i] <= 0x1FFFFFFFFFFFFF);
+  }
+  for (intptr_t i = 0; i < kNumHandlers; i++) {
+    EXPECT(PortMap::PortExists(ports[i]));
+    EXPECT(PortMap::HasPorts(&handlers[i]));
+  }
+  for (intptr_t i = 0; i < kNumHandlers; i += 2) {
+    PortMap::ClosePorts(&handlers[i]);
+  }
+  for (intptr_t i = 0; i < kNumHandlers; i++) {
+    EXPECT_EQ(i % 2 != 0, PortMap::PortExists(ports[i]));
+    EXPECT_EQ(i % 2 != 0, PortMap::HasPorts(&handlers[i]));
+  }
+  for (intptr_t i = 1; i < kNumHandlers; i += 2) {
+    PortMap::ClosePort(ports[i]);
+    EXPECT(!PortMap::PortExists(ports[i]));
+  }
+}
+
 TEST_CASE(PortMap_PostMessage) {
   PortTestMessageHandler handler;
   Dart_Port port = PortMap::CreatePort(&handler);
@@ -3226,10 +3226,10 @@ class UntaggedPointerBase : public UntaggedInstance {
   uint8_t* data_;
 
  private:
-  template <typename T>
+  template <typename S, typename T>
   friend void CopyTypedDataBaseWithSafepointChecks(
       Thread*,
-      const T&,
+      const S&,
       const T&,
       intptr_t);  // Access _data for memmove with safepoint checkins.
 
@@ -636,8 +636,21 @@ DEFINE_RUNTIME_ENTRY(AllocateObject, 2) {
   }
 #endif
   ASSERT(cls.is_allocate_finalized());
-  const Instance& instance = Instance::Handle(
-      zone, Instance::NewAlreadyFinalized(cls, SpaceForRuntimeAllocation()));
+  Scavenger* new_space = thread->heap()->new_space();
+  if (UNLIKELY(new_space->HasPendingPretenureUpdates())) {
+    new_space->UpdatePretenuredAllocationStubs(thread);
+  }
+  Heap::Space space = SpaceForRuntimeAllocation();
+  if (thread->isolate_group()->class_table()->ShouldPretenure(cls.id()) &&
+      !new_space->ShouldSamplePretenuredClass()) {
+    // The allocation stub of a pretenured class gets here when it cannot bump
+    // allocate in old space; the slow path remembers the result, so
+    // write-barrier elimination remains valid. Allocating in old space also
+    // refills the thread's buffer for the stub.
+    space = Heap::kOld;
+  }
+  const Instance& instance =
+      Instance::Handle(zone, Instance::NewAlreadyFinalized(cls, space));
   if (cls.NumTypeArguments() == 0) {
     // No type arguments required for a non-parameterized type.
     ASSERT(Instance::CheckedHandle(zone, arguments.ArgAt(1)).IsNull());
@@ -4066,7 +4079,8 @@ DEFINE_RUNTIME_ENTRY(OptimizeInvokedFunction, 1) {
       if (isolate_group->background_compiler()->EnqueueCompilation(function)) {
         // Reduce the chance of triggering a compilation while the function is
         // being compiled in the background. INT32_MIN should ensure that it
-        // takes long time to trigger a compilation.
+        // takes long time to trigger a compilation. The queue keeps counting
+        // calls from there to prioritize the function.
         // Note that the background compilation queue rejects duplicate entries.
         function.SetUsageCounter(INT32_MIN);
         // Continue in the same code.
@@ -665,6 +665,7 @@ void Thread::ResumeThreadInternal(Thread* thread) {
 
 void Thread::SuspendThreadInternal(Thread* thread, VMTag::VMTagId tag) {
   thread->heap()->new_space()->AbandonRemainingTLAB(thread);
+  thread->heap()->old_space()->AbandonThreadAllocationBuffer(thread);
 
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
   thread->heap_sampler().Cleanup();
@@ -861,6 +862,10 @@ ErrorPtr Thread::HandleInterrupts(uword interrupt_bits) {
       heap()->CollectGarbage(this, GCType::kEvacuate, GCReason::kStoreBuffer);
     }
     heap()->CheckFinalizeMarking(this);
+    Scavenger* new_space = heap()->new_space();
+    if (new_space->HasPendingPretenureUpdates()) {
+      new_space->UpdatePretenuredAllocationStubs(this);
+    }
 
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
     HeapProfileSampler& sampler = heap_sampler();
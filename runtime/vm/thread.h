@@ -771,6 +771,27 @@ class Thread : public ThreadState, public IntrusiveDListEntry<Thread> {
   static intptr_t top_offset() { return OFFSET_OF(Thread, top_); }
   static intptr_t end_offset() { return OFFSET_OF(Thread, end_); }
 
+  // The old-space allocation buffer. Carved out of the data freelist by
+  // PageSpace so direct old-space allocations do not take the freelist lock.
+  // The unused tail [old_space_top, old_space_end) is always formatted as a
+  // free list element so the page remains walkable. Allocation stubs of
+  // pretenured classes bump allocate from it too, and are not counted in
+  // old_space_allocations.
+  uword old_space_top() const { return old_space_top_; }
+  uword old_space_end() const { return old_space_end_; }
+  static intptr_t old_space_top_offset() {
+    return OFFSET_OF(Thread, old_space_top_);
+  }
+  static intptr_t old_space_end_offset() {
+    return OFFSET_OF(Thread, old_space_end_);
+  }
+  void set_old_space_top(uword top) { old_space_top_ = top; }
+  void set_old_space_end(uword end) { old_space_end_ = end; }
+  intptr_t old_space_allocations() const { return old_space_allocations_; }
+  void set_old_space_allocations(intptr_t value) {
+    old_space_allocations_ = value;
+  }
+
   int32_t no_safepoint_scope_depth() const {
 #if defined(DEBUG)
     return no_safepoint_scope_depth_;
@@ -1537,6 +1558,8 @@ class Thread : public ThreadState, public IntrusiveDListEntry<Thread> {
   TimelineStream* const dart_stream_;
   StreamInfo* const service_extension_stream_;
   ArrayPtr thread_locals_ = nullptr;
+  uword old_space_top_ = 0;
+  uword old_space_end_ = 0;
 
   // ---- End accessed from generated code. ----
 
@@ -1546,6 +1569,7 @@ class Thread : public ThreadState, public IntrusiveDListEntry<Thread> {
   // DART_PRECOMPILED_RUNTIME.
 
   uword true_end_ = 0;
+  intptr_t old_space_allocations_ = 0;
   mutable Monitor thread_lock_;
   ApiLocalScope* api_reusable_scope_ = nullptr;
   std::atomic<TaskKind> task_kind_ = kUnknownTask;
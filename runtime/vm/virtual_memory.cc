@@ -9,6 +9,22 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            huge_pages,
+            false,
+            "Back heap pages and the instructions image with transparent huge "
+            "pages where the OS supports it.");
+
+RelaxedAtomic<intptr_t> VirtualMemory::huge_page_advised_bytes_ = {0};
+
+#if !defined(DART_HOST_OS_LINUX) && !defined(DART_HOST_OS_ANDROID)
+void VirtualMemory::AdviseHugePages(void* address, intptr_t size) {}
+
+intptr_t VirtualMemory::HugePageBackedBytes() {
+  return -1;
+}
+#endif
+
 bool VirtualMemory::InSamePage(uword address0, uword address1) {
   return (Utils::RoundDown(address0, PageSize()) ==
           Utils::RoundDown(address1, PageSize()));
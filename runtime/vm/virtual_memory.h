@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_VIRTUAL_MEMORY_H_
 #define RUNTIME_VM_VIRTUAL_MEMORY_H_
 
+#include "platform/atomic.h"
 #include "platform/utils.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
@@ -97,6 +98,19 @@ class VirtualMemory {
 
   static void DontNeed(void* address, intptr_t size);
 
+  static constexpr intptr_t kHugePageSize = 2 * MB;
+
+  // Advises the OS to back the range with transparent huge pages. Only done
+  // with --huge_pages and on Linux and Android; a no-op otherwise.
+  static void AdviseHugePages(void* address, intptr_t size);
+
+  // Bytes advised to use huge pages so far, and bytes of the process currently
+  // backed by huge pages as reported by the OS (-1 if unknown). The latter
+  // reads /proc on every call, so it is only sampled when the service asks
+  // for heap statistics.
+  static intptr_t HugePageAdvisedBytes() { return huge_page_advised_bytes_; }
+  static intptr_t HugePageBackedBytes();
+
   // Reserves and commits a virtual memory segment with size. If a segment of
   // the requested size cannot be allocated, nullptr is returned.
   static VirtualMemory* Allocate(intptr_t size,
@@ -193,6 +207,7 @@ class VirtualMemory {
 
   static uword page_size_;
   static VirtualMemory* compressed_heap_;
+  static RelaxedAtomic<intptr_t> huge_page_advised_bytes_;
 
 #if defined(DART_ENABLE_RX_WORKAROUNDS)
   static bool should_dual_map_executable_pages_;
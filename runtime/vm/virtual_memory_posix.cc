@@ -57,6 +57,7 @@ namespace dart {
 #define MAP_FAILED reinterpret_cast<void*>(-1)
 
 DECLARE_FLAG(bool, write_protect_code);
+DECLARE_FLAG(bool, huge_pages);
 
 #if defined(DART_TARGET_OS_LINUX)
 DECLARE_FLAG(bool, generate_perf_events_symbols);
@@ -144,6 +145,40 @@ static void* GenericMapAligned(void* hint,
   return reinterpret_cast<void*>(aligned_base);
 }
 
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+// With --huge_pages, small data allocations are carved out of 2MB-aligned
+// chunks so that neighboring heap pages share a huge page. Each allocation is
+// still unmapped on its own.
+static Mutex* huge_chunk_mutex = nullptr;
+static uword huge_chunk_top = 0;
+static uword huge_chunk_end = 0;
+
+static void* AllocateFromHugeChunk(intptr_t size, intptr_t alignment) {
+  ASSERT(size <= VirtualMemory::kHugePageSize);
+  ASSERT(alignment <= VirtualMemory::kHugePageSize);
+  MutexLocker ml(huge_chunk_mutex);
+  uword top = Utils::RoundUp(huge_chunk_top, alignment);
+  if ((huge_chunk_top == 0) || (top + size > huge_chunk_end)) {
+    const intptr_t chunk_size = VirtualMemory::kHugePageSize;
+    void* chunk = GenericMapAligned(
+        nullptr, PROT_READ | PROT_WRITE, chunk_size, chunk_size,
+        chunk_size * 2 - VirtualMemory::PageSize(),
+        MAP_PRIVATE | MAP_ANONYMOUS);
+    if (chunk == nullptr) {
+      return nullptr;
+    }
+    // Give back the unused tail of the previous chunk.
+    Unmap(huge_chunk_top, huge_chunk_end);
+    VirtualMemory::AdviseHugePages(chunk, chunk_size);
+    huge_chunk_top = reinterpret_cast<uword>(chunk);
+    huge_chunk_end = huge_chunk_top + chunk_size;
+    top = huge_chunk_top;
+  }
+  huge_chunk_top = top + size;
+  return reinterpret_cast<void*>(top);
+}
+#endif  // defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+
 intptr_t VirtualMemory::CalculatePageSize() {
   const intptr_t page_size = getpagesize();
   ASSERT(page_size != 0);
@@ -578,6 +613,9 @@ void VirtualMemory::Init() {
       kCompressedHeapSize);
 #endif  // defined(DART_COMPRESSED_POINTERS)
 #if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  ASSERT(huge_chunk_mutex == nullptr);
+  huge_chunk_mutex = new Mutex();
+
   FILE* fp = fopen("/proc/sys/vm/max_map_count", "r");
   if (fp != nullptr) {
     size_t max_map_count = 0;
@@ -602,6 +640,15 @@ void VirtualMemory::Cleanup() {
   delete compressed_heap_;
 #endif  // defined(DART_COMPRESSED_POINTERS)
   page_size_ = 0;
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  {
+    MutexLocker ml(huge_chunk_mutex);
+    Unmap(huge_chunk_top, huge_chunk_end);
+    huge_chunk_top = huge_chunk_end = 0;
+  }
+  delete huge_chunk_mutex;
+  huge_chunk_mutex = nullptr;
+#endif
 #if defined(DART_COMPRESSED_POINTERS)
   compressed_heap_ = nullptr;
   VirtualMemoryCompressedHeap::Cleanup();
@@ -630,6 +677,9 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
       return nullptr;
     }
     Commit(region.pointer(), region.size());
+    // Consecutive commits merge into one mapping, so a 2MB-aligned range can
+    // become a huge page once all of it is in use.
+    AdviseHugePages(region.pointer(), region.size());
     return new VirtualMemory(region, region);
   }
 #endif  // defined(DART_COMPRESSED_POINTERS)
@@ -665,8 +715,18 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
   if (is_executable) {
     hint = reinterpret_cast<void*>(&Dart_Initialize);
   }
-  void* address =
-      GenericMapAligned(hint, prot, size, alignment, allocated_size, map_flags);
+  void* address = nullptr;
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  if (FLAG_huge_pages && !is_executable && (size <= kHugePageSize) &&
+      (alignment <= kHugePageSize)) {
+    address = AllocateFromHugeChunk(size, alignment);
+  }
+  if (address == nullptr)
+#endif
+  {
+    address = GenericMapAligned(hint, prot, size, alignment, allocated_size,
+                                map_flags);
+  }
 #if defined(DART_HOST_OS_LINUX)
   // On WSL 1 trying to allocate memory close to the binary by supplying a hint
   // fails with ENOMEM for unclear reason. Some reports suggest that this might
@@ -862,6 +922,46 @@ void VirtualMemory::DontNeed(void* address, intptr_t size) {
   }
 }
 
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+void VirtualMemory::AdviseHugePages(void* address, intptr_t size) {
+#if defined(MADV_HUGEPAGE)
+  if (!FLAG_huge_pages) return;
+  const uword start = Utils::RoundUp(reinterpret_cast<uword>(address),
+                                     PageSize());
+  const uword end = Utils::RoundDown(reinterpret_cast<uword>(address) + size,
+                                     PageSize());
+  if (start >= end) return;
+  // Fails if the kernel was built without transparent huge pages, or for file
+  // mappings on some kernels. Either way the memory stays usable.
+  if (madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE) ==
+      0) {
+    huge_page_advised_bytes_.fetch_add(end - start);
+  } else {
+    LOG_INFO("madvise(0x%" Px ", 0x%" Px ", MADV_HUGEPAGE) failed\n", start,
+             end - start);
+  }
+#endif  // defined(MADV_HUGEPAGE)
+}
+
+intptr_t VirtualMemory::HugePageBackedBytes() {
+  FILE* fp = fopen("/proc/self/smaps_rollup", "r");
+  if (fp == nullptr) {
+    return -1;
+  }
+  intptr_t total_kb = 0;
+  char line[256];
+  while (fgets(line, sizeof(line), fp) != nullptr) {
+    intptr_t kb = 0;
+    if ((sscanf(line, "AnonHugePages: %" Pd " kB", &kb) == 1) ||
+        (sscanf(line, "FilePmdMapped: %" Pd " kB", &kb) == 1)) {
+      total_kb += kb;
+    }
+  }
+  fclose(fp);
+  return total_kb * KB;
+}
+#endif  // defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+
 #if defined(DART_HOST_OS_MACOS)
 // TODO(52579): Reenable on Fuchsia.
 bool VirtualMemory::DuplicateRX(VirtualMemory* target) {
@@ -10,6 +10,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, huge_pages);
+
 bool IsZero(char* begin, char* end) {
   for (char* current = begin; current < end; ++current) {
     if (*current != 0) {
@@ -127,4 +129,56 @@ VM_UNIT_TEST_CASE(DuplicateRXVirtualMemory) {
 
 #endif  // defined(DART_HOST_OS_MACOS)
 
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+// Whether madvise(MADV_HUGEPAGE) can succeed, i.e. the kernel has transparent
+// huge pages and they are not disabled.
+static bool TransparentHugePagesAvailable() {
+  FILE* fp = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+  if (fp == nullptr) {
+    return false;
+  }
+  char line[256];
+  bool available = false;
+  if (fgets(line, sizeof(line), fp) != nullptr) {
+    available = strstr(line, "[never]") == nullptr;
+  }
+  fclose(fp);
+  return available;
+}
+
+VM_UNIT_TEST_CASE(HugePageVirtualMemory) {
+  if (!TransparentHugePagesAvailable()) {
+    return;
+  }
+  SetFlagScope<bool> sfs(&FLAG_huge_pages, true);
+  const intptr_t advised_before = VirtualMemory::HugePageAdvisedBytes();
+  const intptr_t kCount = VirtualMemory::kHugePageSize / kPageSize;
+  VirtualMemory* vms[kCount];
+  for (intptr_t i = 0; i < kCount; i++) {
+    vms[i] = VirtualMemory::AllocateAligned(kPageSize, kPageSize,
+                                            /*is_executable=*/false,
+                                            /*is_compressed=*/false, "test");
+    EXPECT(vms[i] != nullptr);
+    EXPECT(Utils::IsAligned(vms[i]->start(), kPageSize));
+    char* buf = reinterpret_cast<char*>(vms[i]->address());
+    EXPECT(IsZero(buf, buf + vms[i]->size()));
+    buf[0] = 'x';
+  }
+  // Consecutive pages are carved out of the same chunk where possible.
+  for (intptr_t i = 1; i < kCount; i++) {
+    if (Utils::IsAligned(vms[i]->start(), VirtualMemory::kHugePageSize)) {
+      continue;  // Started a new chunk.
+    }
+    EXPECT_EQ(vms[i - 1]->end(), vms[i]->start());
+  }
+  // A huge page's worth of allocations cannot all fit in what is left of the
+  // current chunk, so at least one new chunk was advised.
+  EXPECT(VirtualMemory::HugePageAdvisedBytes() >=
+         advised_before + VirtualMemory::kHugePageSize);
+  for (intptr_t i = 0; i < kCount; i++) {
+    delete vms[i];
+  }
+}
+#endif
+
 }  // namespace dart
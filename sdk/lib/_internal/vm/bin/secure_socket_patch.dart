@@ -161,6 +161,16 @@ base class _SecureFilterImpl extends NativeFieldWrapperClass1
 
   int processBuffer(int bufferIndex) => throw UnimplementedError();
 
+  int enableKernelTls(RawSocket socket) {
+    if (socket is! _RawSocket) {
+      return _RawSecureSocket.kernelTlsUnavailable;
+    }
+    return _enableKernelTls(socket._socket);
+  }
+
+  @pragma("vm:external-name", "SecureSocket_EnableKernelTls")
+  external int _enableKernelTls(_NativeSocket socket);
+
   @pragma("vm:external-name", "SecureSocket_GetSelectedProtocol")
   external String? selectedProtocol();
 
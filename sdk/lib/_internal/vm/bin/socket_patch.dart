@@ -1479,6 +1479,50 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
     }
   }
 
+  // Writes [bytes] bytes from [chunks], a flat list of
+  // <List<int> buffer, int offset, int length> triples, with a single gather
+  // write where the platform supports it. See [write] for the result.
+  int writeVector(List<Object> chunks, int bytes) {
+    if (isClosing || isClosed) return 0;
+    if (bytes == 0) return 0;
+    try {
+      for (int i = 0; i < chunks.length; i += 3) {
+        final offset = chunks[i + 1] as int;
+        final length = chunks[i + 2] as int;
+        _BufferAndStart bufferAndStart = _ensureFastAndSerializableByteData(
+          chunks[i] as List<int>,
+          offset,
+          offset + length,
+        );
+        chunks[i] = bufferAndStart.buffer;
+        chunks[i + 1] = bufferAndStart.start;
+      }
+      if (!const bool.fromEnvironment("dart.vm.product")) {
+        _SocketProfile.collectStatistic(
+          id,
+          _SocketProfileType.writeBytes,
+          bytes,
+        );
+      }
+      int result = _nativeWriteVector(chunks);
+      if (result >= 0) {
+        // As in [write], pause writing after a partial write until the write
+        // event arrives.
+        writeAvailable = (result == bytes) && !hasPendingWrite();
+      } else {
+        // Negative result indicates that we forced a short write for testing
+        // purpose.
+        result = -result;
+        writeAvailable = !hasPendingWrite();
+      }
+      return result;
+    } catch (e) {
+      StackTrace st = StackTrace.current;
+      scheduleMicrotask(() => reportError(e, st, "Write failed"));
+      return 0;
+    }
+  }
+
   int send(
     List<int> buffer,
     int offset,
@@ -2042,6 +2086,8 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
   external List<dynamic> _nativeReceiveMessage(int len);
   @pragma("vm:external-name", "Socket_WriteList")
   external int _nativeWrite(List<int> buffer, int offset, int bytes);
+  @pragma("vm:external-name", "Socket_WriteVector")
+  external int _nativeWriteVector(List<Object> chunks);
   @pragma("vm:external-name", "Socket_HasPendingWrite")
   external bool _nativeHasPendingWrite();
   @pragma("vm:external-name", "Socket_SendTo")
@@ -2237,7 +2283,7 @@ class _RawServerSocket extends Stream<RawSocket>
 }
 
 class _RawSocket extends Stream<RawSocketEvent>
-    implements RawSocket, _RawSocketBase {
+    implements RawSocket, _RawSocketBase, _VectoredWriteSocket {
   final _NativeSocket _socket;
   final _controller = StreamController<RawSocketEvent>(sync: true);
   bool _readEventsEnabled = true;
@@ -2388,6 +2434,9 @@ class _RawSocket extends Stream<RawSocketEvent>
   int write(List<int> buffer, [int offset = 0, int? count]) =>
       _socket.write(buffer, offset, count);
 
+  int _writeVector(List<Object> chunks, int bytes) =>
+      _socket.writeVector(chunks, bytes);
+
   int sendMessage(
     List<SocketControlMessage> controlMessages,
     List<int> data, [
@@ -2554,10 +2603,23 @@ class Socket {
 }
 
 class _SocketStreamConsumer implements StreamConsumer<List<int>> {
+  // Data that arrives while the socket cannot take more is buffered and
+  // written with a single vectored write once it can. The stream is paused
+  // when this much is buffered.
+  static const int _maxBufferedBytes = 64 * 1024;
+  static const int _maxBufferedChunks = 64;
+
   StreamSubscription? subscription;
   final _Socket socket;
-  int? offset;
-  List<int>? buffer;
+  // Data from the stream that is not written yet. The first buffer is
+  // written from [offset].
+  final List<List<int>> buffers = <List<int>>[];
+  int offset = 0;
+  int bufferedBytes = 0;
+  // Whether a write event was requested to continue writing.
+  bool waitingForWriteEvent = false;
+  // Whether the stream is done while data is still buffered.
+  bool streamDone = false;
   bool paused = false;
   Completer<Socket>? streamCompleter;
 
@@ -2570,14 +2632,19 @@ class _SocketStreamConsumer implements StreamConsumer<List<int>> {
       subscription = stream.listen(
         (data) {
           assert(!paused);
-          assert(buffer == null);
-          buffer = data;
-          offset = 0;
+          buffers.add(data);
+          bufferedBytes += data.length;
+          if (waitingForWriteEvent) {
+            // Gather the data into the write that follows the write event.
+            _pauseIfFull();
+            return;
+          }
           try {
             write();
           } catch (e) {
-            buffer = null;
+            buffers.clear();
             offset = 0;
+            bufferedBytes = 0;
 
             socket.destroy();
             stop();
@@ -2590,10 +2657,12 @@ class _SocketStreamConsumer implements StreamConsumer<List<int>> {
         },
         onDone: () {
           // Note: stream only delivers done event if subscription is not paused.
-          // so it is crucial to keep subscription paused while writes are
-          // in flight.
-          assert(buffer == null);
-          done();
+          // Data that is still buffered is written before completing.
+          if (buffers.isEmpty && !waitingForWriteEvent) {
+            done();
+          } else {
+            streamDone = true;
+          }
         },
         cancelOnError: true,
       );
@@ -2622,31 +2691,74 @@ class _SocketStreamConsumer implements StreamConsumer<List<int>> {
   void write() {
     final sub = subscription;
     if (sub == null) return;
+    waitingForWriteEvent = false;
 
     // We have something to write out.
-    if (offset! < buffer!.length) {
-      offset =
-          offset! + socket._write(buffer!, offset!, buffer!.length - offset!);
+    if (bufferedBytes > 0) {
+      int written;
+      if (buffers.length == 1) {
+        final buffer = buffers.first;
+        written = socket._write(buffer, offset, buffer.length - offset);
+      } else {
+        final chunks = <Object>[];
+        for (int i = 0; i < buffers.length; i++) {
+          final start = (i == 0) ? offset : 0;
+          chunks
+            ..add(buffers[i])
+            ..add(start)
+            ..add(buffers[i].length - start);
+        }
+        written = socket._writeVector(chunks, bufferedBytes);
+      }
+      _advance(written);
+    } else {
+      _advance(0);
     }
 
-    if (offset! < buffer!.length || !_previousWriteHasCompleted) {
+    if (buffers.isNotEmpty || !_previousWriteHasCompleted) {
       // On Windows we might have written the whole buffer out but we are
-      // still waiting for the write to complete. We should not resume the
-      // subscription until the pending write finishes and we receive a
+      // still waiting for the write to complete. We should not write the
+      // next chunk until the pending write finishes and we receive a
       // writeEvent signaling that we can write the next chunk or that we
       // can consider all data flushed from our side into kernel buffers.
-      if (!paused) {
-        paused = true;
-        sub.pause();
-      }
+      waitingForWriteEvent = true;
+      _pauseIfFull();
       socket._enableWriteEvent();
     } else {
       // Write fully completed.
-      buffer = null;
       if (paused) {
         paused = false;
         sub.resume();
       }
+      if (streamDone) {
+        streamDone = false;
+        done();
+      }
+    }
+  }
+
+  // Drops the first [written] bytes from [buffers], along with buffers that
+  // are empty.
+  void _advance(int written) {
+    bufferedBytes -= written;
+    while (buffers.isNotEmpty) {
+      final remaining = buffers.first.length - offset;
+      if (written < remaining) {
+        offset += written;
+        return;
+      }
+      written -= remaining;
+      buffers.removeAt(0);
+      offset = 0;
+    }
+  }
+
+  void _pauseIfFull() {
+    if (!paused &&
+        (bufferedBytes >= _maxBufferedBytes ||
+            buffers.length >= _maxBufferedChunks)) {
+      paused = true;
+      subscription!.pause();
     }
   }
 
@@ -2668,6 +2780,8 @@ class _SocketStreamConsumer implements StreamConsumer<List<int>> {
     sub.cancel();
     subscription = null;
     paused = false;
+    waitingForWriteEvent = false;
+    streamDone = false;
     socket._disableWriteEvent();
   }
 }
@@ -2817,7 +2931,7 @@ class _Socket extends Stream<Uint8List> implements Socket {
     _detachReady = completer;
     _sink.close();
     return completer.future.then((_) {
-      assert(_consumer.buffer == null);
+      assert(_consumer.buffers.isEmpty);
       var raw = _raw;
       _raw = null;
       return [raw, _subscription];
@@ -2908,6 +3022,27 @@ class _Socket extends Stream<Uint8List> implements Socket {
     return 0;
   }
 
+  // Writes [bytes] bytes from [chunks], see [_VectoredWriteSocket].
+  int _writeVector(List<Object> chunks, int bytes) {
+    final raw = _raw;
+    if (raw is _VectoredWriteSocket) {
+      return raw._writeVector(chunks, bytes);
+    }
+    // Write the chunks one by one until one is only written partially.
+    int written = 0;
+    for (int i = 0; (i < chunks.length) && (_raw != null); i += 3) {
+      final length = chunks[i + 2] as int;
+      final result = _write(
+        chunks[i] as List<int>,
+        chunks[i + 1] as int,
+        length,
+      );
+      written += result;
+      if (result < length) break;
+    }
+    return written;
+  }
+
   void _enableWriteEvent() {
     _raw?.writeEventsEnabled = true;
   }
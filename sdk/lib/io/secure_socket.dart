@@ -538,6 +538,15 @@ abstract interface class _RawSocketBase {
   void set _owner(owner);
 }
 
+// Interface used by [_ExternalBuffer] to write both linear ranges of a
+// wrapped buffer to sockets that support gather writes with a single call.
+abstract interface class _VectoredWriteSocket {
+  // Writes [bytes] bytes from [chunks], a flat list of
+  // <List<int> buffer, int offset, int length> triples. Returns the number of
+  // bytes written, like [RawSocket.write].
+  int _writeVector(List<Object> chunks, int bytes);
+}
+
 class _RawSecureSocket extends Stream<RawSocketEvent>
     implements RawSecureSocket, _RawSocketBase {
   // Status states
@@ -553,6 +562,12 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   static const int writeEncryptedId = 3;
   static const int bufferCount = 4;
 
+  // Results of _SecureFilter.enableKernelTls. These must agree with those in
+  // runtime/bin/secure_socket_filter.h.
+  static const int kernelTlsUnavailable = -1;
+  static const int kernelTlsRetry = 0;
+  static const int kernelTlsEnabled = 1;
+
   // Is a buffer identifier for an encrypted buffer?
   static bool _isBufferEncrypted(int identifier) =>
       identifier >= readEncryptedId;
@@ -588,6 +603,11 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   bool _connectPending = true;
   bool _filterPending = false;
   bool _filterActive = false;
+  // Once the session has been handed over to kernel TLS, the socket encrypts
+  // and decrypts the records itself, and plaintext goes straight between the
+  // socket and the plaintext buffers.
+  bool _kernelTlsPossible = true;
+  bool _kernelTls = false;
 
   _SecureFilter? _secureFilter = _SecureFilter._();
   String? _selectedProtocol;
@@ -1016,6 +1036,9 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
     if (_status != connectedStatus) {
       throw HandshakeException("Called renegotiate on a non-connected socket");
     }
+    if (_kernelTls) {
+      throw HandshakeException("Called renegotiate on a kernel TLS socket");
+    }
     _status = handshakeStatus;
     _filterStatus.writeEmpty = false;
     _scheduleFilter();
@@ -1078,14 +1101,18 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
         _filterActive = true;
         _filterPending = false;
 
-        _filterStatus = await _pushAllFilterStages();
+        _filterStatus = _kernelTls
+            ? _pushKernelTls()
+            : await _pushAllFilterStages();
         _filterActive = false;
         if (_status == closedStatus) {
           _secureFilter!.destroy();
           _secureFilter = null;
           return;
         }
-        if (_readEventsEnabled) {
+        if (_readEventsEnabled &&
+            !(_kernelTls &&
+                _secureFilter!.buffers![readPlaintextId].free == 0)) {
           _socket.readEventsEnabled = true;
         }
         if (_filterStatus.writeEmpty && _closedWrite && !_socketClosedWrite) {
@@ -1126,6 +1153,8 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
           if (_status == handshakeStatus) {
             await _secureHandshake();
           }
+        } else {
+          _tryEnableKernelTls();
         }
       }
     } catch (e, st) {
@@ -1157,9 +1186,11 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
 
   void _readSocket() {
     if (_status == closedStatus) return;
-    var buffer = _secureFilter!.buffers![readEncryptedId];
+    var bufferId = _kernelTls ? readPlaintextId : readEncryptedId;
+    var buffer = _secureFilter!.buffers![bufferId];
     if (buffer.writeFromSource(_readSocketOrBufferedData) > 0) {
       _filterStatus.readEmpty = false;
+      if (_kernelTls) _scheduleReadEvent();
     } else {
       _socket.readEventsEnabled = false;
     }
@@ -1167,11 +1198,47 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
 
   void _writeSocket() {
     if (_socketClosedWrite) return;
-    var buffer = _secureFilter!.buffers![writeEncryptedId];
+    var bufferId = _kernelTls ? writePlaintextId : writeEncryptedId;
+    var buffer = _secureFilter!.buffers![bufferId];
     if (buffer.readToSocket(_socket)) {
       // Returns true if blocked
       _socket.writeEventsEnabled = true;
     }
+    if (_kernelTls) _sendWriteEvent();
+  }
+
+  // Hands the session over to kernel TLS, if enabled, as soon as no
+  // encrypted data is left in the buffers. Plaintext that is still buffered
+  // is sent or delivered as is afterwards.
+  void _tryEnableKernelTls() {
+    if (!_kernelTlsPossible ||
+        _status != connectedStatus ||
+        _socketClosedRead ||
+        _socketClosedWrite ||
+        _bufferedData != null) {
+      return;
+    }
+    var bufs = _secureFilter!.buffers!;
+    if (!bufs[readEncryptedId].isEmpty || !bufs[writeEncryptedId].isEmpty) {
+      return;
+    }
+    switch (_secureFilter!.enableKernelTls(_socket)) {
+      case kernelTlsEnabled:
+        _kernelTlsPossible = false;
+        _kernelTls = true;
+        _filterPending = true;
+      case kernelTlsUnavailable:
+        _kernelTlsPossible = false;
+    }
+  }
+
+  _FilterStatus _pushKernelTls() {
+    _writeSocket();
+    if (_socket.available() > 0) _readSocket();
+    var bufs = _secureFilter!.buffers!;
+    return _FilterStatus()
+      ..writeEmpty = bufs[writePlaintextId].isEmpty
+      ..readEmpty = bufs[readPlaintextId].isEmpty;
   }
 
   // If a read event should be sent, add it to the controller.
@@ -1401,6 +1468,20 @@ class _ExternalBuffer {
   }
 
   bool readToSocket(RawSocket socket) {
+    if (start > end && end > 0 && socket is _VectoredWriteSocket) {
+      // The data wraps around: write both linear ranges at once.
+      final firstLength = size - start;
+      final bytes = socket._writeVector(<Object>[
+        data!,
+        start,
+        firstLength,
+        data!,
+        0,
+        end,
+      ], firstLength + end);
+      advanceStart(bytes);
+      return !isEmpty;
+    }
     // Loop over zero, one, or two linear data ranges.
     while (true) {
       var toWrite = linearLength;
@@ -1433,6 +1514,10 @@ abstract class _SecureFilter {
   void init();
   X509Certificate? get peerCertificate;
   int processBuffer(int bufferIndex);
+
+  // Hands the session over to kernel TLS on [socket]. Returns one of the
+  // _RawSecureSocket.kernelTls* values.
+  int enableKernelTls(RawSocket socket);
   void registerBadCertificateCallback(bool Function(X509Certificate) callback);
   void registerHandshakeCompleteCallback(Function handshakeCompleteHandler);
   void registerKeyLogPort(SendPort port);
@@ -892,6 +892,16 @@ abstract interface class SendPort implements Capability {
   /// identified as immutable (e.g. strings) will be shared whereas all other
   /// objects will be copied.
   ///
+  /// When the VM runs with the experimental `--promote-immutable-objects`
+  /// option, records, unmodifiable lists and instances of classes whose
+  /// instance fields are all final and not late can also be identified as
+  /// immutable when they are sent, provided everything they reference is
+  /// immutable as well. Such objects are then shared with the receiver and
+  /// are [identical] to the objects the sender sent, in this and all later
+  /// messages. A [WeakReference] or [Expando] entry in the message whose
+  /// target or key is shared keeps it, as the receiver can reach it just like
+  /// the sender.
+  ///
   /// The send happens immediately and may have a linear time cost to copy the
   /// transitive object graph. The send itself doesn't block (i.e. doesn't wait
   /// until the receiver has received the message). The corresponding receive
@@ -0,0 +1,183 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Runs socket and timer traffic through the event handler with the epoll and
+// the io_uring backends. On kernels without io_uring support --use-io-uring
+// falls back to epoll.
+//
+// VMOptions=
+// VMOptions=--use-io-uring
+// VMOptions=--use-io-uring --short_socket_read --short_socket_write
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+Uint8List makeData(int length, int seed) {
+  final data = Uint8List(length);
+  for (int i = 0; i < length; i++) {
+    data[i] = (i * 7 + seed) & 0xff;
+  }
+  return data;
+}
+
+// Many concurrent connections to an echo server.
+Future testEcho() async {
+  const connections = 32;
+  const length = 64 * 1024 + 17;
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((socket) {
+    socket.listen(socket.add, onDone: socket.close);
+  });
+
+  await Future.wait([
+    for (int i = 0; i < connections; i++)
+      () async {
+        final data = makeData(length, i);
+        final socket = await Socket.connect(server.address, server.port);
+        socket.add(data);
+        await socket.flush();
+        // Half close, so the server sees the end of the data.
+        final received = BytesBuilder(copy: false);
+        final done = socket.listen(received.add).asFuture();
+        await socket.close();
+        await done;
+        Expect.listEquals(data, received.takeBytes());
+      }(),
+  ]);
+  await server.close();
+}
+
+// A single large write that cannot complete at once relies on write events.
+Future testRawWriteEvents() async {
+  const length = 8 * 1024 * 1024;
+  final server = await RawServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  final received = Completer<int>();
+  server.listen((client) {
+    int count = 0;
+    client.listen((event) {
+      switch (event) {
+        case RawSocketEvent.read:
+          count += client.read()?.length ?? 0;
+          break;
+        case RawSocketEvent.readClosed:
+          client.close();
+          received.complete(count);
+          break;
+      }
+    });
+  });
+
+  final socket = await RawSocket.connect(server.address, server.port);
+  final data = makeData(length, 0);
+  int written = 0;
+  socket.listen((event) {
+    switch (event) {
+      case RawSocketEvent.write:
+        written += socket.write(data, written);
+        if (written < length) {
+          socket.writeEventsEnabled = true;
+        } else {
+          socket.shutdown(SocketDirection.send);
+        }
+        break;
+      case RawSocketEvent.readClosed:
+        socket.close();
+        break;
+    }
+  });
+  Expect.equals(length, await received.future);
+  await server.close();
+}
+
+// Listening sockets are level triggered: connections accepted by two shared
+// listeners must all be reported.
+Future testSharedListeners() async {
+  const connections = 50;
+  final server1 = await RawServerSocket.bind(
+    InternetAddress.loopbackIPv4,
+    0,
+    shared: true,
+  );
+  final server2 = await RawServerSocket.bind(
+    InternetAddress.loopbackIPv4,
+    server1.port,
+    shared: true,
+  );
+  int accepted = 0;
+  final allAccepted = Completer<void>();
+  void onClient(RawSocket client) {
+    client.close();
+    if (++accepted == connections) {
+      allAccepted.complete();
+    }
+  }
+
+  server1.listen(onClient);
+  server2.listen(onClient);
+  final sockets = await Future.wait([
+    for (int i = 0; i < connections; i++)
+      RawSocket.connect(InternetAddress.loopbackIPv4, server1.port),
+  ]);
+  await allAccepted.future;
+  for (final socket in sockets) {
+    socket.close();
+  }
+  await server1.close();
+  await server2.close();
+}
+
+// Timers fire in deadline order, cancelled timers never fire and periodic
+// timers keep firing, also while sockets are busy.
+Future testTimers() async {
+  final fired = <int>[];
+  final done = Completer<void>();
+  const count = 100;
+  final timers = <Timer>[];
+  int remaining = count ~/ 2;
+  for (int i = 0; i < count; i++) {
+    final delay = (i * 37) % 50;
+    timers.add(
+      Timer(Duration(milliseconds: delay), () {
+        fired.add(delay);
+        if (--remaining == 0) {
+          done.complete();
+        }
+      }),
+    );
+  }
+  for (int i = 1; i < count; i += 2) {
+    timers[i].cancel();
+  }
+
+  int ticks = 0;
+  final periodicDone = Completer<void>();
+  Timer.periodic(const Duration(milliseconds: 2), (timer) {
+    if (++ticks == 10) {
+      timer.cancel();
+      periodicDone.complete();
+    }
+  });
+
+  await Future.wait([done.future, periodicDone.future, testEcho()]);
+  Expect.equals(count ~/ 2, fired.length);
+  // Timers created a millisecond apart may swap places when their delays
+  // differ by one.
+  for (int i = 1; i < fired.length; i++) {
+    Expect.isTrue(fired[i - 1] <= fired[i] + 1);
+  }
+  Expect.equals(10, ticks);
+}
+
+main() async {
+  asyncStart();
+  await testEcho();
+  await testRawWriteEvents();
+  await testSharedListeners();
+  await testTimers();
+  asyncEnd();
+}
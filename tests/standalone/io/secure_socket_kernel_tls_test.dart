@@ -0,0 +1,158 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Runs TLS traffic over loopback with and without handing the sessions over
+// to kernel TLS. Where the kernel has no TLS support --use-kernel-tls falls
+// back to encrypting in BoringSSL, and the traffic must be the same.
+//
+// VMOptions=
+// VMOptions=--use-kernel-tls
+// VMOptions=--use-kernel-tls --short_socket_read --short_socket_write
+// OtherResources=certificates/server_chain.pem
+// OtherResources=certificates/server_key.pem
+// OtherResources=certificates/trusted_certs.pem
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+String localFile(path) => Platform.script.resolve(path).toFilePath();
+
+SecurityContext serverContext = SecurityContext()
+  ..useCertificateChain(localFile('certificates/server_chain.pem'))
+  ..usePrivateKey(
+    localFile('certificates/server_key.pem'),
+    password: 'dartdart',
+  );
+
+// Allowing renegotiation keeps the session in BoringSSL.
+SecurityContext userspaceServerContext = SecurityContext()
+  ..useCertificateChain(localFile('certificates/server_chain.pem'))
+  ..usePrivateKey(
+    localFile('certificates/server_key.pem'),
+    password: 'dartdart',
+  )
+  ..allowLegacyUnsafeRenegotiation = true;
+
+SecurityContext clientContext = SecurityContext()
+  ..setTrustedCertificates(localFile('certificates/trusted_certs.pem'));
+
+Uint8List makeData(int length, int seed) {
+  final data = Uint8List(length);
+  for (int i = 0; i < length; i++) {
+    data[i] = (i * 13 + seed) & 0xff;
+  }
+  return data;
+}
+
+// The number of sessions the kernel has encrypted so far, or null if the
+// kernel has no TLS support loaded.
+int? kernelTlsSessions() {
+  final stats = File('/proc/net/tls_stat');
+  if (!Platform.isLinux || !stats.existsSync()) return null;
+  for (final line in stats.readAsLinesSync()) {
+    final fields = line.split(RegExp(r'\s+'));
+    if (fields.length == 2 && fields[0] == 'TlsTxSw') {
+      return int.parse(fields[1]);
+    }
+  }
+  return null;
+}
+
+Future<SecureServerSocket> startEchoServer(SecurityContext context) async {
+  final server = await SecureServerSocket.bind(
+    InternetAddress.loopbackIPv4,
+    0,
+    context,
+  );
+  server.listen((SecureSocket client) {
+    // Greet before reading, so records are in flight while the client hands
+    // its session over.
+    client.add(makeData(100, 1));
+    client.listen(client.add, onDone: client.close);
+  });
+  return server;
+}
+
+// Sends data of the given length and expects the greeting followed by the
+// same data back.
+Future echo(SecureServerSocket server, int length, int seed) async {
+  final data = makeData(length, seed);
+  final socket = await SecureSocket.connect(
+    InternetAddress.loopbackIPv4,
+    server.port,
+    context: clientContext,
+  );
+  final received = BytesBuilder(copy: false);
+  final done = socket.listen(received.add).asFuture();
+  socket.add(data);
+  await socket.flush();
+  await socket.close();
+  await done;
+  final bytes = received.takeBytes();
+  Expect.equals(100 + length, bytes.length);
+  Expect.listEquals(makeData(100, 1), bytes.sublist(0, 100));
+  Expect.listEquals(data, bytes.sublist(100));
+}
+
+Future testEcho(SecurityContext context) async {
+  final server = await startEchoServer(context);
+  await Future.wait([
+    for (int i = 0; i < 8; i++) echo(server, 1024 * 1024 + i * 4099, i),
+  ]);
+  // Lengths around the size of a TLS record.
+  for (final length in [0, 1, 16383, 16384, 16385]) {
+    await echo(server, length, length);
+  }
+  await server.close();
+}
+
+// Data written right after the handshake, before the session could be
+// handed over, must still arrive in order.
+Future testWriteDuringHandoff() async {
+  final server = await SecureServerSocket.bind(
+    InternetAddress.loopbackIPv4,
+    0,
+    serverContext,
+  );
+  final serverDone = server.first.then((SecureSocket client) async {
+    final received = BytesBuilder(copy: false);
+    await client.listen(received.add).asFuture();
+    await client.close();
+    return received.takeBytes();
+  });
+  final socket = await SecureSocket.connect(
+    InternetAddress.loopbackIPv4,
+    server.port,
+    context: clientContext,
+  );
+  final expected = BytesBuilder();
+  for (int i = 0; i < 100; i++) {
+    final chunk = makeData(i * 37, i);
+    expected.add(chunk);
+    socket.add(chunk);
+  }
+  await socket.close();
+  Expect.listEquals(expected.takeBytes(), await serverDone);
+  await server.close();
+}
+
+main() async {
+  asyncStart();
+  final sessionsBefore = kernelTlsSessions() ?? 0;
+  await testEcho(serverContext);
+  await testEcho(userspaceServerContext);
+  await testWriteDuringHandoff();
+  final sessionsAfter = kernelTlsSessions();
+  if (Platform.executableArguments.contains('--use-kernel-tls') &&
+      sessionsAfter != null) {
+    // The kernel supports TLS, so at least the long running sessions must
+    // have been handed over.
+    Expect.isTrue(sessionsAfter > sessionsBefore);
+  }
+  asyncEnd();
+}
@@ -0,0 +1,124 @@
+// Copyright (c) 2025, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Adds many chunks to a plain socket while the peer is not reading, so that
+// they are buffered and written together with vectored writes once the peer
+// reads again.
+//
+// VMOptions=
+// VMOptions=--short_socket_write
+// VMOptions=--short_socket_read --short_socket_write
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+// Chunks of different kinds and sizes, including empty ones and views.
+List<List<int>> makeChunks() {
+  final chunks = <List<int>>[];
+  int value = 0;
+  int next() => value++ & 0xff;
+  for (int i = 0; i < 2000; i++) {
+    final length = (i * 37) % 300;
+    switch (i % 4) {
+      case 0:
+        chunks.add(Uint8List.fromList(List.generate(length, (_) => next())));
+      case 1:
+        chunks.add(List<int>.generate(length, (_) => next()));
+      case 2:
+        final backing = Uint8List(length + 8);
+        for (int j = 0; j < length; j++) {
+          backing[4 + j] = next();
+        }
+        chunks.add(Uint8List.view(backing.buffer, 4, length));
+      case 3:
+        chunks.add(const <int>[]);
+    }
+  }
+  // Larger than the socket buffers.
+  chunks.add(List<int>.generate(4 * 1024 * 1024, (_) => next()));
+  for (int i = 0; i < 100; i++) {
+    chunks.add(<int>[next()]);
+  }
+  return chunks;
+}
+
+Future testGatheredWrites() async {
+  final chunks = makeChunks();
+  final expected = BytesBuilder(copy: false);
+  chunks.forEach(expected.add);
+  final expectedBytes = expected.takeBytes();
+
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  final received = Completer<Uint8List>();
+  server.listen((connection) {
+    final builder = BytesBuilder(copy: false);
+    final subscription = connection.listen(
+      builder.add,
+      onDone: () {
+        received.complete(builder.takeBytes());
+        connection.destroy();
+      },
+    );
+    // Let the writer back up before reading.
+    subscription.pause();
+    Timer(const Duration(milliseconds: 200), subscription.resume);
+  });
+
+  final socket = await Socket.connect(
+    InternetAddress.loopbackIPv4,
+    server.port,
+  );
+  for (final chunk in chunks) {
+    socket.add(chunk);
+  }
+  // Completes only after the buffered chunks have been written.
+  await socket.flush();
+  await socket.close();
+  final bytes = await received.future;
+  Expect.listEquals(expectedBytes, bytes);
+  socket.destroy();
+  await server.close();
+}
+
+Future testFlushBetweenChunks() async {
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  final received = Completer<List<int>>();
+  server.listen((connection) {
+    final bytes = <int>[];
+    connection.listen(
+      bytes.addAll,
+      onDone: () {
+        received.complete(bytes);
+        connection.destroy();
+      },
+    );
+  });
+
+  final socket = await Socket.connect(
+    InternetAddress.loopbackIPv4,
+    server.port,
+  );
+  final expected = <int>[];
+  for (int i = 0; i < 50; i++) {
+    final chunk = List<int>.generate(i, (j) => (i + j) & 0xff);
+    expected.addAll(chunk);
+    socket.add(chunk);
+    if (i % 7 == 0) await socket.flush();
+  }
+  await socket.close();
+  Expect.listEquals(expected, await received.future);
+  socket.destroy();
+  await server.close();
+}
+
+main() async {
+  asyncStart();
+  await testGatheredWrites();
+  await testFlushBetweenChunks();
+  asyncEnd();
+}